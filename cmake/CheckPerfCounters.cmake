@@ -0,0 +1,31 @@
+# Boolector: Satisfiablity Modulo Theories (SMT) solver.
+#
+# Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+#
+# This file is part of Boolector.
+# See COPYING for more information on using this software.
+#
+
+# Check if hardware performance counters (Linux perf_event_open) are available.
+include(CheckCSourceCompiles)
+CHECK_C_SOURCE_COMPILES(
+"
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+int main ()
+{
+  struct perf_event_attr attr;
+  memset (&attr, 0, sizeof (attr));
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = PERF_COUNT_HW_CPU_CYCLES;
+  attr.read_format = PERF_FORMAT_GROUP;
+  (void) syscall (__NR_perf_event_open, &attr, 0, -1, -1, 0);
+  (void) ioctl (0, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  return 0;
+}
+"
+HAVE_PERF_COUNTERS
+)
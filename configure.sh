@@ -30,6 +30,7 @@ python=no
 py2=no
 py3=no
 timestats=no
+perfcounters=no
 
 # Enable macOS universal binaries
 univeral=no
@@ -74,6 +75,7 @@ where <option> is one of the following:
   --py2             prefer Python 2.7
   --py3             prefer Python 3
   --time-stats      compile with time statistics
+  --perf-counters   compile with hardware performance counters (Linux)
   --universal       produce macOS universal x86_64/arm64 binaries
 
   --gmp             use gmp for bit-vector implementation
@@ -153,6 +155,7 @@ do
     --py2)        py2=yes;;
     --py3)        py3=yes;;
     --time-stats) timestats=yes;;
+    --perf-counters) perfcounters=yes;;
     --universal)  universal=yes;;
 
     --gmp) gmp=yes;;
@@ -214,6 +217,7 @@ cmake_opts="$CMAKE_OPTS"
 [ $py2 = yes ] && cmake_opts="$cmake_opts -DUSE_PYTHON2=ON"
 [ $py3 = yes ] && cmake_opts="$cmake_opts -DUSE_PYTHON3=ON"
 [ $timestats = yes ] && cmake_opts="$cmake_opts -DTIME_STATS=ON"
+[ $perfcounters = yes ] && cmake_opts="$cmake_opts -DPERF_COUNTERS=ON"
 
 [ -n "$flags" ] && cmake_opts="$cmake_opts -DFLAGS=$flags"
 
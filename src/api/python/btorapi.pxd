@@ -592,6 +592,15 @@ cdef extern from "boolector.h":
     void boolector_dump_aiger_binary (Btor * btor, FILE * file, bool merge_roots) \
       except +raise_py_error
 
+    void boolector_dump_btor_binary (Btor * btor, FILE * file) \
+      except +raise_py_error
+
+    bool boolector_snapshot_write (Btor * btor, FILE * file) \
+      except +raise_py_error
+
+    const char * boolector_snapshot_read (Btor * btor, FILE * file) \
+      except +raise_py_error
+
     const char * boolector_copyright (Btor * btor) \
       except +raise_py_error
 
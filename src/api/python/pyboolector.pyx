@@ -956,8 +956,8 @@ cdef class Boolector:
             :rtype: :class:`~pyboolector.Boolector`
 
             .. note::
-                If Lingeling is used as SAT solver, Boolector can be cloned at
-                any time, since Lingeling also supports cloning. However, if
+                If Lingeling or CaDiCaL is used as SAT solver, Boolector can be
+                cloned at any time, since both also support cloning. However, if
                 you use :func:`~pyboolector.Boolector.Clone` with MiniSAT or
                 PicoSAT (no cloning suppport), Boolector can only be cloned
                 prior to the first :func:`~pyboolector.Boolector.Sat` call.
@@ -1224,7 +1224,7 @@ cdef class Boolector:
 
             Dump input formula to output file.
 
-            :param format: A file format identifier string (use 'btor' for BTOR_, 'smt2' for `SMT-LIB v2`_, 'aig' for binary AIGER (QF_BV only), and 'aag' for ASCII AIGER (QF_BV only)).
+            :param format: A file format identifier string (use 'btor' for BTOR_, 'smt2' for `SMT-LIB v2`_, 'aig' for binary AIGER (QF_BV only), 'aag' for ASCII AIGER (QF_BV only), and 'btorbin' for the compact binary BTOR format).
             :type format: str
             :param outile: Output file name (default: stdout).
             :type format: str.
@@ -1251,11 +1251,65 @@ cdef class Boolector:
             btorapi.boolector_dump_aiger_binary(self._c_btor, c_file, True)
         elif format.lower() == "aag":
             btorapi.boolector_dump_aiger_ascii(self._c_btor, c_file, True)
+        elif format.lower() == "btorbin":
+            btorapi.boolector_dump_btor_binary(self._c_btor, c_file)
         else:
             raise BoolectorException("Invalid dump format '{}'".format(format))
         if outfile is not None:
             fclose(c_file)
 
+    def Snapshot_write(self, str outfile):
+        """ Snapshot_write(outfile)
+
+            Write a binary snapshot of the current formula to output file,
+            which can be restored via
+            :func:`~pyboolector.Boolector.Snapshot_read` without parsing and
+            simplifying the formula again.
+
+            Assumptions, bit-blasted AIGs and the state of the SAT solver are
+            not part of a snapshot.
+
+            :param outfile: Output file name.
+            :type outfile: str
+        """
+        cdef FILE * c_file
+        cdef cbool res
+
+        if os.path.isdir(outfile):
+            raise BoolectorException(
+                    "Outfile '{}' is a directory".format(outfile))
+        c_file = fopen(_ChPtr(outfile)._c_str, "wb")
+        if c_file == NULL:
+            raise BoolectorException(
+                    "Outfile '{}' can not be opened".format(outfile))
+        res = btorapi.boolector_snapshot_write(self._c_btor, c_file)
+        if fclose(c_file) != 0 or not res:
+            raise BoolectorException(
+                    "Writing snapshot to '{}' failed".format(outfile))
+
+    def Snapshot_read(self, str infile):
+        """ Snapshot_read(infile)
+
+            Restore the formula of a snapshot written via
+            :func:`~pyboolector.Boolector.Snapshot_write` and add its
+            constraints to the current formula.
+
+            :param infile: Input file name.
+            :type infile: str
+        """
+        cdef FILE * c_file
+        cdef const char * err_msg
+
+        if not os.path.isfile(infile):
+            raise BoolectorException("File '{}' does not exist".format(infile))
+        c_file = fopen(_ChPtr(infile)._c_str, "rb")
+        err_msg = btorapi.boolector_snapshot_read(self._c_btor, c_file)
+        fclose(c_file)
+        if err_msg != NULL:
+            raise BoolectorException(
+                    "Reading snapshot '{}' failed: {}".format(
+                        infile, _to_str(err_msg)))
+
     # Boolector nodes
 
     def Const(self, c, uint32_t width = 1):
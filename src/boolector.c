@@ -20,9 +20,11 @@
 #include "btorparse.h"
 #include "btorprintmodel.h"
 #include "btorsat.h"
+#include "btorsnapshot.h"
 #include "btorsort.h"
 #include "btortrapi.h"
 #include "dumper/btordumpaig.h"
+#include "dumper/btordumpbin.h"
 #include "dumper/btordumpbtor.h"
 #include "dumper/btordumpsmt.h"
 #include "preprocess/btorpreprocess.h"
@@ -421,11 +423,19 @@ boolector_push (Btor *btor, uint32_t level)
   if (level == 0) return;
 
   uint32_t i;
+  BtorSortId sort;
+  BtorNode *lit;
+
+  sort = btor_sort_bool (btor);
   for (i = 0; i < level; i++)
   {
-    BTOR_PUSH_STACK (btor->assertions_trail,
-                     BTOR_COUNT_STACK (btor->assertions));
+    lit = btor_exp_var (btor, sort, 0);
+    /* marks the assertions guarded by 'lit' (and the negation of 'lit'
+     * asserted on pop), which are not dumped */
+    lit->activation_below = 1;
+    BTOR_PUSH_STACK (btor->activation_lits, lit);
   }
+  btor_sort_release (btor, sort);
   btor->num_push_pop++;
 }
 
@@ -436,23 +446,22 @@ boolector_pop (Btor *btor, uint32_t level)
   BTOR_TRAPI ("%u", level);
   BTOR_ABORT (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL),
               "incremental usage has not been enabled");
-  BTOR_ABORT (level > BTOR_COUNT_STACK (btor->assertions_trail),
+  BTOR_ABORT (level > BTOR_COUNT_STACK (btor->activation_lits),
               "can not pop more levels (%u) than created via push (%u).",
               level,
-              BTOR_COUNT_STACK (btor->assertions_trail));
+              BTOR_COUNT_STACK (btor->activation_lits));
 
   if (level == 0) return;
 
-  uint32_t i, pos;
+  uint32_t i;
   BtorNode *cur;
 
-  for (i = 0, pos = 0; i < level; i++)
-    pos = BTOR_POP_STACK (btor->assertions_trail);
-
-  while (BTOR_COUNT_STACK (btor->assertions) > pos)
+  /* permanently disable the assertions of the popped contexts, which are
+   * then simplified away (together with their AIGs and clauses) */
+  for (i = 0; i < level; i++)
   {
-    cur = BTOR_POP_STACK (btor->assertions);
-    btor_hashint_table_remove (btor->assertions_cache, btor_node_get_id (cur));
+    cur = BTOR_POP_STACK (btor->activation_lits);
+    btor_assert_exp (btor, btor_node_invert (cur));
     btor_node_release (btor, cur);
   }
   btor->num_push_pop++;
@@ -479,16 +488,14 @@ boolector_assert (Btor *btor, BoolectorNode *node)
   BTOR_ABORT (btor_node_real_addr (exp)->parameterized,
               "assertion must not be parameterized");
 
-  /* all assertions at a context level > 0 are internally handled as
-   * assumptions. */
-  if (BTOR_COUNT_STACK (btor->assertions_trail) > 0)
+  /* all assertions at a context level > 0 are guarded by the activation
+   * literal of the current context. */
+  if (BTOR_COUNT_STACK (btor->activation_lits) > 0)
   {
-    int32_t id = btor_node_get_id (exp);
-    if (!btor_hashint_table_contains (btor->assertions_cache, id))
-    {
-      BTOR_PUSH_STACK (btor->assertions, btor_node_copy (btor, exp));
-      btor_hashint_table_add (btor->assertions_cache, id);
-    }
+    BtorNode *imp;
+    imp = btor_exp_implies (btor, BTOR_TOP_STACK (btor->activation_lits), exp);
+    btor_assert_exp (btor, imp);
+    btor_node_release (btor, imp);
   }
   else
     btor_assert_exp (btor, exp);
@@ -4919,6 +4926,55 @@ boolector_dump_aiger_binary (Btor *btor, FILE *file, bool merge_roots)
 #endif
 }
 
+void
+boolector_dump_btor_binary (Btor *btor, FILE *file)
+{
+  BTOR_TRAPI ("");
+  BTOR_ABORT_ARG_NULL (btor);
+  BTOR_ABORT_ARG_NULL (file);
+  BTOR_WARN (btor->assumptions->count > 0,
+             "dumping in incremental mode only captures the current state "
+             "of the input formula without assumptions");
+  btor_dumpbin_dump (btor, file);
+#ifndef NDEBUG
+  BTOR_CHKCLONE_NORES (dump_btor_binary, stdout);
+#endif
+}
+
+bool
+boolector_snapshot_write (Btor *btor, FILE *file)
+{
+  bool res;
+
+  BTOR_TRAPI ("");
+  BTOR_ABORT_ARG_NULL (btor);
+  BTOR_ABORT_ARG_NULL (file);
+  BTOR_WARN (btor->assumptions->count > 0,
+             "snapshots only capture the current state of the input formula "
+             "without assumptions");
+  res = btor_snapshot_write (btor, file);
+  BTOR_TRAPI_RETURN_BOOL (res);
+  return res;
+}
+
+const char *
+boolector_snapshot_read (Btor *btor, FILE *file)
+{
+  const char *res;
+
+  BTOR_TRAPI ("");
+  BTOR_ABORT_ARG_NULL (btor);
+  BTOR_ABORT_ARG_NULL (file);
+  res = btor_snapshot_read (btor, file);
+#ifndef NDEBUG
+  /* the formula is restored without API calls, hence the shadow clone is
+   * created anew */
+  if (btor->clone && !res) boolector_chkclone (btor);
+#endif
+  BTOR_TRAPI_RETURN_STR (res);
+  return res;
+}
+
 /*------------------------------------------------------------------------*/
 
 const char *
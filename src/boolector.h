@@ -77,10 +77,10 @@ Btor *boolector_new (void);
   :return: The exact (but disjunct) copy of the Boolector instance ``btor``.
 
   .. note::
-    If Lingeling is used as SAT solver, Boolector can be cloned at any time,
-    since Lingeling also supports cloning. However, with all other SAT solver
-    that do not support cloning, Boolector can only be cloned prior to the
-    first boolector_sat call.
+    If Lingeling or CaDiCaL is used as SAT solver, Boolector can be cloned at
+    any time, since both also support cloning. However, with all other SAT
+    solvers that do not support cloning, Boolector can only be cloned prior to
+    the first boolector_sat call.
 */
 Btor *boolector_clone (Btor *btor);
 
@@ -2500,6 +2500,43 @@ void boolector_dump_aiger_ascii (Btor *btor, FILE *file, bool merge_roots);
 */
 void boolector_dump_aiger_binary (Btor *btor, FILE *file, bool merge_roots);
 
+/*!
+  Dumps formula to file in a compact binary format, which can be read back
+  via boolector_parse.
+
+  :param btor: Boolector instance
+  :param file: Output file.
+*/
+void boolector_dump_btor_binary (Btor *btor, FILE *file);
+
+/*!
+  Write a binary snapshot of the current formula to file, which can be
+  restored via boolector_snapshot_read without parsing and simplifying the
+  formula again.
+
+  A snapshot contains the sorts, the simplified constraints and the symbols of
+  the formula.  Assumptions, bit-blasted AIGs and the state of the SAT solver
+  are not part of a snapshot, they are rebuilt by the next
+  boolector_sat call.  Snapshots are not portable across machines with
+  different byte order.
+
+  :param btor: Boolector instance.
+  :param file: Output file.
+  :return: True if the snapshot was written successfully.
+*/
+bool boolector_snapshot_write (Btor *btor, FILE *file);
+
+/*!
+  Restore the formula of a snapshot written via boolector_snapshot_write
+  and add its constraints to the current formula.
+
+  :param btor: Boolector instance.
+  :param file: Input file.
+  :return: 0 on success, and an error message otherwise (in which case the
+           formula of ``btor`` is left unchanged).
+*/
+const char *boolector_snapshot_read (Btor *btor, FILE *file);
+
 /*------------------------------------------------------------------------*/
 
 /*!
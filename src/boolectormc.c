@@ -229,6 +229,21 @@ boolector_mc_kind (BtorMC *mc, int32_t mink, int32_t maxk)
   return btor_mc_kind (mc, mink, maxk);
 }
 
+int32_t
+boolector_mc_pdr (BtorMC *mc, int32_t maxk)
+{
+  BtorPtrHashTableIterator it;
+  bool arrays = false;
+
+  BTOR_ABORT_ARG_NULL (mc);
+  btor_iter_hashptr_init (&it, mc->inputs);
+  btor_iter_hashptr_queue (&it, mc->states);
+  while (btor_iter_hashptr_has_next (&it))
+    arrays |= boolector_is_array (mc->btor, btor_iter_hashptr_next (&it));
+  BTOR_ABORT (arrays, "IC3/PDR does not support array states or inputs");
+  return btor_mc_pdr (mc, maxk);
+}
+
 /*------------------------------------------------------------------------*/
 
 char *
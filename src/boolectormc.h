@@ -85,6 +85,12 @@ int32_t boolector_mc_bmc (BtorMC *, int32_t mink, int32_t maxk);
 
 int32_t boolector_mc_kind (BtorMC *, int32_t mink, int32_t maxk);
 
+/* Check bad state properties with IC3/PDR using at most 'maxk' frames.
+ * Returns the length of the counterexample if a property is reachable, and
+ * -1 otherwise. Unreachable properties are reported as for k-induction.
+ * Requires that all states and inputs are bit-vectors. */
+int32_t boolector_mc_pdr (BtorMC *, int32_t maxk);
+
 /*------------------------------------------------------------------------*/
 
 /* Assumes that 'boolector_mc_set_opt (mc, BTOR_MC_OPT_TRACE_GEN, 1)'
@@ -12,6 +12,7 @@
 #include "btorcore.h"
 #include "btorsat.h"
 #include "utils/btoraigmap.h"
+#include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 #include "utils/btorutil.h"
 
@@ -59,6 +60,28 @@
 
 // #define BTOR_AIG_TO_CNF_NARY_AND
 
+#define BTOR_AIG_TO_CNF_PLAISTED_GREENBAUM
+
+/*------------------------------------------------------------------------*/
+
+/* Polarities of an AIG in the CNF.  The implication from its CNF literal to
+ * its definition is added for the positive, the converse one for the
+ * negative polarity. */
+#define BTOR_AIG_POS 1
+#define BTOR_AIG_NEG 2
+#define BTOR_AIG_BOTH 3
+
+/* Flags of the polarities on the stack of 'aig_to_sat_polarity'. */
+#define BTOR_AIG_COUNT 4 /* reached via an edge not counted in 'local' yet */
+#define BTOR_AIG_POST 8  /* children are encoded, add the implications */
+
+/* Polarity of the top-level constraints. */
+#ifdef BTOR_AIG_TO_CNF_PLAISTED_GREENBAUM
+#define BTOR_AIG_TOP_POL BTOR_AIG_POS
+#else
+#define BTOR_AIG_TOP_POL BTOR_AIG_BOTH
+#endif
+
 /*------------------------------------------------------------------------*/
 
 static void
@@ -109,6 +132,7 @@ release_cnf_id_aig_mgr (BtorAIGMgr *amgr, BtorAIG *aig)
   amgr->cnfid2aig.start[aig->cnf_id] = 0;
   btor_sat_mgr_release_cnf_id (amgr->smgr, aig->cnf_id);
   aig->cnf_id = 0;
+  aig->pol    = 0;
 }
 
 static void
@@ -796,6 +820,7 @@ btor_aig_mgr_new (Btor *btor)
   assert ((size_t) BTOR_AIG_FALSE == 0);
   assert ((size_t) BTOR_AIG_TRUE == 1);
   BTOR_INIT_STACK (btor->mm, amgr->cnfid2aig);
+  amgr->num_shared_ids = INT32_MAX;
   return amgr;
 }
 
@@ -893,6 +918,13 @@ btor_aig_mgr_clone (Btor *btor, BtorAIGMgr *amgr)
   res->num_cnf_vars     = amgr->num_cnf_vars;
   res->num_cnf_clauses  = amgr->num_cnf_clauses;
   res->num_cnf_literals = amgr->num_cnf_literals;
+  res->num_gcs          = amgr->num_gcs;
+  res->num_gc_ids       = amgr->num_gc_ids;
+  res->num_gc_bytes     = amgr->num_gc_bytes;
+  /* both managers create new AIGs independently from now on */
+  if ((size_t) amgr->num_shared_ids > BTOR_COUNT_STACK (amgr->id2aig))
+    amgr->num_shared_ids = (int32_t) BTOR_COUNT_STACK (amgr->id2aig);
+  res->num_shared_ids = amgr->num_shared_ids;
   clone_aigs (amgr, res);
   return res;
 }
@@ -907,11 +939,102 @@ btor_aig_mgr_delete (BtorAIGMgr *amgr)
   mm = amgr->btor->mm;
   BTOR_RELEASE_AIG_UNIQUE_TABLE (mm, amgr->table);
   btor_sat_mgr_delete (amgr->smgr);
+  if (amgr->eval_cache) btor_hashint_map_delete (amgr->eval_cache);
   BTOR_RELEASE_STACK (amgr->id2aig);
   BTOR_RELEASE_STACK (amgr->cnfid2aig);
   BTOR_DELETE (mm, amgr);
 }
 
+size_t
+btor_aig_mgr_num_dead_ids (const BtorAIGMgr *amgr)
+{
+  assert (amgr);
+  assert (BTOR_COUNT_STACK (amgr->id2aig)
+          >= 2 + amgr->cur_num_aigs + amgr->cur_num_aig_vars);
+  return BTOR_COUNT_STACK (amgr->id2aig) - 2 - amgr->cur_num_aigs
+         - amgr->cur_num_aig_vars;
+}
+
+static int32_t
+gc_map_id (const int32_t *map, int32_t id)
+{
+  return id < 0 ? -map[-id] : map[id];
+}
+
+void
+btor_aig_mgr_gc (BtorAIGMgr *amgr)
+{
+  assert (amgr);
+
+  BtorMemMgr *mm;
+  BtorAIG *aig;
+  int32_t *map, id;
+  size_t i, count, size;
+  uint32_t hash;
+
+  if (!btor_aig_mgr_num_dead_ids (amgr)) return;
+
+  mm    = amgr->btor->mm;
+  count = BTOR_COUNT_STACK (amgr->id2aig);
+  size  = BTOR_SIZE_STACK (amgr->id2aig);
+
+  /* Renumber in increasing order of the old ids, which preserves the order
+   * of children (and thus, the normalization of BTOR_OPT_SORT_AIG).  Since
+   * children have smaller ids than their parents, they are already renumbered
+   * when their parents are visited.  Ids 0 and 1 are reserved for the
+   * constants. */
+  BTOR_CNEWN (mm, map, count);
+  for (i = 2, id = 2; i < count; i++)
+  {
+    aig = BTOR_PEEK_STACK (amgr->id2aig, i);
+    if (!aig)
+    {
+      /* ids above the first deleted AIG are renumbered */
+      if (amgr->num_shared_ids > (int32_t) i)
+        amgr->num_shared_ids = (int32_t) i;
+      continue;
+    }
+    assert (!aig->mark);
+    map[i]  = id;
+    aig->id = id;
+    if (!aig->is_var)
+    {
+      aig->children[0] = gc_map_id (map, aig->children[0]);
+      aig->children[1] = gc_map_id (map, aig->children[1]);
+      assert (aig->children[0] && aig->children[1]);
+    }
+    BTOR_POKE_STACK (amgr->id2aig, id, aig);
+    id++;
+  }
+  amgr->id2aig.top = amgr->id2aig.start + id;
+
+  /* rebuild unique table since hash values depend on the children ids */
+  BTOR_CLRN (amgr->table.chains, amgr->table.size);
+  for (i = 2; i < (size_t) id; i++)
+  {
+    aig = BTOR_PEEK_STACK (amgr->id2aig, i);
+    if (aig->is_var) continue;
+    hash                     = compute_aig_hash (aig, amgr->table.size);
+    aig->next                = amgr->table.chains[hash];
+    amgr->table.chains[hash] = aig->id;
+  }
+
+  /* CNF ids of deleted AIGs are still mapped if they were not released */
+  for (i = 0; i < BTOR_SIZE_STACK (amgr->cnfid2aig); i++)
+    if (amgr->cnfid2aig.start[i])
+      amgr->cnfid2aig.start[i] = map[amgr->cnfid2aig.start[i]];
+
+  BTOR_DELETEN (mm, map, count);
+
+  BTOR_REALLOC (mm, amgr->id2aig.start, size, (size_t) id);
+  amgr->id2aig.top = amgr->id2aig.start + id;
+  amgr->id2aig.end = amgr->id2aig.top;
+
+  amgr->num_gcs++;
+  amgr->num_gc_ids += count - id;
+  amgr->num_gc_bytes += (size - id) * sizeof (BtorAIG *);
+}
+
 static bool
 is_xor_aig (BtorAIGMgr *amgr, BtorAIG *aig, BtorAIGPtrStack *leafs)
 {
@@ -1046,6 +1169,13 @@ set_next_id_aig_mgr (BtorAIGMgr *amgr, BtorAIG *root)
   amgr->num_cnf_vars++;
 }
 
+static uint32_t
+flip_aig_pol (uint32_t pol)
+{
+  return (pol & ~BTOR_AIG_BOTH) | ((pol & BTOR_AIG_POS) << 1)
+         | ((pol & BTOR_AIG_NEG) >> 1);
+}
+
 #ifdef BTOR_EXTRACT_TOP_LEVEL_MULTI_OR
 static bool
 is_or_aig (BtorAIGMgr *amgr, BtorAIG *root, BtorAIGPtrStack *leafs)
@@ -1107,55 +1237,84 @@ is_or_aig (BtorAIGMgr *amgr, BtorAIG *root, BtorAIGPtrStack *leafs)
 }
 #endif
 
-void
-btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
+/* Plaisted-Greenbaum transformation of 'start' in polarities 'pol'.  Only
+ * the implications of a Tseitin definition needed for the polarities in
+ * which an AIG occurs are added.  If an AIG encoded in one polarity is
+ * reached in the other one later on, it is upgraded together with its
+ * children.  For BTOR_AIG_BOTH this is the Tseitin transformation.
+ */
+static void
+aig_to_sat_polarity (BtorAIGMgr *amgr, BtorAIG *start, uint32_t pol)
 {
   BtorAIGPtrStack stack, tree, leafs, marked;
+  BtorIntStack pols, clauses;
+  uint32_t local, count, missing, lpol;
   int32_t x, y, a, b, c;
   bool isxor, isite;
   BtorAIG *root, *cur;
   BtorSATMgr *smgr;
   BtorMemMgr *mm;
-  uint32_t local;
   BtorAIG **p;
 
   if (btor_aig_is_const (start)) return;
 
   assert (amgr);
+  assert (pol && pol <= BTOR_AIG_BOTH);
 
   smgr = amgr->smgr;
   mm   = amgr->btor->mm;
 
   BTOR_INIT_STACK (mm, stack);
+  BTOR_INIT_STACK (mm, pols);
   BTOR_INIT_STACK (mm, tree);
   BTOR_INIT_STACK (mm, leafs);
   BTOR_INIT_STACK (mm, marked);
+  BTOR_INIT_STACK (mm, clauses);
 
-  start = BTOR_REAL_ADDR_AIG (start);
+  if (BTOR_IS_INVERTED_AIG (start))
+  {
+    start = BTOR_INVERT_AIG (start);
+    pol   = flip_aig_pol (pol);
+  }
   BTOR_PUSH_STACK (stack, start);
+  BTOR_PUSH_STACK (pols, pol | BTOR_AIG_COUNT);
 
   while (!BTOR_EMPTY_STACK (stack))
   {
-    root = BTOR_REAL_ADDR_AIG (BTOR_POP_STACK (stack));
+    root = BTOR_POP_STACK (stack);
+    pol  = BTOR_POP_STACK (pols);
 
-    if (root->mark == 2)
+    if (BTOR_IS_INVERTED_AIG (root))
     {
-      assert (root->cnf_id);
-      assert (root->local < root->refs);
-      root->local++;
-      continue;
+      root = BTOR_INVERT_AIG (root);
+      pol  = flip_aig_pol (pol);
     }
 
-    if (root->cnf_id) continue;
-
     if (btor_aig_is_var (root))
     {
-      set_next_id_aig_mgr (amgr, root);
+      if (!root->cnf_id) set_next_id_aig_mgr (amgr, root);
       continue;
     }
 
-    assert (root->mark < 2);
     assert (btor_aig_is_and (root));
+
+    if (pol & BTOR_AIG_POST)
+    {
+      missing = pol & BTOR_AIG_BOTH;
+      assert (root->mark);
+      assert (!(root->pol & missing));
+    }
+    else
+    {
+      if ((pol & BTOR_AIG_COUNT) && root->mark)
+      {
+        assert (root->local < root->refs);
+        root->local++;
+      }
+      missing = pol & ~root->pol & BTOR_AIG_BOTH;
+      if (!missing) continue;
+    }
+
     assert (BTOR_EMPTY_STACK (tree));
     assert (BTOR_EMPTY_STACK (leafs));
 
@@ -1191,22 +1350,35 @@ btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
 #endif
     }
 
-    if (root->mark == 0)
+    if (!(pol & BTOR_AIG_POST))
     {
-      root->mark = 1;
-      assert (root->refs >= 1);
-      assert (!root->local);
-      root->local = 1;
-      BTOR_PUSH_STACK (marked, root);
+      /* edges to the children are counted on the first visit only */
+      count = 0;
+      if (!root->mark)
+      {
+        root->mark = 1;
+        assert (root->refs >= 1);
+        assert (!root->local);
+        root->local = (pol & BTOR_AIG_COUNT) ? 1 : 0;
+        BTOR_PUSH_STACK (marked, root);
+        count = BTOR_AIG_COUNT;
+      }
       BTOR_PUSH_STACK (stack, root);
-      for (p = leafs.start; p < leafs.top; p++) BTOR_PUSH_STACK (stack, *p);
+      BTOR_PUSH_STACK (pols, missing | BTOR_AIG_POST);
+      for (p = leafs.start; p < leafs.top; p++)
+      {
+        /* XOR inputs and ITE conditions occur in both polarities */
+        if (isxor || (isite && p == leafs.start + 2))
+          lpol = BTOR_AIG_BOTH;
+        else
+          lpol = missing;
+        BTOR_PUSH_STACK (stack, *p);
+        BTOR_PUSH_STACK (pols, lpol | count);
+      }
     }
     else
     {
-      assert (root->mark == 1);
-      root->mark = 2;
-
-      set_next_id_aig_mgr (amgr, root);
+      if (!root->cnf_id) set_next_id_aig_mgr (amgr, root);
       x = root->cnf_id;
       assert (x);
 
@@ -1216,27 +1388,35 @@ btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
         a = btor_aig_get_cnf_id (leafs.start[0]);
         b = btor_aig_get_cnf_id (leafs.start[1]);
 
-        btor_sat_add (smgr, -x);
-        btor_sat_add (smgr, a);
-        btor_sat_add (smgr, -b);
-        btor_sat_add (smgr, 0);
-
-        btor_sat_add (smgr, -x);
-        btor_sat_add (smgr, -a);
-        btor_sat_add (smgr, b);
-        btor_sat_add (smgr, 0);
-
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, -a);
-        btor_sat_add (smgr, -b);
-        btor_sat_add (smgr, 0);
-
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, a);
-        btor_sat_add (smgr, b);
-        btor_sat_add (smgr, 0);
-        amgr->num_cnf_clauses += 4;
-        amgr->num_cnf_literals += 12;
+        if (missing & BTOR_AIG_POS)
+        {
+          BTOR_PUSH_STACK (clauses, -x);
+          BTOR_PUSH_STACK (clauses, a);
+          BTOR_PUSH_STACK (clauses, -b);
+          BTOR_PUSH_STACK (clauses, 0);
+
+          BTOR_PUSH_STACK (clauses, -x);
+          BTOR_PUSH_STACK (clauses, -a);
+          BTOR_PUSH_STACK (clauses, b);
+          BTOR_PUSH_STACK (clauses, 0);
+          amgr->num_cnf_clauses += 2;
+          amgr->num_cnf_literals += 6;
+        }
+
+        if (missing & BTOR_AIG_NEG)
+        {
+          BTOR_PUSH_STACK (clauses, x);
+          BTOR_PUSH_STACK (clauses, -a);
+          BTOR_PUSH_STACK (clauses, -b);
+          BTOR_PUSH_STACK (clauses, 0);
+
+          BTOR_PUSH_STACK (clauses, x);
+          BTOR_PUSH_STACK (clauses, a);
+          BTOR_PUSH_STACK (clauses, b);
+          BTOR_PUSH_STACK (clauses, 0);
+          amgr->num_cnf_clauses += 2;
+          amgr->num_cnf_literals += 6;
+        }
       }
       else if (isite)
       {
@@ -1245,71 +1425,92 @@ btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
         b = btor_aig_get_cnf_id (leafs.start[1]);  // then
         c = btor_aig_get_cnf_id (leafs.start[2]);  // cond
 
-        btor_sat_add (smgr, -x);
-        btor_sat_add (smgr, -c);
-        btor_sat_add (smgr, b);
-        btor_sat_add (smgr, 0);
-
-        btor_sat_add (smgr, -x);
-        btor_sat_add (smgr, c);
-        btor_sat_add (smgr, a);
-        btor_sat_add (smgr, 0);
-
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, -c);
-        btor_sat_add (smgr, -b);
-        btor_sat_add (smgr, 0);
-
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, c);
-        btor_sat_add (smgr, -a);
-        btor_sat_add (smgr, 0);
-        amgr->num_cnf_clauses += 4;
-        amgr->num_cnf_literals += 12;
+        if (missing & BTOR_AIG_POS)
+        {
+          BTOR_PUSH_STACK (clauses, -x);
+          BTOR_PUSH_STACK (clauses, -c);
+          BTOR_PUSH_STACK (clauses, b);
+          BTOR_PUSH_STACK (clauses, 0);
+
+          BTOR_PUSH_STACK (clauses, -x);
+          BTOR_PUSH_STACK (clauses, c);
+          BTOR_PUSH_STACK (clauses, a);
+          BTOR_PUSH_STACK (clauses, 0);
+          amgr->num_cnf_clauses += 2;
+          amgr->num_cnf_literals += 6;
+        }
+
+        if (missing & BTOR_AIG_NEG)
+        {
+          BTOR_PUSH_STACK (clauses, x);
+          BTOR_PUSH_STACK (clauses, -c);
+          BTOR_PUSH_STACK (clauses, -b);
+          BTOR_PUSH_STACK (clauses, 0);
+
+          BTOR_PUSH_STACK (clauses, x);
+          BTOR_PUSH_STACK (clauses, c);
+          BTOR_PUSH_STACK (clauses, -a);
+          BTOR_PUSH_STACK (clauses, 0);
+          amgr->num_cnf_clauses += 2;
+          amgr->num_cnf_literals += 6;
+        }
       }
       else
       {
-        for (p = leafs.start; p < leafs.top; p++)
+        if (missing & BTOR_AIG_NEG)
         {
-          cur = *p;
-          y   = btor_aig_get_cnf_id (cur);
-          assert (y);
-          btor_sat_add (smgr, -y);
+          for (p = leafs.start; p < leafs.top; p++)
+          {
+            cur = *p;
+            y   = btor_aig_get_cnf_id (cur);
+            assert (y);
+            BTOR_PUSH_STACK (clauses, -y);
+            amgr->num_cnf_literals++;
+          }
+          BTOR_PUSH_STACK (clauses, x);
+          BTOR_PUSH_STACK (clauses, 0);
+          amgr->num_cnf_clauses++;
           amgr->num_cnf_literals++;
         }
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, 0);
-        amgr->num_cnf_clauses++;
-        amgr->num_cnf_literals++;
 
-        for (p = leafs.start; p < leafs.top; p++)
+        if (missing & BTOR_AIG_POS)
         {
-          cur = *p;
-          y   = btor_aig_get_cnf_id (cur);
-          btor_sat_add (smgr, -x);
-          btor_sat_add (smgr, y);
-          btor_sat_add (smgr, 0);
-          amgr->num_cnf_clauses++;
-          amgr->num_cnf_literals += 2;
+          for (p = leafs.start; p < leafs.top; p++)
+          {
+            cur = *p;
+            y   = btor_aig_get_cnf_id (cur);
+            assert (y);
+            BTOR_PUSH_STACK (clauses, -x);
+            BTOR_PUSH_STACK (clauses, y);
+            BTOR_PUSH_STACK (clauses, 0);
+            amgr->num_cnf_clauses++;
+            amgr->num_cnf_literals += 2;
+          }
         }
       }
+      root->pol |= missing;
     }
     BTOR_RESET_STACK (leafs);
   }
   BTOR_RELEASE_STACK (stack);
+  BTOR_RELEASE_STACK (pols);
   BTOR_RELEASE_STACK (leafs);
   BTOR_RELEASE_STACK (tree);
 
+  /* add all clauses at once, before CNF indices of inner nodes are released
+   * below */
+  btor_sat_add_clauses (smgr, clauses.start, BTOR_COUNT_STACK (clauses));
+  BTOR_RELEASE_STACK (clauses);
+
   while (!BTOR_EMPTY_STACK (marked))
   {
     cur = BTOR_POP_STACK (marked);
     assert (!BTOR_IS_INVERTED_AIG (cur));
-    assert (cur->mark > 0);
+    assert (cur->mark);
     cur->mark = 0;
     assert (cur->cnf_id);
     assert (btor_aig_is_and (cur));
-    local = cur->local;
-    assert (local > 0);
+    local      = cur->local;
     cur->local = 0;
     if (cur == start) continue;
     assert (cur->refs >= local);
@@ -1319,6 +1520,14 @@ btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
   BTOR_RELEASE_STACK (marked);
 }
 
+void
+btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
+{
+  BTOR_PERF_BEGIN (amgr->btor, BTOR_PERF_CNF);
+  aig_to_sat_polarity (amgr, start, BTOR_AIG_BOTH);
+  BTOR_PERF_END (amgr->btor, BTOR_PERF_CNF);
+}
+
 static void
 aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *aig)
 {
@@ -1338,6 +1547,22 @@ btor_aig_to_sat (BtorAIGMgr *amgr, BtorAIG *aig)
   if (!btor_aig_is_const (aig)) aig_to_sat_tseitin (amgr, aig);
 }
 
+/* Encodes 'aig' occurring positively in a top-level clause. */
+static void
+aig_to_sat_toplevel (BtorAIGMgr *amgr, BtorAIG *aig)
+{
+  assert (amgr);
+  if (btor_aig_is_const (aig)) return;
+  BTOR_MSG (amgr->btor->msg,
+            3,
+            "transforming top-level AIG into CNF using %s transformation",
+            BTOR_AIG_TOP_POL == BTOR_AIG_BOTH ? "Tseitin"
+                                              : "Plaisted-Greenbaum");
+  BTOR_PERF_BEGIN (amgr->btor, BTOR_PERF_CNF);
+  aig_to_sat_polarity (amgr, aig, BTOR_AIG_TOP_POL);
+  BTOR_PERF_END (amgr->btor, BTOR_PERF_CNF);
+}
+
 void
 btor_aig_add_toplevel_to_sat (BtorAIGMgr *amgr, BtorAIG *root)
 {
@@ -1351,6 +1576,7 @@ btor_aig_add_toplevel_to_sat (BtorAIGMgr *amgr, BtorAIG *root)
   BtorSATMgr *smgr;
   BtorAIG *aig, *left;
   BtorAIGPtrStack stack;
+  BtorIntStack clauses;
 #ifdef BTOR_EXTRACT_TOP_LEVEL_MULTI_OR
   BtorAIGPtrStack leafs;
   BtorAIG **p;
@@ -1373,6 +1599,7 @@ btor_aig_add_toplevel_to_sat (BtorAIGMgr *amgr, BtorAIG *root)
   }
 
   BTOR_INIT_STACK (mm, stack);
+  BTOR_INIT_STACK (mm, clauses);
   aig = root;
   goto BTOR_ADD_TOPLEVEL_AIG_TO_SAT_WITHOUT_POP;
 
@@ -1397,23 +1624,24 @@ btor_aig_add_toplevel_to_sat (BtorAIGMgr *amgr, BtorAIG *root)
           left = *p;
           if (btor_aig_is_const (left))  // TODO reachable?
             continue;
-          btor_aig_to_sat (amgr, left);
+          aig_to_sat_toplevel (amgr, BTOR_INVERT_AIG (left));
         }
         for (p = leafs.start; p < leafs.top; p++)
         {
           left = *p;
           assert (btor_aig_get_cnf_id (left));
-          btor_sat_add (smgr, btor_aig_get_cnf_id (BTOR_INVERT_AIG (left)));
+          BTOR_PUSH_STACK (clauses,
+                           btor_aig_get_cnf_id (BTOR_INVERT_AIG (left)));
           amgr->num_cnf_literals++;
         }
-        btor_sat_add (smgr, 0);
+        BTOR_PUSH_STACK (clauses, 0);
         amgr->num_cnf_clauses++;
       }
       else
       {
-        btor_aig_to_sat (amgr, aig);
-        btor_sat_add (smgr, btor_aig_get_cnf_id (aig));
-        btor_sat_add (smgr, 0);
+        aig_to_sat_toplevel (amgr, aig);
+        BTOR_PUSH_STACK (clauses, btor_aig_get_cnf_id (aig));
+        BTOR_PUSH_STACK (clauses, 0);
         amgr->num_cnf_literals++;
         amgr->num_cnf_clauses++;
       }
@@ -1424,19 +1652,19 @@ btor_aig_add_toplevel_to_sat (BtorAIGMgr *amgr, BtorAIG *root)
       {
         left  = BTOR_INVERT_AIG (btor_aig_get_left_child (amgr, real_aig));
         right = BTOR_INVERT_AIG (btor_aig_get_right_child (amgr, real_aig));
-        btor_aig_to_sat (amgr, left);
-        btor_aig_to_sat (amgr, right);
-        btor_sat_add (smgr, btor_aig_get_cnf_id (left));
-        btor_sat_add (smgr, btor_aig_get_cnf_id (right));
-        btor_sat_add (smgr, 0);
+        aig_to_sat_toplevel (amgr, left);
+        aig_to_sat_toplevel (amgr, right);
+        BTOR_PUSH_STACK (clauses, btor_aig_get_cnf_id (left));
+        BTOR_PUSH_STACK (clauses, btor_aig_get_cnf_id (right));
+        BTOR_PUSH_STACK (clauses, 0);
         amgr->num_cnf_clauses++;
         amgr->num_cnf_literals += 2;
       }
       else
       {
-        btor_aig_to_sat (amgr, aig);
-        btor_sat_add (smgr, btor_aig_get_cnf_id (aig));
-        btor_sat_add (smgr, 0);
+        aig_to_sat_toplevel (amgr, aig);
+        BTOR_PUSH_STACK (clauses, btor_aig_get_cnf_id (aig));
+        BTOR_PUSH_STACK (clauses, 0);
         amgr->num_cnf_clauses++;
         amgr->num_cnf_literals++;
       }
@@ -1444,7 +1672,11 @@ btor_aig_add_toplevel_to_sat (BtorAIGMgr *amgr, BtorAIG *root)
     }
   }
   BTOR_RELEASE_STACK (stack);
+  btor_sat_add_clauses (smgr, clauses.start, BTOR_COUNT_STACK (clauses));
+  BTOR_RELEASE_STACK (clauses);
 #else
+  int32_t clause[2];
+
   if (root == BTOR_AIG_TRUE) return;
 
   if (root == BTOR_AIG_FALSE)
@@ -1452,9 +1684,10 @@ btor_aig_add_toplevel_to_sat (BtorAIGMgr *amgr, BtorAIG *root)
     btor_sat_add (amgr->smgr, 0);
     return;
   }
-  btor_aig_to_sat (amgr, root);
-  btor_sat_add (amgr->smgr, btor_aig_get_cnf_id (root));
-  btor_sat_add (amgr->smgr, 0);
+  aig_to_sat_toplevel (amgr, root);
+  clause[0] = btor_aig_get_cnf_id (root);
+  clause[1] = 0;
+  btor_sat_add_clauses (amgr->smgr, clause, 2);
 #endif
 }
 
@@ -1464,6 +1697,93 @@ btor_aig_get_sat_mgr (const BtorAIGMgr *amgr)
   return amgr ? amgr->smgr : 0;
 }
 
+static int32_t
+deref_aig (BtorAIGMgr *amgr, BtorAIG *aig)
+{
+  int32_t val;
+  assert (!BTOR_IS_INVERTED_AIG (aig));
+  if (!aig->cnf_id) return -1;
+  val = btor_sat_deref (amgr->smgr, aig->cnf_id);
+  return val ? val : -1;
+}
+
+/* The CNF literal of an AND encoded in one polarity only is not necessarily
+ * equal to its value, and ANDs are not encoded at all before they are used
+ * in a constraint.  Their value is hence computed from their children.  The
+ * literals of variables and of ANDs encoded in both polarities are exact.
+ *
+ * Computed values are cached in 'eval_cache' across queries (assignments of
+ * bit-vectors are queried bit by bit, and the cones of the bits overlap).
+ * The cache is reset when the SAT solver was called, the CNF was extended
+ * or AIG ids were compacted since the values were computed. */
+static BtorIntHashTable *
+get_eval_cache (BtorAIGMgr *amgr)
+{
+  if (amgr->eval_cache && amgr->eval_satcalls == amgr->smgr->satcalls
+      && amgr->eval_clauses == amgr->num_cnf_clauses
+      && amgr->eval_gcs == amgr->num_gcs)
+    return amgr->eval_cache;
+
+  if (amgr->eval_cache) btor_hashint_map_delete (amgr->eval_cache);
+  amgr->eval_cache    = btor_hashint_map_new (amgr->btor->mm);
+  amgr->eval_satcalls = amgr->smgr->satcalls;
+  amgr->eval_clauses  = amgr->num_cnf_clauses;
+  amgr->eval_gcs      = amgr->num_gcs;
+  return amgr->eval_cache;
+}
+
+static int32_t
+eval_aig (BtorAIGMgr *amgr, BtorAIG *root)
+{
+  BtorIntHashTable *cache;
+  BtorHashTableData *d;
+  BtorAIGPtrStack stack;
+  BtorAIG *cur, *l, *r;
+  int32_t lval, rval;
+
+  assert (!BTOR_IS_INVERTED_AIG (root));
+  assert (btor_aig_is_and (root));
+
+  cache = get_eval_cache (amgr);
+  if ((d = btor_hashint_map_get (cache, root->id))) return d->as_int;
+
+  BTOR_INIT_STACK (amgr->btor->mm, stack);
+  BTOR_PUSH_STACK (stack, root);
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_TOP_STACK (stack);
+    if (btor_hashint_map_contains (cache, cur->id))
+    {
+      (void) BTOR_POP_STACK (stack);
+      continue;
+    }
+    if (cur->is_var || cur->pol == BTOR_AIG_BOTH)
+    {
+      (void) BTOR_POP_STACK (stack);
+      btor_hashint_map_add (cache, cur->id)->as_int = deref_aig (amgr, cur);
+      continue;
+    }
+    l = btor_aig_get_left_child (amgr, cur);
+    r = btor_aig_get_right_child (amgr, cur);
+    if (!btor_hashint_map_contains (cache, BTOR_REAL_ADDR_AIG (l)->id))
+      BTOR_PUSH_STACK (stack, BTOR_REAL_ADDR_AIG (l));
+    else if (!btor_hashint_map_contains (cache, BTOR_REAL_ADDR_AIG (r)->id))
+      BTOR_PUSH_STACK (stack, BTOR_REAL_ADDR_AIG (r));
+    else
+    {
+      (void) BTOR_POP_STACK (stack);
+      lval = btor_hashint_map_get (cache, BTOR_REAL_ADDR_AIG (l)->id)->as_int;
+      rval = btor_hashint_map_get (cache, BTOR_REAL_ADDR_AIG (r)->id)->as_int;
+      if (BTOR_IS_INVERTED_AIG (l)) lval = -lval;
+      if (BTOR_IS_INVERTED_AIG (r)) rval = -rval;
+      btor_hashint_map_add (cache, cur->id)->as_int =
+          lval > 0 && rval > 0 ? 1 : -1;
+    }
+  }
+  BTOR_RELEASE_STACK (stack);
+  return btor_hashint_map_get (cache, root->id)->as_int;
+}
+
 int32_t
 btor_aig_get_assignment (BtorAIGMgr *amgr, BtorAIG *aig)
 {
@@ -1471,17 +1791,15 @@ btor_aig_get_assignment (BtorAIGMgr *amgr, BtorAIG *aig)
   if (aig == BTOR_AIG_TRUE) return 1;
   if (aig == BTOR_AIG_FALSE) return -1;
 
-  /* Note: If an AIG is not yet encoded to SAT or if the SAT solver returns
-   * undefined for a variable, we implicitly initialize it with false (-1). */
-  int32_t val = -1;
-  if (BTOR_REAL_ADDR_AIG (aig)->cnf_id > 0)
-  {
-    val = btor_sat_deref (amgr->smgr, BTOR_REAL_ADDR_AIG (aig)->cnf_id);
-    if (val == 0)
-    {
-      val = -1;
-    }
-  }
+  /* Note: If an AIG variable is not yet encoded to SAT or if the SAT solver
+   * returns undefined for it, we implicitly initialize it with false (-1).
+   * ANDs not encoded in both polarities are evaluated. */
+  int32_t val;
+  BtorAIG *real_aig = BTOR_REAL_ADDR_AIG (aig);
+  if (real_aig->is_var || real_aig->pol == BTOR_AIG_BOTH)
+    val = deref_aig (amgr, real_aig);
+  else
+    val = eval_aig (amgr, real_aig);
   return BTOR_IS_INVERTED_AIG (aig) ? -val : val;
 }
 
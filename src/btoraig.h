@@ -12,6 +12,7 @@
 #include "btoropt.h"
 #include "btorsat.h"
 #include "btortypes.h"
+#include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 #include "utils/btormem.h"
 #include "utils/btorstack.h"
@@ -31,6 +32,7 @@ struct BtorAIG
   int32_t next; /* next AIG id for unique table */
   uint8_t mark : 2;
   uint8_t is_var : 1; /* is it an AIG variable or an AND? */
+  uint8_t pol : 2;    /* polarities of an AND encoded in the CNF */
   uint32_t local;
   int32_t children[]; /* only allocated for AIG AND */
 };
@@ -56,6 +58,19 @@ struct BtorAIGMgr
   BtorAIGPtrStack id2aig; /* id to AIG node */
   BtorIntStack cnfid2aig; /* cnf id to AIG id */
 
+  /* AIG ids below were neither created nor renumbered since this manager was
+   * cloned or it was cloned from another manager (INT32_MAX if neither),
+   * i.e., they denote the same AIGs as in the managers it is related to via
+   * cloning (see btorclausebus.h) */
+  int32_t num_shared_ids;
+
+  /* values of ANDs evaluated from their children, valid for the SAT call,
+   * number of clauses and number of id compactions below (not cloned) */
+  BtorIntHashTable *eval_cache;
+  int32_t eval_satcalls;
+  uint_least64_t eval_clauses;
+  uint_least64_t eval_gcs;
+
   uint_least64_t cur_num_aigs;     /* current number of ANDs */
   uint_least64_t cur_num_aig_vars; /* current number of AIG variables */
 
@@ -65,6 +80,9 @@ struct BtorAIGMgr
   uint_least64_t num_cnf_vars;
   uint_least64_t num_cnf_clauses;
   uint_least64_t num_cnf_literals;
+  uint_least64_t num_gcs;      /* number of AIG id compactions */
+  uint_least64_t num_gc_ids;   /* number of reclaimed AIG ids */
+  uint_least64_t num_gc_bytes; /* number of reclaimed id table bytes */
 };
 
 typedef struct BtorAIGMgr BtorAIGMgr;
@@ -169,6 +187,15 @@ void btor_aig_mgr_delete (BtorAIGMgr *amgr);
 
 BtorSATMgr *btor_aig_get_sat_mgr (const BtorAIGMgr *amgr);
 
+/* Number of AIG ids not in use anymore (AIGs deleted since the last
+ * compaction). */
+size_t btor_aig_mgr_num_dead_ids (const BtorAIGMgr *amgr);
+
+/* Renumbers all live AIGs densely (preserving their relative order) and
+ * shrinks 'id2aig' accordingly.  AIG ids stored outside of the AIG manager
+ * are invalidated, CNF ids are preserved ('cnfid2aig' is updated). */
+void btor_aig_mgr_gc (BtorAIGMgr *amgr);
+
 /* Variable representing 1 bit. */
 BtorAIG *btor_aig_var (BtorAIGMgr *amgr);
 
@@ -204,7 +231,8 @@ void btor_aig_release (BtorAIGMgr *amgr, BtorAIG *aig);
 void btor_aig_to_sat (BtorAIGMgr *amgr, BtorAIG *aig);
 
 /* As 'btor_aig_to_sat' but also add the argument as new SAT constraint.
- * Actually this will result in less constraints being generated.
+ * Actually this will result in less constraints being generated, since the
+ * AIG is only encoded in the polarities in which its nodes occur.
  */
 void btor_aig_add_toplevel_to_sat (BtorAIGMgr *, BtorAIG *);
 
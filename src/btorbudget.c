@@ -0,0 +1,121 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btorbudget.h"
+
+#include "btorcore.h"
+#include "btoropt.h"
+#include "btorsat.h"
+#include "utils/btorutil.h"
+
+#include <assert.h>
+
+/*------------------------------------------------------------------------*/
+
+static const char *
+resource_name (BtorBudgetResource r)
+{
+  return r == BTOR_BUDGET_TIME ? "time" : "memory";
+}
+
+static size_t
+mem_allocated (Btor *btor)
+{
+  return btor->mm->allocated + btor->mm->sat_allocated;
+}
+
+static int32_t
+terminate_sat (void *btor)
+{
+  return btor_terminate ((Btor *) btor);
+}
+
+/*------------------------------------------------------------------------*/
+
+void
+btor_budget_start (Btor *btor)
+{
+  assert (btor);
+
+  BtorBudget *budget = &btor->budget;
+  BtorSATMgr *smgr;
+
+  budget->active     = false;
+  budget->exhausted  = BTOR_BUDGET_NONE;
+  budget->time_limit = btor_opt_get (btor, BTOR_OPT_BUDGET_TIME) / 1000.0;
+  budget->mem_limit = (size_t) btor_opt_get (btor, BTOR_OPT_BUDGET_MEM) << 20;
+  if (!budget->time_limit && !budget->mem_limit) return;
+
+  smgr             = btor_get_sat_mgr (btor);
+  budget->active   = true;
+  budget->start    = btor_util_current_time ();
+  budget->mem      = mem_allocated (btor);
+  budget->simplify = btor->time.simplify;
+  budget->synth    = btor->time.synth_exp;
+  budget->sat      = smgr->sat_time;
+
+  /* check the budget from within the SAT solver, btor_terminate also calls
+   * the termination function of the instance (if any) */
+  btor_sat_mgr_set_term (smgr, terminate_sat, btor);
+}
+
+void
+btor_budget_stop (Btor *btor)
+{
+  assert (btor);
+
+  BtorBudget *budget = &btor->budget;
+  BtorSATMgr *smgr;
+  double elapsed, simplify, synth, sat, other, mem;
+
+  if (!budget->active) return;
+  budget->active = false;
+  if (!budget->exhausted) return;
+
+  smgr     = btor_get_sat_mgr (btor);
+  elapsed  = btor_util_current_time () - budget->start;
+  simplify = btor->time.simplify - budget->simplify;
+  synth    = btor->time.synth_exp - budget->synth;
+  sat      = smgr->sat_time - budget->sat;
+  other    = elapsed - simplify - synth - sat;
+  mem      = (double) mem_allocated (btor) - (double) budget->mem;
+
+  BTOR_MSG (btor->msg,
+            1,
+            "%s budget exhausted after %.2f seconds and %.1f MB allocated",
+            resource_name (budget->exhausted),
+            elapsed,
+            mem / (1 << 20));
+  BTOR_MSG (btor->msg, 1, "  %.2f seconds rewriting", simplify);
+  BTOR_MSG (btor->msg, 1, "  %.2f seconds bit-blasting", synth);
+  BTOR_MSG (btor->msg, 1, "  %.2f seconds SAT solving", sat);
+  BTOR_MSG (btor->msg,
+            1,
+            "  %.2f seconds refinement and other",
+            other > 0 ? other : 0);
+}
+
+bool
+btor_budget_exhausted (Btor *btor)
+{
+  assert (btor);
+
+  BtorBudget *budget = &btor->budget;
+
+  if (!budget->active) return false;
+  if (budget->exhausted) return true;
+
+  if (budget->mem_limit
+      && mem_allocated (btor) > budget->mem + budget->mem_limit)
+    budget->exhausted = BTOR_BUDGET_MEM;
+  else if (budget->time_limit
+           && btor_util_current_time () - budget->start > budget->time_limit)
+    budget->exhausted = BTOR_BUDGET_TIME;
+
+  return budget->exhausted != BTOR_BUDGET_NONE;
+}
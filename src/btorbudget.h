@@ -0,0 +1,67 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORBUDGET_H_INCLUDED
+#define BTORBUDGET_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "btortypes.h"
+
+/* Resource budget of a single btor_check_sat call (wall-clock time
+ * BTOR_OPT_BUDGET_TIME and memory BTOR_OPT_BUDGET_MEM allocated via the memory
+ * manager of the instance, including the SAT solver if it uses it).  The
+ * memory budget limits the increase of allocated memory since the start of
+ * the call, not the memory held by the instance in total.
+ *
+ * The budget is checked via btor_terminate, i.e., at the same points as the
+ * termination callback: between rewriting rounds, before each refinement
+ * iteration and from within the SAT solver.  If it is exhausted,
+ * btor_check_sat returns 'unknown'.  Exhausting the budget does not
+ * permanently terminate the instance, in incremental mode a subsequent call
+ * (with a fresh budget) resumes from the current state, i.e., simplified and
+ * bit-blasted constraints, lemmas and learned clauses are kept. */
+
+enum BtorBudgetResource
+{
+  BTOR_BUDGET_NONE,
+  BTOR_BUDGET_TIME,
+  BTOR_BUDGET_MEM,
+};
+
+typedef enum BtorBudgetResource BtorBudgetResource;
+
+struct BtorBudget
+{
+  bool active;
+  BtorBudgetResource exhausted;
+  double time_limit; /* in seconds, 0 if unlimited */
+  size_t mem_limit;  /* in bytes, 0 if unlimited */
+  double start;      /* wall-clock time at start */
+  size_t mem;        /* memory allocated at start */
+  /* process time spent in rewriting, bit-blasting and SAT solving at start */
+  double simplify;
+  double synth;
+  double sat;
+};
+
+typedef struct BtorBudget BtorBudget;
+
+/* Start budget for the current btor_check_sat call (if any limit is set). */
+void btor_budget_start (Btor *btor);
+
+/* Stop budget and report where it went if it was exhausted. */
+void btor_budget_stop (Btor *btor);
+
+/* Returns true if the budget of the current btor_check_sat call is exhausted.
+ * Cheap enough to be called from the termination callback of the SAT solver.
+ */
+bool btor_budget_exhausted (Btor *btor);
+
+#endif
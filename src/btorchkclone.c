@@ -382,6 +382,7 @@ chkclone_aig (BtorAIG *aig, BtorAIG *clone)
     BTOR_CHKCLONE_AIG (cnf_id);
     BTOR_CHKCLONE_AIG (mark);
     BTOR_CHKCLONE_AIG (is_var);
+    BTOR_CHKCLONE_AIG (pol);
     BTOR_CHKCLONE_AIG (local);
     if (!real_aig->is_var)
       for (i = 0; i < 2; i++) BTOR_CHKCLONE_AIG (children[i]);
@@ -504,6 +505,7 @@ btor_chkclone_exp (Btor *btor,
   BTOR_CHKCLONE_EXP (bytes);
   BTOR_CHKCLONE_EXP (parameterized);
   BTOR_CHKCLONE_EXP (lambda_below);
+  BTOR_CHKCLONE_EXP (activation_below);
 
   if (btor_node_is_bv_const (real_exp))
   {
@@ -1037,6 +1039,9 @@ chkclone_slv (Btor *btor, Btor *clone)
     BtorPtrHashTableIterator cit;
 
     chkclone_node_ptr_hash_table (slv->lemmas, cslv->lemmas, 0);
+    assert (slv->lemma_db->count == cslv->lemma_db->count);
+    assert (slv->lemma_db_bytes == cslv->lemma_db_bytes);
+    assert (slv->lemma_db_count == cslv->lemma_db_count);
 
     if (slv->score)
     {
@@ -1085,6 +1090,10 @@ chkclone_slv (Btor *btor, Btor *clone)
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, beta_reduction_conflicts);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, extensionality_lemmas);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, lemmas_size_sum);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, lemmas_duplicate);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, lemmas_subsumed);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, lemmas_subsuming);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, lemma_batches_full);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_failed_vars);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_assumed_vars);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_failed_applies);
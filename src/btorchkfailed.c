@@ -80,10 +80,11 @@ btor_check_failed_assumptions (Btor *btor)
   clone->slv->api.delet (clone->slv);
   clone->slv = 0;
 
-  /* clone->assertions have already been added at this point. */
-  while (!BTOR_EMPTY_STACK (clone->assertions))
+  /* the activation literals of clone->activation_lits have already been
+   * added at this point (as assumptions, asserted below if failed). */
+  while (!BTOR_EMPTY_STACK (clone->activation_lits))
   {
-    ass = BTOR_POP_STACK (clone->assertions);
+    ass = BTOR_POP_STACK (clone->activation_lits);
     btor_node_release (clone, ass);
   }
 
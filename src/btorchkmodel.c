@@ -160,10 +160,11 @@ btor_check_model (BtorCheckModelContext *ctx)
     btor_assert_exp (clone, btor_iter_hashptr_next (&it));
   btor_reset_assumptions (clone);
 
-  /* clone->assertions have been already added at this point. */
-  while (!BTOR_EMPTY_STACK (clone->assertions))
+  /* the activation literals of clone->activation_lits have been already
+   * added at this point (as assumptions). */
+  while (!BTOR_EMPTY_STACK (clone->activation_lits))
   {
-    cur = BTOR_POP_STACK (clone->assertions);
+    cur = BTOR_POP_STACK (clone->activation_lits);
     btor_node_release (clone, cur);
   }
 
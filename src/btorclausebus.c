@@ -0,0 +1,342 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btorclausebus.h"
+
+#include "btoraig.h"
+#include "btorcore.h"
+#include "btorsat.h"
+#include "utils/btorhashint.h"
+#include "utils/btormem.h"
+#include "utils/btorstack.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+#ifdef BTOR_HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
+/*------------------------------------------------------------------------*/
+
+/* Attached instance, passed as state to the share callbacks of its SAT
+ * manager. */
+struct BtorClauseBusPort
+{
+  BtorClauseBus *bus;
+  Btor *btor;
+  int32_t id;
+  size_t next;       /* next published clause to import */
+  BtorIntStack lits; /* allocated with the memory manager of 'btor' */
+};
+
+typedef struct BtorClauseBusPort BtorClauseBusPort;
+
+BTOR_DECLARE_STACK (BtorClauseBusPortPtr, BtorClauseBusPort *);
+
+/* All accesses are synchronized via 'mutex'.  Published clauses are stored as
+ * id of the publishing port, size and (sorted) AIG literals, and are never
+ * removed.  Clauses are only published once, duplicates are detected via
+ * their hash value (clauses with colliding hash values are dropped).  Only
+ * AIG ids below 'num_shared_ids' denote the same AIGs in all instances
+ * attached so far, clauses over other AIGs are neither published nor
+ * imported. */
+struct BtorClauseBus
+{
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_t mutex;
+#endif
+  BtorMemMgr *mm;
+  BtorClauseBusPortPtrStack ports;
+  int32_t next_id;
+  int32_t num_shared_ids;
+  BtorIntStack clauses;
+  BtorIntHashTable *published;
+};
+
+/*------------------------------------------------------------------------*/
+
+static void
+lock (BtorClauseBus *bus)
+{
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_lock (&bus->mutex);
+#else
+  (void) bus;
+#endif
+}
+
+static void
+unlock (BtorClauseBus *bus)
+{
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_unlock (&bus->mutex);
+#else
+  (void) bus;
+#endif
+}
+
+static BtorClauseBusPort *
+find_port (BtorClauseBus *bus, Btor *btor)
+{
+  BtorClauseBusPort *res = 0;
+  size_t i;
+
+  lock (bus);
+  for (i = 0; i < BTOR_COUNT_STACK (bus->ports) && !res; i++)
+    if (BTOR_PEEK_STACK (bus->ports, i)->btor == btor)
+      res = BTOR_PEEK_STACK (bus->ports, i);
+  unlock (bus);
+  return res;
+}
+
+static int
+cmp_lit (const void *p, const void *q)
+{
+  int32_t a = *(const int32_t *) p, b = *(const int32_t *) q;
+  return a < b ? -1 : a > b;
+}
+
+static bool
+shared_clause (BtorClauseBus *bus, const int32_t *lits, uint32_t size)
+{
+  uint32_t i;
+  for (i = 0; i < size; i++)
+    if (abs (lits[i]) >= bus->num_shared_ids) return false;
+  return true;
+}
+
+static int32_t
+hash_clause (const int32_t *lits, uint32_t size)
+{
+  uint32_t i, res = size;
+  for (i = 0; i < size; i++) res = (res + (uint32_t) lits[i]) * 2654435761u;
+  return res ? (int32_t) res : 1;
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+publish (BtorClauseBusPort *port, const int32_t *lits, uint32_t size)
+{
+  BtorClauseBus *bus = port->bus;
+  BtorAIGMgr *amgr   = btor_get_aig_mgr (port->btor);
+  int32_t cnf_id, aig_id, hash;
+  uint32_t i;
+
+  BTOR_RESET_STACK (port->lits);
+  for (i = 0; i < size; i++)
+  {
+    cnf_id = abs (lits[i]);
+    if ((size_t) cnf_id >= BTOR_SIZE_STACK (amgr->cnfid2aig)) return;
+    aig_id = amgr->cnfid2aig.start[cnf_id];
+    if (!aig_id) return;
+    BTOR_PUSH_STACK (port->lits, lits[i] < 0 ? -aig_id : aig_id);
+  }
+  qsort (port->lits.start, size, sizeof (int32_t), cmp_lit);
+  hash = hash_clause (port->lits.start, size);
+
+  lock (bus);
+  if (shared_clause (bus, port->lits.start, size)
+      && !btor_hashint_table_contains (bus->published, hash))
+  {
+    btor_hashint_table_add (bus->published, hash);
+    BTOR_PUSH_STACK (bus->clauses, port->id);
+    BTOR_PUSH_STACK (bus->clauses, (int32_t) size);
+    for (i = 0; i < size; i++)
+      BTOR_PUSH_STACK (bus->clauses, BTOR_PEEK_STACK (port->lits, i));
+  }
+  unlock (bus);
+}
+
+static void
+share_learned (void *state, const int32_t *lits, uint32_t size)
+{
+  publish ((BtorClauseBusPort *) state, lits, size);
+}
+
+static uint32_t
+import (BtorClauseBusPort *port)
+{
+  BtorClauseBus *bus = port->bus;
+  BtorAIGMgr *amgr   = btor_get_aig_mgr (port->btor);
+  BtorAIG *aig;
+  int32_t lit, aig_id;
+  uint32_t size, j, res = 0;
+  size_t i, start;
+
+  BTOR_RESET_STACK (port->lits);
+  lock (bus);
+  for (i = port->next; i < BTOR_COUNT_STACK (bus->clauses); i += size + 2)
+  {
+    size = (uint32_t) BTOR_PEEK_STACK (bus->clauses, i + 1);
+    if (BTOR_PEEK_STACK (bus->clauses, i) == port->id) continue;
+    /* published before an instance with fewer shared ids was attached */
+    if (!shared_clause (bus, bus->clauses.start + i + 2, size)) continue;
+    start = BTOR_COUNT_STACK (port->lits);
+    for (j = 0; j < size; j++)
+    {
+      lit    = BTOR_PEEK_STACK (bus->clauses, i + 2 + j);
+      aig_id = abs (lit);
+      if ((size_t) aig_id >= BTOR_COUNT_STACK (amgr->id2aig)) break;
+      aig = btor_aig_get_by_id (amgr, aig_id);
+      if (!aig || !aig->cnf_id) break;
+      BTOR_PUSH_STACK (port->lits, lit < 0 ? -aig->cnf_id : aig->cnf_id);
+    }
+    if (j < size)
+    {
+      port->lits.top = port->lits.start + start;
+      continue;
+    }
+    BTOR_PUSH_STACK (port->lits, 0);
+    res++;
+  }
+  port->next = BTOR_COUNT_STACK (bus->clauses);
+  unlock (bus);
+
+  if (res)
+  {
+    btor_sat_import_clauses (btor_get_sat_mgr (port->btor),
+                             port->lits.start,
+                             BTOR_COUNT_STACK (port->lits));
+  }
+  return res;
+}
+
+static void
+share_import (void *state, BtorSATMgr *smgr)
+{
+  BtorClauseBusPort *port = (BtorClauseBusPort *) state;
+  (void) smgr;
+  assert (btor_get_sat_mgr (port->btor) == smgr);
+  import (port);
+}
+
+/*------------------------------------------------------------------------*/
+
+BtorClauseBus *
+btor_clause_bus_new (void)
+{
+  BtorClauseBus *res;
+  BtorMemMgr *mm;
+
+  mm = btor_mem_mgr_new ();
+  BTOR_CNEW (mm, res);
+  res->mm             = mm;
+  res->num_shared_ids = INT32_MAX;
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_init (&res->mutex, 0);
+#endif
+  BTOR_INIT_STACK (mm, res->ports);
+  BTOR_INIT_STACK (mm, res->clauses);
+  res->published = btor_hashint_table_new (mm);
+  return res;
+}
+
+void
+btor_clause_bus_delete (BtorClauseBus *bus)
+{
+  assert (bus);
+  assert (BTOR_EMPTY_STACK (bus->ports));
+
+  BtorMemMgr *mm = bus->mm;
+
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_destroy (&bus->mutex);
+#endif
+  BTOR_RELEASE_STACK (bus->ports);
+  BTOR_RELEASE_STACK (bus->clauses);
+  btor_hashint_table_delete (bus->published);
+  BTOR_DELETE (mm, bus);
+  btor_mem_mgr_delete (mm);
+}
+
+void
+btor_clause_bus_attach (BtorClauseBus *bus, Btor *btor)
+{
+  assert (bus);
+  assert (btor);
+  assert (!find_port (bus, btor));
+
+  BtorAIGMgr *amgr = btor_get_aig_mgr (btor);
+  BtorClauseBusPort *port;
+  int32_t num_shared_ids;
+
+  /* AIGs created after attaching are not shared */
+  num_shared_ids = amgr->num_shared_ids;
+  if ((size_t) num_shared_ids > BTOR_COUNT_STACK (amgr->id2aig))
+    num_shared_ids = (int32_t) BTOR_COUNT_STACK (amgr->id2aig);
+
+  lock (bus);
+  if (num_shared_ids < bus->num_shared_ids)
+    bus->num_shared_ids = num_shared_ids;
+  BTOR_CNEW (bus->mm, port);
+  port->bus  = bus;
+  port->btor = btor;
+  port->id   = bus->next_id++;
+  BTOR_INIT_STACK (btor->mm, port->lits);
+  BTOR_PUSH_STACK (bus->ports, port);
+  unlock (bus);
+
+  btor_sat_mgr_set_share (btor_get_sat_mgr (btor),
+                          share_learned,
+                          share_import,
+                          port,
+                          btor_opt_get (btor, BTOR_OPT_SAT_SHARE_SIZE),
+                          btor_opt_get (btor, BTOR_OPT_SAT_SHARE_LBD));
+}
+
+void
+btor_clause_bus_detach (BtorClauseBus *bus, Btor *btor)
+{
+  assert (bus);
+  assert (btor);
+
+  BtorClauseBusPort *port;
+  size_t i;
+
+  port = find_port (bus, btor);
+  assert (port);
+  btor_sat_mgr_set_share (btor_get_sat_mgr (btor), 0, 0, 0, 0, 0);
+
+  BTOR_RELEASE_STACK (port->lits);
+
+  lock (bus);
+  for (i = 0; BTOR_PEEK_STACK (bus->ports, i) != port; i++)
+    ;
+  BTOR_POKE_STACK (bus->ports, i, BTOR_TOP_STACK (bus->ports));
+  (void) BTOR_POP_STACK (bus->ports);
+  BTOR_DELETE (bus->mm, port);
+  unlock (bus);
+}
+
+void
+btor_clause_bus_publish (BtorClauseBus *bus,
+                         Btor *btor,
+                         const int32_t *lits,
+                         uint32_t size)
+{
+  assert (bus);
+  assert (btor);
+  assert (!size || lits);
+
+  BtorClauseBusPort *port = find_port (bus, btor);
+  assert (port);
+  publish (port, lits, size);
+}
+
+uint32_t
+btor_clause_bus_import (BtorClauseBus *bus, Btor *btor)
+{
+  assert (bus);
+  assert (btor);
+
+  BtorClauseBusPort *port = find_port (bus, btor);
+  assert (port);
+  return import (port);
+}
@@ -0,0 +1,55 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORCLAUSEBUS_H_INCLUDED
+#define BTORCLAUSEBUS_H_INCLUDED
+
+#include <stdint.h>
+
+#include "btortypes.h"
+
+/* A clause bus exchanges learned clauses between the SAT solvers of Boolector
+ * instances that solve the same formula, e.g., an instance and its clones
+ * configured with different SAT engines or seeds, possibly running in
+ * parallel.  Clauses are published over AIG ids (mapped via 'cnfid2aig') and
+ * imported over the CNF ids that the importing instance assigned to the same
+ * AIGs.  Hence, all instances must assert the same constraints (assumptions
+ * may differ), and AIG ids of attached instances must correspond when they
+ * are attached, as for an instance and its clones.  Since instances create
+ * AIGs independently after cloning and attaching, only clauses over AIGs that
+ * existed in all instances when they were attached (and cloned) are shared.
+ * Clauses over other AIGs, or over variables that do not correspond to an AIG
+ * encoded to CNF in the importing instance, are dropped. */
+
+typedef struct BtorClauseBus BtorClauseBus;
+
+BtorClauseBus *btor_clause_bus_new (void);
+
+/* Requires that all instances are detached. */
+void btor_clause_bus_delete (BtorClauseBus *bus);
+
+/* Attach 'btor' to 'bus'.  Learned clauses of its SAT solver up to size
+ * BTOR_OPT_SAT_SHARE_SIZE and LBD BTOR_OPT_SAT_SHARE_LBD are published on
+ * 'bus', clauses published by other instances are imported before each SAT
+ * call.  Instances must be detached before they are deleted. */
+void btor_clause_bus_attach (BtorClauseBus *bus, Btor *btor);
+
+void btor_clause_bus_detach (BtorClauseBus *bus, Btor *btor);
+
+/* Publish clause 'lits' (over CNF ids of attached instance 'btor'). */
+void btor_clause_bus_publish (BtorClauseBus *bus,
+                              Btor *btor,
+                              const int32_t *lits,
+                              uint32_t size);
+
+/* Import the clauses published by other instances since the last import into
+ * the SAT solver of attached instance 'btor'.  Returns the number of imported
+ * clauses. */
+uint32_t btor_clause_bus_import (BtorClauseBus *bus, Btor *btor);
+
+#endif
@@ -260,6 +260,85 @@ btor_clone_data_as_bv_ptr_htable (BtorMemMgr *mm,
 
 /*------------------------------------------------------------------------*/
 
+/* The nodes of a clone have the same ids as their originals. Hence, while
+ * cloning, nodes are mapped via the id table of the clone, which avoids
+ * hash table lookups in the expression map. */
+
+static BtorNode *
+clone_mapped_by_id (const Btor *clone, const BtorNode *exp)
+{
+  assert (clone);
+  assert (exp);
+
+  BtorNode *real_exp, *res;
+
+  real_exp = btor_node_real_addr (exp);
+  assert ((size_t) real_exp->id < BTOR_COUNT_STACK (clone->nodes_id_table));
+  res = BTOR_PEEK_STACK (clone->nodes_id_table, real_exp->id);
+  assert (res);
+  assert (res->id == real_exp->id);
+  return btor_node_cond_invert (exp, res);
+}
+
+static void *
+clone_key_as_node_by_id (BtorMemMgr *mm, const void *clone, const void *key)
+{
+  assert (clone);
+  assert (key);
+  (void) mm;
+  return clone_mapped_by_id ((Btor *) clone, (BtorNode *) key);
+}
+
+static void
+clone_data_as_node_ptr_by_id (BtorMemMgr *mm,
+                              const void *clone,
+                              BtorHashTableData *data,
+                              BtorHashTableData *cloned_data)
+{
+  assert (clone);
+  assert (data);
+  assert (cloned_data);
+  (void) mm;
+  cloned_data->as_ptr =
+      clone_mapped_by_id ((Btor *) clone, (BtorNode *) data->as_ptr);
+}
+
+static void
+clone_node_ptr_stack_by_id (Btor *clone,
+                            BtorNodePtrStack *stack,
+                            BtorNodePtrStack *res,
+                            bool is_zero_terminated)
+{
+  assert (clone);
+  assert (stack);
+  assert (res);
+
+  uint32_t i, n;
+  bool has_zero_terminated;
+
+  BTOR_INIT_STACK (clone->mm, *res);
+  assert (BTOR_SIZE_STACK (*stack) || !BTOR_COUNT_STACK (*stack));
+  if (BTOR_SIZE_STACK (*stack))
+  {
+    BTOR_NEWN (clone->mm, res->start, BTOR_SIZE_STACK (*stack));
+    res->top = res->start;
+    res->end = res->start + BTOR_SIZE_STACK (*stack);
+
+    n                   = BTOR_COUNT_STACK (*stack);
+    has_zero_terminated = n && !BTOR_PEEK_STACK (*stack, n - 1);
+    if (is_zero_terminated && has_zero_terminated) n -= 1;
+
+    for (i = 0; i < n; i++)
+      BTOR_PUSH_STACK (*res, clone_mapped_by_id (clone, stack->start[i]));
+
+    if (is_zero_terminated && has_zero_terminated) BTOR_PUSH_STACK (*res, 0);
+  }
+  assert (BTOR_COUNT_STACK (*stack) == BTOR_COUNT_STACK (*res));
+  assert (BTOR_SIZE_STACK (*stack) == BTOR_SIZE_STACK (*res));
+}
+
+/*------------------------------------------------------------------------*/
+
 static void
 clone_sorts_unique_table (Btor *btor, Btor *clone)
 {
@@ -497,7 +576,6 @@ clone_exp (Btor *clone,
   assert (btor_node_is_regular (exp));
   assert (parents);
   assert (nodes);
-  assert (exp_map);
 
   uint32_t i;
   BtorBitVector *bits;
@@ -560,14 +638,11 @@ clone_exp (Btor *clone,
   {
     if (!btor_node_is_bv_var (exp) && !btor_node_is_param (exp))
     {
-      if (exp->arity)
+      /* children have smaller ids and are already cloned */
+      for (i = 0; i < exp->arity; i++)
       {
-        for (i = 0; i < exp->arity; i++)
-        {
-          res->e[i] = btor_nodemap_mapped (exp_map, exp->e[i]);
-          assert (exp->e[i] != res->e[i]);
-          assert (res->e[i]);
-        }
+        res->e[i] = clone_mapped_by_id (clone, exp->e[i]);
+        assert (exp->e[i] != res->e[i]);
       }
 
       for (i = 0; i < exp->arity; i++)
@@ -615,7 +690,7 @@ clone_exp (Btor *clone,
                         &((BtorBinderNode *) res)->body);
   }
 
-  btor_nodemap_map (exp_map, exp, res);
+  if (exp_map) btor_nodemap_map (exp_map, exp, res);
 
   return res;
 }
@@ -672,8 +747,7 @@ clone_nodes_id_table (Btor *btor,
 {
   assert (btor);
   assert (clone);
-  assert (res);
-  assert (exp_map);
+  assert (res == &clone->nodes_id_table);
 
   size_t i;
   int32_t tag;
@@ -727,8 +801,7 @@ clone_nodes_id_table (Btor *btor,
   {
     tmp = BTOR_POP_STACK (nodes);
     assert (*tmp);
-    *tmp = btor_nodemap_mapped (exp_map, *tmp);
-    assert (*tmp);
+    *tmp = clone_mapped_by_id (clone, *tmp);
   }
 
   while (!BTOR_EMPTY_STACK (parents))
@@ -736,8 +809,7 @@ clone_nodes_id_table (Btor *btor,
     tmp = BTOR_POP_STACK (parents);
     assert (*tmp);
     tag  = btor_node_get_tag (*tmp);
-    *tmp = btor_nodemap_mapped (exp_map, btor_node_real_addr (*tmp));
-    assert (*tmp);
+    *tmp = clone_mapped_by_id (clone, btor_node_real_addr (*tmp));
     *tmp = btor_node_set_tag (*tmp, tag);
   }
 
@@ -754,10 +826,10 @@ clone_nodes_id_table (Btor *btor,
         cloned_exp,
         btor_hashptr_table_clone (mm,
                                   t,
-                                  btor_clone_key_as_node,
-                                  btor_clone_data_as_node_ptr,
-                                  exp_map,
-                                  exp_map));
+                                  clone_key_as_node_by_id,
+                                  clone_data_as_node_ptr_by_id,
+                                  clone,
+                                  clone));
   }
 
   BTOR_RELEASE_STACK (parents);
@@ -766,11 +838,10 @@ clone_nodes_id_table (Btor *btor,
 }
 
 static void
-clone_nodes_unique_table (Btor *btor, Btor *clone, BtorNodeMap *exp_map)
+clone_nodes_unique_table (Btor *btor, Btor *clone)
 {
   assert (btor);
   assert (clone);
-  assert (exp_map);
 
   uint32_t i;
   BtorNodeUniqueTable *table, *res;
@@ -787,8 +858,7 @@ clone_nodes_unique_table (Btor *btor, Btor *clone, BtorNodeMap *exp_map)
   for (i = 0; i < table->size; i++)
   {
     if (!table->chains[i]) continue;
-    res->chains[i] = btor_nodemap_mapped (exp_map, table->chains[i]);
-    assert (res->chains[i]);
+    res->chains[i] = clone_mapped_by_id (clone, table->chains[i]);
   }
 }
 
@@ -825,24 +895,24 @@ clone_nodes_unique_table (Btor *btor, Btor *clone, BtorNodeMap *exp_map)
     assert (MEM_PTR_HASH_TABLE (table) == MEM_PTR_HASH_TABLE (clone)); \
   } while (0)
 
-#define CLONE_PTR_HASH_TABLE(table)                           \
-  do                                                          \
-  {                                                           \
-    clone->table = btor_hashptr_table_clone (                 \
-        mm, btor->table, btor_clone_key_as_node, 0, emap, 0); \
-    CHKCLONE_MEM_PTR_HASH_TABLE (btor->table, clone->table);  \
+#define CLONE_PTR_HASH_TABLE(table)                             \
+  do                                                            \
+  {                                                             \
+    clone->table = btor_hashptr_table_clone (                   \
+        mm, btor->table, clone_key_as_node_by_id, 0, clone, 0); \
+    CHKCLONE_MEM_PTR_HASH_TABLE (btor->table, clone->table);    \
   } while (0)
 
-#define CLONE_PTR_HASH_TABLE_DATA(table, data_func)                      \
-  do                                                                     \
-  {                                                                      \
-    BTORLOG_TIMESTAMP (delta);                                           \
-    clone->table = btor_hashptr_table_clone (                            \
-        mm, btor->table, btor_clone_key_as_node, data_func, emap, emap); \
-    BTORLOG (2,                                                          \
-             "  clone " #table " table: %.3f s",                         \
-             (btor_util_time_stamp () - delta));                         \
-    CHKCLONE_MEM_PTR_HASH_TABLE (btor->table, clone->table);             \
+#define CLONE_PTR_HASH_TABLE_DATA(table, data_func)                          \
+  do                                                                         \
+  {                                                                          \
+    BTORLOG_TIMESTAMP (delta);                                               \
+    clone->table = btor_hashptr_table_clone (                                \
+        mm, btor->table, clone_key_as_node_by_id, data_func, clone, clone); \
+    BTORLOG (2,                                                              \
+             "  clone " #table " table: %.3f s",                             \
+             (btor_util_time_stamp () - delta));                             \
+    CHKCLONE_MEM_PTR_HASH_TABLE (btor->table, clone->table);                 \
   } while (0)
 
 #if 0
@@ -909,6 +979,9 @@ clone_aux_btor (Btor *btor,
   btor_rng_clone (&btor->rng, &clone->rng);
 
   BTOR_CLR (&clone->cbs);
+  BTOR_CLR (&clone->budget);
+  clone->profile = 0;
+  clone->perf    = 0;
   btor_opt_clone_opts (btor, clone);
 #ifndef NDEBUG
   allocated += BTOR_OPT_NUM_OPTS * sizeof (BtorOpt);
@@ -928,6 +1001,8 @@ clone_aux_btor (Btor *btor,
   /* always auto cleanup internal and external references (may be dangling
    * otherise) */
   btor_opt_set (clone, BTOR_OPT_AUTO_CLEANUP, 1);
+  /* do not write to the profile output of 'btor' */
+  btor_opt_set (clone, BTOR_OPT_PROFILE, 0);
   btor_opt_set (clone, BTOR_OPT_AUTO_CLEANUP_INTERNAL, 1);
 
   if (exp_layer_only)
@@ -1019,6 +1094,8 @@ clone_aux_btor (Btor *btor,
                             + 2 * sizeof (BtorAIG *)
                             + sizeof (int32_t)) /* unique table chains */
               == clone->mm->allocated);
+      /* AIGs are rebuilt with different ids */
+      btor_get_aig_mgr (clone)->num_shared_ids = 2;
     }
     else
     {
@@ -1078,9 +1155,14 @@ clone_aux_btor (Btor *btor,
   assert (allocated == clone->mm->allocated);
 #endif
 
-  emap = btor_nodemap_new (clone);
-  assert ((allocated += sizeof (*emap) + MEM_PTR_HASH_TABLE (emap->table))
-          == clone->mm->allocated);
+  /* the expression map is only needed if it is returned or for cloning the
+   * solver, nodes are otherwise mapped via the id table of the clone */
+  if (exp_map || (clone_slv && btor->slv))
+  {
+    emap = btor_nodemap_new (clone);
+    assert ((allocated += sizeof (*emap) + MEM_PTR_HASH_TABLE (emap->table))
+            == clone->mm->allocated);
+  }
 
   BTOR_INIT_STACK (btor->mm, rhos);
   BTORLOG_TIMESTAMP (delta);
@@ -1112,17 +1194,17 @@ clone_aux_btor (Btor *btor,
       allocated += MEM_PTR_HASH_TABLE (btor_node_lambda_get_static_rho (cur));
   }
   /* Note: hash table is initialized with size 1 */
-  allocated += (emap->table->size - 1) * sizeof (BtorPtrHashBucket *)
-               + emap->table->count * sizeof (BtorPtrHashBucket)
-               + BTOR_SIZE_STACK (btor->nodes_id_table) * sizeof (BtorNode *);
+  if (emap)
+    allocated += (emap->table->size - 1) * sizeof (BtorPtrHashBucket *)
+                 + emap->table->count * sizeof (BtorPtrHashBucket);
+  allocated += BTOR_SIZE_STACK (btor->nodes_id_table) * sizeof (BtorNode *);
   assert (allocated == clone->mm->allocated);
 #endif
 
-  clone->true_exp = btor_nodemap_mapped (emap, btor->true_exp);
-  assert (clone->true_exp);
+  clone->true_exp = clone_mapped_by_id (clone, btor->true_exp);
 
   BTORLOG_TIMESTAMP (delta);
-  clone_nodes_unique_table (btor, clone, emap);
+  clone_nodes_unique_table (btor, clone);
   BTORLOG (2,
            "  clone nodes unique table: %.3f s",
            (btor_util_time_stamp () - delta));
@@ -1132,9 +1214,9 @@ clone_aux_btor (Btor *btor,
   clone->symbols = btor_hashptr_table_clone (mm,
                                              btor->symbols,
                                              btor_clone_key_as_str,
-                                             btor_clone_data_as_node_ptr,
+                                             clone_data_as_node_ptr_by_id,
                                              0,
-                                             emap);
+                                             clone);
 #ifndef NDEBUG
   uint32_t str_bytes = 0;
   btor_iter_hashptr_init (&pit, btor->symbols);
@@ -1146,9 +1228,9 @@ clone_aux_btor (Btor *btor,
 #endif
   clone->node2symbol = btor_hashptr_table_clone (mm,
                                                  btor->node2symbol,
-                                                 btor_clone_key_as_node,
+                                                 clone_key_as_node_by_id,
                                                  btor_clone_data_as_str_ptr,
-                                                 emap,
+                                                 clone,
                                                  clone->symbols);
 #ifndef NDEBUG
   assert ((allocated += MEM_PTR_HASH_TABLE (btor->node2symbol))
@@ -1179,10 +1261,11 @@ clone_aux_btor (Btor *btor,
   CLONE_PTR_HASH_TABLE_DATA (feqs, btor_clone_data_as_int);
   assert ((allocated += MEM_PTR_HASH_TABLE (btor->feqs))
           == clone->mm->allocated);
-  CLONE_PTR_HASH_TABLE_DATA (substitutions, btor_clone_data_as_node_ptr);
+  CLONE_PTR_HASH_TABLE_DATA (substitutions, clone_data_as_node_ptr_by_id);
   assert ((allocated += MEM_PTR_HASH_TABLE (btor->substitutions))
           == clone->mm->allocated);
-  CLONE_PTR_HASH_TABLE_DATA (varsubst_constraints, btor_clone_data_as_node_ptr);
+  CLONE_PTR_HASH_TABLE_DATA (varsubst_constraints,
+                             clone_data_as_node_ptr_by_id);
   assert ((allocated += MEM_PTR_HASH_TABLE (btor->varsubst_constraints))
           == clone->mm->allocated);
   CLONE_PTR_HASH_TABLE (embedded_constraints);
@@ -1200,30 +1283,16 @@ clone_aux_btor (Btor *btor,
   CLONE_PTR_HASH_TABLE (orig_assumptions);
   assert ((allocated += MEM_PTR_HASH_TABLE (btor->orig_assumptions))
           == clone->mm->allocated);
-  btor_clone_node_ptr_stack (
-      mm, &btor->failed_assumptions, &clone->failed_assumptions, emap, true);
+  clone_node_ptr_stack_by_id (
+      clone, &btor->failed_assumptions, &clone->failed_assumptions, true);
   assert ((allocated +=
            BTOR_SIZE_STACK (btor->failed_assumptions) * sizeof (BtorNode *))
           == clone->mm->allocated);
 
-  clone->assertions_cache =
-      btor_hashint_table_clone (clone->mm, btor->assertions_cache);
-  assert ((allocated += MEM_INT_HASH_TABLE (btor->assertions_cache))
-          == clone->mm->allocated);
-
-  btor_clone_node_ptr_stack (
-      mm, &btor->assertions, &clone->assertions, emap, false);
-  assert (
-      (allocated += BTOR_SIZE_STACK (btor->assertions) * sizeof (BtorNode *))
-      == clone->mm->allocated);
-
-  BTOR_INIT_STACK (clone->mm, clone->assertions_trail);
-  for (i = 0; i < BTOR_COUNT_STACK (btor->assertions_trail); i++)
-    BTOR_PUSH_STACK (clone->assertions_trail,
-                     BTOR_PEEK_STACK (btor->assertions_trail, i));
-  BTOR_ADJUST_STACK (btor->assertions_trail, clone->assertions_trail);
+  clone_node_ptr_stack_by_id (
+      clone, &btor->activation_lits, &clone->activation_lits, false);
   assert ((allocated +=
-           BTOR_SIZE_STACK (btor->assertions_trail) * sizeof (uint32_t))
+           BTOR_SIZE_STACK (btor->activation_lits) * sizeof (BtorNode *))
           == clone->mm->allocated);
 
   if (btor->bv_model)
@@ -1294,10 +1363,10 @@ clone_aux_btor (Btor *btor,
     assert (exp->rho);
     cloned_exp->rho = btor_hashptr_table_clone (mm,
                                                 exp->rho,
-                                                btor_clone_key_as_node,
-                                                btor_clone_data_as_node_ptr,
-                                                emap,
-                                                emap);
+                                                clone_key_as_node_by_id,
+                                                clone_data_as_node_ptr_by_id,
+                                                clone,
+                                                clone);
 #ifndef NDEBUG
     allocated += MEM_PTR_HASH_TABLE (cloned_exp->rho);
 #endif
@@ -1313,17 +1382,16 @@ clone_aux_btor (Btor *btor,
     for (i = 0; i < BTOR_COUNT_STACK (btor->functions_with_model); i++)
       btor_node_release (
           clone,
-          btor_nodemap_mapped (
-              emap, BTOR_PEEK_STACK (btor->functions_with_model, i)));
+          clone_mapped_by_id (clone,
+                              BTOR_PEEK_STACK (btor->functions_with_model, i)));
   }
   else
   {
     BTORLOG_TIMESTAMP (delta);
-    btor_clone_node_ptr_stack (mm,
-                               &btor->functions_with_model,
-                               &clone->functions_with_model,
-                               emap,
-                               false);
+    clone_node_ptr_stack_by_id (clone,
+                                &btor->functions_with_model,
+                                &clone->functions_with_model,
+                                false);
     BTORLOG (2,
              "  clone functions_with_model: %.3f s",
              btor_util_time_stamp () - delta);
@@ -1333,7 +1401,7 @@ clone_aux_btor (Btor *btor,
   }
 
   BTORLOG_TIMESTAMP (delta);
-  btor_clone_node_ptr_stack (mm, &btor->outputs, &clone->outputs, emap, false);
+  clone_node_ptr_stack_by_id (clone, &btor->outputs, &clone->outputs, false);
   BTORLOG (2, "  clone outputs: %.3f s", btor_util_time_stamp () - delta);
   assert ((allocated += BTOR_SIZE_STACK (btor->outputs) * sizeof (BtorNode *))
           == clone->mm->allocated);
@@ -1342,10 +1410,10 @@ clone_aux_btor (Btor *btor,
   clone->parameterized =
       btor_hashptr_table_clone (mm,
                                 btor->parameterized,
-                                btor_clone_key_as_node,
+                                clone_key_as_node_by_id,
                                 btor_clone_data_as_int_htable,
-                                emap,
-                                emap);
+                                clone,
+                                clone);
   BTORLOG (2,
            "  clone parameterized table: %.3f s",
            (btor_util_time_stamp () - delta));
@@ -1419,6 +1487,8 @@ clone_aux_btor (Btor *btor,
 
       allocated += MEM_PTR_HASH_TABLE (slv->lemmas);
       allocated += BTOR_SIZE_STACK (slv->cur_lemmas) * sizeof (BtorNode *);
+      CHKCLONE_MEM_INT_HASH_MAP (slv->lemma_db, cslv->lemma_db);
+      allocated += MEM_INT_HASH_MAP (slv->lemma_db) + slv->lemma_db_bytes;
 
       if (slv->score)
       {
@@ -1545,7 +1615,7 @@ clone_aux_btor (Btor *btor,
 
   if (exp_map)
     *exp_map = emap;
-  else
+  else if (emap)
     btor_nodemap_delete (emap);
 
 #ifndef NDEBUG
@@ -77,6 +77,9 @@
        ? btor_aigvec_not ((btor)->avmgr, btor_node_real_addr (exp)->av) \
        : btor_aigvec_copy ((btor)->avmgr, exp->av))
 
+/* minimum number of unused AIG ids before AIG ids are compacted */
+#define BTOR_AIG_GC_MIN_DEAD_IDS 10000
+
 /*------------------------------------------------------------------------*/
 
 static BtorAIG *exp_to_aig (Btor *, BtorNode *);
@@ -568,6 +571,12 @@ btor_print_stats (Btor *btor)
             1,
             "  %7lld CNF literals",
             btor->avmgr ? btor->avmgr->amgr->num_cnf_literals : 0);
+  BTOR_MSG (btor->msg,
+            1,
+            "  %7lld AIG id compactions (%lld ids, %lld bytes reclaimed)",
+            btor->avmgr ? btor->avmgr->amgr->num_gcs : 0,
+            btor->avmgr ? btor->avmgr->amgr->num_gc_ids : 0,
+            btor->avmgr ? btor->avmgr->amgr->num_gc_bytes : 0);
 
   if (btor->slv) btor->slv->api.print_stats (btor->slv);
 
@@ -662,6 +671,10 @@ btor_print_stats (Btor *btor)
   if (btor->slv) btor->slv->api.print_time_stats (btor->slv);
 #endif
 
+#ifdef BTOR_PERF_COUNTERS
+  btor_perf_print_stats (btor);
+#endif
+
   BTOR_MSG (btor->msg, 1, "");
   BTOR_MSG (
       btor->msg, 1, "%.1f MB", btor->mm->maxallocated / (double) (1 << 20));
@@ -763,9 +776,7 @@ btor_new (void)
                               (BtorHashPtr) btor_node_hash_by_id,
                               (BtorCmpPtr) btor_node_compare_by_id);
 
-  BTOR_INIT_STACK (mm, btor->assertions);
-  BTOR_INIT_STACK (mm, btor->assertions_trail);
-  btor->assertions_cache = btor_hashint_table_new (mm);
+  BTOR_INIT_STACK (mm, btor->activation_lits);
 
 #ifndef NDEBUG
   btor->stats.rw_rules_applied = btor_hashptr_table_new (
@@ -801,6 +812,8 @@ btor_terminate (Btor *btor)
 {
   assert (btor);
 
+  /* does not set 'cbs.term.done', the next btor_check_sat call resumes */
+  if (btor_budget_exhausted (btor)) return 1;
   if (btor->cbs.term.termfun) return btor->cbs.term.termfun (btor);
   return 0;
 }
@@ -902,6 +915,11 @@ btor_delete (Btor *btor)
 
   if (btor->slv) btor->slv->api.delet (btor->slv);
 
+  btor_profile_delete (btor);
+#ifdef BTOR_PERF_COUNTERS
+  btor_perf_delete (btor);
+#endif
+
   if (btor->parse_error_msg) btor_mem_freestr (mm, btor->parse_error_msg);
 
   btor_ass_delete_bv_list (
@@ -937,11 +955,9 @@ btor_delete (Btor *btor)
   }
   BTOR_RELEASE_STACK (btor->failed_assumptions);
 
-  for (i = 0; i < BTOR_COUNT_STACK (btor->assertions); i++)
-    btor_node_release (btor, BTOR_PEEK_STACK (btor->assertions, i));
-  BTOR_RELEASE_STACK (btor->assertions);
-  BTOR_RELEASE_STACK (btor->assertions_trail);
-  btor_hashint_table_delete (btor->assertions_cache);
+  for (i = 0; i < BTOR_COUNT_STACK (btor->activation_lits); i++)
+    btor_node_release (btor, BTOR_PEEK_STACK (btor->activation_lits, i));
+  BTOR_RELEASE_STACK (btor->activation_lits);
 
   btor_model_delete (btor);
   btor_node_release (btor, btor->true_exp);
@@ -1811,7 +1827,7 @@ exp_to_cnf_lit (Btor *btor, BtorNode *exp)
       sign *= -1;
     }
 
-    if (!aig->cnf_id) btor_aig_to_sat_tseitin (amgr, aig);
+    btor_aig_to_sat_tseitin (amgr, aig);
 
     res = aig->cnf_id;
     btor_aig_release (amgr, aig);
@@ -2014,13 +2030,27 @@ btor_fixate_assumptions (Btor *btor)
   BtorNode *exp;
   BtorNodePtrStack stack;
   BtorPtrHashTableIterator it;
+  BtorIntHashTable *activation_lits;
   size_t i;
 
+  /* activation literals of open contexts are assumed by btor_check_sat and
+   * must not be fixated */
+  activation_lits = btor_hashint_table_new (btor->mm);
+  for (i = 0; i < BTOR_COUNT_STACK (btor->activation_lits); i++)
+    btor_hashint_table_add (
+        activation_lits,
+        btor_node_get_id (BTOR_PEEK_STACK (btor->activation_lits, i)));
+
   BTOR_INIT_STACK (btor->mm, stack);
   btor_iter_hashptr_init (&it, btor->assumptions);
   while (btor_iter_hashptr_has_next (&it))
-    BTOR_PUSH_STACK (stack,
-                     btor_node_copy (btor, btor_iter_hashptr_next (&it)));
+  {
+    exp = btor_iter_hashptr_next (&it);
+    if (btor_hashint_table_contains (activation_lits, btor_node_get_id (exp)))
+      continue;
+    BTOR_PUSH_STACK (stack, btor_node_copy (btor, exp));
+  }
+  btor_hashint_table_delete (activation_lits);
   for (i = 0; i < BTOR_COUNT_STACK (stack); i++)
   {
     exp = BTOR_PEEK_STACK (stack, i);
@@ -2466,8 +2496,10 @@ btor_substitute_node (Btor *btor,
 
 /*------------------------------------------------------------------------*/
 
-/* bit vector skeleton is always encoded, i.e., if btor_node_is_synth is true,
- * then it is also encoded. with option lazy_synthesize enabled,
+/* inputs of the bit vector skeleton are always encoded, i.e., if
+ * btor_node_is_synth is true for a bv var, apply or feq node, then it is also
+ * encoded.  all other AIGs are encoded on demand, in the polarities in which
+ * they occur in constraints.  with option lazy_synthesize enabled,
  * 'btor_synthesize_exp' stops at feq and apply nodes */
 void
 btor_synthesize_exp (Btor *btor,
@@ -2497,6 +2529,7 @@ btor_synthesize_exp (Btor *btor,
   assert (exp);
 
   start          = btor_util_time_stamp ();
+  BTOR_PERF_BEGIN (btor, BTOR_PERF_SYNTH_EXP);
   mm             = btor->mm;
   avmgr          = btor->avmgr;
   count          = 0;
@@ -2702,7 +2735,6 @@ btor_synthesize_exp (Btor *btor,
           if (invert_av0) btor_aigvec_invert (avmgr, av0);
           if (invert_av1) btor_aigvec_invert (avmgr, av1);
         }
-        if (!opt_lazy_synth) btor_aigvec_to_sat_tseitin (avmgr, cur->av);
       }
       else
       {
@@ -2751,7 +2783,6 @@ btor_synthesize_exp (Btor *btor,
       }
       assert (cur->av);
       BTORLOG (2, "  synthesized: %s", btor_util_node2string (cur));
-      btor_aigvec_to_sat_tseitin (avmgr, cur->av);
     }
   }
   BTOR_RELEASE_STACK (exp_stack);
@@ -2761,6 +2792,7 @@ btor_synthesize_exp (Btor *btor,
     BTOR_MSG (
         btor->msg, 3, "synthesized %u expressions into AIG vectors", count);
 
+  BTOR_PERF_END (btor, BTOR_PERF_SYNTH_EXP);
   btor->time.synth_exp += btor_util_time_stamp () - start;
 }
 
@@ -2870,6 +2902,39 @@ update_sat_assignments (Btor * btor)
 }
 #endif
 
+/* Compact AIG ids if enough AIGs were deleted since the last compaction
+ * (e.g., by rebuilding simplified expressions).  AIG ids are not compacted
+ * while the SAT manager is attached to a clause bus, which maps clauses via
+ * AIG ids. */
+static void
+gc_aigs (Btor *btor)
+{
+  assert (btor);
+
+  BtorAIGMgr *amgr;
+  uint32_t perc;
+  size_t dead, count;
+  double start;
+
+  if (!btor->avmgr) return;
+  if (!(perc = btor_opt_get (btor, BTOR_OPT_AIG_GC))) return;
+  amgr = btor_get_aig_mgr (btor);
+  if (amgr->smgr->share.state) return;
+
+  dead  = btor_aig_mgr_num_dead_ids (amgr);
+  count = BTOR_COUNT_STACK (amgr->id2aig);
+  if (dead < BTOR_AIG_GC_MIN_DEAD_IDS || 100 * dead < perc * count) return;
+
+  start = btor_util_time_stamp ();
+  btor_aig_mgr_gc (amgr);
+  BTOR_MSG (btor->msg,
+            1,
+            "compacted %zu of %zu AIG ids in %.2f seconds",
+            dead,
+            count,
+            btor_util_time_stamp () - start);
+}
+
 int32_t
 btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
 {
@@ -2890,17 +2955,20 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
 
   if (btor->valid_assignments == 1) btor_reset_incremental_usage (btor);
 
-  /* 'btor->assertions' contains all assertions that were asserted in context
-   * levels > 0 (boolector_push). We assume all these assertions on every
-   * btor_check_sat call since these assumptions are valid until the
-   * corresponding context is popped. */
-  if (BTOR_COUNT_STACK (btor->assertions) > 0)
+  btor_budget_start (btor);
+  btor_profile_check_sat_begin (btor);
+
+  /* Assertions in context levels > 0 (boolector_push) are guarded by the
+   * activation literal of their context.  We assume the activation literals
+   * of all open contexts on every btor_check_sat call (independent of the
+   * number of assertions).  Activation literals of popped contexts are
+   * asserted to false (see boolector_pop). */
+  if (BTOR_COUNT_STACK (btor->activation_lits) > 0)
   {
-    assert (BTOR_COUNT_STACK (btor->assertions_trail) > 0);
     uint32_t i;
-    for (i = 0; i < BTOR_COUNT_STACK (btor->assertions); i++)
+    for (i = 0; i < BTOR_COUNT_STACK (btor->activation_lits); i++)
     {
-      btor_assume_exp (btor, BTOR_PEEK_STACK (btor->assertions, i));
+      btor_assume_exp (btor, BTOR_PEEK_STACK (btor->activation_lits, i));
     }
   }
 
@@ -2921,6 +2989,8 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
     btor_opt_set (uclone, BTOR_OPT_CHK_UNCONSTRAINED, 0);
     btor_opt_set (uclone, BTOR_OPT_CHK_MODEL, 0);
     btor_opt_set (uclone, BTOR_OPT_CHK_FAILED_ASSUMPTIONS, 0);
+    btor_opt_set (uclone, BTOR_OPT_BUDGET_TIME, 0);
+    btor_opt_set (uclone, BTOR_OPT_BUDGET_MEM, 0);
     btor_set_term (uclone, 0, 0);
 
     btor_opt_set (uclone, BTOR_OPT_ENGINE, BTOR_ENGINE_FUN);
@@ -2969,10 +3039,20 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
     btor_opt_set (btor, BTOR_OPT_BETA_REDUCE, BTOR_BETA_REDUCE_ALL);
   }
 
+  btor_profile_begin (btor, "simplify");
   res = btor_simplify (btor);
+  btor_profile_end (btor);
 
-  if (res != BTOR_RESULT_UNSAT)
+  if (res != BTOR_RESULT_UNSAT && btor_budget_exhausted (btor))
   {
+    res = BTOR_RESULT_UNKNOWN;
+  }
+  else if (res != BTOR_RESULT_UNSAT)
+  {
+    btor_profile_begin (btor, "aig_gc");
+    gc_aigs (btor);
+    btor_profile_end (btor);
+
     engine = btor_opt_get (btor, BTOR_OPT_ENGINE);
 
     if (!btor->slv)
@@ -3014,7 +3094,7 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
         btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
         while (btor_iter_hashptr_has_next (&it))
         {
-          cur = btor_iter_hashptr_next (&it);
+          cur = btor_node_real_addr (btor_iter_hashptr_next (&it));
           BTOR_ABORT (cur->lambda_below || cur->apply_below,
                       "quantifiers with functions not supported yet");
         }
@@ -3030,14 +3110,18 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
     }
 
     assert (btor->slv);
+    btor_profile_begin (btor, "solve");
     res = btor->slv->api.sat (btor->slv);
+    btor_profile_end (btor);
   }
+  btor_budget_stop (btor);
   btor->last_sat_result = res;
   btor->btor_sat_btor_called++;
   btor->valid_assignments = 1;
 
   if (btor_opt_get (btor, BTOR_OPT_MODEL_GEN) && res == BTOR_RESULT_SAT)
   {
+    btor_profile_begin (btor, "model_gen");
     switch (btor_opt_get (btor, BTOR_OPT_ENGINE))
     {
       case BTOR_ENGINE_SLS:
@@ -3050,6 +3134,7 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
         btor->slv->api.generate_model (
             btor->slv, btor_opt_get (btor, BTOR_OPT_MODEL_GEN) == 2, true);
     }
+    btor_profile_end (btor);
   }
 
 #ifndef NDEBUG
@@ -3060,7 +3145,7 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
     assert (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL));
     assert (!btor_opt_get (btor, BTOR_OPT_MODEL_GEN));
     BtorSolverResult ucres = btor_check_sat (uclone, -1, -1);
-    assert (res == ucres);
+    assert (res == ucres || res == BTOR_RESULT_UNKNOWN);
     btor_delete (uclone);
   }
 
@@ -3080,6 +3165,8 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
     btor_check_failed_assumptions (btor);
 #endif
 
+  btor_profile_check_sat_end (btor);
+
   delta = btor_util_time_stamp () - start;
 
   BTOR_MSG (btor->msg,
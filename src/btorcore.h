@@ -10,9 +10,12 @@
 #define BTORCORE_H_INCLUDED
 
 #include "btorass.h"
+#include "btorbudget.h"
 #include "btormsg.h"
 #include "btornode.h"
 #include "btoropt.h"
+#include "btorperf.h"
+#include "btorprofile.h"
 #include "btorrwcache.h"
 #include "btorsat.h"
 #include "btorslv.h"
@@ -148,15 +151,16 @@ struct Btor
    * this stack is needed for boolector_get_failed_assumptions only */
   BtorNodePtrStack failed_assumptions;
 
-  /* maintain assertions for different contexts push/pop */
-  BtorNodePtrStack assertions;
-  /* caches the assertions on stack 'assertions' */
-  BtorIntHashTable *assertions_cache;
-  /* saves the number of assertions on each push */
-  BtorUIntStack assertions_trail;
+  /* activation literals of the contexts created via push (one per context
+   * level), assertions in a context are guarded by its activation literal */
+  BtorNodePtrStack activation_lits;
   /* Number of push/pop calls (used for unique symbol prefixes) */
   uint32_t num_push_pop;
 
+  BtorBudget budget; /* resource budget of current btor_check_sat call */
+  BtorProfile *profile; /* phase profile (BTOR_OPT_PROFILE) */
+  BtorPerf *perf; /* hardware performance counters (BTOR_PERF_COUNTERS) */
+
 #ifndef NDEBUG
   Btor *clone; /* shadow clone (debugging only) */
 #endif
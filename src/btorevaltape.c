@@ -0,0 +1,578 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btorevaltape.h"
+
+#include "btorcore.h"
+#include "btornode.h"
+#include "utils/btorhashint.h"
+#include "utils/btorstack.h"
+
+/*------------------------------------------------------------------------*/
+
+enum BtorEvalTapeOp
+{
+  BTOR_EVALTAPE_OP_NOT,
+  BTOR_EVALTAPE_OP_SLICE,
+  BTOR_EVALTAPE_OP_AND,
+  BTOR_EVALTAPE_OP_EQ,
+  BTOR_EVALTAPE_OP_ADD,
+  BTOR_EVALTAPE_OP_MUL,
+  BTOR_EVALTAPE_OP_ULT,
+  BTOR_EVALTAPE_OP_SLL,
+  BTOR_EVALTAPE_OP_SRL,
+  BTOR_EVALTAPE_OP_UDIV,
+  BTOR_EVALTAPE_OP_UREM,
+  BTOR_EVALTAPE_OP_CONCAT,
+  BTOR_EVALTAPE_OP_COND,
+};
+
+typedef enum BtorEvalTapeOp BtorEvalTapeOp;
+
+/* Instruction 'dst := op (arg[0], ..., arg[arity - 1])' over registers. */
+struct BtorEvalTapeInstr
+{
+  BtorEvalTapeOp op;
+  uint32_t dst;
+  uint32_t arg[3];
+  uint32_t upper; /* slice only */
+  uint32_t lower; /* slice only */
+};
+
+typedef struct BtorEvalTapeInstr BtorEvalTapeInstr;
+
+BTOR_DECLARE_STACK (BtorEvalTapeInstr, BtorEvalTapeInstr);
+
+struct BtorEvalTape
+{
+  Btor *btor;
+  BtorEvalTapeInstrStack instrs; /* topologically ordered instructions */
+  BtorBitVectorPtrStack regs;    /* register slots */
+  BtorNodePtrStack inputs;       /* input nodes */
+  BtorUIntStack input_regs;      /* register of input i */
+  BtorUIntStack result_regs;     /* register of root i */
+  BtorUIntStack widths;          /* bit-width of register i */
+  BtorUIntStack const_regs;      /* registers holding constants */
+  uint32_t max_width;            /* maximum bit-width of all registers */
+
+  /* packed evaluation */
+  const uint64_t **pregs; /* packed register slots */
+  uint64_t *pbuf;         /* storage of packed non-input register slots */
+  uint32_t pbuf_n;        /* number of assignments 'pbuf' was allocated for */
+};
+
+/*------------------------------------------------------------------------*/
+
+static bool
+is_op_kind (BtorNodeKind kind)
+{
+  switch (kind)
+  {
+    case BTOR_BV_SLICE_NODE:
+    case BTOR_BV_AND_NODE:
+    case BTOR_BV_EQ_NODE:
+    case BTOR_BV_ADD_NODE:
+    case BTOR_BV_MUL_NODE:
+    case BTOR_BV_ULT_NODE:
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+    case BTOR_BV_UDIV_NODE:
+    case BTOR_BV_UREM_NODE:
+    case BTOR_BV_CONCAT_NODE:
+    case BTOR_COND_NODE:
+    case BTOR_FORALL_NODE:
+    case BTOR_EXISTS_NODE: return true;
+    default: return false;
+  }
+}
+
+static BtorEvalTapeOp
+get_op (BtorNodeKind kind)
+{
+  switch (kind)
+  {
+    case BTOR_BV_SLICE_NODE: return BTOR_EVALTAPE_OP_SLICE;
+    case BTOR_BV_AND_NODE: return BTOR_EVALTAPE_OP_AND;
+    case BTOR_BV_EQ_NODE: return BTOR_EVALTAPE_OP_EQ;
+    case BTOR_BV_ADD_NODE: return BTOR_EVALTAPE_OP_ADD;
+    case BTOR_BV_MUL_NODE: return BTOR_EVALTAPE_OP_MUL;
+    case BTOR_BV_ULT_NODE: return BTOR_EVALTAPE_OP_ULT;
+    case BTOR_BV_SLL_NODE: return BTOR_EVALTAPE_OP_SLL;
+    case BTOR_BV_SRL_NODE: return BTOR_EVALTAPE_OP_SRL;
+    case BTOR_BV_UDIV_NODE: return BTOR_EVALTAPE_OP_UDIV;
+    case BTOR_BV_UREM_NODE: return BTOR_EVALTAPE_OP_UREM;
+    case BTOR_BV_CONCAT_NODE: return BTOR_EVALTAPE_OP_CONCAT;
+    default: assert (kind == BTOR_COND_NODE); return BTOR_EVALTAPE_OP_COND;
+  }
+}
+
+static uint32_t
+new_reg (BtorEvalTape *tape, BtorBitVector *bv, uint32_t width)
+{
+  BTOR_PUSH_STACK (tape->regs, bv);
+  BTOR_PUSH_STACK (tape->widths, width);
+  if (width > tape->max_width) tape->max_width = width;
+  return BTOR_COUNT_STACK (tape->regs) - 1;
+}
+
+/* Get register of (possibly inverted) 'exp', which is created on demand
+ * for inverted nodes. */
+static uint32_t
+get_reg (BtorEvalTape *tape, BtorIntHashTable *regs, BtorNode *exp)
+{
+  int32_t id;
+  BtorHashTableData *d;
+  BtorEvalTapeInstr instr;
+
+  id = btor_node_get_id (exp);
+  d  = btor_hashint_map_get (regs, id);
+  if (d) return d->as_int;
+
+  assert (btor_node_is_inverted (exp));
+  d = btor_hashint_map_get (regs, -id);
+  assert (d);
+
+  memset (&instr, 0, sizeof (instr));
+  instr.op     = BTOR_EVALTAPE_OP_NOT;
+  instr.arg[0] = d->as_int;
+  instr.dst    = new_reg (tape, 0, BTOR_PEEK_STACK (tape->widths, d->as_int));
+  BTOR_PUSH_STACK (tape->instrs, instr);
+  btor_hashint_map_add (regs, id)->as_int = instr.dst;
+  return instr.dst;
+}
+
+BtorEvalTape *
+btor_evaltape_new (Btor *btor, BtorNode *roots[], uint32_t nroots)
+{
+  assert (btor);
+  assert (roots);
+  assert (nroots > 0);
+
+  uint32_t i, reg;
+  int32_t j;
+  BtorEvalTape *tape;
+  BtorEvalTapeInstr instr;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+  BtorIntHashTable *regs, *mark;
+  BtorMemMgr *mm;
+
+  mm = btor->mm;
+  BTOR_CNEW (mm, tape);
+  tape->btor = btor;
+  BTOR_INIT_STACK (mm, tape->instrs);
+  BTOR_INIT_STACK (mm, tape->regs);
+  BTOR_INIT_STACK (mm, tape->inputs);
+  BTOR_INIT_STACK (mm, tape->input_regs);
+  BTOR_INIT_STACK (mm, tape->result_regs);
+  BTOR_INIT_STACK (mm, tape->widths);
+  BTOR_INIT_STACK (mm, tape->const_regs);
+
+  regs = btor_hashint_map_new (mm);
+  mark = btor_hashint_table_new (mm);
+  BTOR_INIT_STACK (mm, visit);
+  for (i = 0; i < nroots; i++)
+    BTOR_PUSH_STACK (visit, btor_node_real_addr (roots[i]));
+
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = BTOR_POP_STACK (visit);
+    assert (!btor_node_is_inverted (cur));
+
+    if (btor_hashint_map_contains (regs, cur->id)) continue;
+
+    if (!btor_hashint_table_contains (mark, cur->id))
+    {
+      btor_hashint_table_add (mark, cur->id);
+
+      if (btor_node_is_bv_const (cur))
+      {
+        reg = new_reg (tape,
+                       btor_bv_copy (mm, btor_node_bv_const_get_bits (cur)),
+                       btor_node_bv_get_width (btor, cur));
+        btor_hashint_map_add (regs, cur->id)->as_int = reg;
+        BTOR_PUSH_STACK (tape->const_regs, reg);
+      }
+      else if (!is_op_kind (cur->kind))
+      {
+        reg = new_reg (tape, 0, btor_node_bv_get_width (btor, cur));
+        btor_hashint_map_add (regs, cur->id)->as_int = reg;
+        BTOR_PUSH_STACK (tape->inputs, btor_node_copy (btor, cur));
+        BTOR_PUSH_STACK (tape->input_regs, reg);
+      }
+      else
+      {
+        BTOR_PUSH_STACK (visit, cur);
+        /* the value of a quantifier is the value of its body */
+        if (btor_node_is_quantifier (cur))
+          BTOR_PUSH_STACK (visit, btor_node_real_addr (cur->e[1]));
+        else
+          for (j = cur->arity - 1; j >= 0; j--)
+            BTOR_PUSH_STACK (visit, btor_node_real_addr (cur->e[j]));
+      }
+    }
+    else if (btor_node_is_quantifier (cur))
+    {
+      reg = get_reg (tape, regs, cur->e[1]);
+      btor_hashint_map_add (regs, cur->id)->as_int = reg;
+    }
+    else
+    {
+      memset (&instr, 0, sizeof (instr));
+      instr.op = get_op (cur->kind);
+      for (j = 0; j < cur->arity; j++)
+        instr.arg[j] = get_reg (tape, regs, cur->e[j]);
+      if (btor_node_is_bv_slice (cur))
+      {
+        instr.upper = btor_node_bv_slice_get_upper (cur);
+        instr.lower = btor_node_bv_slice_get_lower (cur);
+      }
+      instr.dst = new_reg (tape, 0, btor_node_bv_get_width (btor, cur));
+      BTOR_PUSH_STACK (tape->instrs, instr);
+      btor_hashint_map_add (regs, cur->id)->as_int = instr.dst;
+    }
+  }
+
+  for (i = 0; i < nroots; i++)
+    BTOR_PUSH_STACK (tape->result_regs, get_reg (tape, regs, roots[i]));
+
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_table_delete (mark);
+  btor_hashint_map_delete (regs);
+  return tape;
+}
+
+void
+btor_evaltape_delete (BtorEvalTape *tape)
+{
+  assert (tape);
+
+  uint32_t i, nregs;
+  Btor *btor;
+  BtorMemMgr *mm;
+
+  btor  = tape->btor;
+  mm    = btor->mm;
+  nregs = BTOR_COUNT_STACK (tape->regs);
+
+  for (i = 0; i < nregs; i++)
+  {
+    if (!BTOR_PEEK_STACK (tape->regs, i)) continue;
+    btor_bv_free (mm, BTOR_PEEK_STACK (tape->regs, i));
+  }
+  for (i = 0; i < BTOR_COUNT_STACK (tape->inputs); i++)
+    btor_node_release (btor, BTOR_PEEK_STACK (tape->inputs, i));
+
+  BTOR_RELEASE_STACK (tape->instrs);
+  BTOR_RELEASE_STACK (tape->regs);
+  BTOR_RELEASE_STACK (tape->inputs);
+  BTOR_RELEASE_STACK (tape->input_regs);
+  BTOR_RELEASE_STACK (tape->result_regs);
+  if (tape->pregs) BTOR_DELETEN (mm, tape->pregs, nregs);
+  if (tape->pbuf) BTOR_DELETEN (mm, tape->pbuf, (size_t) tape->pbuf_n * nregs);
+  BTOR_RELEASE_STACK (tape->widths);
+  BTOR_RELEASE_STACK (tape->const_regs);
+  BTOR_DELETE (mm, tape);
+}
+
+uint32_t
+btor_evaltape_get_num_inputs (const BtorEvalTape *tape)
+{
+  assert (tape);
+  return BTOR_COUNT_STACK (tape->inputs);
+}
+
+BtorNode *
+btor_evaltape_get_input (const BtorEvalTape *tape, uint32_t idx)
+{
+  assert (tape);
+  assert (idx < BTOR_COUNT_STACK (tape->inputs));
+  return BTOR_PEEK_STACK (tape->inputs, idx);
+}
+
+void
+btor_evaltape_set_input (BtorEvalTape *tape,
+                         uint32_t idx,
+                         const BtorBitVector *bv)
+{
+  assert (tape);
+  assert (idx < BTOR_COUNT_STACK (tape->inputs));
+  assert (bv);
+  assert (btor_bv_get_width (bv)
+          == btor_node_bv_get_width (tape->btor,
+                                     BTOR_PEEK_STACK (tape->inputs, idx)));
+
+  uint32_t reg;
+  BtorMemMgr *mm;
+
+  mm  = tape->btor->mm;
+  reg = BTOR_PEEK_STACK (tape->input_regs, idx);
+  if (tape->regs.start[reg]) btor_bv_free (mm, tape->regs.start[reg]);
+  tape->regs.start[reg] = btor_bv_copy (mm, bv);
+}
+
+void
+btor_evaltape_run (BtorEvalTape *tape)
+{
+  assert (tape);
+
+  uint32_t i;
+  BtorEvalTapeInstr *instr;
+  BtorBitVector **regs, *result;
+  BtorMemMgr *mm;
+
+  mm   = tape->btor->mm;
+  regs = tape->regs.start;
+
+#ifndef NDEBUG
+  for (i = 0; i < BTOR_COUNT_STACK (tape->input_regs); i++)
+    assert (regs[BTOR_PEEK_STACK (tape->input_regs, i)]);
+#endif
+
+  for (i = 0; i < BTOR_COUNT_STACK (tape->instrs); i++)
+  {
+    instr = tape->instrs.start + i;
+    switch (instr->op)
+    {
+      case BTOR_EVALTAPE_OP_NOT:
+        result = btor_bv_not (mm, regs[instr->arg[0]]);
+        break;
+
+      case BTOR_EVALTAPE_OP_SLICE:
+        result = btor_bv_slice (
+            mm, regs[instr->arg[0]], instr->upper, instr->lower);
+        break;
+
+      case BTOR_EVALTAPE_OP_AND:
+        result = btor_bv_and (mm, regs[instr->arg[0]], regs[instr->arg[1]]);
+        break;
+
+      case BTOR_EVALTAPE_OP_EQ:
+        result = btor_bv_eq (mm, regs[instr->arg[0]], regs[instr->arg[1]]);
+        break;
+
+      case BTOR_EVALTAPE_OP_ADD:
+        result = btor_bv_add (mm, regs[instr->arg[0]], regs[instr->arg[1]]);
+        break;
+
+      case BTOR_EVALTAPE_OP_MUL:
+        result = btor_bv_mul (mm, regs[instr->arg[0]], regs[instr->arg[1]]);
+        break;
+
+      case BTOR_EVALTAPE_OP_ULT:
+        result = btor_bv_ult (mm, regs[instr->arg[0]], regs[instr->arg[1]]);
+        break;
+
+      case BTOR_EVALTAPE_OP_SLL:
+        result = btor_bv_sll (mm, regs[instr->arg[0]], regs[instr->arg[1]]);
+        break;
+
+      case BTOR_EVALTAPE_OP_SRL:
+        result = btor_bv_srl (mm, regs[instr->arg[0]], regs[instr->arg[1]]);
+        break;
+
+      case BTOR_EVALTAPE_OP_UDIV:
+        result = btor_bv_udiv (mm, regs[instr->arg[0]], regs[instr->arg[1]]);
+        break;
+
+      case BTOR_EVALTAPE_OP_UREM:
+        result = btor_bv_urem (mm, regs[instr->arg[0]], regs[instr->arg[1]]);
+        break;
+
+      case BTOR_EVALTAPE_OP_CONCAT:
+        result = btor_bv_concat (mm, regs[instr->arg[0]], regs[instr->arg[1]]);
+        break;
+
+      default:
+        assert (instr->op == BTOR_EVALTAPE_OP_COND);
+        if (btor_bv_is_true (regs[instr->arg[0]]))
+          result = btor_bv_copy (mm, regs[instr->arg[1]]);
+        else
+          result = btor_bv_copy (mm, regs[instr->arg[2]]);
+    }
+
+    if (regs[instr->dst]) btor_bv_free (mm, regs[instr->dst]);
+    regs[instr->dst] = result;
+  }
+}
+
+const BtorBitVector *
+btor_evaltape_get_result (const BtorEvalTape *tape, uint32_t idx)
+{
+  assert (tape);
+  assert (idx < BTOR_COUNT_STACK (tape->result_regs));
+  assert (tape->regs.start[BTOR_PEEK_STACK (tape->result_regs, idx)]);
+  return tape->regs.start[BTOR_PEEK_STACK (tape->result_regs, idx)];
+}
+
+/*------------------------------------------------------------------------*/
+
+static inline uint64_t
+get_mask (uint32_t width)
+{
+  assert (width > 0);
+  assert (width <= 64);
+  return width == 64 ? UINT64_MAX : ((uint64_t) 1 << width) - 1;
+}
+
+bool
+btor_evaltape_is_packable (const BtorEvalTape *tape)
+{
+  assert (tape);
+  return tape->max_width <= 64;
+}
+
+void
+btor_evaltape_set_input_packed (BtorEvalTape *tape,
+                                uint32_t idx,
+                                const uint64_t *values)
+{
+  assert (tape);
+  assert (btor_evaltape_is_packable (tape));
+  assert (idx < BTOR_COUNT_STACK (tape->inputs));
+  assert (values);
+
+  if (!tape->pregs)
+    BTOR_CNEWN (tape->btor->mm, tape->pregs, BTOR_COUNT_STACK (tape->regs));
+  tape->pregs[BTOR_PEEK_STACK (tape->input_regs, idx)] = values;
+}
+
+void
+btor_evaltape_prepare_packed (BtorEvalTape *tape, uint32_t n)
+{
+  assert (tape);
+  assert (btor_evaltape_is_packable (tape));
+  assert (n > 0);
+
+  uint32_t i, k, reg, nregs;
+  uint64_t c, *r;
+  BtorMemMgr *mm;
+
+  mm    = tape->btor->mm;
+  nregs = BTOR_COUNT_STACK (tape->regs);
+
+  if (!tape->pregs) BTOR_CNEWN (mm, tape->pregs, nregs);
+
+  /* (re)allocate storage for non-input registers */
+  if (n == tape->pbuf_n) return;
+
+  if (tape->pbuf) BTOR_DELETEN (mm, tape->pbuf, (size_t) tape->pbuf_n * nregs);
+  BTOR_NEWN (mm, tape->pbuf, (size_t) n * nregs);
+  tape->pbuf_n = n;
+  for (i = 0; i < BTOR_COUNT_STACK (tape->const_regs); i++)
+  {
+    reg = BTOR_PEEK_STACK (tape->const_regs, i);
+    r   = tape->pbuf + (size_t) reg * n;
+    c   = btor_bv_to_uint64 (BTOR_PEEK_STACK (tape->regs, reg));
+    for (k = 0; k < n; k++) r[k] = c;
+    tape->pregs[reg] = r;
+  }
+  for (i = 0; i < BTOR_COUNT_STACK (tape->instrs); i++)
+  {
+    reg              = BTOR_PEEK_STACK (tape->instrs, i).dst;
+    tape->pregs[reg] = tape->pbuf + (size_t) reg * n;
+  }
+}
+
+void
+btor_evaltape_run_packed (BtorEvalTape *tape, uint32_t n)
+{
+  assert (tape);
+  assert (btor_evaltape_is_packable (tape));
+  assert (n > 0);
+
+  uint32_t i, k, shift;
+  uint64_t m, *r;
+  const uint64_t *a, *b, *e;
+  BtorEvalTapeInstr *instr;
+
+  btor_evaltape_prepare_packed (tape, n);
+#ifndef NDEBUG
+  for (i = 0; i < BTOR_COUNT_STACK (tape->input_regs); i++)
+    assert (tape->pregs[BTOR_PEEK_STACK (tape->input_regs, i)]);
+#endif
+
+  for (i = 0; i < BTOR_COUNT_STACK (tape->instrs); i++)
+  {
+    instr = tape->instrs.start + i;
+    r     = tape->pbuf + (size_t) instr->dst * n;
+    m     = get_mask (BTOR_PEEK_STACK (tape->widths, instr->dst));
+    a     = tape->pregs[instr->arg[0]];
+    b     = tape->pregs[instr->arg[1]];
+
+    switch (instr->op)
+    {
+      case BTOR_EVALTAPE_OP_NOT:
+        for (k = 0; k < n; k++) r[k] = ~a[k] & m;
+        break;
+
+      case BTOR_EVALTAPE_OP_SLICE:
+        shift = instr->lower;
+        for (k = 0; k < n; k++) r[k] = (a[k] >> shift) & m;
+        break;
+
+      case BTOR_EVALTAPE_OP_AND:
+        for (k = 0; k < n; k++) r[k] = a[k] & b[k];
+        break;
+
+      case BTOR_EVALTAPE_OP_EQ:
+        for (k = 0; k < n; k++) r[k] = a[k] == b[k];
+        break;
+
+      case BTOR_EVALTAPE_OP_ADD:
+        for (k = 0; k < n; k++) r[k] = (a[k] + b[k]) & m;
+        break;
+
+      case BTOR_EVALTAPE_OP_MUL:
+        for (k = 0; k < n; k++) r[k] = (a[k] * b[k]) & m;
+        break;
+
+      case BTOR_EVALTAPE_OP_ULT:
+        for (k = 0; k < n; k++) r[k] = a[k] < b[k];
+        break;
+
+      case BTOR_EVALTAPE_OP_SLL:
+        shift = BTOR_PEEK_STACK (tape->widths, instr->dst);
+        for (k = 0; k < n; k++)
+          r[k] = b[k] >= shift ? 0 : (a[k] << b[k]) & m;
+        break;
+
+      case BTOR_EVALTAPE_OP_SRL:
+        shift = BTOR_PEEK_STACK (tape->widths, instr->dst);
+        for (k = 0; k < n; k++) r[k] = b[k] >= shift ? 0 : a[k] >> b[k];
+        break;
+
+      case BTOR_EVALTAPE_OP_UDIV:
+        for (k = 0; k < n; k++) r[k] = b[k] ? a[k] / b[k] : m;
+        break;
+
+      case BTOR_EVALTAPE_OP_UREM:
+        for (k = 0; k < n; k++) r[k] = b[k] ? a[k] % b[k] : a[k];
+        break;
+
+      case BTOR_EVALTAPE_OP_CONCAT:
+        shift = BTOR_PEEK_STACK (tape->widths, instr->arg[1]);
+        for (k = 0; k < n; k++) r[k] = (a[k] << shift) | b[k];
+        break;
+
+      default:
+        assert (instr->op == BTOR_EVALTAPE_OP_COND);
+        e = tape->pregs[instr->arg[2]];
+        for (k = 0; k < n; k++) r[k] = a[k] ? b[k] : e[k];
+    }
+  }
+}
+
+const uint64_t *
+btor_evaltape_get_result_packed (const BtorEvalTape *tape, uint32_t idx)
+{
+  assert (tape);
+  assert (tape->pregs);
+  assert (idx < BTOR_COUNT_STACK (tape->result_regs));
+  return tape->pregs[BTOR_PEEK_STACK (tape->result_regs, idx)];
+}
@@ -0,0 +1,79 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTOREVALTAPE_H_INCLUDED
+#define BTOREVALTAPE_H_INCLUDED
+
+#include "btorbv.h"
+#include "btortypes.h"
+
+/* Word-level evaluator for a fixed set of bit-vector terms.
+ *
+ * The cones of the given roots are compiled once into a topologically ordered
+ * array of instructions over dense register slots. Leaves that are not
+ * constants (e.g., variables and parameters) are inputs of the tape. After
+ * assigning all inputs, btor_evaltape_run evaluates all instructions in order
+ * and the values of the roots can be queried. Inputs can be reassigned and the
+ * tape rerun arbitrarily often without traversing the DAG again. */
+typedef struct BtorEvalTape BtorEvalTape;
+
+/* Compile the cones of 'roots' into a new evaluation tape. */
+BtorEvalTape *btor_evaltape_new (Btor *btor,
+                                 BtorNode *roots[],
+                                 uint32_t nroots);
+
+/* Delete evaluation tape. */
+void btor_evaltape_delete (BtorEvalTape *tape);
+
+/* Get the number of inputs of 'tape'. */
+uint32_t btor_evaltape_get_num_inputs (const BtorEvalTape *tape);
+
+/* Get the node of input 'idx'. */
+BtorNode *btor_evaltape_get_input (const BtorEvalTape *tape, uint32_t idx);
+
+/* Assign value 'bv' to input 'idx' (the value is copied). */
+void btor_evaltape_set_input (BtorEvalTape *tape,
+                              uint32_t idx,
+                              const BtorBitVector *bv);
+
+/* Evaluate all instructions of 'tape' under the current input assignment. */
+void btor_evaltape_run (BtorEvalTape *tape);
+
+/* Get the value of root 'idx' computed by the last call to
+ * btor_evaltape_run. The value is owned by the tape. */
+const BtorBitVector *btor_evaltape_get_result (const BtorEvalTape *tape,
+                                               uint32_t idx);
+
+/* Packed evaluation: evaluate the tape for 'n' input assignments at once,
+ * where the values of each register are stored in an array of 'n' 64-bit
+ * words. Only applicable if all nodes in the tape are at most 64 bits wide. */
+
+/* Determine if packed evaluation is applicable for 'tape'. */
+bool btor_evaltape_is_packable (const BtorEvalTape *tape);
+
+/* Assign packed values 'values' to input 'idx'. The values are not copied
+ * and must not be freed while the tape is in use. */
+void btor_evaltape_set_input_packed (BtorEvalTape *tape,
+                                     uint32_t idx,
+                                     const uint64_t *values);
+
+/* Allocate the packed register storage of 'tape' for 'n' input assignments.
+ * Called by btor_evaltape_run_packed if necessary. After preparing, running
+ * the tape for 'n' assignments does not allocate memory, which allows to run
+ * prepared tapes concurrently (one thread per tape). */
+void btor_evaltape_prepare_packed (BtorEvalTape *tape, uint32_t n);
+
+/* Evaluate all instructions of 'tape' for 'n' packed input assignments. */
+void btor_evaltape_run_packed (BtorEvalTape *tape, uint32_t n);
+
+/* Get the 'n' packed values of root 'idx' computed by the last call to
+ * btor_evaltape_run_packed. The values are owned by the tape. */
+const uint64_t *btor_evaltape_get_result_packed (const BtorEvalTape *tape,
+                                                 uint32_t idx);
+
+#endif
@@ -76,6 +76,7 @@ enum BtorMainOption
   BTORMAIN_OPT_DUMP_SMT,
   BTORMAIN_OPT_DUMP_AAG,
   BTORMAIN_OPT_DUMP_AIG,
+  BTORMAIN_OPT_DUMP_BTOR_BINARY,
   BTORMAIN_OPT_DUMP_AIGER_MERGE,
   /* this MUST be the last entry! */
   BTORMAIN_OPT_NUM_OPTS,
@@ -370,6 +371,18 @@ btormain_init_opts (BtorMainApp *app)
                      false,
                      BTOR_ARG_EXPECT_NONE,
                      "dump QF_BV formula in binary AIGER format");
+  btormain_init_opt (app,
+                     BTORMAIN_OPT_DUMP_BTOR_BINARY,
+                     true,
+                     true,
+                     "dump-btor-binary",
+                     "dbb",
+                     0,
+                     0,
+                     1,
+                     false,
+                     BTOR_ARG_EXPECT_NONE,
+                     "dump formula in compact binary BTOR format");
   btormain_init_opt (app,
                      BTORMAIN_OPT_DUMP_AIGER_MERGE,
                      true,
@@ -1215,6 +1228,10 @@ boolector_main (int32_t argc, char **argv)
           dump = BTOR_OUTPUT_FORMAT_AIGER_BINARY;
           goto SET_OUTPUT_FORMAT;
 
+        case BTORMAIN_OPT_DUMP_BTOR_BINARY:
+          dump = BTOR_OUTPUT_FORMAT_BTOR_BINARY;
+          goto SET_OUTPUT_FORMAT;
+
         case BTORMAIN_OPT_DUMP_AIGER_MERGE: dump_merge = true; break;
 
         default:
@@ -1526,6 +1543,10 @@ boolector_main (int32_t argc, char **argv)
         if (g_verbosity) btormain_msg ("dumping in ascii AIGER format");
         boolector_dump_aiger_ascii (btor, g_app->outfile, dump_merge);
         break;
+      case BTOR_OUTPUT_FORMAT_BTOR_BINARY:
+        if (g_verbosity) btormain_msg ("dumping in binary BTOR format");
+        boolector_dump_btor_binary (btor, g_app->outfile);
+        break;
       default:
         assert (dump == BTOR_OUTPUT_FORMAT_AIGER_BINARY);
         if (g_verbosity) btormain_msg ("dumping in binary AIGER format");
@@ -1548,7 +1569,9 @@ boolector_main (int32_t argc, char **argv)
     sat_res = parse_res;
 
   assert (boolector_terminate (btor) || sat_res != BOOLECTOR_UNKNOWN
-          || boolector_get_opt (btor, BTOR_OPT_PRINT_DIMACS));
+          || boolector_get_opt (btor, BTOR_OPT_PRINT_DIMACS)
+          || boolector_get_opt (btor, BTOR_OPT_BUDGET_TIME)
+          || boolector_get_opt (btor, BTOR_OPT_BUDGET_MEM));
 
   /* check if status is equal to benchmark status (if provided) */
   if (sat_res == BOOLECTOR_SAT && parse_status == BOOLECTOR_UNSAT)
@@ -10,10 +10,15 @@
 
 #include "boolector.h"
 #include "boolectormc.h"
+#include "btoraig.h"
+#include "btoraigvec.h"
+#include "btorbv.h"
 #include "btorcore.h"
+#include "btormodel.h"
 #include "btormsg.h"
 #include "btornode.h"
 #include "btoropt.h"
+#include "btorsat.h"
 #include "dumper/btordumpbtor.h"
 #include "utils/boolectornodemap.h"
 #include "utils/btorutil.h"
@@ -36,6 +41,10 @@ struct BtorMCModel2ConstMapper
   BtorMC *mc;
 };
 
+typedef struct BtorMCUnroller BtorMCUnroller;
+
+static void unroller_delete (BtorMCUnroller *u);
+
 /*------------------------------------------------------------------------*/
 
 static void
@@ -167,6 +176,34 @@ init_options (BtorMC *mc)
             0,
             1,
             "add simple path constraints");
+  init_opt (mc,
+            BTOR_MC_OPT_PDR,
+            true,
+            "pdr",
+            0,
+            0,
+            0,
+            1,
+            "enable IC3/PDR engine");
+  init_opt (mc,
+            BTOR_MC_OPT_REDUCE,
+            true,
+            "reduce",
+            0,
+            1,
+            0,
+            1,
+            "reduce model to cone of influence, constant and equivalent "
+            "states");
+  init_opt (mc,
+            BTOR_MC_OPT_AIG_UNROLL,
+            true,
+            "aig-unroll",
+            0,
+            0,
+            0,
+            1,
+            "unroll bit-blasted transition relation in BMC");
 }
 
 /*------------------------------------------------------------------------*/
@@ -240,7 +277,9 @@ btor_mc_new (void)
   BTOR_INIT_STACK (mm, res->bad);
   BTOR_INIT_STACK (mm, res->constraints);
   BTOR_INIT_STACK (mm, res->reached);
-  BTOR_INIT_STACK (mm, res->init_assumptions);
+  BTOR_INIT_STACK (mm, res->induction_frames);
+  BTOR_INIT_STACK (mm, res->activation);
+  res->distinct_frames = btor_hashint_table_new (mm);
   init_options (res);
   return res;
 }
@@ -268,31 +307,32 @@ delete_mc_state (BtorMC *mc, BtorMCstate *state)
   boolector_release (btor, state->node);
   if (state->init) boolector_release (btor, state->init);
   if (state->next) boolector_release (btor, state->next);
+  if (state->constant) boolector_release (btor, state->constant);
   BTOR_DELETE (mc->mm, state);
 }
 
 static void
-release_mc_frame_stack (BtorMC *mc, BoolectorNodePtrStack *stack)
+release_mc_frame_stack (Btor *ubtor, BoolectorNodePtrStack *stack)
 {
   BoolectorNode *node;
 
   while (!BTOR_EMPTY_STACK (*stack))
   {
     node = BTOR_POP_STACK (*stack);
-    if (node) boolector_release (mc->forward, node);
+    if (node) boolector_release (ubtor, node);
   }
 
   BTOR_RELEASE_STACK (*stack);
 }
 
 static void
-release_mc_frame (BtorMC *mc, BtorMCFrame *frame)
+release_mc_frame (Btor *ubtor, BtorMCFrame *frame)
 {
-  release_mc_frame_stack (mc, &frame->inputs);
-  release_mc_frame_stack (mc, &frame->init);
-  release_mc_frame_stack (mc, &frame->states);
-  release_mc_frame_stack (mc, &frame->next);
-  release_mc_frame_stack (mc, &frame->bad);
+  release_mc_frame_stack (ubtor, &frame->inputs);
+  release_mc_frame_stack (ubtor, &frame->init);
+  release_mc_frame_stack (ubtor, &frame->states);
+  release_mc_frame_stack (ubtor, &frame->next);
+  release_mc_frame_stack (ubtor, &frame->bad);
 }
 
 void
@@ -317,8 +357,19 @@ btor_mc_delete (BtorMC *mc)
       mc->states->count,
       BTOR_COUNT_STACK (mc->bad),
       BTOR_COUNT_STACK (mc->constraints));
-  for (f = mc->frames.start; f < mc->frames.top; f++) release_mc_frame (mc, f);
+  for (f = mc->frames.start; f < mc->frames.top; f++)
+    release_mc_frame (mc->forward, f);
   BTOR_RELEASE_STACK (mc->frames);
+  for (f = mc->induction_frames.start; f < mc->induction_frames.top; f++)
+    release_mc_frame (mc->induction, f);
+  BTOR_RELEASE_STACK (mc->induction_frames);
+  while (!BTOR_EMPTY_STACK (mc->activation))
+  {
+    BoolectorNode *act = BTOR_POP_STACK (mc->activation);
+    if (act) boolector_release (mc->induction, act);
+  }
+  BTOR_RELEASE_STACK (mc->activation);
+  btor_hashint_table_delete (mc->distinct_frames);
   btor_iter_hashptr_init (&it, mc->inputs);
   while (btor_iter_hashptr_has_next (&it))
     delete_mc_input (mc, btor_iter_hashptr_next_data (&it)->as_ptr);
@@ -334,10 +385,9 @@ btor_mc_delete (BtorMC *mc)
     boolector_release (btor, BTOR_POP_STACK (mc->constraints));
   BTOR_RELEASE_STACK (mc->constraints);
   BTOR_RELEASE_STACK (mc->reached);
-  while (mc->forward && !BTOR_EMPTY_STACK (mc->init_assumptions))
-    boolector_release (mc->forward, BTOR_POP_STACK (mc->init_assumptions));
-  BTOR_RELEASE_STACK (mc->init_assumptions);
   if (mc->forward) boolector_delete (mc->forward);
+  if (mc->induction) boolector_delete (mc->induction);
+  if (mc->unroller) unroller_delete (mc->unroller);
   BTOR_DELETEN (mm, mc->options, BTOR_MC_OPT_NUM_OPTS);
   BTOR_DELETE (mm, mc);
   btor_mem_mgr_delete (mm);
@@ -508,6 +558,9 @@ btor_mc_state (BtorMC *mc, BoolectorSort sort, const char *symbol)
   state->id   = (int32_t) mc->states->count;
   state->node = res;
   state->init = state->next = 0;
+  state->constant = 0;
+  state->repr     = state;
+  state->coi      = true;
   bucket = btor_hashptr_table_add (mc->states, boolector_copy (btor, res));
   assert (bucket);
   assert (!bucket->data.as_ptr);
@@ -715,885 +768,2865 @@ btor_mc_dump (BtorMC *mc, FILE *file)
 
 /*------------------------------------------------------------------------*/
 
-static char *
-timed_symbol (BtorMC *mc, char ch, BoolectorNode *node, int32_t time)
+/* The model is reduced once before it is unrolled:
+ *  - states stuck at a constant in all reachable states are replaced by that
+ *    constant (detected by ternary simulation from the initial states),
+ *  - states with the same constant initial value and the same next state
+ *    function (modulo states already found equivalent) are merged,
+ *  - next state functions of states outside the cone of influence of the
+ *    unreached bad state properties and the constraints are not unrolled.
+ * Constant and merged states are invariants of all reachable states and are
+ * hence also sound for the induction unrolling. */
+
+/* Ternary value, bits set in 'x' are unknown (and zero in 'val'). */
+struct BtorMCTernary
 {
-  assert (mc);
-  assert (node);
-  assert (btor_node_is_regular ((BtorNode *) node));
-  assert (time >= 0);
+  BtorBitVector *val, *x;
+};
 
-  char *res, suffix[20];
-  const char *symbol;
-  uint32_t symlen, reslen;
+typedef struct BtorMCTernary BtorMCTernary;
 
-  symbol = boolector_get_symbol (mc->btor, node);
-  if (!symbol) return 0;
-  sprintf (suffix, "%c%d", ch, time);
-  symlen = strlen (symbol);
-  reslen = symlen + strlen (suffix) + 1;
-  res    = btor_mem_malloc (mc->mm, reslen);
-  (void) strcpy (res, symbol);
-  strcpy (res + symlen, suffix);
+static BtorMCTernary *
+ternary_new (BtorMemMgr *mm, BtorBitVector *val, BtorBitVector *x)
+{
+  BtorMCTernary *res;
+  BtorBitVector *tmp;
+
+  BTOR_NEW (mm, res);
+  tmp      = btor_bv_not (mm, x);
+  res->val = btor_bv_and (mm, val, tmp);
+  res->x   = x;
+  btor_bv_free (mm, tmp);
+  btor_bv_free (mm, val);
   return res;
 }
 
-static BoolectorNode *
-new_var_or_array (BtorMC *mc, BoolectorNode *src, const char *symbol)
+static BtorMCTernary *
+ternary_unknown (BtorMemMgr *mm, uint32_t width)
 {
-  BoolectorNode *dst;
-  BoolectorSort sort;
-  Btor *btor = mc->btor;
-  Btor *fwd  = mc->forward;
+  return ternary_new (mm, btor_bv_new (mm, width), btor_bv_ones (mm, width));
+}
 
-  sort = copy_sort (btor, fwd, src);
-  if (boolector_is_var (btor, src))
-  {
-    dst = boolector_var (fwd, sort, symbol);
-  }
-  else
-  {
-    assert (boolector_is_array (btor, src));
-    dst = boolector_array (fwd, sort, symbol);
-  }
-  boolector_release_sort (fwd, sort);
-  return dst;
+static BtorMCTernary *
+ternary_copy (BtorMemMgr *mm, const BtorMCTernary *t, bool invert)
+{
+  return ternary_new (
+      mm,
+      invert ? btor_bv_not (mm, t->val) : btor_bv_copy (mm, t->val),
+      btor_bv_copy (mm, t->x));
 }
 
 static void
-initialize_inputs_of_frame (BtorMC *mc, BoolectorNodeMap *map, BtorMCFrame *f)
+ternary_delete (BtorMemMgr *mm, BtorMCTernary *t)
 {
-  Btor *btor;
-  BoolectorNode *src, *dst;
-  BtorPtrHashTableIterator it;
-  char *sym;
+  btor_bv_free (mm, t->val);
+  btor_bv_free (mm, t->x);
+  BTOR_DELETE (mm, t);
+}
 
-#ifndef NDEBUG
-  size_t i = 0;
-  BtorMCInput *input;
-#endif
+static bool
+ternary_is_known (const BtorMCTernary *t)
+{
+  return btor_bv_is_zero (t->x);
+}
 
-  btor = mc->btor;
+static bool
+ternary_is_equal (const BtorMCTernary *a, const BtorMCTernary *b)
+{
+  return !btor_bv_compare (a->val, b->val) && !btor_bv_compare (a->x, b->x);
+}
 
-  BTOR_MSG (boolector_get_btor_msg (btor),
-            2,
-            "initializing %u inputs of frame %d",
-            mc->inputs->count,
-            f->time);
+/* Least ternary value that over-approximates both 'a' and 'b'. */
+static BtorMCTernary *
+ternary_join (BtorMemMgr *mm, const BtorMCTernary *a, const BtorMCTernary *b)
+{
+  BtorBitVector *diff, *tmp, *x;
+
+  diff = btor_bv_xor (mm, a->val, b->val);
+  tmp  = btor_bv_or (mm, a->x, b->x);
+  x    = btor_bv_or (mm, tmp, diff);
+  btor_bv_free (mm, tmp);
+  btor_bv_free (mm, diff);
+  return ternary_new (mm, btor_bv_copy (mm, a->val), x);
+}
 
-  BTOR_INIT_STACK (mc->mm, f->inputs);
+/* A bit is a known zero if it is a known zero in 'a' or 'b', and a known one
+ * if it is a known one in both. */
+static BtorMCTernary *
+ternary_and (BtorMemMgr *mm, const BtorMCTernary *a, const BtorMCTernary *b)
+{
+  BtorBitVector *za, *zb, *zero, *tmp, *x;
+
+  tmp = btor_bv_or (mm, a->val, a->x);
+  za  = btor_bv_not (mm, tmp);
+  btor_bv_free (mm, tmp);
+  tmp = btor_bv_or (mm, b->val, b->x);
+  zb  = btor_bv_not (mm, tmp);
+  btor_bv_free (mm, tmp);
+  zero = btor_bv_or (mm, za, zb);
+  btor_bv_free (mm, za);
+  btor_bv_free (mm, zb);
+  tmp = btor_bv_or (mm, a->x, b->x);
+  za  = btor_bv_not (mm, zero);
+  x   = btor_bv_and (mm, tmp, za);
+  btor_bv_free (mm, za);
+  btor_bv_free (mm, tmp);
+  btor_bv_free (mm, zero);
+  return ternary_new (mm, btor_bv_and (mm, a->val, b->val), x);
+}
 
-  btor_iter_hashptr_init (&it, mc->inputs);
-  while (btor_iter_hashptr_has_next (&it))
+/* Known to be false if some bit known in both differs, known to be true if
+ * all bits are known and equal. */
+static BtorMCTernary *
+ternary_eq (BtorMemMgr *mm, const BtorMCTernary *a, const BtorMCTernary *b)
+{
+  BtorBitVector *x, *known, *diff, *tmp;
+  BtorMCTernary *res;
+
+  x     = btor_bv_or (mm, a->x, b->x);
+  known = btor_bv_not (mm, x);
+  tmp   = btor_bv_xor (mm, a->val, b->val);
+  diff  = btor_bv_and (mm, tmp, known);
+  btor_bv_free (mm, tmp);
+  if (!btor_bv_is_zero (diff))
+    res = ternary_new (mm, btor_bv_new (mm, 1), btor_bv_new (mm, 1));
+  else if (btor_bv_is_zero (x))
+    res = ternary_new (mm, btor_bv_one (mm, 1), btor_bv_new (mm, 1));
+  else
+    res = ternary_unknown (mm, 1);
+  btor_bv_free (mm, diff);
+  btor_bv_free (mm, known);
+  btor_bv_free (mm, x);
+  return res;
+}
+
+static BtorMCTernary *
+ternary_slice (BtorMemMgr *mm, const BtorMCTernary *a, BtorNode *slice)
+{
+  uint32_t upper, lower;
+
+  upper = btor_node_bv_slice_get_upper (slice);
+  lower = btor_node_bv_slice_get_lower (slice);
+  return ternary_new (mm,
+                      btor_bv_slice (mm, a->val, upper, lower),
+                      btor_bv_slice (mm, a->x, upper, lower));
+}
+
+/* A known shift moves the unknown bits, the bits shifted in are known. */
+static BtorMCTernary *
+ternary_shift (BtorMemMgr *mm,
+               const BtorMCTernary *a,
+               const BtorMCTernary *b,
+               bool left)
+{
+  if (!ternary_is_known (b))
+    return ternary_unknown (mm, btor_bv_get_width (a->val));
+  if (left)
+    return ternary_new (mm,
+                        btor_bv_sll (mm, a->val, b->val),
+                        btor_bv_sll (mm, a->x, b->val));
+  return ternary_new (
+      mm, btor_bv_srl (mm, a->val, b->val), btor_bv_srl (mm, a->x, b->val));
+}
+
+/* All other operators are only evaluated on known operands. */
+static BtorMCTernary *
+ternary_binary (BtorMemMgr *mm,
+                BtorNodeKind kind,
+                uint32_t width,
+                const BtorMCTernary *a,
+                const BtorMCTernary *b)
+{
+  BtorBitVector *res;
+
+  if (!ternary_is_known (a) || !ternary_is_known (b))
+    return ternary_unknown (mm, width);
+  switch (kind)
   {
-#ifndef NDEBUG
-    input = it.bucket->data.as_ptr;
-    assert (input);
-#endif
-    src = (BoolectorNode *) btor_iter_hashptr_next (&it);
-    assert (src);
-    assert (btor_node_is_regular ((BtorNode *) src));
-#ifndef NDEBUG
-    assert (input->node == src);
-    assert (input->id >= 0);
-    assert ((size_t) input->id == i);
-#endif
-    sym = timed_symbol (mc, '@', src, f->time);
-    dst = new_var_or_array (mc, src, sym);
-    btor_mem_freestr (mc->mm, sym);
-    assert (BTOR_COUNT_STACK (f->inputs) == i++);
-    BTOR_PUSH_STACK (f->inputs, dst);
-    boolector_nodemap_map (map, src, dst);
+    case BTOR_BV_ADD_NODE: res = btor_bv_add (mm, a->val, b->val); break;
+    case BTOR_BV_MUL_NODE: res = btor_bv_mul (mm, a->val, b->val); break;
+    case BTOR_BV_ULT_NODE: res = btor_bv_ult (mm, a->val, b->val); break;
+    case BTOR_BV_UDIV_NODE: res = btor_bv_udiv (mm, a->val, b->val); break;
+    default:
+      assert (kind == BTOR_BV_UREM_NODE);
+      res = btor_bv_urem (mm, a->val, b->val);
   }
+  return ternary_new (mm, res, btor_bv_new (mm, width));
 }
 
-static void
-initialize_states_of_frame (BtorMC *mc, BoolectorNodeMap *map, BtorMCFrame *f)
+static bool
+ternary_is_evaluated (BtorNode *exp)
 {
-  Btor *btor, *fwd;
-  BoolectorNode *src, *dst;
-  BtorPtrHashTableIterator it;
-  BtorMCstate *state;
-  BtorMCFrame *p;
-  char *sym;
-  size_t i;
+  switch (exp->kind)
+  {
+    case BTOR_BV_SLICE_NODE:
+    case BTOR_BV_AND_NODE:
+    case BTOR_BV_EQ_NODE:
+    case BTOR_BV_ADD_NODE:
+    case BTOR_BV_MUL_NODE:
+    case BTOR_BV_ULT_NODE:
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+    case BTOR_BV_UDIV_NODE:
+    case BTOR_BV_UREM_NODE:
+    case BTOR_BV_CONCAT_NODE: return true;
+    case BTOR_COND_NODE: return !btor_node_is_fun (exp);
+    default: return false;
+  }
+}
 
-  assert (mc);
-  assert (f);
-  assert (f->time >= 0);
+/* Evaluates bit-vector expression 'exp' of the model with state values
+ * 'env' (indexed by state id), inputs are unknown. The values of all nodes
+ * visited are cached in 'cache' (owned by it), the result is owned by the
+ * caller. Array reads are unknown. */
+static BtorMCTernary *
+ternary_eval (BtorMC *mc,
+              BtorMCTernary **env,
+              BtorIntHashTable *cache,
+              BoolectorNode *node)
+{
+  BtorMemMgr *mm;
+  BtorNodePtrStack visit;
+  BtorNode *exp, *cur, *child;
+  BtorHashTableData *d;
+  BtorMCTernary *res, *e[3];
+  BtorPtrHashBucket *b;
+  BtorMCstate *state;
+  uint32_t i, width;
+  Btor *btor;
 
+  mm   = mc->mm;
   btor = mc->btor;
-  fwd  = mc->forward;
-
-  BTOR_MSG (boolector_get_btor_msg (btor),
-            2,
-            "initializing %u states in frame %d",
-            mc->states->count,
-            f->time);
-
-  BTOR_INIT_STACK (mc->mm, f->states);
+  exp  = BTOR_IMPORT_BOOLECTOR_NODE (node);
 
-  i = 0;
-  btor_iter_hashptr_init (&it, mc->states);
-  while (btor_iter_hashptr_has_next (&it))
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_PUSH_STACK (visit, btor_node_real_addr (exp));
+  while (!BTOR_EMPTY_STACK (visit))
   {
-    state = it.bucket->data.as_ptr;
-    assert (state);
-    assert (state->id >= 0);
-    assert ((size_t) state->id == i);
-    src = (BoolectorNode *) btor_iter_hashptr_next (&it);
-    assert (src);
-    assert (btor_node_is_regular ((BtorNode *) src));
-    assert (state->node == src);
+    cur = BTOR_POP_STACK (visit);
+    d   = btor_hashint_map_get (cache, cur->id);
+    if (d && d->as_ptr) continue;
 
-    if (!f->time && state->init)
+    if (!d && ternary_is_evaluated (cur))
     {
-      dst = boolector_nodemap_substitute_node (mc->forward, map, state->init);
-      dst = boolector_copy (mc->forward, dst);
-      // special case: const initialization (constant array)
-      if (boolector_is_array (btor, src) && boolector_is_const (btor, state->init))
+      btor_hashint_map_add (cache, cur->id);
+      BTOR_PUSH_STACK (visit, cur);
+      for (i = 0; i < cur->arity; i++)
+        BTOR_PUSH_STACK (visit, btor_node_real_addr (cur->e[i]));
+      continue;
+    }
+
+    width = btor_node_bv_get_width (btor, cur);
+    if (ternary_is_evaluated (cur))
+    {
+      for (i = 0; i < cur->arity; i++)
       {
-        BoolectorSort s    = copy_sort (btor, fwd, src);
-        BoolectorNode *tmp = boolector_const_array (fwd, s, dst);
-        boolector_release_sort (fwd, s);
-        boolector_release (fwd, dst);
-        dst = tmp;
+        child = cur->e[i];
+        d     = btor_hashint_map_get (cache, btor_node_real_addr (child)->id);
+        assert (d);
+        assert (d->as_ptr);
+        e[i] = ternary_copy (mm, d->as_ptr, btor_node_is_inverted (child));
       }
-
-      if (btor_mc_get_opt (mc, BTOR_MC_OPT_KINDUCTION))
+      switch (cur->kind)
       {
-        BoolectorNode *init_expr = dst;
-        dst                      = new_var_or_array (mc, src, 0);
-        BTOR_PUSH_STACK (mc->init_assumptions,
-                         boolector_eq (mc->forward, dst, init_expr));
-        boolector_release (mc->forward, init_expr);
+        case BTOR_BV_SLICE_NODE: res = ternary_slice (mm, e[0], cur); break;
+        case BTOR_BV_AND_NODE: res = ternary_and (mm, e[0], e[1]); break;
+        case BTOR_BV_EQ_NODE: res = ternary_eq (mm, e[0], e[1]); break;
+        case BTOR_BV_SLL_NODE:
+        case BTOR_BV_SRL_NODE:
+          res = ternary_shift (mm, e[0], e[1], cur->kind == BTOR_BV_SLL_NODE);
+          break;
+        case BTOR_BV_CONCAT_NODE:
+          res = ternary_new (mm,
+                             btor_bv_concat (mm, e[0]->val, e[1]->val),
+                             btor_bv_concat (mm, e[0]->x, e[1]->x));
+          break;
+        case BTOR_COND_NODE:
+          if (!ternary_is_known (e[0]))
+            res = ternary_join (mm, e[1], e[2]);
+          else if (btor_bv_is_one (e[0]->val))
+            res = ternary_copy (mm, e[1], false);
+          else
+            res = ternary_copy (mm, e[2], false);
+          break;
+        default:
+          res = ternary_binary (mm, cur->kind, width, e[0], e[1]);
       }
+      for (i = 0; i < cur->arity; i++) ternary_delete (mm, e[i]);
     }
-    else if (f->time > 0 && state->next)
+    else if (btor_node_is_bv_const (cur))
     {
-      p   = f - 1;
-      dst = BTOR_PEEK_STACK (p->next, i);
-      dst = boolector_copy (fwd, dst);
+      res = ternary_new (mm,
+                         btor_bv_copy (mm, btor_node_bv_const_get_bits (cur)),
+                         btor_bv_new (mm, width));
     }
-    else
+    else if (btor_node_is_bv_var (cur)
+             && (b = btor_hashptr_table_get (mc->states, cur)))
     {
-      sym = timed_symbol (mc, '#', src, f->time);
-      dst = new_var_or_array (mc, src, sym);
-      btor_mem_freestr (mc->mm, sym);
+      state = b->data.as_ptr;
+      assert (env[state->id]);
+      res = ternary_copy (mm, env[state->id], false);
     }
-    assert (BTOR_COUNT_STACK (f->states) == i);
-    BTOR_PUSH_STACK (f->states, dst);
-    i += 1;
-    boolector_nodemap_map (map, src, dst);
+    else
+      res = ternary_unknown (mm, width);
+
+    d = btor_hashint_map_get (cache, cur->id);
+    if (!d) d = btor_hashint_map_add (cache, cur->id);
+    d->as_ptr = res;
   }
+  BTOR_RELEASE_STACK (visit);
+
+  d = btor_hashint_map_get (cache, btor_node_real_addr (exp)->id);
+  assert (d);
+  return ternary_copy (mm, d->as_ptr, btor_node_is_inverted (exp));
 }
 
 static void
-initialize_next_state_functions_of_frame (BtorMC *mc,
-                                          BoolectorNodeMap *map,
-                                          BtorMCFrame *f)
+ternary_delete_cache (BtorMemMgr *mm, BtorIntHashTable *cache)
 {
-  BoolectorNode *src, *dst, *node;
-  BtorMCstate *state;
+  BtorIntHashTableIterator it;
+
+  btor_iter_hashint_init (&it, cache);
+  while (btor_iter_hashint_has_next (&it))
+    ternary_delete (mm, btor_iter_hashint_next_data (&it)->as_ptr);
+  btor_hashint_map_delete (cache);
+}
+
+static bool
+is_bv_state (BtorMC *mc, BtorMCstate *state)
+{
+  return boolector_is_var (mc->btor, state->node);
+}
+
+/* Ternary simulation of the bit-vector states until a fixpoint is reached,
+ * starting from the initial states and joining the values of the next state
+ * functions. States that are fully known in the fixpoint are constant. */
+static uint32_t
+find_constant_states (BtorMC *mc)
+{
+  BtorMemMgr *mm;
+  BtorMCTernary **env, **tmp, *t;
+  BtorIntHashTable *cache;
   BtorPtrHashTableIterator it;
-  int32_t nextstates;
-  size_t i;
-  (void) node;
+  BtorMCstate *state;
+  uint32_t n, res;
+  char *bits;
+  bool changed;
 
-  assert (mc);
-  assert (map);
-  assert (f);
-  assert (f->time >= 0);
+  mm = mc->mm;
+  n  = mc->states->count;
+  BTOR_CNEWN (mm, env, n);
+  BTOR_CNEWN (mm, tmp, n);
 
-  BTOR_MSG (boolector_get_btor_msg (mc->btor),
-            2,
-            "initializing %d next state functions of frame %d",
-            mc->nextstates,
-            f->time);
+  cache = btor_hashint_map_new (mm);
+  btor_iter_hashptr_init (&it, mc->states);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    state = btor_iter_hashptr_next_data (&it)->as_ptr;
+    if (!is_bv_state (mc, state)) continue;
+    env[state->id] =
+        ternary_unknown (mm, boolector_get_width (mc->btor, state->node));
+  }
+  btor_iter_hashptr_init (&it, mc->states);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    state = btor_iter_hashptr_next_data (&it)->as_ptr;
+    if (!is_bv_state (mc, state) || !state->init) continue;
+    tmp[state->id] = ternary_eval (mc, env, cache, state->init);
+  }
+  ternary_delete_cache (mm, cache);
+  btor_iter_hashptr_init (&it, mc->states);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    state = btor_iter_hashptr_next_data (&it)->as_ptr;
+    if (!tmp[state->id]) continue;
+    ternary_delete (mm, env[state->id]);
+    env[state->id] = tmp[state->id];
+    tmp[state->id] = 0;
+  }
 
-  BTOR_INIT_STACK (mc->mm, f->next);
+  do
+  {
+    changed = false;
+    cache   = btor_hashint_map_new (mm);
+    btor_iter_hashptr_init (&it, mc->states);
+    while (btor_iter_hashptr_has_next (&it))
+    {
+      state = btor_iter_hashptr_next_data (&it)->as_ptr;
+      if (!is_bv_state (mc, state)) continue;
+      if (state->next)
+      {
+        t              = ternary_eval (mc, env, cache, state->next);
+        tmp[state->id] = ternary_join (mm, env[state->id], t);
+        ternary_delete (mm, t);
+      }
+      else
+        tmp[state->id] = ternary_unknown (
+            mm, btor_bv_get_width (env[state->id]->val));
+    }
+    ternary_delete_cache (mm, cache);
+    btor_iter_hashptr_init (&it, mc->states);
+    while (btor_iter_hashptr_has_next (&it))
+    {
+      state = btor_iter_hashptr_next_data (&it)->as_ptr;
+      if (!tmp[state->id]) continue;
+      if (!ternary_is_equal (env[state->id], tmp[state->id])) changed = true;
+      ternary_delete (mm, env[state->id]);
+      env[state->id] = tmp[state->id];
+      tmp[state->id] = 0;
+    }
+  } while (changed);
 
-  i          = 0;
-  nextstates = 0;
+  res = 0;
   btor_iter_hashptr_init (&it, mc->states);
   while (btor_iter_hashptr_has_next (&it))
   {
-    state = it.bucket->data.as_ptr;
-    assert (state);
-    node = (BoolectorNode *) btor_iter_hashptr_next (&it);
-    assert (state->node == node);
-    assert (BTOR_COUNT_STACK (f->next) == i);
-    src = state->next;
-    if (src)
+    state = btor_iter_hashptr_next_data (&it)->as_ptr;
+    if (!env[state->id]) continue;
+    if (ternary_is_known (env[state->id]))
     {
-      dst = boolector_nodemap_substitute_node (mc->forward, map, src);
-      dst = boolector_copy (mc->forward, dst);
-      BTOR_PUSH_STACK (f->next, dst);
-      nextstates++;
+      bits            = btor_bv_to_char (mm, env[state->id]->val);
+      state->constant = boolector_const (mc->btor, bits);
+      btor_mem_freestr (mm, bits);
+      res++;
     }
-    else
-      BTOR_PUSH_STACK (f->next, 0);
-    i += 1;
+    ternary_delete (mm, env[state->id]);
   }
-  assert (nextstates == mc->nextstates);
-  assert (BTOR_COUNT_STACK (f->next) == mc->states->count);
+  BTOR_DELETEN (mm, env, n);
+  BTOR_DELETEN (mm, tmp, n);
+  return res;
 }
 
-static void
-initialize_constraints_of_frame (BtorMC *mc,
-                                 BoolectorNodeMap *map,
-                                 BtorMCFrame *f)
+static bool
+is_merge_candidate (BtorMC *mc, BtorMCstate *state)
 {
-  BoolectorNode *src, *dst;
-  uint32_t i;
+  return is_bv_state (mc, state) && !state->constant && state->next
+         && state->init && boolector_is_const (mc->btor, state->init);
+}
 
-  assert (mc);
-  assert (map);
-  assert (f);
+/* Partition refinement: starting from the classes of states with the same
+ * initial value, a class is split until all of its states have the same next
+ * state function if merged states are replaced by their representative (the
+ * state with the smallest id) and constant states by their value. */
+static uint32_t
+merge_equivalent_states (BtorMC *mc)
+{
+  BtorMemMgr *mm;
+  Btor *btor;
+  BtorPtrHashTable *classes;
+  BtorPtrHashTableIterator it;
+  BtorPtrHashBucket *b;
+  BoolectorNodeMap *map;
+  BoolectorNodePtrStack keys;
+  BoolectorNode *next, *key;
+  BtorMCstate *state, **repr;
+  uint32_t n, res;
+  bool changed;
+
+  mm   = mc->mm;
+  btor = mc->btor;
+  n    = mc->states->count;
+  BTOR_CNEWN (mm, repr, n);
+  BTOR_INIT_STACK (mm, keys);
+
+  classes = btor_hashptr_table_new (mm, 0, 0);
+  btor_iter_hashptr_init (&it, mc->states);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    state = btor_iter_hashptr_next_data (&it)->as_ptr;
+    if (!is_merge_candidate (mc, state)) continue;
+    if (!(b = btor_hashptr_table_get (classes, state->init)))
+      btor_hashptr_table_add (classes, state->init)->data.as_ptr = state;
+    else
+      state->repr = b->data.as_ptr;
+  }
+  btor_hashptr_table_delete (classes);
+
+  do
+  {
+    map = boolector_nodemap_new (btor);
+    btor_iter_hashptr_init (&it, mc->states);
+    while (btor_iter_hashptr_has_next (&it))
+    {
+      state = btor_iter_hashptr_next_data (&it)->as_ptr;
+      if (state->constant)
+        boolector_nodemap_map (map, state->node, state->constant);
+      else if (state->repr != state)
+        boolector_nodemap_map (map, state->node, state->repr->node);
+    }
+
+    /* states stay in the same class if they were in the same class and have
+     * the same next state function */
+    classes = btor_hashptr_table_new (mm, 0, 0);
+    btor_iter_hashptr_init (&it, mc->states);
+    while (btor_iter_hashptr_has_next (&it))
+    {
+      state = btor_iter_hashptr_next_data (&it)->as_ptr;
+      if (!is_merge_candidate (mc, state)) continue;
+      next = boolector_nodemap_substitute_node (btor, map, state->next);
+      key  = boolector_concat (btor, state->repr->node, next);
+      BTOR_PUSH_STACK (keys, key);
+      if (!(b = btor_hashptr_table_get (classes, key)))
+      {
+        btor_hashptr_table_add (classes, key)->data.as_ptr = state;
+        repr[state->id] = state;
+      }
+      else
+        repr[state->id] = b->data.as_ptr;
+    }
+    btor_hashptr_table_delete (classes);
+    boolector_nodemap_delete (map);
+    while (!BTOR_EMPTY_STACK (keys))
+      boolector_release (btor, BTOR_POP_STACK (keys));
+
+    changed = false;
+    btor_iter_hashptr_init (&it, mc->states);
+    while (btor_iter_hashptr_has_next (&it))
+    {
+      state = btor_iter_hashptr_next_data (&it)->as_ptr;
+      if (!is_merge_candidate (mc, state)) continue;
+      if (state->repr != repr[state->id]) changed = true;
+      state->repr = repr[state->id];
+    }
+  } while (changed);
+
+  res = 0;
+  btor_iter_hashptr_init (&it, mc->states);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    state = btor_iter_hashptr_next_data (&it)->as_ptr;
+    if (state->repr != state) res++;
+  }
+  BTOR_RELEASE_STACK (keys);
+  BTOR_DELETEN (mm, repr, n);
+  return res;
+}
+
+/* Marks the states in the cone of influence of the unreached bad state
+ * properties and the constraints. Constant states do not depend on other
+ * states, merged states depend on their representative only. */
+static void
+update_cone_of_influence (BtorMC *mc)
+{
+  BtorNodePtrStack visit;
+  BtorIntHashTable *cache;
+  BtorPtrHashTableIterator it;
+  BtorPtrHashBucket *b;
+  BtorMCstate *state;
+  BoolectorNode *root;
+  BtorNode *cur;
+  uint32_t i, coi;
+
+  mc->coi_num_reached = mc->num_reached;
+  if (!btor_mc_get_opt (mc, BTOR_MC_OPT_REDUCE)
+      || btor_mc_get_opt (mc, BTOR_MC_OPT_TRACE_GEN_FULL))
+    return;
+
+  BTOR_INIT_STACK (mc->mm, visit);
+  for (i = 0; i < BTOR_COUNT_STACK (mc->bad); i++)
+  {
+    if (BTOR_PEEK_STACK (mc->reached, i) >= 0) continue;
+    root = BTOR_PEEK_STACK (mc->bad, i);
+    BTOR_PUSH_STACK (visit, BTOR_IMPORT_BOOLECTOR_NODE (root));
+  }
+  for (i = 0; i < BTOR_COUNT_STACK (mc->constraints); i++)
+  {
+    root = BTOR_PEEK_STACK (mc->constraints, i);
+    BTOR_PUSH_STACK (visit, BTOR_IMPORT_BOOLECTOR_NODE (root));
+  }
+
+  btor_iter_hashptr_init (&it, mc->states);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    state      = btor_iter_hashptr_next_data (&it)->as_ptr;
+    state->coi = false;
+  }
+
+  coi   = 0;
+  cache = btor_hashint_table_new (mc->mm);
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (btor_hashint_table_contains (cache, cur->id)) continue;
+    btor_hashint_table_add (cache, cur->id);
+
+    if ((b = btor_hashptr_table_get (mc->states, cur)))
+    {
+      state = b->data.as_ptr;
+      if (state->constant) continue;
+      if (state->repr != state)
+      {
+        BTOR_PUSH_STACK (visit, BTOR_IMPORT_BOOLECTOR_NODE (state->repr->node));
+        continue;
+      }
+      state->coi = true;
+      coi++;
+      if (state->next)
+        BTOR_PUSH_STACK (visit, BTOR_IMPORT_BOOLECTOR_NODE (state->next));
+      if (state->init)
+        BTOR_PUSH_STACK (visit, BTOR_IMPORT_BOOLECTOR_NODE (state->init));
+    }
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+  btor_hashint_table_delete (cache);
+  BTOR_RELEASE_STACK (visit);
 
   BTOR_MSG (boolector_get_btor_msg (mc->btor),
+            1,
+            "%u of %u states in cone of influence of %u properties",
+            coi,
+            mc->states->count,
+            BTOR_COUNT_STACK (mc->bad) - mc->num_reached);
+}
+
+/* Called before unrolling or bit-blasting the model. */
+static void
+reduce_model (BtorMC *mc)
+{
+  uint32_t constant, merged;
+
+  if (!mc->reduced)
+  {
+    mc->reduced = true;
+    if (btor_mc_get_opt (mc, BTOR_MC_OPT_REDUCE) && mc->states->count)
+    {
+      constant = find_constant_states (mc);
+      merged   = merge_equivalent_states (mc);
+      BTOR_MSG (boolector_get_btor_msg (mc->btor),
+                1,
+                "found %u constant and %u equivalent states",
+                constant,
+                merged);
+    }
+    update_cone_of_influence (mc);
+  }
+  else if (mc->coi_num_reached != mc->num_reached)
+    update_cone_of_influence (mc);
+}
+
+/* True if the state is unrolled with its own next state function. */
+static bool
+is_unrolled_state (BtorMCstate *state)
+{
+  return state->coi && !state->constant && state->repr == state;
+}
+
+/*------------------------------------------------------------------------*/
+
+static char *
+timed_symbol (BtorMC *mc, char ch, BoolectorNode *node, int32_t time)
+{
+  assert (mc);
+  assert (node);
+  assert (btor_node_is_regular ((BtorNode *) node));
+  assert (time >= 0);
+
+  char *res, suffix[20];
+  const char *symbol;
+  uint32_t symlen, reslen;
+
+  symbol = boolector_get_symbol (mc->btor, node);
+  if (!symbol) return 0;
+  sprintf (suffix, "%c%d", ch, time);
+  symlen = strlen (symbol);
+  reslen = symlen + strlen (suffix) + 1;
+  res    = btor_mem_malloc (mc->mm, reslen);
+  (void) strcpy (res, symbol);
+  strcpy (res + symlen, suffix);
+  return res;
+}
+
+static BoolectorNode *
+new_var_or_array (BtorMC *mc,
+                  Btor *fwd,
+                  BoolectorNode *src,
+                  const char *symbol)
+{
+  BoolectorNode *dst;
+  BoolectorSort sort;
+  Btor *btor = mc->btor;
+
+  sort = copy_sort (btor, fwd, src);
+  if (boolector_is_var (btor, src))
+  {
+    dst = boolector_var (fwd, sort, symbol);
+  }
+  else
+  {
+    assert (boolector_is_array (btor, src));
+    dst = boolector_array (fwd, sort, symbol);
+  }
+  boolector_release_sort (fwd, sort);
+  return dst;
+}
+
+static void
+initialize_inputs_of_frame (BtorMC *mc,
+                            Btor *ubtor,
+                            BoolectorNodeMap *map,
+                            BtorMCFrame *f)
+{
+  Btor *btor;
+  BoolectorNode *src, *dst;
+  BtorPtrHashTableIterator it;
+  char *sym;
+
+#ifndef NDEBUG
+  size_t i = 0;
+  BtorMCInput *input;
+#endif
+
+  btor = mc->btor;
+
+  BTOR_MSG (boolector_get_btor_msg (btor),
             2,
-            "initializing %u environment constraints of frame %d",
-            BTOR_COUNT_STACK (mc->constraints),
+            "initializing %u inputs of frame %d",
+            mc->inputs->count,
             f->time);
 
-  for (i = 0; i < BTOR_COUNT_STACK (mc->constraints); i++)
+  BTOR_INIT_STACK (mc->mm, f->inputs);
+
+  btor_iter_hashptr_init (&it, mc->inputs);
+  while (btor_iter_hashptr_has_next (&it))
   {
-    src = BTOR_PEEK_STACK (mc->constraints, i);
+#ifndef NDEBUG
+    input = it.bucket->data.as_ptr;
+    assert (input);
+#endif
+    src = (BoolectorNode *) btor_iter_hashptr_next (&it);
     assert (src);
-    dst = boolector_nodemap_substitute_node (mc->forward, map, src);
-    boolector_assert (mc->forward, dst);
+    assert (btor_node_is_regular ((BtorNode *) src));
+#ifndef NDEBUG
+    assert (input->node == src);
+    assert (input->id >= 0);
+    assert ((size_t) input->id == i);
+#endif
+    sym = timed_symbol (mc, '@', src, f->time);
+    dst = new_var_or_array (mc, ubtor, src, sym);
+    btor_mem_freestr (mc->mm, sym);
+    assert (BTOR_COUNT_STACK (f->inputs) == i++);
+    BTOR_PUSH_STACK (f->inputs, dst);
+    boolector_nodemap_map (map, src, dst);
   }
 }
 
+/* Only the forward unrolling applies the initial state predicates, the
+ * induction unrolling starts in an arbitrary state. */
 static void
-initialize_bad_state_properties_of_frame (BtorMC *mc,
-                                          BoolectorNodeMap *map,
-                                          BtorMCFrame *f)
+initialize_states_of_frame (BtorMC *mc,
+                            Btor *ubtor,
+                            BoolectorNodeMap *map,
+                            BtorMCFrame *f)
 {
+  Btor *btor, *fwd;
   BoolectorNode *src, *dst;
-  uint32_t i;
+  BtorPtrHashTableIterator it;
+  BtorMCstate *state;
+  BtorMCFrame *p;
+  char *sym;
+  size_t i;
 
   assert (mc);
-  assert (map);
   assert (f);
+  assert (f->time >= 0);
 
-  BTOR_MSG (boolector_get_btor_msg (mc->btor),
+  btor = mc->btor;
+  fwd  = ubtor;
+
+  BTOR_MSG (boolector_get_btor_msg (btor),
             2,
-            "initializing %u bad state properties of frame %d",
-            BTOR_COUNT_STACK (mc->bad),
+            "initializing %u states in frame %d",
+            mc->states->count,
             f->time);
 
-  BTOR_INIT_STACK (mc->mm, f->bad);
+  BTOR_INIT_STACK (mc->mm, f->states);
 
-  for (i = 0; i < BTOR_COUNT_STACK (mc->bad); i++)
+  /* next state functions of the previous frame (0 if not unrolled) */
+  p = f->time > 0 ? f - 1 : 0;
+  i = 0;
+  btor_iter_hashptr_init (&it, mc->states);
+  while (btor_iter_hashptr_has_next (&it))
   {
-    if (BTOR_PEEK_STACK (mc->reached, i) < 0)
+    state = it.bucket->data.as_ptr;
+    assert (state);
+    assert (state->id >= 0);
+    assert ((size_t) state->id == i);
+    src = (BoolectorNode *) btor_iter_hashptr_next (&it);
+    assert (src);
+    assert (btor_node_is_regular ((BtorNode *) src));
+    assert (state->node == src);
+
+    if (state->constant)
     {
-      src = BTOR_PEEK_STACK (mc->bad, i);
-      assert (src);
-      dst = boolector_nodemap_substitute_node (mc->forward, map, src);
-      dst = boolector_copy (mc->forward, dst);
+      dst = boolector_nodemap_substitute_node (fwd, map, state->constant);
+      dst = boolector_copy (fwd, dst);
+    }
+    else if (state->repr != state)
+    {
+      assert (state->repr->id < state->id);
+      dst = BTOR_PEEK_STACK (f->states, state->repr->id);
+      dst = boolector_copy (fwd, dst);
+    }
+    else if (!f->time && state->init && fwd == mc->forward)
+    {
+      dst = boolector_nodemap_substitute_node (fwd, map, state->init);
+      dst = boolector_copy (fwd, dst);
+      // special case: const initialization (constant array)
+      if (boolector_is_array (btor, src) && boolector_is_const (btor, state->init))
+      {
+        BoolectorSort s    = copy_sort (btor, fwd, src);
+        BoolectorNode *tmp = boolector_const_array (fwd, s, dst);
+        boolector_release_sort (fwd, s);
+        boolector_release (fwd, dst);
+        dst = tmp;
+      }
+    }
+    else if (p && BTOR_PEEK_STACK (p->next, i))
+    {
+      dst = BTOR_PEEK_STACK (p->next, i);
+      dst = boolector_copy (fwd, dst);
+    }
+    else
+    {
+      sym = timed_symbol (mc, '#', src, f->time);
+      dst = new_var_or_array (mc, fwd, src, sym);
+      btor_mem_freestr (mc->mm, sym);
+    }
+    assert (BTOR_COUNT_STACK (f->states) == i);
+    BTOR_PUSH_STACK (f->states, dst);
+    i += 1;
+    boolector_nodemap_map (map, src, dst);
+  }
+}
+
+static void
+initialize_next_state_functions_of_frame (BtorMC *mc,
+                                          Btor *ubtor,
+                                          BoolectorNodeMap *map,
+                                          BtorMCFrame *f)
+{
+  BoolectorNode *src, *dst, *node;
+  BtorMCstate *state;
+  BtorPtrHashTableIterator it;
+  int32_t nextstates;
+  size_t i;
+  (void) node;
+
+  assert (mc);
+  assert (map);
+  assert (f);
+  assert (f->time >= 0);
+
+  BTOR_MSG (boolector_get_btor_msg (mc->btor),
+            2,
+            "initializing %d next state functions of frame %d",
+            mc->nextstates,
+            f->time);
+
+  BTOR_INIT_STACK (mc->mm, f->next);
+
+  i          = 0;
+  nextstates = 0;
+  btor_iter_hashptr_init (&it, mc->states);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    state = it.bucket->data.as_ptr;
+    assert (state);
+    node = (BoolectorNode *) btor_iter_hashptr_next (&it);
+    assert (state->node == node);
+    assert (BTOR_COUNT_STACK (f->next) == i);
+    src = state->next;
+    if (src && is_unrolled_state (state))
+    {
+      dst = boolector_nodemap_substitute_node (ubtor, map, src);
+      dst = boolector_copy (ubtor, dst);
+      BTOR_PUSH_STACK (f->next, dst);
+      nextstates++;
+    }
+    else
+      BTOR_PUSH_STACK (f->next, 0);
+    i += 1;
+  }
+  assert (nextstates <= mc->nextstates);
+  assert (BTOR_COUNT_STACK (f->next) == mc->states->count);
+}
+
+static void
+initialize_constraints_of_frame (BtorMC *mc,
+                                 Btor *ubtor,
+                                 BoolectorNodeMap *map,
+                                 BtorMCFrame *f)
+{
+  BoolectorNode *src, *dst;
+  uint32_t i;
+
+  assert (mc);
+  assert (map);
+  assert (f);
+
+  BTOR_MSG (boolector_get_btor_msg (mc->btor),
+            2,
+            "initializing %u environment constraints of frame %d",
+            BTOR_COUNT_STACK (mc->constraints),
+            f->time);
+
+  for (i = 0; i < BTOR_COUNT_STACK (mc->constraints); i++)
+  {
+    src = BTOR_PEEK_STACK (mc->constraints, i);
+    assert (src);
+    dst = boolector_nodemap_substitute_node (ubtor, map, src);
+    boolector_assert (ubtor, dst);
+  }
+}
+
+static void
+initialize_bad_state_properties_of_frame (BtorMC *mc,
+                                          Btor *ubtor,
+                                          BoolectorNodeMap *map,
+                                          BtorMCFrame *f)
+{
+  BoolectorNode *src, *dst;
+  uint32_t i;
+
+  assert (mc);
+  assert (map);
+  assert (f);
+
+  BTOR_MSG (boolector_get_btor_msg (mc->btor),
+            2,
+            "initializing %u bad state properties of frame %d",
+            BTOR_COUNT_STACK (mc->bad),
+            f->time);
+
+  BTOR_INIT_STACK (mc->mm, f->bad);
+
+  for (i = 0; i < BTOR_COUNT_STACK (mc->bad); i++)
+  {
+    if (BTOR_PEEK_STACK (mc->reached, i) < 0)
+    {
+      src = BTOR_PEEK_STACK (mc->bad, i);
+      assert (src);
+      dst = boolector_nodemap_substitute_node (ubtor, map, src);
+      dst = boolector_copy (ubtor, dst);
+    }
+    else
+      dst = 0;
+
+    BTOR_PUSH_STACK (f->bad, dst);
+  }
+}
+
+static Btor *
+new_unrolling_manager (BtorMC *mc, const char *name, bool model_gen)
+{
+  Btor *res;
+  uint32_t v;
+
+  BTOR_MSG (boolector_get_btor_msg (mc->btor), 1, "new %s manager", name);
+  res = boolector_new ();
+  boolector_set_opt (res, BTOR_OPT_INCREMENTAL, 1);
+  if (model_gen) boolector_set_opt (res, BTOR_OPT_MODEL_GEN, 1);
+  if ((v = btor_mc_get_opt (mc, BTOR_MC_OPT_VERBOSITY)))
+    boolector_set_opt (res, BTOR_OPT_VERBOSITY, v);
+  return res;
+}
+
+static BtorMCFrame *
+initialize_new_frame (BtorMC *mc, Btor *ubtor, BtorMCFrameStack *frames)
+{
+  assert (mc);
+  assert (ubtor);
+  assert (frames);
+
+  BtorMCFrame frame, *f;
+  BoolectorNodeMap *map;
+  int32_t time;
+
+  time = BTOR_COUNT_STACK (*frames);
+  BTOR_CLR (&frame);
+  BTOR_PUSH_STACK (*frames, frame);
+  f       = frames->start + time;
+  f->time = time;
+
+  BTOR_INIT_STACK (mc->mm, f->init);
+
+  if (mc->coi_num_reached != mc->num_reached) update_cone_of_influence (mc);
+
+  map = boolector_nodemap_new (ubtor);
+
+  initialize_inputs_of_frame (mc, ubtor, map, f);
+  initialize_states_of_frame (mc, ubtor, map, f);
+  initialize_next_state_functions_of_frame (mc, ubtor, map, f);
+  initialize_constraints_of_frame (mc, ubtor, map, f);
+  initialize_bad_state_properties_of_frame (mc, ubtor, map, f);
+
+  boolector_nodemap_delete (map);
+
+  return f;
+}
+
+static void
+initialize_new_forward_frame (BtorMC *mc)
+{
+  assert (mc);
+
+  BtorMCFrame *f;
+
+  if (!mc->forward)
+    mc->forward = new_unrolling_manager (
+        mc, "forward", btor_mc_get_opt (mc, BTOR_MC_OPT_TRACE_GEN));
+
+  f = initialize_new_frame (mc, mc->forward, &mc->frames);
+
+  BTOR_MSG (boolector_get_btor_msg (mc->btor),
+            1,
+            "initialized forward frame at bound k = %d",
+            f->time);
+}
+
+/* Returns the activation literal of bad state property 'i' in the induction
+ * unrolling (created on demand). */
+static BoolectorNode *
+get_activation (BtorMC *mc, size_t i)
+{
+  BoolectorNode *act;
+  BoolectorSort s;
+
+  assert (mc->induction);
+  while (BTOR_COUNT_STACK (mc->activation) <= i)
+    BTOR_PUSH_STACK (mc->activation, 0);
+  act = BTOR_PEEK_STACK (mc->activation, i);
+  if (!act)
+  {
+    s   = boolector_bool_sort (mc->induction);
+    act = boolector_var (mc->induction, s, 0);
+    boolector_release_sort (mc->induction, s);
+    BTOR_POKE_STACK (mc->activation, i, act);
+  }
+  return act;
+}
+
+/* The induction unrolling is shared by all bad state properties and only
+ * ever extended. Under its activation literal, a property is assumed to
+ * not hold in all frames but the last one. */
+static void
+initialize_new_induction_frame (BtorMC *mc)
+{
+  assert (mc);
+
+  BtorMCFrame *f, *p;
+  BoolectorNode *bad, *act, *not_bad, *imp;
+  Btor *ind;
+  size_t i;
+
+  if (!mc->induction)
+    mc->induction = new_unrolling_manager (
+        mc, "induction", btor_mc_get_opt (mc, BTOR_MC_OPT_SIMPLE_PATH));
+  ind = mc->induction;
+
+  f = initialize_new_frame (mc, ind, &mc->induction_frames);
+
+  if (f->time > 0)
+  {
+    p = f - 1;
+    for (i = 0; i < BTOR_COUNT_STACK (p->bad); i++)
+    {
+      if (BTOR_PEEK_STACK (mc->reached, i) >= 0) continue;
+      bad = BTOR_PEEK_STACK (p->bad, i);
+      if (!bad) continue;
+      act     = get_activation (mc, i);
+      not_bad = boolector_not (ind, bad);
+      imp     = boolector_implies (ind, act, not_bad);
+      boolector_assert (ind, imp);
+      boolector_release (ind, imp);
+      boolector_release (ind, not_bad);
+    }
+  }
+
+  BTOR_MSG (boolector_get_btor_msg (mc->btor),
+            1,
+            "initialized induction frame at bound k = %d",
+            f->time);
+}
+
+/* Witnesses are streamed through a line buffer that is reused for all values
+ * and flushed after each frame (or earlier if it grows beyond
+ * BTOR_MC_WITNESS_FLUSH_SIZE), reading values directly from the model of the
+ * forward instance rather than allocating an assignment string per value. */
+#define BTOR_MC_WITNESS_FLUSH_SIZE (1u << 16)
+
+static void
+witness_flush (BtorCharStack *buf)
+{
+  fwrite (buf->start, 1, BTOR_COUNT_STACK (*buf), stdout);
+  BTOR_RESET_STACK (*buf);
+}
+
+static void
+witness_put_str (BtorCharStack *buf, const char *str)
+{
+  const char *c;
+  for (c = str; *c; c++) BTOR_PUSH_STACK (*buf, *c);
+}
+
+static void
+witness_put_uint (BtorCharStack *buf, uint64_t n)
+{
+  char digits[24], *p;
+
+  p    = digits + sizeof digits;
+  *--p = 0;
+  do
+  {
+    *--p = '0' + n % 10;
+    n /= 10;
+  } while (n);
+  witness_put_str (buf, p);
+}
+
+static void
+witness_put_bits (BtorCharStack *buf, const BtorBitVector *bv)
+{
+  uint32_t i;
+  for (i = btor_bv_get_width (bv); i > 0; i--)
+    BTOR_PUSH_STACK (*buf, btor_bv_get_bit (bv, i - 1) ? '1' : '0');
+}
+
+/* Append ' <symbol>(@|#)<time>' (or the default symbol) to 'buf'. */
+static void
+witness_put_symbol (BtorCharStack *buf,
+                    const char *sym,
+                    const char *default_sym,
+                    uint32_t id,
+                    char tag,
+                    int32_t time)
+{
+  BTOR_PUSH_STACK (*buf, ' ');
+  if (sym)
+    witness_put_str (buf, sym);
+  else
+  {
+    witness_put_str (buf, default_sym);
+    witness_put_uint (buf, id);
+  }
+  BTOR_PUSH_STACK (*buf, tag);
+  witness_put_uint (buf, time);
+  BTOR_PUSH_STACK (*buf, '\n');
+}
+
+static void
+print_witness_at_time (BtorMC *mc,
+                       BtorCharStack *buf,
+                       BoolectorNode *node,
+                       int32_t time)
+{
+  bool is_bv;
+  const char *default_sym, *sym;
+  uint32_t id;
+  BtorPtrHashBucket *b;
+  BtorMCInput *input;
+  BtorMCstate *state;
+  BoolectorNode *node_at_time;
+  BtorMCFrame *frame;
+  BtorNode *exp;
+  BtorBitVectorTuple *t;
+  const BtorPtrHashTable *model;
+  BtorPtrHashTableIterator it;
+  Btor *btor, *fwd;
+
+  btor  = mc->btor;
+  fwd   = mc->forward;
+  is_bv = boolector_is_bitvec_sort (btor, boolector_get_sort (btor, node));
+  frame = mc->frames.start + time;
+  b     = btor_hashptr_table_get (mc->states, node);
+  const bool is_state = (b != 0);
+  if (b)
+  {
+    state        = b->data.as_ptr;
+    id           = state->id;
+    node_at_time = BTOR_PEEK_STACK (frame->states, id);
+    default_sym  = "state";
+  }
+  else
+  {
+    b = btor_hashptr_table_get (mc->inputs, node);
+    assert (b);
+    input        = b->data.as_ptr;
+    id           = input->id;
+    node_at_time = BTOR_PEEK_STACK (frame->inputs, id);
+    default_sym  = "input";
+  }
+
+  assert (fwd->last_sat_result == BTOR_RESULT_SAT);
+  assert (fwd->valid_assignments);
+  exp = BTOR_IMPORT_BOOLECTOR_NODE (node_at_time);
+  sym = boolector_get_symbol (mc->btor, node);
+  if (is_bv)
+  {
+    witness_put_uint (buf, id);
+    BTOR_PUSH_STACK (*buf, ' ');
+    witness_put_bits (buf, btor_model_get_bv (fwd, exp));
+    witness_put_symbol (buf, sym, default_sym, id, is_state ? '#' : '@', time);
+  }
+  else
+  {
+    exp = btor_simplify_exp (fwd, exp);
+    if (!fwd->fun_model || !(model = btor_model_get_fun (fwd, exp))) return;
+    btor_iter_hashptr_init (&it, (BtorPtrHashTable *) model);
+    while (btor_iter_hashptr_has_next (&it))
+    {
+      b = it.bucket;
+      t = btor_iter_hashptr_next (&it);
+      assert (t->arity <= 1);
+      witness_put_uint (buf, id);
+      witness_put_str (buf, " [");
+      /* arity 0: default value of constant arrays */
+      if (t->arity)
+        witness_put_bits (buf, t->bv[0]);
+      else
+        BTOR_PUSH_STACK (*buf, '*');
+      witness_put_str (buf, "] ");
+      witness_put_bits (buf, b->data.as_ptr);
+      witness_put_symbol (buf, sym, default_sym, id, '@', time);
+    }
+  }
+  if (BTOR_COUNT_STACK (*buf) >= BTOR_MC_WITNESS_FLUSH_SIZE)
+    witness_flush (buf);
+}
+
+static void
+print_witness (BtorMC *mc, int32_t time, size_t bad_id)
+{
+  assert (time >= 0);
+  assert (BTOR_PEEK_STACK (mc->reached, bad_id) == time);
+
+  size_t i;
+  BtorMCstate *state;
+  BoolectorNode *src;
+  BtorPtrHashTableIterator it;
+  BtorCharStack buf;
+  bool full_trace, printed_state_header;
+
+  full_trace = btor_mc_get_opt (mc, BTOR_MC_OPT_TRACE_GEN_FULL) == 1;
+
+  BTOR_INIT_STACK (mc->mm, buf);
+  witness_put_str (&buf, "sat\nb");
+  witness_put_uint (&buf, bad_id);
+  BTOR_PUSH_STACK (buf, '\n');
+
+  for (i = 0; i <= (size_t) time; i++)
+  {
+    /* We have to print the state assignments if
+     * 1) the state is uninitialized
+     * 2) the state has no next function (primary input)
+     * 3) the user wants a full trace
+     * In all other cases the state part can be omitted. */
+    printed_state_header = false;
+    btor_iter_hashptr_init (&it, mc->states);
+    while (btor_iter_hashptr_has_next (&it))
+    {
+      state = it.bucket->data.as_ptr;
+      assert (state);
+      src = (BoolectorNode *) btor_iter_hashptr_next (&it);
+      if (((i == 0) && !state->init) || !state->next || full_trace)
+      {
+        if (!printed_state_header)
+        {
+          printed_state_header = true;
+          BTOR_PUSH_STACK (buf, '#');
+          witness_put_uint (&buf, i);
+          BTOR_PUSH_STACK (buf, '\n');
+        }
+        print_witness_at_time (mc, &buf, src, i);
+      }
+    }
+
+    BTOR_PUSH_STACK (buf, '@');
+    witness_put_uint (&buf, i);
+    BTOR_PUSH_STACK (buf, '\n');
+    btor_iter_hashptr_init (&it, mc->inputs);
+    while (btor_iter_hashptr_has_next (&it))
+    {
+      src = (BoolectorNode *) btor_iter_hashptr_next (&it);
+      print_witness_at_time (mc, &buf, src, i);
+    }
+    witness_flush (&buf);
+  }
+  witness_put_str (&buf, ".\n");
+  witness_flush (&buf);
+  BTOR_RELEASE_STACK (buf);
+  fflush (stdout);
+}
+
+/* Returns true if all bit-vector states of frames 'f1' and 'f2' of the
+ * induction unrolling have the same value in the current model (array states
+ * are not compared). Only states unrolled with their own next state function
+ * are compared, all others are either determined by them or irrelevant. */
+static bool
+is_equal_in_model (BtorMC *mc, BtorMCFrame *f1, BtorMCFrame *f2)
+{
+  assert (BTOR_COUNT_STACK (f1->states) == BTOR_COUNT_STACK (f2->states));
+
+  size_t i;
+  Btor *ind;
+  BtorNode *s1, *s2;
+  BtorPtrHashTableIterator it;
+
+  ind = mc->induction;
+  btor_iter_hashptr_init (&it, mc->states);
+  for (i = 0; i < BTOR_COUNT_STACK (f1->states); i++)
+  {
+    if (!is_unrolled_state (btor_iter_hashptr_next_data (&it)->as_ptr))
+      continue;
+    s1 = BTOR_IMPORT_BOOLECTOR_NODE (BTOR_PEEK_STACK (f1->states, i));
+    s2 = BTOR_IMPORT_BOOLECTOR_NODE (BTOR_PEEK_STACK (f2->states, i));
+    if (btor_node_is_array (btor_node_real_addr (s1))) continue;
+    if (btor_bv_compare (btor_model_get_bv (ind, s1),
+                         btor_model_get_bv (ind, s2)))
+      return false;
+  }
+  return true;
+}
+
+/* Simple path constraints are added lazily: only for a pair of frames of the
+ * induction unrolling that is not distinct in the current counterexample to
+ * induction, and at most once per pair. Returns false if there is no such
+ * pair up to bound 'k'. */
+static bool
+add_simple_path_constraint (BtorMC *mc, int32_t k)
+{
+  int32_t a, b, key;
+  size_t i;
+  Btor *ind;
+  BtorMCFrame *f1, *f2;
+  BoolectorNode *eq, *tmp, *states_eq;
+  BtorPtrHashTableIterator it;
+
+  ind = mc->induction;
+
+  for (b = 1; b <= k; b++)
+  {
+    f2 = mc->induction_frames.start + b;
+    for (a = 0; a < b; a++)
+    {
+      key = b * (b - 1) / 2 + a + 1; /* 0 is not a valid key */
+      if (btor_hashint_table_contains (mc->distinct_frames, key)) continue;
+      f1 = mc->induction_frames.start + a;
+      if (!is_equal_in_model (mc, f1, f2)) continue;
+
+      states_eq = boolector_true (ind);
+      btor_iter_hashptr_init (&it, mc->states);
+      for (i = 0; i < BTOR_COUNT_STACK (f1->states); i++)
+      {
+        if (!is_unrolled_state (btor_iter_hashptr_next_data (&it)->as_ptr))
+          continue;
+        eq  = boolector_eq (ind,
+                           BTOR_PEEK_STACK (f1->states, i),
+                           BTOR_PEEK_STACK (f2->states, i));
+        tmp = boolector_and (ind, states_eq, eq);
+        boolector_release (ind, states_eq);
+        boolector_release (ind, eq);
+        states_eq = tmp;
+      }
+      tmp = boolector_not (ind, states_eq);
+      boolector_assert (ind, tmp);
+      boolector_release (ind, tmp);
+      boolector_release (ind, states_eq);
+      btor_hashint_table_add (mc->distinct_frames, key);
+
+      BTOR_MSG (boolector_get_btor_msg (mc->btor),
+                1,
+                "adding simple path constraint for %d and %d",
+                a,
+                b);
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Induction step for bad state property 'i' at bound 'k': the property is
+ * proven if it can not be reached in frame 'k' of the induction unrolling
+ * while not holding in all previous frames. */
+static bool
+check_induction_step (BtorMC *mc, size_t i, int32_t k)
+{
+  assert (mc);
+  assert (k >= 0);
+  assert (BTOR_PEEK_STACK (mc->reached, i) < 0);
+
+  bool opt_simple_path;
+  int32_t res;
+  BtorMCFrame *f;
+  BoolectorNode *bad, *act;
+
+  opt_simple_path = btor_mc_get_opt (mc, BTOR_MC_OPT_SIMPLE_PATH) == 1;
+
+  while (BTOR_COUNT_STACK (mc->induction_frames) <= (size_t) k)
+    initialize_new_induction_frame (mc);
+
+  f   = mc->induction_frames.start + k;
+  bad = BTOR_PEEK_STACK (f->bad, i);
+  assert (bad);
+  act = get_activation (mc, i);
+
+  for (;;)
+  {
+    boolector_assume (mc->induction, act);
+    boolector_assume (mc->induction, bad);
+    res = boolector_sat (mc->induction);
+    if (btor_mc_get_opt (mc, BTOR_MC_OPT_BTOR_STATS))
+      boolector_print_stats (mc->induction);
+    if (res == BOOLECTOR_UNSAT) break;
+    assert (res == BOOLECTOR_SAT);
+    if (!opt_simple_path || !add_simple_path_constraint (mc, k)) return false;
+  }
+
+  /* the property is decided, retract its induction hypotheses */
+  act = boolector_not (mc->induction, act);
+  boolector_assert (mc->induction, act);
+  boolector_release (mc->induction, act);
+  return true;
+}
+
+/* Record that bad state property 'i' was reached at bound 'k' (with a
+ * satisfiable forward frame 'k'). */
+static void
+mark_reached (BtorMC *mc, size_t i, int32_t k)
+{
+  if (BTOR_PEEK_STACK (mc->reached, i) < 0)
+  {
+    mc->num_reached++;
+    assert (mc->num_reached <= BTOR_COUNT_STACK (mc->bad));
+    BTOR_POKE_STACK (mc->reached, i, k);
+    if (mc->call_backs.reached_at_bound.fun)
+    {
+      mc->call_backs.reached_at_bound.fun (
+          mc->call_backs.reached_at_bound.state, i, k);
+    }
+  }
+
+  if (btor_mc_get_opt (mc, BTOR_MC_OPT_TRACE_GEN))
+  {
+    print_witness (mc, k, i);
+  }
+}
+
+/* Record that bad state property 'i' was proven unreachable at bound 'k'. */
+static void
+mark_proven (BtorMC *mc, size_t i, int32_t k)
+{
+  mc->num_reached++;
+  assert (mc->num_reached <= BTOR_COUNT_STACK (mc->bad));
+  BTOR_POKE_STACK (mc->reached, i, k);
+  printf ("unsat\nb%zd\n", i);
+}
+
+/* Engines not working on the forward unrolling take the witness (and the
+ * assignments) of bad state property 'i' reached at bound 'k' from it.  The
+ * environment constraints of frames beyond 'k' may exclude the witness, hence
+ * properties must be replayed in increasing order of bounds. */
+static void
+replay_on_forward_frames (BtorMC *mc, size_t i, int32_t k)
+{
+  BtorMCFrame *f;
+  BoolectorNode *bad;
+  int32_t res;
+
+  if (!btor_mc_get_opt (mc, BTOR_MC_OPT_TRACE_GEN)) return;
+
+  while (BTOR_COUNT_STACK (mc->frames) <= (size_t) k)
+    initialize_new_forward_frame (mc);
+  f   = mc->frames.start + k;
+  bad = BTOR_PEEK_STACK (f->bad, i);
+  assert (bad);
+  boolector_assume (mc->forward, bad);
+  res = boolector_sat (mc->forward);
+  assert (res == BOOLECTOR_SAT);
+  (void) res;
+}
+
+static int32_t
+check_last_forward_frame (BtorMC *mc)
+{
+  assert (mc);
+
+  size_t i;
+  int32_t k, res, reachable, unreachable;
+  bool opt_kinduction;
+  BtorMCFrame *f;
+  BoolectorNode *bad;
+  Btor *btor;
+
+  btor = mc->btor;
+
+  opt_kinduction = btor_mc_get_opt (mc, BTOR_MC_OPT_KINDUCTION) == 1;
+  k = BTOR_COUNT_STACK (mc->frames) - 1;
+  assert (k >= 0);
+  f = mc->frames.top - 1;
+  assert (f->time == k);
+
+  BTOR_MSG (boolector_get_btor_msg (btor),
+            1,
+            "checking forward frame at bound k = %d",
+            k);
+  reachable   = 0;
+  unreachable = 0;
+
+  for (i = 0; i < BTOR_COUNT_STACK (f->bad); i++)
+  {
+    bad = BTOR_PEEK_STACK (f->bad, i);
+    if (!bad)
+    {
+      int32_t reached;
+      reached = BTOR_PEEK_STACK (mc->reached, i);
+      assert (reached >= 0);
+      BTOR_MSG (boolector_get_btor_msg (btor),
+                1,
+                "skipping checking bad state property %zu "
+                "at bound %d reached before at %d",
+                i,
+                k,
+                reached);
+      continue;
+    }
+    BTOR_MSG (boolector_get_btor_msg (btor),
+              1,
+              "checking forward frame bad state property %zu at bound k = %d",
+              i,
+              k);
+
+    boolector_assume (mc->forward, bad);
+    res = boolector_sat (mc->forward);
+    if (res == BOOLECTOR_SAT)
+    {
+      mc->state = BTOR_SAT_MC_STATE;
+      BTOR_MSG (boolector_get_btor_msg (btor),
+                1,
+                "bad state property %zu reachable at bound k = %d SATISFIABLE",
+                i,
+                k);
+      reachable++;
+      mark_reached (mc, i, k);
+
+      if (btor_mc_get_opt (mc, BTOR_MC_OPT_STOP_FIRST))
+        break;
+    }
+    else
+    {
+      assert (res == BOOLECTOR_UNSAT);
+
+      if (opt_kinduction)
+      {
+        if (!check_induction_step (mc, i, k))
+        {
+          mc->state = BTOR_NO_MC_STATE;
+        }
+        else
+        {
+          mc->state = BTOR_UNSAT_MC_STATE;
+          BTOR_MSG (boolector_get_btor_msg (btor),
+                    1,
+                    "bad state property %zu unreachable at bound k = %d "
+                    "UNSATISFIABLE",
+                    i,
+                    k);
+          mark_proven (mc, i, k);
+          unreachable++;
+        }
+      }
+      else
+      {
+        mc->state = BTOR_UNSAT_MC_STATE;
+        BTOR_MSG (boolector_get_btor_msg (btor),
+                  1,
+                  "bad state property %zu at bound k = %d UNSATISFIABLE",
+                  i,
+                  k);
+      }
+    }
+    if (btor_mc_get_opt (mc, BTOR_MC_OPT_BTOR_STATS))
+      boolector_print_stats (mc->forward);
+  }
+
+  BTOR_MSG (boolector_get_btor_msg (btor),
+            1,
+            "found %d reachable and %d unreachable bad state properties "
+            "at bound k = %d",
+            reachable,
+            unreachable,
+            k);
+
+  return reachable;
+}
+
+static bool
+has_arrays (BtorMC *mc)
+{
+  BtorPtrHashTableIterator it;
+
+  btor_iter_hashptr_init (&it, mc->inputs);
+  btor_iter_hashptr_queue (&it, mc->states);
+  while (btor_iter_hashptr_has_next (&it))
+    if (boolector_is_array (mc->btor, btor_iter_hashptr_next (&it)))
+      return true;
+  return false;
+}
+
+static int32_t unroller_bmc (BtorMC *mc, int32_t mink, int32_t maxk);
+
+int32_t
+btor_mc_bmc (BtorMC *mc, int32_t mink, int32_t maxk)
+{
+  assert (mc);
+
+  int32_t k;
+  Btor *btor;
+
+  btor = mc->btor;
+
+  mc_release_assignments (mc);
+  reduce_model (mc);
+
+  BTOR_MSG (boolector_get_btor_msg (btor),
+            1,
+            "calling BMC on %u properties from bound %d "
+            "up-to maximum bound k = %d",
+            BTOR_COUNT_STACK (mc->bad),
+            mink,
+            maxk);
+
+  BTOR_MSG (
+      boolector_get_btor_msg (btor),
+      1,
+      "trace generation %s",
+      btor_mc_get_opt (mc, BTOR_MC_OPT_TRACE_GEN) ? "enabled" : "disabled");
+
+  mc->state = BTOR_NO_MC_STATE;
+
+  if (btor_mc_get_opt (mc, BTOR_MC_OPT_AIG_UNROLL))
+  {
+    if (!has_arrays (mc)) return unroller_bmc (mc, mink, maxk);
+    BTOR_MSG (boolector_get_btor_msg (btor),
+              1,
+              "model with arrays, unrolling on the expression level");
+  }
+
+  while ((k = BTOR_COUNT_STACK (mc->frames)) <= maxk)
+  {
+    if (mc->call_backs.starting_bound.fun)
+    {
+      mc->call_backs.starting_bound.fun (mc->call_backs.starting_bound.state,
+                                         k);
+    }
+
+    initialize_new_forward_frame (mc);
+    if (k < mink) continue;
+    if (check_last_forward_frame (mc))
+    {
+      if (btor_mc_get_opt (mc, BTOR_MC_OPT_STOP_FIRST)
+          || mc->num_reached == BTOR_COUNT_STACK (mc->bad) || k == maxk)
+      {
+        BTOR_MSG (boolector_get_btor_msg (btor),
+                  2,
+                  "entering SAT state at bound k=%d",
+                  k);
+        assert (k >= 0);
+        return k;
+      }
+    }
+  }
+
+  BTOR_MSG (boolector_get_btor_msg (btor), 2, "entering UNSAT state");
+  mc->state = BTOR_UNSAT_MC_STATE;
+
+  return -1;
+}
+
+int32_t
+btor_mc_kind (BtorMC *mc, int32_t mink, int32_t maxk)
+{
+  assert (mc);
+
+  int32_t k;
+  Btor *btor;
+
+  btor = mc->btor;
+
+  mc_release_assignments (mc);
+  reduce_model (mc);
+
+  BTOR_MSG (boolector_get_btor_msg (btor),
+            1,
+            "calling k-induction on %u properties from bound %d "
+            "up-to maximum bound k = %d",
+            BTOR_COUNT_STACK (mc->bad),
+            mink,
+            maxk);
+
+  BTOR_MSG (
+      boolector_get_btor_msg (btor),
+      1,
+      "trace generation %s",
+      btor_mc_get_opt (mc, BTOR_MC_OPT_TRACE_GEN) ? "enabled" : "disabled");
+
+  mc->state = BTOR_NO_MC_STATE;
+
+  while ((k = BTOR_COUNT_STACK (mc->frames)) <= maxk)
+  {
+    if (mc->call_backs.starting_bound.fun)
+    {
+      mc->call_backs.starting_bound.fun (mc->call_backs.starting_bound.state,
+                                         k);
+    }
+
+    initialize_new_forward_frame (mc);
+    if (k < mink) continue;
+    (void) check_last_forward_frame (mc);
+    if (mc->state != BTOR_NO_MC_STATE)
+    {
+      if (btor_mc_get_opt (mc, BTOR_MC_OPT_STOP_FIRST)
+          || mc->num_reached == BTOR_COUNT_STACK (mc->bad) || k == maxk)
+      {
+        if (mc->state == BTOR_SAT_MC_STATE)
+        {
+          BTOR_MSG (boolector_get_btor_msg (btor),
+                    2,
+                    "entering SAT state at bound k=%d",
+                    k);
+          assert (k >= 0);
+          return k;
+        }
+        else
+        {
+          return k;
+        }
+      }
+    }
+  }
+
+  BTOR_MSG (boolector_get_btor_msg (btor), 2, "entering UNSAT state");
+  mc->state = BTOR_UNSAT_MC_STATE;
+
+  return -1;
+}
+
+/*------------------------------------------------------------------------*/
+
+/* The reduced model bit-blasted once into AIGs of a separate Boolector
+ * instance (bit-vector models only). PDR encodes these AIGs into the SAT
+ * solver of that instance, the AIG unroller instantiates them per frame. */
+
+struct BtorMCAIGModel
+{
+  Btor *btor;
+  BtorAIGMgr *amgr;
+  BtorSATMgr *smgr;
+  BtorVoidPtrStack aigvecs;    /* keeps the bit-blasted nodes alive */
+  BtorAIGPtrStack cur;         /* AIG variable of each state bit */
+  BtorAIGPtrStack next;        /* next state function bits */
+  BtorAIGPtrStack init;        /* initial state bits (the state bit if none) */
+  BtorAIGPtrStack constraints; /* one per environment constraint */
+  BtorAIGPtrStack bad;         /* one per bad state property (false if
+                                  reached) */
+  BtorAIGPtrStack inputs; /* next state bits of states without next state
+                             function (AIG variables owned by the model) */
+};
+
+typedef struct BtorMCAIGModel BtorMCAIGModel;
+
+static void
+aig_model_bitblast (BtorMCAIGModel *m,
+                    BoolectorNode *node,
+                    BtorAIGPtrStack *aigs)
+{
+  BtorAIGVec *av;
+  BtorNode *exp;
+  uint32_t i;
+
+  exp = btor_simplify_exp (m->btor, BTOR_IMPORT_BOOLECTOR_NODE (node));
+  av  = btor_exp_to_aigvec (m->btor, exp, 0);
+  BTOR_PUSH_STACK (m->aigvecs, av);
+  for (i = 0; i < av->width; i++) BTOR_PUSH_STACK (*aigs, av->aigs[i]);
+}
+
+
+static void
+aig_model_init (BtorMC *mc, BtorMCAIGModel *m)
+{
+  BtorMemMgr *mm;
+  Btor *btor;
+  BoolectorNodeMap *map;
+  BoolectorNodePtrStack vars;
+  BtorPtrHashTableIterator it;
+  BtorMCstate *state;
+  BoolectorNode *src, *dst;
+  BtorAIG *aig;
+  size_t i, n;
+  uint32_t j, v;
+
+  mm = mc->mm;
+  BTOR_CLR (m);
+  m->btor = btor = boolector_new ();
+  if ((v = btor_mc_get_opt (mc, BTOR_MC_OPT_VERBOSITY)))
+    boolector_set_opt (btor, BTOR_OPT_VERBOSITY, v);
+  m->amgr = btor_get_aig_mgr (btor);
+  m->smgr = btor_get_sat_mgr (btor);
+  btor_sat_enable_solver (m->smgr);
+  btor_sat_init (m->smgr);
+
+  BTOR_INIT_STACK (mm, m->aigvecs);
+  BTOR_INIT_STACK (mm, m->cur);
+  BTOR_INIT_STACK (mm, m->next);
+  BTOR_INIT_STACK (mm, m->init);
+  BTOR_INIT_STACK (mm, m->constraints);
+  BTOR_INIT_STACK (mm, m->bad);
+  BTOR_INIT_STACK (mm, m->inputs);
+  BTOR_INIT_STACK (mm, vars);
+
+  map = boolector_nodemap_new (btor);
+
+  btor_iter_hashptr_init (&it, mc->inputs);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    src = btor_iter_hashptr_next (&it);
+    dst = new_var_or_array (mc, btor, src, 0);
+    boolector_nodemap_map (map, src, dst);
+    BTOR_PUSH_STACK (vars, dst);
+  }
+
+  /* only states in the cone of influence are bit-blasted, constant and
+   * merged states are replaced */
+  btor_iter_hashptr_init (&it, mc->states);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    state = it.bucket->data.as_ptr;
+    src   = btor_iter_hashptr_next (&it);
+    if (state->constant)
+    {
+      dst = boolector_nodemap_substitute_node (btor, map, state->constant);
+      dst = boolector_copy (btor, dst);
+    }
+    else if (!state->repr->coi)
+      continue;
+    else if (state->repr != state)
+      dst = boolector_copy (btor,
+                            boolector_nodemap_mapped (map, state->repr->node));
+    else
+    {
+      dst = new_var_or_array (mc, btor, src, 0);
+      aig_model_bitblast (m, dst, &m->cur);
+    }
+    boolector_nodemap_map (map, src, dst);
+    BTOR_PUSH_STACK (vars, dst);
+  }
+
+  /* next state functions and initial states */
+  btor_iter_hashptr_init (&it, mc->states);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    state = it.bucket->data.as_ptr;
+    src   = btor_iter_hashptr_next (&it);
+    if (!is_unrolled_state (state)) continue;
+    if (state->next)
+    {
+      dst = boolector_nodemap_substitute_node (btor, map, state->next);
+      aig_model_bitblast (m, dst, &m->next);
+    }
+    else
+    {
+      for (j = 0; j < boolector_get_width (mc->btor, src); j++)
+      {
+        aig = btor_aig_var (m->amgr);
+        BTOR_PUSH_STACK (m->inputs, aig);
+        BTOR_PUSH_STACK (m->next, aig);
+      }
+    }
+    if (state->init)
+    {
+      dst = boolector_nodemap_substitute_node (btor, map, state->init);
+      aig_model_bitblast (m, dst, &m->init);
+    }
+    else
+    {
+      n = BTOR_COUNT_STACK (m->init);
+      for (j = 0; j < boolector_get_width (mc->btor, src); j++)
+        BTOR_PUSH_STACK (m->init, BTOR_PEEK_STACK (m->cur, n + j));
+    }
+  }
+  assert (BTOR_COUNT_STACK (m->cur) == BTOR_COUNT_STACK (m->next));
+  assert (BTOR_COUNT_STACK (m->cur) == BTOR_COUNT_STACK (m->init));
+
+  for (i = 0; i < BTOR_COUNT_STACK (mc->constraints); i++)
+  {
+    src = BTOR_PEEK_STACK (mc->constraints, i);
+    dst = boolector_nodemap_substitute_node (btor, map, src);
+    aig_model_bitblast (m, dst, &m->constraints);
+  }
+
+  for (i = 0; i < BTOR_COUNT_STACK (mc->bad); i++)
+  {
+    if (BTOR_PEEK_STACK (mc->reached, i) >= 0)
+    {
+      BTOR_PUSH_STACK (m->bad, BTOR_AIG_FALSE);
+      continue;
+    }
+    src = BTOR_PEEK_STACK (mc->bad, i);
+    dst = boolector_nodemap_substitute_node (btor, map, src);
+    aig_model_bitblast (m, dst, &m->bad);
+  }
+
+  boolector_nodemap_delete (map);
+  while (!BTOR_EMPTY_STACK (vars))
+    boolector_release (btor, BTOR_POP_STACK (vars));
+  BTOR_RELEASE_STACK (vars);
+
+  BTOR_MSG (boolector_get_btor_msg (mc->btor),
+            1,
+            "bit-blasted transition relation: %u state bits",
+            BTOR_COUNT_STACK (m->cur));
+}
+
+static void
+aig_model_release (BtorMCAIGModel *m)
+{
+  while (!BTOR_EMPTY_STACK (m->aigvecs))
+    btor_aigvec_release_delete (m->btor->avmgr, BTOR_POP_STACK (m->aigvecs));
+  BTOR_RELEASE_STACK (m->aigvecs);
+  BTOR_RELEASE_STACK (m->cur);
+  BTOR_RELEASE_STACK (m->next);
+  BTOR_RELEASE_STACK (m->init);
+  BTOR_RELEASE_STACK (m->constraints);
+  BTOR_RELEASE_STACK (m->bad);
+  while (!BTOR_EMPTY_STACK (m->inputs))
+    btor_aig_release (m->amgr, BTOR_POP_STACK (m->inputs));
+  BTOR_RELEASE_STACK (m->inputs);
+  boolector_delete (m->btor);
+}
+
+/* Encodes 'aig' into the SAT solver and returns its literal. */
+static int32_t
+aig_model_encode (BtorMCAIGModel *m, BtorAIG *aig)
+{
+  btor_aig_to_sat_tseitin (m->amgr, aig);
+  return btor_aig_get_cnf_id (aig);
+}
+
+/*------------------------------------------------------------------------*/
+
+/* BMC on the bit-blasted transition relation.
+ *
+ * The AIGs of the model are translated once into a clause template over
+ * template variables (1 is the constant true, followed by the state bits,
+ * the inputs and the AND gates). A frame is instantiated by renumbering the
+ * template variables to SAT variables and adding the renumbered clauses
+ * directly to the SAT solver, where the state bits of frame k + 1 are the
+ * next state function literals of frame k. Variables of a frame are released
+ * as soon as the next frame is instantiated, except for those carried over
+ * as state bits. Clauses only needed for the initial states are kept
+ * separately and instantiated in frame 0 only. */
+
+struct BtorMCUnroller
+{
+  BtorMC *mc;
+  BtorMCAIGModel model;
+  BtorSATMgr *smgr;
+  BtorIntHashTable *tvars;   /* template variable of each AIG id */
+  int32_t num_tvars;         /* number of template variables */
+  BtorIntStack clauses;      /* template clauses of the transition relation */
+  BtorIntStack init_clauses; /* template clauses of the initial states */
+  BtorIntStack next;         /* template literals of next state functions */
+  BtorIntStack constraints;  /* template literals of constraints */
+  BtorIntStack bad;          /* template literals of bad state properties */
+  int32_t init;              /* template literal of the initial states */
+  BtorIntStack lits;         /* SAT literal of each template variable */
+  BtorIntStack state;        /* SAT literals of the state bits */
+  BtorIntStack badlits;      /* SAT literals of the bad state properties */
+  BtorIntStack vars, prev;   /* SAT variables of current and previous frame */
+  BtorIntStack buf;          /* renumbered clauses of the current frame */
+  int32_t num_frames;
+};
+
+static int32_t
+unroller_new_tvar (BtorMCUnroller *u, BtorAIG *aig)
+{
+  assert (!btor_hashint_map_contains (u->tvars, aig->id));
+  btor_hashint_map_add (u->tvars, aig->id)->as_int = ++u->num_tvars;
+  return u->num_tvars;
+}
+
+static int32_t
+unroller_get_tlit (BtorMCUnroller *u, BtorAIG *aig)
+{
+  int32_t res;
+
+  if (aig == BTOR_AIG_TRUE) return 1;
+  if (aig == BTOR_AIG_FALSE) return -1;
+  res = btor_hashint_map_get (u->tvars, BTOR_REAL_ADDR_AIG (aig)->id)->as_int;
+  return BTOR_IS_INVERTED_AIG (aig) ? -res : res;
+}
+
+/* Translates the AIG cone of 'root' not translated before into template
+ * clauses added to 'clauses' and returns the template literal of 'root'. */
+static int32_t
+unroller_translate (BtorMCUnroller *u, BtorAIG *root, BtorIntStack *clauses)
+{
+  BtorAIGPtrStack stack;
+  BtorAIG *cur, *l, *r;
+  int32_t x, a, b;
+  bool ready;
+
+  BTOR_INIT_STACK (u->mc->mm, stack);
+  if (!btor_aig_is_const (root))
+    BTOR_PUSH_STACK (stack, BTOR_REAL_ADDR_AIG (root));
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_TOP_STACK (stack);
+    if (btor_hashint_map_contains (u->tvars, cur->id))
+    {
+      (void) BTOR_POP_STACK (stack);
+      continue;
+    }
+    if (btor_aig_is_var (cur))
+    {
+      (void) BTOR_POP_STACK (stack);
+      unroller_new_tvar (u, cur);
+      continue;
+    }
+    assert (btor_aig_is_and (cur));
+    l     = btor_aig_get_left_child (u->model.amgr, cur);
+    r     = btor_aig_get_right_child (u->model.amgr, cur);
+    ready = true;
+    if (!btor_hashint_map_contains (u->tvars, BTOR_REAL_ADDR_AIG (l)->id))
+    {
+      BTOR_PUSH_STACK (stack, BTOR_REAL_ADDR_AIG (l));
+      ready = false;
+    }
+    if (!btor_hashint_map_contains (u->tvars, BTOR_REAL_ADDR_AIG (r)->id))
+    {
+      BTOR_PUSH_STACK (stack, BTOR_REAL_ADDR_AIG (r));
+      ready = false;
     }
-    else
-      dst = 0;
-
-    BTOR_PUSH_STACK (f->bad, dst);
+    if (!ready) continue;
+    (void) BTOR_POP_STACK (stack);
+    x = unroller_new_tvar (u, cur);
+    a = unroller_get_tlit (u, l);
+    b = unroller_get_tlit (u, r);
+    BTOR_PUSH_STACK (*clauses, -x);
+    BTOR_PUSH_STACK (*clauses, a);
+    BTOR_PUSH_STACK (*clauses, 0);
+    BTOR_PUSH_STACK (*clauses, -x);
+    BTOR_PUSH_STACK (*clauses, b);
+    BTOR_PUSH_STACK (*clauses, 0);
+    BTOR_PUSH_STACK (*clauses, x);
+    BTOR_PUSH_STACK (*clauses, -a);
+    BTOR_PUSH_STACK (*clauses, -b);
+    BTOR_PUSH_STACK (*clauses, 0);
   }
+  BTOR_RELEASE_STACK (stack);
+  return unroller_get_tlit (u, root);
 }
 
-static void
-initialize_new_forward_frame (BtorMC *mc)
+static BtorMCUnroller *
+unroller_new (BtorMC *mc)
 {
-  assert (mc);
-
-  Btor *btor;
-  BtorMCFrame frame, *f;
-  BoolectorNodeMap *map;
-  int32_t time;
-
-  btor = mc->btor;
-
-  time = BTOR_COUNT_STACK (mc->frames);
-  BTOR_CLR (&frame);
-  BTOR_PUSH_STACK (mc->frames, frame);
-  f       = mc->frames.start + time;
-  f->time = time;
+  BtorMCUnroller *u;
+  BtorMemMgr *mm;
+  BtorMCAIGModel *m;
+  BtorAIG *init, *eq, *tmp;
+  size_t i;
 
-  if (!mc->forward)
+  mm = mc->mm;
+  BTOR_CNEW (mm, u);
+  u->mc = mc;
+  m     = &u->model;
+  aig_model_init (mc, m);
+  u->smgr  = m->smgr;
+  u->tvars = btor_hashint_map_new (mm);
+
+  BTOR_INIT_STACK (mm, u->clauses);
+  BTOR_INIT_STACK (mm, u->init_clauses);
+  BTOR_INIT_STACK (mm, u->next);
+  BTOR_INIT_STACK (mm, u->constraints);
+  BTOR_INIT_STACK (mm, u->bad);
+  BTOR_INIT_STACK (mm, u->lits);
+  BTOR_INIT_STACK (mm, u->state);
+  BTOR_INIT_STACK (mm, u->badlits);
+  BTOR_INIT_STACK (mm, u->vars);
+  BTOR_INIT_STACK (mm, u->prev);
+  BTOR_INIT_STACK (mm, u->buf);
+
+  /* template variable 1 is the constant true, followed by the state bits */
+  u->num_tvars = 1;
+  for (i = 0; i < BTOR_COUNT_STACK (m->cur); i++)
+    unroller_new_tvar (u, BTOR_PEEK_STACK (m->cur, i));
+
+  for (i = 0; i < BTOR_COUNT_STACK (m->next); i++)
+    BTOR_PUSH_STACK (
+        u->next,
+        unroller_translate (u, BTOR_PEEK_STACK (m->next, i), &u->clauses));
+  for (i = 0; i < BTOR_COUNT_STACK (m->constraints); i++)
+    BTOR_PUSH_STACK (u->constraints,
+                     unroller_translate (
+                         u, BTOR_PEEK_STACK (m->constraints, i), &u->clauses));
+  for (i = 0; i < BTOR_COUNT_STACK (m->bad); i++)
+    BTOR_PUSH_STACK (
+        u->bad,
+        unroller_translate (u, BTOR_PEEK_STACK (m->bad, i), &u->clauses));
+
+  init = BTOR_AIG_TRUE;
+  for (i = 0; i < BTOR_COUNT_STACK (m->cur); i++)
   {
-    uint32_t v;
-    BTOR_MSG (boolector_get_btor_msg (btor), 1, "new forward manager");
-    mc->forward = boolector_new ();
-    boolector_set_opt (mc->forward, BTOR_OPT_INCREMENTAL, 1);
-    if (btor_mc_get_opt (mc, BTOR_MC_OPT_TRACE_GEN))
-      boolector_set_opt (mc->forward, BTOR_OPT_MODEL_GEN, 1);
-    if ((v = btor_mc_get_opt (mc, BTOR_MC_OPT_VERBOSITY)))
-      boolector_set_opt (mc->forward, BTOR_OPT_VERBOSITY, v);
+    eq  = btor_aig_eq (m->amgr,
+                      BTOR_PEEK_STACK (m->cur, i),
+                      BTOR_PEEK_STACK (m->init, i));
+    tmp = btor_aig_and (m->amgr, init, eq);
+    btor_aig_release (m->amgr, init);
+    btor_aig_release (m->amgr, eq);
+    init = tmp;
   }
+  u->init = unroller_translate (u, init, &u->init_clauses);
+  btor_aig_release (m->amgr, init);
 
-  BTOR_INIT_STACK (mc->mm, f->init);
+  BTOR_MSG (boolector_get_btor_msg (mc->btor),
+            1,
+            "unrolling template: %d variables, %zu literals per frame",
+            u->num_tvars,
+            BTOR_COUNT_STACK (u->clauses));
+  return u;
+}
 
-  map = boolector_nodemap_new (mc->forward);
+static void
+unroller_delete (BtorMCUnroller *u)
+{
+  BtorMemMgr *mm = u->mc->mm;
+
+  btor_hashint_map_delete (u->tvars);
+  BTOR_RELEASE_STACK (u->clauses);
+  BTOR_RELEASE_STACK (u->init_clauses);
+  BTOR_RELEASE_STACK (u->next);
+  BTOR_RELEASE_STACK (u->constraints);
+  BTOR_RELEASE_STACK (u->bad);
+  BTOR_RELEASE_STACK (u->lits);
+  BTOR_RELEASE_STACK (u->state);
+  BTOR_RELEASE_STACK (u->badlits);
+  BTOR_RELEASE_STACK (u->vars);
+  BTOR_RELEASE_STACK (u->prev);
+  BTOR_RELEASE_STACK (u->buf);
+  aig_model_release (&u->model);
+  BTOR_DELETE (mm, u);
+}
 
-  initialize_inputs_of_frame (mc, map, f);
-  initialize_states_of_frame (mc, map, f);
-  initialize_next_state_functions_of_frame (mc, map, f);
-  initialize_constraints_of_frame (mc, map, f);
-  initialize_bad_state_properties_of_frame (mc, map, f);
+/* Returns the SAT literal of template literal 'tlit' in the current frame. */
+static int32_t
+unroller_lit (BtorMCUnroller *u, int32_t tlit)
+{
+  int32_t v, res;
 
-  boolector_nodemap_delete (map);
+  v   = abs (tlit);
+  res = BTOR_PEEK_STACK (u->lits, v);
+  if (!res)
+  {
+    res = btor_sat_mgr_next_cnf_id (u->smgr);
+    BTOR_POKE_STACK (u->lits, v, res);
+    BTOR_PUSH_STACK (u->vars, res);
+  }
+  return tlit < 0 ? -res : res;
+}
 
-  BTOR_MSG (boolector_get_btor_msg (btor),
-            1,
-            "initialized forward frame at bound k = %d",
-            time);
+static void
+unroller_add_clauses (BtorMCUnroller *u, BtorIntStack *clauses)
+{
+  int32_t *p;
+
+  BTOR_RESET_STACK (u->buf);
+  for (p = clauses->start; p < clauses->top; p++)
+    BTOR_PUSH_STACK (u->buf, *p ? unroller_lit (u, *p) : 0);
+  btor_sat_add_clauses (u->smgr, u->buf.start, BTOR_COUNT_STACK (u->buf));
 }
 
 static void
-print_witness_at_time (BtorMC *mc, BoolectorNode *node, int32_t time)
+unroller_add_frame (BtorMCUnroller *u)
 {
-  bool is_bv;
-  const char *default_sym, *sym, *value;
-  char **indices = 0, **values = 0;
-  uint32_t i, size, id;
-  BtorPtrHashBucket *b;
-  BtorMCInput *input;
-  BtorMCstate *state;
-  BoolectorNode *node_at_time;
-  BtorMCFrame *frame;
-  Btor *btor, *fwd;
+  BtorIntHashTable *carried;
+  BtorIntStack tmp;
+  int32_t *p, v;
+  size_t i;
 
-  btor  = mc->btor;
-  fwd   = mc->forward;
-  is_bv = boolector_is_bitvec_sort (btor, boolector_get_sort (btor, node));
-  frame = mc->frames.start + time;
-  b     = btor_hashptr_table_get (mc->states, node);
-  const bool is_state = (b != 0);
-  if (b)
+  tmp     = u->prev;
+  u->prev = u->vars;
+  u->vars = tmp;
+  BTOR_RESET_STACK (u->vars);
+
+  BTOR_RESET_STACK (u->lits);
+  for (v = 0; v <= u->num_tvars; v++) BTOR_PUSH_STACK (u->lits, 0);
+  BTOR_POKE_STACK (u->lits, 1, u->smgr->true_lit);
+  for (i = 0; i < BTOR_COUNT_STACK (u->state); i++)
+    BTOR_POKE_STACK (u->lits, i + 2, BTOR_PEEK_STACK (u->state, i));
+
+  if (!u->num_frames)
   {
-    state        = b->data.as_ptr;
-    id           = state->id;
-    node_at_time = BTOR_PEEK_STACK (frame->states, id);
-    default_sym  = "state";
+    unroller_add_clauses (u, &u->init_clauses);
+    btor_sat_add (u->smgr, unroller_lit (u, u->init));
+    btor_sat_add (u->smgr, 0);
   }
-  else
+  unroller_add_clauses (u, &u->clauses);
+
+  for (i = 0; i < BTOR_COUNT_STACK (u->constraints); i++)
   {
-    b = btor_hashptr_table_get (mc->inputs, node);
-    assert (b);
-    input        = b->data.as_ptr;
-    id           = input->id;
-    node_at_time = BTOR_PEEK_STACK (frame->inputs, id);
-    default_sym  = "input";
+    btor_sat_add (u->smgr,
+                  unroller_lit (u, BTOR_PEEK_STACK (u->constraints, i)));
+    btor_sat_add (u->smgr, 0);
   }
 
-  if (is_bv)
-    value = boolector_bv_assignment (fwd, node_at_time);
-  else
-    boolector_array_assignment (fwd, node_at_time, &indices, &values, &size);
-
-  sym = boolector_get_symbol (mc->btor, node);
-  if (is_bv)
+  BTOR_RESET_STACK (u->badlits);
+  for (i = 0; i < BTOR_COUNT_STACK (u->bad); i++)
   {
-    assert (value);
-    printf ("%d %s", id, value);
-    if (sym)
-      printf (" %s", sym);
+    if (BTOR_PEEK_STACK (u->mc->reached, i) >= 0)
+      BTOR_PUSH_STACK (u->badlits, 0);
     else
-      printf (" %s%d", default_sym, id);
-    printf ("%c%d\n", is_state ? '#' : '@', time);
-    boolector_free_bv_assignment (fwd, value);
+      BTOR_PUSH_STACK (u->badlits,
+                       unroller_lit (u, BTOR_PEEK_STACK (u->bad, i)));
   }
-  else
+
+  BTOR_RESET_STACK (u->state);
+  for (i = 0; i < BTOR_COUNT_STACK (u->next); i++)
+    BTOR_PUSH_STACK (u->state, unroller_lit (u, BTOR_PEEK_STACK (u->next, i)));
+
+  /* the previous frame is only referenced through the state bits */
+  carried = btor_hashint_table_new (u->mc->mm);
+  for (i = 0; i < BTOR_COUNT_STACK (u->lits); i++)
   {
-    for (i = 0; i < size; i++)
-    {
-      printf ("%d [%s] %s", id, indices[i], values[i]);
-      if (sym)
-        printf (" %s", sym);
-      else
-        printf (" %s%d", default_sym, id);
-      printf ("@%d\n", time);
-    }
-    boolector_free_array_assignment (fwd, indices, values, size);
+    v = abs (BTOR_PEEK_STACK (u->lits, i));
+    if (v && !btor_hashint_table_contains (carried, v))
+      btor_hashint_table_add (carried, v);
   }
+  for (p = u->prev.start; p < u->prev.top; p++)
+  {
+    if (btor_hashint_table_contains (carried, *p))
+      BTOR_PUSH_STACK (u->vars, *p);
+    else
+      btor_sat_mgr_release_cnf_id (u->smgr, *p);
+  }
+  btor_hashint_table_delete (carried);
+
+  u->num_frames++;
 }
 
-static void
-print_witness (BtorMC *mc, int32_t time, size_t bad_id)
+static int32_t
+unroller_check_last_frame (BtorMCUnroller *u)
 {
-  assert (time >= 0);
-  assert (BTOR_PEEK_STACK (mc->reached, bad_id) == time);
-
+  BtorMC *mc;
+  Btor *btor;
+  int32_t k, bad, res, reachable;
   size_t i;
-  BtorMCstate *state;
-  BoolectorNode *src;
-  BtorPtrHashTableIterator it;
-  bool full_trace, printed_state_header;
 
-  full_trace = btor_mc_get_opt (mc, BTOR_MC_OPT_TRACE_GEN_FULL) == 1;
+  mc        = u->mc;
+  btor      = mc->btor;
+  k         = u->num_frames - 1;
+  reachable = 0;
 
-  printf ("sat\nb%zu\n", bad_id);
+  BTOR_MSG (boolector_get_btor_msg (btor),
+            1,
+            "checking unrolled frame at bound k = %d",
+            k);
 
-  for (i = 0; i <= (size_t) time; i++)
+  for (i = 0; i < BTOR_COUNT_STACK (u->badlits); i++)
   {
-    /* We have to print the state assignments if
-     * 1) the state is uninitialized
-     * 2) the state has no next function (primary input)
-     * 3) the user wants a full trace
-     * In all other cases the state part can be omitted. */
-    printed_state_header = false;
-    btor_iter_hashptr_init (&it, mc->states);
-    while (btor_iter_hashptr_has_next (&it))
+    bad = BTOR_PEEK_STACK (u->badlits, i);
+    if (!bad || BTOR_PEEK_STACK (mc->reached, i) >= 0) continue;
+
+    btor_sat_assume (u->smgr, bad);
+    res = btor_sat_check_sat (u->smgr, -1);
+    if (res == BTOR_RESULT_SAT)
     {
-      state = it.bucket->data.as_ptr;
-      assert (state);
-      src = (BoolectorNode *) btor_iter_hashptr_next (&it);
-      if (((i == 0) && !state->init) || !state->next || full_trace)
-      {
-        if (!printed_state_header)
-        {
-          printed_state_header = true;
-          printf ("#%zu\n", i);
-        }
-        print_witness_at_time (mc, src, i);
-      }
-    }
+      mc->state = BTOR_SAT_MC_STATE;
+      BTOR_MSG (boolector_get_btor_msg (btor),
+                1,
+                "bad state property %zu reachable at bound k = %d SATISFIABLE",
+                i,
+                k);
+      reachable++;
+      replay_on_forward_frames (mc, i, k);
+      mark_reached (mc, i, k);
 
-    printf ("@%zu\n", i);
-    btor_iter_hashptr_init (&it, mc->inputs);
-    while (btor_iter_hashptr_has_next (&it))
+      if (btor_mc_get_opt (mc, BTOR_MC_OPT_STOP_FIRST)) break;
+    }
+    else
     {
-      src = (BoolectorNode *) btor_iter_hashptr_next (&it);
-      print_witness_at_time (mc, src, i);
+      assert (res == BTOR_RESULT_UNSAT);
+      mc->state = BTOR_UNSAT_MC_STATE;
+      BTOR_MSG (boolector_get_btor_msg (btor),
+                1,
+                "bad state property %zu at bound k = %d UNSATISFIABLE",
+                i,
+                k);
     }
+    if (btor_mc_get_opt (mc, BTOR_MC_OPT_BTOR_STATS))
+      btor_sat_print_stats (u->smgr);
   }
-  printf (".\n");
-  fflush (stdout);
+
+  return reachable;
 }
 
-/* Check whether n1 and n2 are distinct. For bit-vectors we check if the values
- * are distinct, for arrays we check if the arrays differ on at least one
- * index. */
-static bool
-is_distinct (Btor *btor, BoolectorNode *n1, BoolectorNode *n2)
+static int32_t
+unroller_bmc (BtorMC *mc, int32_t mink, int32_t maxk)
 {
-  bool res = false;
-  const char *val1, *val2;
-  char **indices1 = 0, **indices2 = 0, **values1 = 0, **values2 = 0;
-  uint32_t i, size1, size2;
-  BtorPtrHashTable *cache;
-  BtorPtrHashBucket *b;
-
-  if (boolector_is_array (btor, n1))
-  {
-    assert (boolector_is_array (btor, n2));
-    cache = btor_hashptr_table_new (btor->mm, btor_hash_str, btor_compare_str);
+  BtorMCUnroller *u;
+  int32_t k;
+  Btor *btor;
 
-    boolector_array_assignment (btor, n1, &indices1, &values1, &size1);
-    boolector_array_assignment (btor, n2, &indices2, &values2, &size2);
+  btor = mc->btor;
+  if (!mc->unroller) mc->unroller = unroller_new (mc);
+  u = mc->unroller;
 
-    for (i = 0; i < size1; i++)
+  while ((k = u->num_frames) <= maxk)
+  {
+    if (mc->call_backs.starting_bound.fun)
     {
-      assert (!btor_hashptr_table_get (cache, indices1[i]));
-      btor_hashptr_table_add (cache, indices1[i])->data.as_str = values1[i];
+      mc->call_backs.starting_bound.fun (mc->call_backs.starting_bound.state,
+                                         k);
     }
-    for (i = 0; i < size2; i++)
+
+    unroller_add_frame (u);
+    if (k < mink) continue;
+    if (unroller_check_last_frame (u))
     {
-      if ((b = btor_hashptr_table_get (cache, indices2[i])))
+      if (btor_mc_get_opt (mc, BTOR_MC_OPT_STOP_FIRST)
+          || mc->num_reached == BTOR_COUNT_STACK (mc->bad) || k == maxk)
       {
-        if (strcmp (b->data.as_str, values2[i]))
-        {
-          res = true;
-          break;
-        }
+        BTOR_MSG (boolector_get_btor_msg (btor),
+                  2,
+                  "entering SAT state at bound k=%d",
+                  k);
+        return k;
       }
     }
-    boolector_free_array_assignment (btor, indices1, values1, size1);
-    boolector_free_array_assignment (btor, indices2, values2, size2);
-  }
-  else
-  {
-    val1 = boolector_bv_assignment (btor, n1);
-    val2 = boolector_bv_assignment (btor, n2);
-    res  = strcmp (val1, val2) != 0;
-    boolector_free_bv_assignment (btor, val1);
-    boolector_free_bv_assignment (btor, val2);
   }
-  return res;
+
+  BTOR_MSG (boolector_get_btor_msg (btor), 2, "entering UNSAT state");
+  mc->state = BTOR_UNSAT_MC_STATE;
+
+  return -1;
 }
 
-static BoolectorNode *
-create_distinct_state (BtorMC *mc, BtorMCFrame *f1, BtorMCFrame *f2)
-{
-  assert (BTOR_COUNT_STACK (f1->states) == BTOR_COUNT_STACK (f2->states));
+/*------------------------------------------------------------------------*/
 
-  size_t i, num_states;
-  bool distinct = false;
-  Btor *btor;
-  BoolectorNode *s1, *s2, *res = 0, *tmp, *eq;
+/* IC3 / property directed reachability.
+ *
+ * The bit-blasted model is encoded once, all queries are then solved
+ * incrementally by the SAT solver of its Boolector instance under
+ * assumptions. Frame F_k (k > 0) is the conjunction of all
+ * lemmas at levels >= k, where a lemma blocking cube c at level k is added
+ * as clause (-act_k | -c). The activation literal act_0 guards the initial
+ * states, hence F_0 = I. Cubes are stored as signed state bit indices
+ * '+/-(bit + 1)', lemmas and proof obligations in flat integer stacks. */
+
+struct BtorMCPDR
+{
+  BtorMC *mc;
+  BtorMCAIGModel model;
+  BtorSATMgr *smgr;
+  BtorIntStack cur;         /* literal of each state bit */
+  BtorIntStack next;        /* literal of the next state function bits */
+  BtorIntStack bad;         /* literal of each bad state property */
+  BtorIntStack act;         /* activation literal of each frame */
+  BtorIntStack lemmas;      /* level, size, literals (per lemma) */
+  BtorIntStack obligations; /* literals, size, level (per obligation) */
+  BtorIntStack cube, pred, tmp;
+  int32_t depth; /* length of the counterexample found */
+};
 
-  btor       = mc->forward;
-  num_states = BTOR_COUNT_STACK (f1->states);
-  for (i = 0; i < num_states; i++)
-  {
-    s1 = BTOR_PEEK_STACK (f1->states, i);
-    s2 = BTOR_PEEK_STACK (f2->states, i);
+typedef struct BtorMCPDR BtorMCPDR;
 
-    if (is_distinct (btor, s1, s2))
-    {
-      distinct = true;
-      break;
-    }
+static BtorMCPDR *
+pdr_new (BtorMC *mc)
+{
+  BtorMCPDR *pdr;
+  BtorMemMgr *mm;
+  BtorMCAIGModel *m;
+  BtorAIG *aig, *init, *eq, *tmp;
+  int32_t lit;
+  size_t i;
 
-    eq = boolector_eq (btor, s1, s2);
-    if (res)
-    {
-      tmp = boolector_and (btor, res, eq);
-      boolector_release (btor, res);
-      boolector_release (btor, eq);
-      res = tmp;
-    }
-    else
-    {
-      res = eq;
-    }
+  mm = mc->mm;
+  BTOR_CNEW (mm, pdr);
+  pdr->mc = mc;
+  m       = &pdr->model;
+  aig_model_init (mc, m);
+  pdr->smgr = m->smgr;
+
+  BTOR_INIT_STACK (mm, pdr->cur);
+  BTOR_INIT_STACK (mm, pdr->next);
+  BTOR_INIT_STACK (mm, pdr->bad);
+  BTOR_INIT_STACK (mm, pdr->act);
+  BTOR_INIT_STACK (mm, pdr->lemmas);
+  BTOR_INIT_STACK (mm, pdr->obligations);
+  BTOR_INIT_STACK (mm, pdr->cube);
+  BTOR_INIT_STACK (mm, pdr->pred);
+  BTOR_INIT_STACK (mm, pdr->tmp);
+
+  /* state bits, next state functions and initial states */
+  init = BTOR_AIG_TRUE;
+  for (i = 0; i < BTOR_COUNT_STACK (m->cur); i++)
+  {
+    aig = BTOR_PEEK_STACK (m->cur, i);
+    BTOR_PUSH_STACK (pdr->cur, aig_model_encode (m, aig));
+    BTOR_PUSH_STACK (pdr->next,
+                     aig_model_encode (m, BTOR_PEEK_STACK (m->next, i)));
+    eq  = btor_aig_eq (m->amgr, aig, BTOR_PEEK_STACK (m->init, i));
+    tmp = btor_aig_and (m->amgr, init, eq);
+    btor_aig_release (m->amgr, init);
+    btor_aig_release (m->amgr, eq);
+    init = tmp;
+  }
+  lit = aig_model_encode (m, init);
+  btor_aig_release (m->amgr, init);
+  BTOR_PUSH_STACK (pdr->act, btor_sat_mgr_next_cnf_id (pdr->smgr));
+  btor_sat_add (pdr->smgr, -BTOR_PEEK_STACK (pdr->act, 0));
+  btor_sat_add (pdr->smgr, lit);
+  btor_sat_add (pdr->smgr, 0);
+
+  /* environment constraints hold in every state */
+  for (i = 0; i < BTOR_COUNT_STACK (m->constraints); i++)
+  {
+    aig = BTOR_PEEK_STACK (m->constraints, i);
+    btor_sat_add (pdr->smgr, aig_model_encode (m, aig));
+    btor_sat_add (pdr->smgr, 0);
   }
 
-  if (distinct)
+  for (i = 0; i < BTOR_COUNT_STACK (m->bad); i++)
   {
-    if (res) boolector_release (btor, res);
-    res = 0;
+    if (BTOR_PEEK_STACK (mc->reached, i) >= 0)
+      BTOR_PUSH_STACK (pdr->bad, 0);
+    else
+      BTOR_PUSH_STACK (pdr->bad,
+                       aig_model_encode (m, BTOR_PEEK_STACK (m->bad, i)));
   }
-  else
+
+  return pdr;
+}
+
+static void
+pdr_delete (BtorMCPDR *pdr)
+{
+  BTOR_RELEASE_STACK (pdr->cur);
+  BTOR_RELEASE_STACK (pdr->next);
+  BTOR_RELEASE_STACK (pdr->bad);
+  BTOR_RELEASE_STACK (pdr->act);
+  BTOR_RELEASE_STACK (pdr->lemmas);
+  BTOR_RELEASE_STACK (pdr->obligations);
+  BTOR_RELEASE_STACK (pdr->cube);
+  BTOR_RELEASE_STACK (pdr->pred);
+  BTOR_RELEASE_STACK (pdr->tmp);
+  aig_model_release (&pdr->model);
+  BTOR_DELETE (pdr->mc->mm, pdr);
+}
+
+static int32_t
+pdr_cur_lit (BtorMCPDR *pdr, int32_t l)
+{
+  int32_t lit = BTOR_PEEK_STACK (pdr->cur, abs (l) - 1);
+  return l < 0 ? -lit : lit;
+}
+
+static int32_t
+pdr_next_lit (BtorMCPDR *pdr, int32_t l)
+{
+  int32_t lit = BTOR_PEEK_STACK (pdr->next, abs (l) - 1);
+  return l < 0 ? -lit : lit;
+}
+
+static int32_t
+pdr_num_frames (BtorMCPDR *pdr)
+{
+  return BTOR_COUNT_STACK (pdr->act) - 1;
+}
+
+static void
+pdr_assume_frame (BtorMCPDR *pdr, int32_t k)
+{
+  size_t j;
+  for (j = k; j < BTOR_COUNT_STACK (pdr->act); j++)
+    btor_sat_assume (pdr->smgr, BTOR_PEEK_STACK (pdr->act, j));
+}
+
+static bool
+pdr_sat (BtorMCPDR *pdr)
+{
+  BtorSolverResult res = btor_sat_check_sat (pdr->smgr, -1);
+  assert (res == BTOR_RESULT_SAT || res == BTOR_RESULT_UNSAT);
+  return res == BTOR_RESULT_SAT;
+}
+
+/* Stores the state of the current model as cube. */
+static void
+pdr_get_state (BtorMCPDR *pdr, BtorIntStack *cube)
+{
+  int32_t b;
+
+  BTOR_RESET_STACK (*cube);
+  for (b = 0; b < (int32_t) BTOR_COUNT_STACK (pdr->cur); b++)
   {
-    assert (res);
-    tmp = boolector_not (btor, res);
-    boolector_release (btor, res);
-    res = tmp;
+    if (btor_sat_deref (pdr->smgr, BTOR_PEEK_STACK (pdr->cur, b)) > 0)
+      BTOR_PUSH_STACK (*cube, b + 1);
+    else
+      BTOR_PUSH_STACK (*cube, -(b + 1));
   }
-  return res;
 }
 
 static bool
-add_simple_path_constraints (BtorMC *mc)
+pdr_intersects_init (BtorMCPDR *pdr, BtorIntStack *cube)
+{
+  size_t i;
+
+  btor_sat_assume (pdr->smgr, BTOR_PEEK_STACK (pdr->act, 0));
+  for (i = 0; i < BTOR_COUNT_STACK (*cube); i++)
+    btor_sat_assume (pdr->smgr, pdr_cur_lit (pdr, BTOR_PEEK_STACK (*cube, i)));
+  return pdr_sat (pdr);
+}
+
+/* Checks whether 'cube' is inductive relative to frame 'k - 1', i.e., if
+ * F_{k-1} & -cube & T & cube' is unsatisfiable. If so and 'core' is true,
+ * 'cube' is reduced to the literals used in the proof. Otherwise, the
+ * predecessor state is stored in 'pred' (if given). */
+static bool
+pdr_is_rel_inductive (BtorMCPDR *pdr,
+                      int32_t k,
+                      BtorIntStack *cube,
+                      BtorIntStack *pred,
+                      bool core)
 {
+  assert (k > 0);
+
   bool res;
-  size_t i, j, num_frames;
-  Btor *btor;
-  BtorMCFrame *f1, *f2;
-  BoolectorNode *constraint;
-  BoolectorNodePtrStack constraints;
+  size_t i, j;
+  int32_t l, t;
 
-  btor = mc->forward;
+  t = btor_sat_mgr_next_cnf_id (pdr->smgr);
+  btor_sat_add (pdr->smgr, -t);
+  for (i = 0; i < BTOR_COUNT_STACK (*cube); i++)
+    btor_sat_add (pdr->smgr, -pdr_cur_lit (pdr, BTOR_PEEK_STACK (*cube, i)));
+  btor_sat_add (pdr->smgr, 0);
 
-  BTOR_INIT_STACK (mc->mm, constraints);
+  pdr_assume_frame (pdr, k - 1);
+  btor_sat_assume (pdr->smgr, t);
+  for (i = 0; i < BTOR_COUNT_STACK (*cube); i++)
+    btor_sat_assume (pdr->smgr, pdr_next_lit (pdr, BTOR_PEEK_STACK (*cube, i)));
 
-  // TODO:
-  //   cache simple path constraints
-  num_frames = BTOR_COUNT_STACK (mc->frames);
-  for (i = 0; i < num_frames; i++)
+  res = !pdr_sat (pdr);
+  if (res && core)
   {
-    f1 = mc->frames.start + i;
-    for (j = i + 1; j < num_frames; j++)
+    for (i = j = 0; i < BTOR_COUNT_STACK (*cube); i++)
     {
-      f2         = mc->frames.start + j;
-      constraint = create_distinct_state (mc, f1, f2);
-
-      if (constraint)
-      {
-        BTOR_PUSH_STACK (constraints, constraint);
-        BTOR_MSG (boolector_get_btor_msg (btor),
-                  1,
-                  "adding simple path constraints for %zu and %zu",
-                  i,
-                  j);
-      }
+      l = BTOR_PEEK_STACK (*cube, i);
+      if (!btor_sat_failed (pdr->smgr, pdr_next_lit (pdr, l))) continue;
+      BTOR_POKE_STACK (*cube, j, l);
+      j++;
     }
+    cube->top = cube->start + j;
   }
+  else if (!res && pred)
+    pdr_get_state (pdr, pred);
+
+  /* permanently disable the temporary clause */
+  btor_sat_add (pdr->smgr, -t);
+  btor_sat_add (pdr->smgr, 0);
+  return res;
+}
+
+static void
+pdr_copy_cube (BtorIntStack *dst, BtorIntStack *src)
+{
+  size_t i;
+
+  BTOR_RESET_STACK (*dst);
+  for (i = 0; i < BTOR_COUNT_STACK (*src); i++)
+    BTOR_PUSH_STACK (*dst, BTOR_PEEK_STACK (*src, i));
+}
 
-  for (i = 0; i < BTOR_COUNT_STACK (constraints); i++)
+/* Drops literals from relatively inductive 'pdr->cube' at level 'k' as long
+ * as it remains relatively inductive and disjoint from the initial states. */
+static void
+pdr_generalize (BtorMCPDR *pdr, int32_t k)
+{
+  size_t i, j;
+
+  i = 0;
+  while (i < BTOR_COUNT_STACK (pdr->cube) && BTOR_COUNT_STACK (pdr->cube) > 1)
   {
-    constraint = BTOR_PEEK_STACK (constraints, i);
-    boolector_assert (btor, constraint);
-    boolector_release (btor, constraint);
+    BTOR_RESET_STACK (pdr->tmp);
+    for (j = 0; j < BTOR_COUNT_STACK (pdr->cube); j++)
+      if (j != i) BTOR_PUSH_STACK (pdr->tmp, BTOR_PEEK_STACK (pdr->cube, j));
+    if (!pdr_intersects_init (pdr, &pdr->tmp)
+        && pdr_is_rel_inductive (pdr, k, &pdr->tmp, 0, false))
+      pdr_copy_cube (&pdr->cube, &pdr->tmp);
+    else
+      i++;
   }
-  res = !BTOR_EMPTY_STACK(constraints);
-  BTOR_RELEASE_STACK (constraints);
-  return res;
 }
 
-static int32_t
-check_last_forward_frame (BtorMC *mc)
+static void
+pdr_add_lemma (BtorMCPDR *pdr, int32_t k, BtorIntStack *cube)
 {
-  assert (mc);
+  size_t i;
+  int32_t l;
 
-  size_t i, j;
-  int32_t k, res, reachable, unreachable;
-  bool opt_kinduction, opt_simple_path;
-  BtorMCFrame *f;
-  BoolectorNode *bad;
-  Btor *btor;
+  BTOR_PUSH_STACK (pdr->lemmas, k);
+  BTOR_PUSH_STACK (pdr->lemmas, BTOR_COUNT_STACK (*cube));
+  btor_sat_add (pdr->smgr, -BTOR_PEEK_STACK (pdr->act, k));
+  for (i = 0; i < BTOR_COUNT_STACK (*cube); i++)
+  {
+    l = BTOR_PEEK_STACK (*cube, i);
+    BTOR_PUSH_STACK (pdr->lemmas, l);
+    btor_sat_add (pdr->smgr, -pdr_cur_lit (pdr, l));
+  }
+  btor_sat_add (pdr->smgr, 0);
+}
 
-  btor = mc->btor;
+static void
+pdr_push_obligation (BtorMCPDR *pdr, BtorIntStack *cube, int32_t k)
+{
+  size_t i;
 
-  opt_kinduction = btor_mc_get_opt (mc, BTOR_MC_OPT_KINDUCTION) == 1;
-  opt_simple_path = btor_mc_get_opt (mc, BTOR_MC_OPT_SIMPLE_PATH) == 1;
-  k = BTOR_COUNT_STACK (mc->frames) - 1;
-  assert (k >= 0);
-  f = mc->frames.top - 1;
-  assert (f->time == k);
+  for (i = 0; i < BTOR_COUNT_STACK (*cube); i++)
+    BTOR_PUSH_STACK (pdr->obligations, BTOR_PEEK_STACK (*cube, i));
+  BTOR_PUSH_STACK (pdr->obligations, BTOR_COUNT_STACK (*cube));
+  BTOR_PUSH_STACK (pdr->obligations, k);
+}
 
-  BTOR_MSG (boolector_get_btor_msg (btor),
-            1,
-            "checking forward frame at bound k = %d",
-            k);
-  reachable   = 0;
-  unreachable = 0;
+/* Recursively blocks the proof obligations. Returns true if a
+ * counterexample was found (its length is stored in 'pdr->depth'). */
+static bool
+pdr_block (BtorMCPDR *pdr)
+{
+  int32_t k, size, *lits, i;
 
-  for (i = 0; i < BTOR_COUNT_STACK (f->bad); i++)
+  while (!BTOR_EMPTY_STACK (pdr->obligations))
   {
-    bad = BTOR_PEEK_STACK (f->bad, i);
-    if (!bad)
-    {
-      int32_t reached;
-      reached = BTOR_PEEK_STACK (mc->reached, i);
-      assert (reached >= 0);
-      BTOR_MSG (boolector_get_btor_msg (btor),
-                1,
-                "skipping checking bad state property %zu "
-                "at bound %d reached before at %d",
-                i,
-                k,
-                reached);
-      continue;
-    }
-    BTOR_MSG (boolector_get_btor_msg (btor),
-              1,
-              "checking forward frame bad state property %zu at bound k = %d",
-              i,
-              k);
-
-    boolector_assume (mc->forward, bad);
-    for (j = 0; j < BTOR_COUNT_STACK (mc->init_assumptions); j++)
-    {
-      assert (opt_kinduction);
-      boolector_assume (mc->forward, BTOR_PEEK_STACK (mc->init_assumptions, j));
-    }
+    k    = BTOR_TOP_STACK (pdr->obligations);
+    size = pdr->obligations.top[-2];
+    lits = pdr->obligations.top - 2 - size;
+    BTOR_RESET_STACK (pdr->cube);
+    for (i = 0; i < size; i++) BTOR_PUSH_STACK (pdr->cube, lits[i]);
 
-    res = boolector_sat (mc->forward);
-    if (res == BOOLECTOR_SAT)
+    if (pdr_is_rel_inductive (pdr, k, &pdr->cube, &pdr->pred, true))
     {
-      mc->state = BTOR_SAT_MC_STATE;
-      BTOR_MSG (boolector_get_btor_msg (btor),
-                1,
-                "bad state property %zu reachable at bound k = %d SATISFIABLE",
-                i,
-                k);
-      reachable++;
-      if (BTOR_PEEK_STACK (mc->reached, i) < 0)
-      {
-        mc->num_reached++;
-        assert (mc->num_reached <= BTOR_COUNT_STACK (mc->bad));
-        BTOR_POKE_STACK (mc->reached, i, k);
-        if (mc->call_backs.reached_at_bound.fun)
-        {
-          mc->call_backs.reached_at_bound.fun (
-              mc->call_backs.reached_at_bound.state, i, k);
-        }
-      }
-
-      if (btor_mc_get_opt (mc, BTOR_MC_OPT_TRACE_GEN))
+      pdr->obligations.top -= size + 2;
+      /* the reduced cube must not contain initial states */
+      if (pdr_intersects_init (pdr, &pdr->cube))
       {
-        print_witness (mc, k, i);
+        BTOR_RESET_STACK (pdr->cube);
+        for (i = 0; i < size; i++)
+          BTOR_PUSH_STACK (pdr->cube, pdr->obligations.top[i]);
       }
-
-      if (btor_mc_get_opt (mc, BTOR_MC_OPT_STOP_FIRST))
-        break;
+      pdr_generalize (pdr, k);
+      pdr_add_lemma (pdr, k, &pdr->cube);
     }
-    else
+    else if (k == 1 || pdr_intersects_init (pdr, &pdr->pred))
     {
-      assert (res == BOOLECTOR_UNSAT);
+      pdr->depth = pdr_num_frames (pdr) - k + 1;
+      BTOR_RESET_STACK (pdr->obligations);
+      return true;
+    }
+    else
+      pdr_push_obligation (pdr, &pdr->pred, k - 1);
+  }
+  return false;
+}
 
-      if (opt_kinduction)
-      {
-      KINDUCTION_RECHECK:
-        boolector_assume (mc->forward, bad);
-        res = boolector_sat (mc->forward);
+/* Pushes lemmas to the next frame if they are inductive relative to their
+ * frame. Returns true if two frames became equal, i.e., an inductive
+ * invariant was found. */
+static bool
+pdr_propagate (BtorMCPDR *pdr)
+{
+  int32_t k, n, *p, *end, size, i;
+  bool remaining;
 
-        if (res == BOOLECTOR_SAT)
-        {
-          if (opt_simple_path && add_simple_path_constraints (mc))
-          {
-            goto KINDUCTION_RECHECK;
-          }
-          mc->state = BTOR_NO_MC_STATE;
-        }
-        else
-        {
-          mc->state = BTOR_UNSAT_MC_STATE;
-          BTOR_MSG (boolector_get_btor_msg (btor),
-                    1,
-                    "bad state property %zu unreachable at bound k = %d "
-                    "UNSATISFIABLE",
-                    i,
-                    k);
-          mc->num_reached++;
-          assert (mc->num_reached <= BTOR_COUNT_STACK (mc->bad));
-          BTOR_POKE_STACK (mc->reached, i, k);
-          printf ("unsat\nb%zd\n", i);
-          unreachable++;
-        }
-      }
-      else
+  n = pdr_num_frames (pdr);
+  for (k = 1; k < n; k++)
+  {
+    remaining = false;
+    p         = pdr->lemmas.start;
+    end       = pdr->lemmas.top;
+    for (; p < end; p += 2 + size)
+    {
+      size = p[1];
+      if (p[0] != k) continue;
+      pdr_assume_frame (pdr, k);
+      for (i = 0; i < size; i++)
+        btor_sat_assume (pdr->smgr, pdr_next_lit (pdr, p[2 + i]));
+      if (pdr_sat (pdr))
       {
-        mc->state = BTOR_UNSAT_MC_STATE;
-        BTOR_MSG (boolector_get_btor_msg (btor),
-                  1,
-                  "bad state property %zu at bound k = %d UNSATISFIABLE",
-                  i,
-                  k);
+        remaining = true;
+        continue;
       }
+      p[0] = k + 1;
+      btor_sat_add (pdr->smgr, -BTOR_PEEK_STACK (pdr->act, k + 1));
+      for (i = 0; i < size; i++)
+        btor_sat_add (pdr->smgr, -pdr_cur_lit (pdr, p[2 + i]));
+      btor_sat_add (pdr->smgr, 0);
+    }
+    if (!remaining)
+    {
+      BTOR_MSG (boolector_get_btor_msg (pdr->mc->btor),
+                1,
+                "PDR frames %d and %d are equal",
+                k,
+                k + 1);
+      return true;
     }
-    if (btor_mc_get_opt (mc, BTOR_MC_OPT_BTOR_STATS))
-      boolector_print_stats (mc->forward);
   }
-
-  BTOR_MSG (boolector_get_btor_msg (btor),
-            1,
-            "found %d reachable and %d unreachable bad state properties "
-            "at bound k = %d",
-            reachable,
-            unreachable,
-            k);
-
-  return reachable;
+  return false;
 }
 
-int32_t
-btor_mc_bmc (BtorMC *mc, int32_t mink, int32_t maxk)
+/* Returns 1 if bad state property 'i' is reachable, 0 if it was proven
+ * unreachable and -1 if it is undecided with 'maxk' frames. */
+static int32_t
+pdr_check (BtorMCPDR *pdr, size_t i, int32_t maxk)
 {
-  assert (mc);
-
-  int32_t k;
-  Btor *btor;
-
-  btor = mc->btor;
+  int32_t bad, n;
+  Btor *btor = pdr->mc->btor;
 
-  mc_release_assignments (mc);
-
-  BTOR_MSG (boolector_get_btor_msg (btor),
-            1,
-            "calling BMC on %u properties from bound %d "
-            "up-to maximum bound k = %d",
-            BTOR_COUNT_STACK (mc->bad),
-            mink,
-            maxk);
+  /* frames (and lemmas) of previous properties are no longer assumed */
+  pdr->act.top = pdr->act.start + 1;
+  BTOR_RESET_STACK (pdr->lemmas);
 
-  BTOR_MSG (
-      boolector_get_btor_msg (btor),
-      1,
-      "trace generation %s",
-      btor_mc_get_opt (mc, BTOR_MC_OPT_TRACE_GEN) ? "enabled" : "disabled");
+  bad = BTOR_PEEK_STACK (pdr->bad, i);
+  assert (bad);
 
-  mc->state = BTOR_NO_MC_STATE;
+  pdr_assume_frame (pdr, 0);
+  btor_sat_assume (pdr->smgr, bad);
+  if (pdr_sat (pdr))
+  {
+    pdr->depth = 0;
+    return 1;
+  }
 
-  while ((k = BTOR_COUNT_STACK (mc->frames)) <= maxk)
+  for (n = 1; n <= maxk; n++)
   {
-    if (mc->call_backs.starting_bound.fun)
-    {
-      mc->call_backs.starting_bound.fun (mc->call_backs.starting_bound.state,
-                                         k);
-    }
+    BTOR_PUSH_STACK (pdr->act, btor_sat_mgr_next_cnf_id (pdr->smgr));
+    assert (pdr_num_frames (pdr) == n);
 
-    initialize_new_forward_frame (mc);
-    if (k < mink) continue;
-    if (check_last_forward_frame (mc))
+    for (;;)
     {
-      if (btor_mc_get_opt (mc, BTOR_MC_OPT_STOP_FIRST)
-          || mc->num_reached == BTOR_COUNT_STACK (mc->bad) || k == maxk)
-      {
-        BTOR_MSG (boolector_get_btor_msg (btor),
-                  2,
-                  "entering SAT state at bound k=%d",
-                  k);
-        assert (k >= 0);
-        return k;
-      }
+      pdr_assume_frame (pdr, n);
+      btor_sat_assume (pdr->smgr, bad);
+      if (!pdr_sat (pdr)) break;
+      pdr_get_state (pdr, &pdr->cube);
+      pdr_push_obligation (pdr, &pdr->cube, n);
+      if (pdr_block (pdr)) return 1;
     }
-  }
 
-  BTOR_MSG (boolector_get_btor_msg (btor), 2, "entering UNSAT state");
-  mc->state = BTOR_UNSAT_MC_STATE;
+    BTOR_MSG (boolector_get_btor_msg (btor),
+              1,
+              "PDR blocked bad state property %zu in frame %d "
+              "(%u lemma literals)",
+              i,
+              n,
+              BTOR_COUNT_STACK (pdr->lemmas));
 
+    if (pdr_propagate (pdr)) return 0;
+  }
   return -1;
 }
 
 int32_t
-btor_mc_kind (BtorMC *mc, int32_t mink, int32_t maxk)
+btor_mc_pdr (BtorMC *mc, int32_t maxk)
 {
   assert (mc);
 
-  int32_t k;
+  int32_t res, r, k, maxdepth;
+  size_t i, j;
+  BtorMCPDR *pdr;
   Btor *btor;
+  BtorIntStack reached, depths;
 
   btor = mc->btor;
 
   mc_release_assignments (mc);
+  reduce_model (mc);
 
   BTOR_MSG (boolector_get_btor_msg (btor),
             1,
-            "calling k-induction on %u properties from bound %d "
-            "up-to maximum bound k = %d",
+            "calling PDR on %u properties up-to maximum bound k = %d",
             BTOR_COUNT_STACK (mc->bad),
-            mink,
             maxk);
 
-  BTOR_MSG (
-      boolector_get_btor_msg (btor),
-      1,
-      "trace generation %s",
-      btor_mc_get_opt (mc, BTOR_MC_OPT_TRACE_GEN) ? "enabled" : "disabled");
-
   mc->state = BTOR_NO_MC_STATE;
+  res       = -1;
+  maxdepth  = -1;
+  pdr       = pdr_new (mc);
+  BTOR_INIT_STACK (mc->mm, reached);
+  BTOR_INIT_STACK (mc->mm, depths);
 
-  while ((k = BTOR_COUNT_STACK (mc->frames)) <= maxk)
+  for (i = 0; i < BTOR_COUNT_STACK (mc->bad); i++)
   {
-    if (mc->call_backs.starting_bound.fun)
+    if (BTOR_PEEK_STACK (mc->reached, i) >= 0) continue;
+
+    r = pdr_check (pdr, i, maxk);
+    if (r > 0)
     {
-      mc->call_backs.starting_bound.fun (mc->call_backs.starting_bound.state,
-                                         k);
+      k = pdr->depth;
+      BTOR_MSG (boolector_get_btor_msg (btor),
+                1,
+                "bad state property %zu reachable at bound k = %d",
+                i,
+                k);
+      BTOR_PUSH_STACK (reached, (int32_t) i);
+      BTOR_PUSH_STACK (depths, k);
+      if (k > maxdepth) maxdepth = k;
+      mc->state = BTOR_SAT_MC_STATE;
+      res       = k;
+      if (btor_mc_get_opt (mc, BTOR_MC_OPT_STOP_FIRST)) break;
+    }
+    else if (r == 0)
+    {
+      k = pdr_num_frames (pdr);
+      BTOR_MSG (boolector_get_btor_msg (btor),
+                1,
+                "bad state property %zu unreachable with %d frames "
+                "UNSATISFIABLE",
+                i,
+                k);
+      mark_proven (mc, i, k);
+    }
+    else
+    {
+      BTOR_MSG (boolector_get_btor_msg (btor),
+                1,
+                "bad state property %zu undecided with %d frames",
+                i,
+                maxk);
     }
+  }
 
-    initialize_new_forward_frame (mc);
-    if (k < mink) continue;
-    (void) check_last_forward_frame (mc);
-    if (mc->state != BTOR_NO_MC_STATE)
+  /* properties are settled in order of their index, but witnesses must be
+   * replayed in increasing order of bounds */
+  for (k = 0; k <= maxdepth; k++)
+  {
+    for (j = 0; j < BTOR_COUNT_STACK (reached); j++)
     {
-      if (btor_mc_get_opt (mc, BTOR_MC_OPT_STOP_FIRST)
-          || mc->num_reached == BTOR_COUNT_STACK (mc->bad) || k == maxk)
-      {
-        if (mc->state == BTOR_SAT_MC_STATE)
-        {
-          BTOR_MSG (boolector_get_btor_msg (btor),
-                    2,
-                    "entering SAT state at bound k=%d",
-                    k);
-          assert (k >= 0);
-          return k;
-        }
-        else
-        {
-          return k;
-        }
-      }
+      if (BTOR_PEEK_STACK (depths, j) != k) continue;
+      i = BTOR_PEEK_STACK (reached, j);
+      replay_on_forward_frames (mc, i, k);
+      mark_reached (mc, i, k);
     }
   }
+  BTOR_RELEASE_STACK (reached);
+  BTOR_RELEASE_STACK (depths);
 
-  BTOR_MSG (boolector_get_btor_msg (btor), 2, "entering UNSAT state");
-  mc->state = BTOR_UNSAT_MC_STATE;
+  if (btor_mc_get_opt (mc, BTOR_MC_OPT_BTOR_STATS))
+    btor_sat_print_stats (pdr->smgr);
+  pdr_delete (pdr);
 
-  return -1;
+  if (mc->state == BTOR_NO_MC_STATE)
+  {
+    BTOR_MSG (boolector_get_btor_msg (btor), 2, "entering UNSAT state");
+    mc->state = BTOR_UNSAT_MC_STATE;
+  }
+  return res;
 }
 
 /*------------------------------------------------------------------------*/
@@ -1616,6 +3649,21 @@ zero_normalize_assignment (char *assignment)
   }
 }
 
+/* True if the next state function of 'state' (or of its representative)
+ * was not unrolled into frame 'f' since it is outside the cone of influence.
+ * Its value is then obtained by evaluating its next state function in the
+ * previous frame. */
+static bool
+is_sliced_in_frame (BtorMCstate *state, BtorMCFrame *f)
+{
+  return f->time > 0 && state->next && !state->constant
+         && !BTOR_PEEK_STACK ((f - 1)->next, state->repr->id);
+}
+
+static BoolectorNode *mc_model2const (BtorMC *mc,
+                                      BoolectorNode *node,
+                                      int32_t time);
+
 static BoolectorNode *
 mc_model2const_mapper (Btor *btor, void *m2cmapper, BoolectorNode *node)
 {
@@ -1662,6 +3710,8 @@ mc_model2const_mapper (Btor *btor, void *m2cmapper, BoolectorNode *node)
     state = bucket->data.as_ptr;
     assert (state);
     assert (state->node == node);
+    if (is_sliced_in_frame (state, frame))
+      return boolector_copy (btor, mc_model2const (mc, state->next, time - 1));
     node_at_time = BTOR_PEEK_STACK (frame->states, state->id);
   }
   assert (node_at_time);
@@ -1691,6 +3741,19 @@ mc_model2const (BtorMC *mc, BoolectorNode *node, int32_t time)
       mc->btor, map, &mapper, mc_model2const_mapper, boolector_release, node);
 }
 
+/* Get assignment of 'node_at_time' directly from the model of the forward
+ * instance (allocated with the memory manager of 'mc'). */
+static char *
+model_bv_assignment (BtorMC *mc, BoolectorNode *node_at_time)
+{
+  assert (mc->forward->last_sat_result == BTOR_RESULT_SAT);
+  assert (mc->forward->valid_assignments);
+  return btor_bv_to_char (
+      mc->mm,
+      btor_model_get_bv (mc->forward,
+                         BTOR_IMPORT_BOOLECTOR_NODE (node_at_time)));
+}
+
 char *
 btor_mc_assignment (BtorMC *mc, BoolectorNode *node, int32_t time)
 {
@@ -1704,7 +3767,7 @@ btor_mc_assignment (BtorMC *mc, BoolectorNode *node, int32_t time)
   assert ((size_t) time < BTOR_COUNT_STACK (mc->frames));
 
   BoolectorNode *node_at_time, *const_node;
-  const char *bits_owned_by_forward, *bits;
+  const char *bits;
   BtorPtrHashBucket *bucket;
   BtorMCInput *input;
   BtorMCstate *state;
@@ -1723,12 +3786,12 @@ btor_mc_assignment (BtorMC *mc, BoolectorNode *node, int32_t time)
     frame        = mc->frames.start + time;
     node_at_time = BTOR_PEEK_STACK (frame->inputs, input->id);
     assert (node_at_time);
-    bits_owned_by_forward = boolector_bv_assignment (mc->forward, node_at_time);
-    res                   = btor_mem_strdup (mc->mm, bits_owned_by_forward);
+    res = model_bv_assignment (mc, node_at_time);
     zero_normalize_assignment (res);
-    boolector_free_bv_assignment (mc->forward, bits_owned_by_forward);
   }
-  else if ((bucket = btor_hashptr_table_get (mc->states, node)))
+  else if ((bucket = btor_hashptr_table_get (mc->states, node))
+           && !is_sliced_in_frame (bucket->data.as_ptr,
+                                   mc->frames.start + time))
   {
     state = bucket->data.as_ptr;
     assert (state);
@@ -1736,9 +3799,7 @@ btor_mc_assignment (BtorMC *mc, BoolectorNode *node, int32_t time)
     frame        = mc->frames.start + time;
     node_at_time = BTOR_PEEK_STACK (frame->states, state->id);
     assert (node_at_time);
-    bits_owned_by_forward = boolector_bv_assignment (mc->forward, node_at_time);
-    res                   = btor_mem_strdup (mc->mm, bits_owned_by_forward);
-    boolector_free_bv_assignment (mc->forward, bits_owned_by_forward);
+    res = model_bv_assignment (mc, node_at_time);
   }
   else
   {
@@ -13,6 +13,7 @@
 
 #include "btormctypes.h"
 #include "utils/boolectornodemap.h"
+#include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 #include "utils/btormem.h"
 #include "utils/btorstack.h"
@@ -51,6 +52,13 @@ struct BtorMCstate
 {
   int32_t id;
   BoolectorNode *node, *next, *init;
+  /* Set by the model reduction: the value of a state stuck at a constant in
+   * all reachable states, the representative of its class of equivalent
+   * states (itself if not merged) and whether the state is in the cone of
+   * influence of the unreached bad state properties and constraints. */
+  BoolectorNode *constant;
+  struct BtorMCstate *repr;
+  bool coi;
 };
 typedef struct BtorMCstate BtorMCstate;
 
@@ -82,13 +90,30 @@ struct BtorMC
   int32_t initialized, nextstates;
   Btor *btor, *forward;
   BtorMCFrameStack frames;
+  /* The induction step of k-induction uses a separate unrolling, which
+   * starts in an arbitrary state and is extended incrementally. */
+  Btor *induction;
+  BtorMCFrameStack induction_frames;
+  /* Per bad state property an activation literal guarding the assumptions
+   * that the property does not hold in earlier frames of the induction
+   * unrolling (asserted false once the property is decided). */
+  BoolectorNodePtrStack activation;
+  /* Pairs of frames of the induction unrolling constrained to be distinct
+   * (simple path constraints, added lazily). */
+  BtorIntHashTable *distinct_frames;
   BtorPtrHashTable *inputs;
   BtorPtrHashTable *states;
   BoolectorNodePtrStack bad;
   BoolectorNodePtrStack constraints;
-  BoolectorNodePtrStack init_assumptions;
   BtorIntStack reached;
   uint32_t num_reached;
+  /* The model is reduced once before the first frame is unrolled, the cone
+   * of influence is updated whenever further properties are reached. */
+  bool reduced;
+  uint32_t coi_num_reached;
+  /* BMC on the bit-blasted transition relation instantiated per frame (see
+   * BTOR_MC_OPT_AIG_UNROLL), kept for subsequent calls. */
+  struct BtorMCUnroller *unroller;
   struct
   {
     struct
@@ -171,6 +196,8 @@ int32_t btor_mc_bmc (BtorMC *, int32_t mink, int32_t maxk);
 
 int32_t btor_mc_kind (BtorMC *, int32_t mink, int32_t maxk);
 
+int32_t btor_mc_pdr (BtorMC *, int32_t maxk);
+
 /*------------------------------------------------------------------------*/
 
 /* Assumes that 'btor_mc_set_opt (mc, BTOR_MC_OPT_TRACE_GEN, 1)'
@@ -944,7 +944,11 @@ main (int32_t argc, char **argv)
     {
       kmin = boolector_mc_get_opt (mc, BTOR_MC_OPT_MIN_K);
       kmax = boolector_mc_get_opt (mc, BTOR_MC_OPT_MAX_K);
-      if (boolector_mc_get_opt (mc, BTOR_MC_OPT_KINDUCTION))
+      if (boolector_mc_get_opt (mc, BTOR_MC_OPT_PDR))
+      {
+        (void) boolector_mc_pdr (mc, kmax);
+      }
+      else if (boolector_mc_get_opt (mc, BTOR_MC_OPT_KINDUCTION))
       {
         (void) boolector_mc_kind (mc, kmin, kmax);
       }
@@ -44,6 +44,17 @@ enum BtorMCOption
   /* Enable k-induction engine */
   BTOR_MC_OPT_KINDUCTION,
   BTOR_MC_OPT_SIMPLE_PATH,
+  /* Enable IC3/PDR engine (bit-vector models only). */
+  BTOR_MC_OPT_PDR,
+  /* Enable (val: 1) or disable (val: 0) reducing the model to the cone of
+   * influence of the properties, with constant states replaced and
+   * equivalent states merged, before unrolling it (default: 1). */
+  BTOR_MC_OPT_REDUCE,
+  /* Enable (val: 1) or disable (val: 0) BMC on the bit-blasted transition
+   * relation, which is instantiated per frame directly in the SAT solver
+   * instead of unrolling it on the expression level (bit-vector models
+   * only, default: 0). */
+  BTOR_MC_OPT_AIG_UNROLL,
   /* This MUST be the last entry! */
   BTOR_MC_OPT_NUM_OPTS,
 };
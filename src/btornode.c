@@ -651,6 +651,9 @@ connect_child_exp (Btor *btor, BtorNode *parent, BtorNode *child, uint32_t pos)
 
   if (btor_node_real_addr (child)->apply_below) parent->apply_below = 1;
 
+  if (btor_node_real_addr (child)->activation_below)
+    parent->activation_below = 1;
+
   btor_node_real_addr (child)->parents++;
   inc_exp_ref_counter (btor, child);
 
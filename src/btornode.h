@@ -86,6 +86,8 @@ extern const char *const g_btor_op2str[BTOR_NUM_OPS_NODE];
     uint8_t lambda_below : 1;     /* lambda as sub expression ? */         \
     uint8_t quantifier_below : 1; /* quantifier as sub expression ? */     \
     uint8_t apply_below : 1;      /* apply as sub expression ? */          \
+    uint8_t activation_below : 1; /* push/pop activation literal as sub    \
+                                     expression ? */                       \
     uint8_t propagated : 1;       /* is set during propagation */          \
     uint8_t is_array : 1;         /* function represents array ? */        \
     uint8_t rebuild : 1;          /* indicates whether rebuild is required \
@@ -260,6 +260,11 @@ btor_opt_init_opts (Btor *btor)
                 "aigerbin",
                 BTOR_OUTPUT_FORMAT_AIGER_BINARY,
                 "use the AIGER binary format as output file format");
+  add_opt_help (mm,
+                opts,
+                "btorbin",
+                BTOR_OUTPUT_FORMAT_BTOR_BINARY,
+                "use the compact binary BTOR format as output file format");
   btor->options[BTOR_OPT_OUTPUT_FORMAT].options = opts;
 
   init_opt (btor,
@@ -664,6 +669,12 @@ btor_opt_init_opts (Btor *btor)
                 "all",
                 BTOR_FUN_EAGER_LEMMAS_ALL,
                 "generate lemmas for all conflicts");
+  add_opt_help (mm,
+                opts,
+                "batch",
+                BTOR_FUN_EAGER_LEMMAS_BATCH,
+                "check all applies in one pass and generate lemmas for all "
+                "conflicts (bounded by fun-lemma-batch-size)");
   btor->options[BTOR_OPT_FUN_EAGER_LEMMAS].options  = opts;
 
   init_opt (btor,
@@ -1410,6 +1421,114 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "enable non-destructive term substitutions");
+  init_opt (btor,
+            BTOR_OPT_FUN_LEMMA_BATCH_SIZE,
+            true,
+            false,
+            "fun-lemma-batch-size",
+            0,
+            128,
+            0,
+            UINT32_MAX,
+            "maximum number of lemmas generated per refinement iteration "
+            "with --fun-eager-lemmas=batch (0: unlimited)");
+  init_opt (btor,
+            BTOR_OPT_QUANT_SYNTH_N_THREADS,
+            true,
+            false,
+            "quant-synth-n-threads",
+            0,
+            1,
+            1,
+            UINT32_MAX,
+            "number of threads to use for evaluating synthesis candidates");
+  init_opt (btor,
+            BTOR_OPT_QUANT_N_WORKERS,
+            true,
+            false,
+            "quant-n-workers",
+            0,
+            1,
+            1,
+            UINT32_MAX,
+            "number of ground solver instances for the original formula run "
+            "in parallel with diversified synthesis configurations");
+  init_opt (btor,
+            BTOR_OPT_SAT_PREPROCESS,
+            true,
+            true,
+            "sat-preprocess",
+            0,
+            0,
+            0,
+            1,
+            "simplify CNF (variable elimination, subsumption, equivalent "
+            "literal substitution) before passing it to the SAT solver");
+  init_opt (btor,
+            BTOR_OPT_SAT_SHARE_SIZE,
+            true,
+            false,
+            "sat-share-size",
+            0,
+            8,
+            1,
+            UINT32_MAX,
+            "maximum size of learned clauses shared with other SAT solvers");
+  init_opt (btor,
+            BTOR_OPT_SAT_SHARE_LBD,
+            true,
+            false,
+            "sat-share-lbd",
+            0,
+            3,
+            1,
+            UINT32_MAX,
+            "maximum LBD of learned clauses shared with other SAT solvers");
+  init_opt (btor,
+            BTOR_OPT_AIG_GC,
+            true,
+            false,
+            "aig-gc",
+            0,
+            50,
+            0,
+            100,
+            "compact AIG ids before a SAT call if at least the given "
+            "percentage of ids is unused (0 disables)");
+  init_opt (btor,
+            BTOR_OPT_BUDGET_TIME,
+            true,
+            false,
+            "budget-time",
+            0,
+            0,
+            0,
+            UINT32_MAX,
+            "wall-clock time budget per check-sat call in milliseconds, "
+            "return unknown if exhausted (0 for no limit)");
+  init_opt (btor,
+            BTOR_OPT_BUDGET_MEM,
+            true,
+            false,
+            "budget-mem",
+            0,
+            0,
+            0,
+            UINT32_MAX,
+            "memory budget per check-sat call in MB (allocated during the "
+            "call), return unknown if exceeded (0 for no limit)");
+  init_opt (btor,
+            BTOR_OPT_PROFILE,
+            true,
+            false,
+            "profile",
+            0,
+            BTOR_PROFILE_NONE,
+            BTOR_PROFILE_NONE,
+            BTOR_PROFILE_TRACE,
+            "write phase profile of each SAT call to file given in "
+            "BTORPROFILEOUT or stdout (0: disabled, 1: JSON, "
+            "2: Chrome trace events)");
 }
 
 static void
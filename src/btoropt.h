@@ -90,7 +90,7 @@ extern const char *const g_btor_se_name[BTOR_SAT_ENGINE_MAX + 1];
 #define BTOR_OUTPUT_BASE_DFLT BTOR_OUTPUT_BASE_BIN
 
 #define BTOR_OUTPUT_FORMAT_MIN BTOR_OUTPUT_FORMAT_NONE
-#define BTOR_OUTPUT_FORMAT_MAX BTOR_OUTPUT_FORMAT_AIGER_BINARY
+#define BTOR_OUTPUT_FORMAT_MAX BTOR_OUTPUT_FORMAT_BTOR_BINARY
 #define BTOR_OUTPUT_FORMAT_DFLT BTOR_OUTPUT_FORMAT_NONE
 
 #define BTOR_DP_QSORT_MIN BTOR_DP_QSORT_JUST
@@ -114,7 +114,7 @@ extern const char *const g_btor_se_name[BTOR_SAT_ENGINE_MAX + 1];
 #define BTOR_QUANT_SYNTH_DFLT BTOR_QUANT_SYNTH_ELMR
 
 #define BTOR_FUN_EAGER_LEMMAS_MIN BTOR_FUN_EAGER_LEMMAS_NONE
-#define BTOR_FUN_EAGER_LEMMAS_MAX BTOR_FUN_EAGER_LEMMAS_ALL
+#define BTOR_FUN_EAGER_LEMMAS_MAX BTOR_FUN_EAGER_LEMMAS_BATCH
 #define BTOR_FUN_EAGER_LEMMAS_DFLT BTOR_FUN_EAGER_LEMMAS_CONF
 
 #define BTOR_INCREMENTAL_SMT1_MIN BTOR_INCREMENTAL_SMT1_BASIC
@@ -10,6 +10,8 @@
 #include "boolector.h"
 #include "btorcore.h"
 #include "btoropt.h"
+#include "dumper/btordumpbin.h"
+#include "parser/btorbin.h"
 #include "parser/btorbtor.h"
 #include "parser/btorbtor2.h"
 #include "parser/btorsmt.h"
@@ -147,6 +149,11 @@ btor_parse (Btor *btor,
     parser_api = btor_parsebtor2_parser_api ();
     sprintf (msg, "parsing '%s'", infile_name);
   }
+  else if (has_compressed_suffix (infile_name, ".btorbin"))
+  {
+    parser_api = btor_parsebin_parser_api ();
+    sprintf (msg, "parsing '%s'", infile_name);
+  }
   else if (has_compressed_suffix (infile_name, ".smt2"))
   {
     parser_api = btor_parsesmt2_parser_api ();
@@ -193,7 +200,13 @@ btor_parse (Btor *btor,
     if (ch != EOF && ch)
     {
       assert (first && second);
-      if (first == '(')
+      if (first == BTOR_DUMPBIN_MAGIC[0])
+      {
+        parser_api = btor_parsebin_parser_api ();
+        sprintf (
+            msg, "assuming BTOR binary input,  parsing '%s'", infile_name);
+      }
+      else if (first == '(')
       {
         if (second == 'b')
         {
@@ -0,0 +1,208 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btorperf.h"
+
+#ifdef BTOR_PERF_COUNTERS
+
+#include "btorcore.h"
+#include "utils/btormem.h"
+
+#include <assert.h>
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/*------------------------------------------------------------------------*/
+
+#define BTOR_PERF_NUM_EVENTS 4
+
+static const uint64_t perf_events[BTOR_PERF_NUM_EVENTS] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+static const char *perf_phases[BTOR_PERF_NUM_PHASES] = {
+    "simplify",
+    "synthesize",
+    "cnf",
+    "sat",
+    "prop move",
+};
+
+/* The counters are opened as one group (read at once), with 'fd[0]' as
+ * group leader ('fd[0]' is -1 if counters are not available). */
+struct BtorPerf
+{
+  int32_t fd[BTOR_PERF_NUM_EVENTS];
+  uint32_t depth[BTOR_PERF_NUM_PHASES];
+  uint64_t calls[BTOR_PERF_NUM_PHASES];
+  uint64_t start[BTOR_PERF_NUM_PHASES][BTOR_PERF_NUM_EVENTS];
+  uint64_t count[BTOR_PERF_NUM_PHASES][BTOR_PERF_NUM_EVENTS];
+};
+
+/*------------------------------------------------------------------------*/
+
+static int32_t
+open_counter (uint64_t config, int32_t group)
+{
+  struct perf_event_attr attr;
+
+  memset (&attr, 0, sizeof (attr));
+  attr.type           = PERF_TYPE_HARDWARE;
+  attr.size           = sizeof (attr);
+  attr.config         = config;
+  attr.disabled       = group == -1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv     = 1;
+  attr.read_format    = PERF_FORMAT_GROUP;
+  return (int32_t) syscall (__NR_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+static void
+close_counters (BtorPerf *perf)
+{
+  uint32_t i;
+
+  for (i = BTOR_PERF_NUM_EVENTS; i > 0; i--)
+  {
+    if (perf->fd[i - 1] >= 0) close (perf->fd[i - 1]);
+    perf->fd[i - 1] = -1;
+  }
+}
+
+static bool
+read_counters (BtorPerf *perf, uint64_t *values)
+{
+  uint64_t buf[1 + BTOR_PERF_NUM_EVENTS];
+
+  if (read (perf->fd[0], buf, sizeof (buf)) != sizeof (buf)
+      || buf[0] != BTOR_PERF_NUM_EVENTS)
+    return false;
+  memcpy (values, buf + 1, sizeof (uint64_t) * BTOR_PERF_NUM_EVENTS);
+  return true;
+}
+
+static BtorPerf *
+new_perf (Btor *btor)
+{
+  BtorPerf *res;
+  uint32_t i;
+
+  BTOR_CNEW (btor->mm, res);
+  for (i = 0; i < BTOR_PERF_NUM_EVENTS; i++) res->fd[i] = -1;
+  for (i = 0; i < BTOR_PERF_NUM_EVENTS; i++)
+  {
+    res->fd[i] = open_counter (perf_events[i], i ? res->fd[0] : -1);
+    if (res->fd[i] < 0)
+    {
+      close_counters (res);
+      return res;
+    }
+  }
+  ioctl (res->fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl (res->fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  return res;
+}
+
+static double
+per_kilo (uint64_t a, uint64_t b)
+{
+  return b ? 1000.0 * a / b : 0.0;
+}
+
+/*------------------------------------------------------------------------*/
+
+void
+btor_perf_begin (Btor *btor, BtorPerfPhase phase)
+{
+  assert (btor);
+  assert (phase < BTOR_PERF_NUM_PHASES);
+
+  BtorPerf *perf;
+
+  if (!(perf = btor->perf)) perf = btor->perf = new_perf (btor);
+  if (perf->depth[phase]++ || perf->fd[0] < 0) return;
+  if (!read_counters (perf, perf->start[phase])) close_counters (perf);
+}
+
+void
+btor_perf_end (Btor *btor, BtorPerfPhase phase)
+{
+  assert (btor);
+  assert (phase < BTOR_PERF_NUM_PHASES);
+
+  BtorPerf *perf = btor->perf;
+  uint64_t values[BTOR_PERF_NUM_EVENTS];
+  uint32_t i;
+
+  assert (perf);
+  assert (perf->depth[phase]);
+  if (--perf->depth[phase] || perf->fd[0] < 0) return;
+  if (!read_counters (perf, values))
+  {
+    close_counters (perf);
+    return;
+  }
+  perf->calls[phase] += 1;
+  for (i = 0; i < BTOR_PERF_NUM_EVENTS; i++)
+    perf->count[phase][i] += values[i] - perf->start[phase][i];
+}
+
+void
+btor_perf_delete (Btor *btor)
+{
+  assert (btor);
+
+  if (!btor->perf) return;
+  close_counters (btor->perf);
+  BTOR_DELETE (btor->mm, btor->perf);
+  btor->perf = 0;
+}
+
+void
+btor_perf_print_stats (Btor *btor)
+{
+  assert (btor);
+
+  BtorPerf *perf = btor->perf;
+  uint64_t *c;
+  uint32_t i;
+
+  if (!perf) return;
+
+  BTOR_MSG (btor->msg, 1, "");
+  if (perf->fd[0] < 0)
+  {
+    BTOR_MSG (btor->msg, 1, "hardware performance counters not available");
+    return;
+  }
+  BTOR_MSG (btor->msg, 1, "hardware performance counters:");
+  for (i = 0; i < BTOR_PERF_NUM_PHASES; i++)
+  {
+    if (!perf->calls[i]) continue;
+    c = perf->count[i];
+    BTOR_MSG (btor->msg,
+              1,
+              "  %-10s %7llu calls, %.3f G cycles, %.3f G instructions, "
+              "%.2f IPC, %.2f cache MPKI, %.2f branch MPKI",
+              perf_phases[i],
+              (unsigned long long) perf->calls[i],
+              c[0] / 1e9,
+              c[1] / 1e9,
+              c[0] ? (double) c[1] / c[0] : 0.0,
+              per_kilo (c[2], c[1]),
+              per_kilo (c[3], c[1]));
+  }
+}
+
+#endif
@@ -0,0 +1,63 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORPERF_H_INCLUDED
+#define BTORPERF_H_INCLUDED
+
+#include "btortypes.h"
+
+/* Hardware performance counters (cycles, instructions, cache misses and
+ * branch misses, user space only) around the main phases, available if
+ * compiled with BTOR_PERF_COUNTERS (Linux perf_event_open).  Counts of a
+ * phase include nested phases, recursive calls of a phase are counted once,
+ * and only events of the thread that entered the first phase are counted.
+ * Counters are printed with the statistics (verbosity 1).  Without
+ * BTOR_PERF_COUNTERS, BTOR_PERF_BEGIN and BTOR_PERF_END expand to nothing. */
+
+enum BtorPerfPhase
+{
+  BTOR_PERF_SIMPLIFY,
+  BTOR_PERF_SYNTH_EXP,
+  BTOR_PERF_CNF,
+  BTOR_PERF_SAT,
+  BTOR_PERF_PROP_MOVE,
+  BTOR_PERF_NUM_PHASES,
+};
+
+typedef enum BtorPerfPhase BtorPerfPhase;
+
+typedef struct BtorPerf BtorPerf;
+
+#ifdef BTOR_PERF_COUNTERS
+
+#define BTOR_PERF_BEGIN(btor, phase) btor_perf_begin (btor, phase)
+#define BTOR_PERF_END(btor, phase) btor_perf_end (btor, phase)
+
+void btor_perf_begin (Btor *btor, BtorPerfPhase phase);
+
+void btor_perf_end (Btor *btor, BtorPerfPhase phase);
+
+void btor_perf_delete (Btor *btor);
+
+void btor_perf_print_stats (Btor *btor);
+
+#else
+
+#define BTOR_PERF_BEGIN(btor, phase) \
+  do                                 \
+  {                                  \
+    (void) (btor);                   \
+  } while (0)
+#define BTOR_PERF_END(btor, phase) \
+  do                               \
+  {                                \
+    (void) (btor);                 \
+  } while (0)
+
+#endif
+#endif
@@ -0,0 +1,309 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btorprofile.h"
+
+#include "btorcore.h"
+#include "btoropt.h"
+#include "utils/btormem.h"
+#include "utils/btorstack.h"
+#include "utils/btorutil.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*------------------------------------------------------------------------*/
+
+/* Accumulated over all calls of a phase with the same name and parent. */
+struct BtorProfilePhase
+{
+  const char *name;
+  int32_t parent; /* -1 for top level phases */
+  uint64_t calls;
+  double time;
+  int64_t mem;
+  uint64_t sat_calls;
+};
+
+typedef struct BtorProfilePhase BtorProfilePhase;
+
+/* Open scope of a phase (values at begin), or a closed scope recorded as
+ * trace event (deltas). */
+struct BtorProfileScope
+{
+  uint32_t phase;
+  double start;
+  double time;
+  int64_t mem;
+  uint64_t sat_calls;
+};
+
+typedef struct BtorProfileScope BtorProfileScope;
+
+BTOR_DECLARE_STACK (BtorProfilePhase, BtorProfilePhase);
+BTOR_DECLARE_STACK (BtorProfileScope, BtorProfileScope);
+
+struct BtorProfile
+{
+  BtorMemMgr *mm; /* not accounted in the memory deltas of the phases */
+  BtorProfileMode mode;
+  FILE *out;
+  bool close_out;
+  bool trace_started;
+  double epoch;
+  uint64_t sat_calls;
+  BtorProfilePhaseStack phases;
+  BtorProfileScopeStack scopes;
+  BtorProfileScopeStack events;
+};
+
+/*------------------------------------------------------------------------*/
+
+static int64_t
+mem_allocated (Btor *btor)
+{
+  return (int64_t) (btor->mm->allocated + btor->mm->sat_allocated);
+}
+
+static BtorProfile *
+new_profile (Btor *btor)
+{
+  BtorProfile *res;
+  BtorMemMgr *mm;
+  const char *name;
+
+  mm = btor_mem_mgr_new ();
+  BTOR_CNEW (mm, res);
+  res->mm    = mm;
+  res->out   = stdout;
+  res->epoch = btor_util_current_time ();
+  BTOR_INIT_STACK (mm, res->phases);
+  BTOR_INIT_STACK (mm, res->scopes);
+  BTOR_INIT_STACK (mm, res->events);
+
+  if ((name = getenv ("BTORPROFILEOUT")))
+  {
+    if ((res->out = fopen (name, "w")))
+      res->close_out = true;
+    else
+    {
+      BTOR_MSG (btor->msg, 1, "failed to open profile output '%s'", name);
+      res->out = stdout;
+    }
+  }
+  return res;
+}
+
+static uint32_t
+get_phase (BtorProfile *prof, int32_t parent, const char *name)
+{
+  BtorProfilePhase *p, phase;
+  uint32_t i;
+
+  for (i = BTOR_COUNT_STACK (prof->phases); i > 0; i--)
+  {
+    p = prof->phases.start + i - 1;
+    if (p->parent == parent && (p->name == name || !strcmp (p->name, name)))
+      return i - 1;
+  }
+
+  memset (&phase, 0, sizeof (phase));
+  phase.name   = name;
+  phase.parent = parent;
+  BTOR_PUSH_STACK (prof->phases, phase);
+  return BTOR_COUNT_STACK (prof->phases) - 1;
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+print_json_phase (BtorProfile *prof, uint32_t idx)
+{
+  BtorProfilePhase *p;
+  uint32_t i;
+  bool first;
+
+  p = prof->phases.start + idx;
+  fprintf (prof->out,
+           "{\"name\":\"%s\",\"calls\":%llu,\"time\":%.6f,\"mem\":%lld,"
+           "\"sat_calls\":%llu,\"phases\":[",
+           p->name,
+           (unsigned long long) p->calls,
+           p->time,
+           (long long) p->mem,
+           (unsigned long long) p->sat_calls);
+  for (i = idx + 1, first = true; i < BTOR_COUNT_STACK (prof->phases); i++)
+  {
+    if (prof->phases.start[i].parent != (int32_t) idx) continue;
+    if (!first) fputc (',', prof->out);
+    print_json_phase (prof, i);
+    first = false;
+  }
+  fputs ("]}", prof->out);
+}
+
+static void
+print_json (Btor *btor)
+{
+  BtorProfile *prof = btor->profile;
+  uint32_t i;
+  bool first;
+
+  fprintf (prof->out, "{\"call\":%u,\"phases\":[", btor->btor_sat_btor_called);
+  for (i = 0, first = true; i < BTOR_COUNT_STACK (prof->phases); i++)
+  {
+    if (prof->phases.start[i].parent != -1) continue;
+    if (!first) fputc (',', prof->out);
+    print_json_phase (prof, i);
+    first = false;
+  }
+  fputs ("]}\n", prof->out);
+}
+
+static void
+print_trace (Btor *btor)
+{
+  BtorProfile *prof = btor->profile;
+  BtorProfileScope *e;
+  uint32_t i;
+
+  for (i = 0; i < BTOR_COUNT_STACK (prof->events); i++)
+  {
+    e = prof->events.start + i;
+    fputs (prof->trace_started ? ",\n" : "[\n", prof->out);
+    prof->trace_started = true;
+    fprintf (prof->out,
+             "{\"name\":\"%s\",\"cat\":\"btor\",\"ph\":\"X\",\"pid\":0,"
+             "\"tid\":0,\"ts\":%.0f,\"dur\":%.0f,\"args\":{\"call\":%u,"
+             "\"mem\":%lld,\"sat_calls\":%llu}}",
+             BTOR_PEEK_STACK (prof->phases, e->phase).name,
+             (e->start - prof->epoch) * 1e6,
+             e->time * 1e6,
+             btor->btor_sat_btor_called,
+             (long long) e->mem,
+             (unsigned long long) e->sat_calls);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+void
+btor_profile_delete (Btor *btor)
+{
+  assert (btor);
+
+  BtorProfile *prof = btor->profile;
+  BtorMemMgr *mm;
+
+  if (!prof) return;
+  assert (BTOR_EMPTY_STACK (prof->scopes));
+  if (prof->close_out)
+    fclose (prof->out);
+  else
+    fflush (prof->out);
+  mm = prof->mm;
+  BTOR_RELEASE_STACK (prof->phases);
+  BTOR_RELEASE_STACK (prof->scopes);
+  BTOR_RELEASE_STACK (prof->events);
+  BTOR_DELETE (mm, prof);
+  btor_mem_mgr_delete (mm);
+  btor->profile = 0;
+}
+
+void
+btor_profile_check_sat_begin (Btor *btor)
+{
+  assert (btor);
+
+  BtorProfileMode mode = btor_opt_get (btor, BTOR_OPT_PROFILE);
+
+  if (mode == BTOR_PROFILE_NONE)
+  {
+    btor_profile_delete (btor);
+    return;
+  }
+  if (!btor->profile) btor->profile = new_profile (btor);
+  assert (BTOR_EMPTY_STACK (btor->profile->scopes));
+  btor->profile->mode = mode;
+  BTOR_RESET_STACK (btor->profile->phases);
+  BTOR_RESET_STACK (btor->profile->events);
+  btor_profile_begin (btor, "check_sat");
+}
+
+void
+btor_profile_check_sat_end (Btor *btor)
+{
+  assert (btor);
+
+  BtorProfile *prof = btor->profile;
+
+  if (!prof) return;
+  btor_profile_end (btor);
+  assert (BTOR_EMPTY_STACK (prof->scopes));
+  if (prof->mode == BTOR_PROFILE_TRACE)
+    print_trace (btor);
+  else
+    print_json (btor);
+  fflush (prof->out);
+}
+
+void
+btor_profile_begin (Btor *btor, const char *name)
+{
+  assert (btor);
+  assert (name);
+
+  BtorProfile *prof = btor->profile;
+  BtorProfileScope scope;
+
+  if (!prof) return;
+  scope.phase = get_phase (prof,
+                           BTOR_EMPTY_STACK (prof->scopes)
+                               ? -1
+                               : (int32_t) BTOR_TOP_STACK (prof->scopes).phase,
+                           name);
+  scope.start     = btor_util_current_time ();
+  scope.time      = 0;
+  scope.mem       = mem_allocated (btor);
+  scope.sat_calls = prof->sat_calls;
+  BTOR_PUSH_STACK (prof->scopes, scope);
+}
+
+void
+btor_profile_end (Btor *btor)
+{
+  assert (btor);
+
+  BtorProfile *prof = btor->profile;
+  BtorProfileScope scope;
+  BtorProfilePhase *p;
+
+  if (!prof) return;
+  assert (!BTOR_EMPTY_STACK (prof->scopes));
+  scope           = BTOR_POP_STACK (prof->scopes);
+  scope.time      = btor_util_current_time () - scope.start;
+  scope.mem       = mem_allocated (btor) - scope.mem;
+  scope.sat_calls = prof->sat_calls - scope.sat_calls;
+
+  p = prof->phases.start + scope.phase;
+  p->calls += 1;
+  p->time += scope.time;
+  p->mem += scope.mem;
+  p->sat_calls += scope.sat_calls;
+
+  if (prof->mode == BTOR_PROFILE_TRACE) BTOR_PUSH_STACK (prof->events, scope);
+}
+
+void
+btor_profile_count_sat_call (Btor *btor)
+{
+  assert (btor);
+  if (btor->profile) btor->profile->sat_calls += 1;
+}
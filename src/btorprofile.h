@@ -0,0 +1,55 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORPROFILE_H_INCLUDED
+#define BTORPROFILE_H_INCLUDED
+
+#include "btortypes.h"
+
+/* Hierarchical phase profiler (enabled via BTOR_OPT_PROFILE).
+ *
+ * Phases are nested scopes opened with btor_profile_begin and closed with
+ * btor_profile_end.  For every phase (identified by its name and its parent
+ * phase) the number of calls, the wall-clock time, the change of memory
+ * allocated via the memory manager of the instance and the number of SAT
+ * calls are accumulated.  The profile of a btor_check_sat call is written at
+ * the end of the call to the file given in the environment variable
+ * BTORPROFILEOUT (stdout if not set), either as one JSON object per line
+ * (BTOR_PROFILE_JSON) or as complete events of the Chrome trace-event format
+ * (BTOR_PROFILE_TRACE, the closing ']' of the event array is omitted as
+ * permitted by the format).  Clones are not profiled.  The profiler allocates
+ * its data with a separate memory manager, and is a no-op (besides a null
+ * check) if disabled. */
+
+enum BtorProfileMode
+{
+  BTOR_PROFILE_NONE,
+  BTOR_PROFILE_JSON,
+  BTOR_PROFILE_TRACE,
+};
+
+typedef enum BtorProfileMode BtorProfileMode;
+
+typedef struct BtorProfile BtorProfile;
+
+void btor_profile_delete (Btor *btor);
+
+/* Reset profile and open phase 'check_sat' (if BTOR_OPT_PROFILE is set). */
+void btor_profile_check_sat_begin (Btor *btor);
+
+/* Close phase 'check_sat' and write profile. */
+void btor_profile_check_sat_end (Btor *btor);
+
+/* 'name' is not copied, i.e., it must be a string literal. */
+void btor_profile_begin (Btor *btor, const char *name);
+
+void btor_profile_end (Btor *btor);
+
+void btor_profile_count_sat_call (Btor *btor);
+
+#endif
@@ -21,6 +21,7 @@
 #include "sat/btorlgl.h"
 #include "sat/btorminisat.h"
 #include "sat/btorpicosat.h"
+#include "sat/btorsimp.h"
 #include "utils/btorutil.h"
 
 /*------------------------------------------------------------------------*/
@@ -44,6 +45,16 @@ add (BtorSATMgr *smgr, int32_t lit)
   smgr->api.add (smgr, lit);
 }
 
+static inline void
+add_clauses (BtorSATMgr *smgr, const int32_t *lits, size_t n)
+{
+  size_t i;
+  if (smgr->api.add_clauses)
+    smgr->api.add_clauses (smgr, lits, n);
+  else
+    for (i = 0; i < n; i++) add (smgr, lits[i]);
+}
+
 static inline void
 assume (BtorSATMgr *smgr, int32_t lit)
 {
@@ -75,6 +86,12 @@ enable_verbosity (BtorSATMgr *smgr, int32_t level)
   if (smgr->api.enable_verbosity) smgr->api.enable_verbosity (smgr, level);
 }
 
+static inline void
+export_learned (BtorSATMgr *smgr)
+{
+  if (smgr->api.export_learned) smgr->api.export_learned (smgr);
+}
+
 static inline int32_t
 failed (BtorSATMgr *smgr, int32_t lit)
 {
@@ -91,6 +108,15 @@ fixed (BtorSATMgr *smgr, int32_t lit)
   return 0;
 }
 
+static inline void
+import_clauses (BtorSATMgr *smgr, const int32_t *lits, size_t n)
+{
+  if (smgr->api.import_clauses)
+    smgr->api.import_clauses (smgr, lits, n);
+  else
+    add_clauses (smgr, lits, n);
+}
+
 static inline int32_t
 inc_max_var (BtorSATMgr *smgr)
 {
@@ -133,6 +159,20 @@ sat (BtorSATMgr *smgr, int32_t limit)
   return smgr->api.sat (smgr, limit);
 }
 
+static inline int32_t
+reusable (BtorSATMgr *smgr, int32_t lit)
+{
+  if (smgr->api.reusable) return smgr->api.reusable (smgr, lit);
+  return 0;
+}
+
+static inline void
+reuse (BtorSATMgr *smgr, int32_t lit)
+{
+  assert (smgr->api.reuse);
+  smgr->api.reuse (smgr, lit);
+}
+
 static inline void
 set_output (BtorSATMgr *smgr, FILE *output)
 {
@@ -169,6 +209,8 @@ btor_sat_mgr_new (Btor *btor)
   BTOR_CNEW (btor->mm, smgr);
   smgr->btor   = btor;
   smgr->output = stdout;
+  BTOR_INIT_STACK (btor->mm, smgr->released);
+  BTOR_INIT_STACK (btor->mm, smgr->reusable);
   return smgr;
 }
 
@@ -194,6 +236,45 @@ btor_sat_mgr_set_term (BtorSATMgr *smgr, int32_t (*fun) (void *), void *state)
   smgr->term.state = state;
 }
 
+bool
+btor_sat_mgr_has_clause_sharing_support (const BtorSATMgr *smgr)
+{
+  if (!smgr) return false;
+  return smgr->api.export_learned != 0;
+}
+
+void
+btor_sat_mgr_set_share (BtorSATMgr *smgr,
+                        void (*learned) (void *, const int32_t *, uint32_t),
+                        void (*import) (void *, BtorSATMgr *),
+                        void *state,
+                        uint32_t max_size,
+                        uint32_t max_lbd)
+{
+  assert (smgr);
+  smgr->share.learned  = learned;
+  smgr->share.import   = import;
+  smgr->share.state    = state;
+  smgr->share.max_size = max_size;
+  smgr->share.max_lbd  = max_lbd;
+}
+
+static void
+clone_int_stack (BtorMemMgr *mm, BtorIntStack *clone, BtorIntStack *stack)
+{
+  size_t size = BTOR_SIZE_STACK (*stack);
+  size_t cnt  = BTOR_COUNT_STACK (*stack);
+
+  BTOR_INIT_STACK (mm, *clone);
+  if (size)
+  {
+    BTOR_CNEWN (mm, clone->start, size);
+    clone->end = clone->start + size;
+    clone->top = clone->start + cnt;
+    memcpy (clone->start, stack->start, cnt * sizeof (int32_t));
+  }
+}
+
 // FIXME log output handling, in particular: sat manager name output
 // (see lingeling_sat) should be unique, which is not the case for
 // clones
@@ -215,10 +296,13 @@ btor_sat_mgr_clone (Btor *btor, BtorSATMgr *smgr)
   res->btor   = btor;
   assert (mm->sat_allocated == smgr->btor->mm->sat_allocated);
   res->name = smgr->name;
+  clone_int_stack (mm, &res->released, &smgr->released);
+  clone_int_stack (mm, &res->reusable, &smgr->reusable);
   memcpy (&res->inc_required,
           &smgr->inc_required,
           (char *) smgr + sizeof (*smgr) - (char *) &smgr->inc_required);
   BTOR_CLR (&res->term);
+  BTOR_CLR (&res->share);
   return res;
 }
 
@@ -235,6 +319,13 @@ btor_sat_mgr_next_cnf_id (BtorSATMgr *smgr)
   int32_t result;
   assert (smgr);
   assert (smgr->initialized);
+  if (!BTOR_EMPTY_STACK (smgr->reusable))
+  {
+    result = BTOR_POP_STACK (smgr->reusable);
+    reuse (smgr, result);
+    smgr->reused++;
+    return result;
+  }
   result = inc_max_var (smgr);
   if (abs (result) > smgr->maxvar) smgr->maxvar = abs (result);
   BTOR_ABORT (result <= 0, "CNF id overflow");
@@ -251,6 +342,27 @@ btor_sat_mgr_release_cnf_id (BtorSATMgr *smgr, int32_t lit)
   assert (abs (lit) <= smgr->maxvar);
   if (abs (lit) == smgr->true_lit) return;
   melt (smgr, lit);
+  if (smgr->api.reuse && smgr->inc_required)
+    BTOR_PUSH_STACK (smgr->released, abs (lit));
+}
+
+/* Move released CNF ids that do not occur in any clause anymore (e.g., after
+ * being eliminated by the SAT solver) to the reusable CNF ids. */
+static void
+collect_reusable (BtorSATMgr *smgr)
+{
+  int32_t lit;
+  size_t i, j;
+
+  for (i = j = 0; i < BTOR_COUNT_STACK (smgr->released); i++)
+  {
+    lit = BTOR_PEEK_STACK (smgr->released, i);
+    if (reusable (smgr, lit))
+      BTOR_PUSH_STACK (smgr->reusable, lit);
+    else
+      BTOR_POKE_STACK (smgr->released, j++, lit);
+  }
+  smgr->released.top = smgr->released.start + j;
 }
 
 void
@@ -261,6 +373,8 @@ btor_sat_mgr_delete (BtorSATMgr *smgr)
    * reset_sat has not been called
    */
   if (smgr->initialized) btor_sat_reset (smgr);
+  BTOR_RELEASE_STACK (smgr->released);
+  BTOR_RELEASE_STACK (smgr->reusable);
   BTOR_DELETE (smgr->btor->mm, smgr);
 }
 
@@ -321,6 +435,11 @@ btor_sat_enable_solver (BtorSATMgr *smgr)
             smgr->name,
             smgr->api.assume ? "both incremental and " : "");
 
+  if (btor_opt_get (smgr->btor, BTOR_OPT_SAT_PREPROCESS))
+  {
+    btor_sat_enable_simp (smgr);
+  }
+
   if (btor_opt_get (smgr->btor, BTOR_OPT_PRINT_DIMACS))
   {
     enable_dimacs_printer (smgr);
@@ -370,6 +489,8 @@ btor_sat_print_stats (BtorSATMgr *smgr)
             "%d SAT calls in %.1f seconds",
             smgr->satcalls,
             smgr->sat_time);
+  if (smgr->api.reuse)
+    BTOR_MSG (smgr->btor->msg, 1, "%d CNF ids reused", smgr->reused);
 }
 
 void
@@ -383,6 +504,38 @@ btor_sat_add (BtorSATMgr *smgr, int32_t lit)
   add (smgr, lit);
 }
 
+void
+btor_sat_add_clauses (BtorSATMgr *smgr, const int32_t *lits, size_t n)
+{
+  size_t i;
+  assert (smgr != NULL);
+  assert (smgr->initialized);
+  assert (!n || lits);
+  assert (!n || !lits[n - 1]);
+  assert (!smgr->satcalls || smgr->inc_required);
+  for (i = 0; i < n; i++)
+  {
+    assert (abs (lits[i]) <= smgr->maxvar);
+    if (!lits[i]) smgr->clauses++;
+  }
+  add_clauses (smgr, lits, n);
+}
+
+void
+btor_sat_import_clauses (BtorSATMgr *smgr, const int32_t *lits, size_t n)
+{
+  assert (smgr != NULL);
+  assert (smgr->initialized);
+  assert (!n || lits);
+  assert (!n || !lits[n - 1]);
+  assert (!smgr->satcalls || smgr->inc_required);
+#ifndef NDEBUG
+  size_t i;
+  for (i = 0; i < n; i++) assert (abs (lits[i]) <= smgr->maxvar);
+#endif
+  import_clauses (smgr, lits, n);
+}
+
 BtorSolverResult
 btor_sat_check_sat (BtorSATMgr *smgr, int32_t limit)
 {
@@ -399,9 +552,17 @@ btor_sat_check_sat (BtorSATMgr *smgr, int32_t limit)
             smgr->name,
             limit);
   assert (!smgr->satcalls || smgr->inc_required);
+  if (smgr->share.import) smgr->share.import (smgr->share.state, smgr);
   smgr->satcalls++;
+  btor_profile_begin (smgr->btor, "sat");
+  BTOR_PERF_BEGIN (smgr->btor, BTOR_PERF_SAT);
+  btor_profile_count_sat_call (smgr->btor);
   setterm (smgr);
+  export_learned (smgr);
   sat_res = sat (smgr, limit);
+  if (!BTOR_EMPTY_STACK (smgr->released)) collect_reusable (smgr);
+  BTOR_PERF_END (smgr->btor, BTOR_PERF_SAT);
+  btor_profile_end (smgr->btor);
   smgr->sat_time += btor_util_time_stamp () - start;
   switch (sat_res)
   {
@@ -439,6 +600,8 @@ btor_sat_reset (BtorSATMgr *smgr)
   assert (smgr->initialized);
   BTOR_MSG (smgr->btor->msg, 2, "resetting %s", smgr->name);
   reset (smgr);
+  BTOR_RESET_STACK (smgr->released);
+  BTOR_RESET_STACK (smgr->reusable);
   smgr->solver      = 0;
   smgr->initialized = false;
 }
@@ -508,6 +671,15 @@ dimacs_printer_add (BtorSATMgr *smgr, int32_t lit)
   add (printer->smgr, lit);
 }
 
+static void
+dimacs_printer_add_clauses (BtorSATMgr *smgr, const int32_t *lits, size_t n)
+{
+  BtorCnfPrinter *printer = (BtorCnfPrinter *) smgr->solver;
+  size_t i;
+  for (i = 0; i < n; i++) BTOR_PUSH_STACK (printer->clauses, lits[i]);
+  add_clauses (printer->smgr, lits, n);
+}
+
 static void
 dimacs_printer_assume (BtorSATMgr *smgr, int32_t lit)
 {
@@ -637,22 +809,6 @@ dimacs_printer_stats (BtorSATMgr *smgr)
   stats (printer->smgr);
 }
 
-static void
-clone_int_stack (BtorMemMgr *mm, BtorIntStack *clone, BtorIntStack *stack)
-{
-  size_t size = BTOR_SIZE_STACK (*stack);
-  size_t cnt  = BTOR_COUNT_STACK (*stack);
-
-  BTOR_INIT_STACK (mm, *clone);
-  if (size)
-  {
-    BTOR_CNEWN (mm, clone->start, size);
-    clone->end = clone->start + size;
-    clone->top = clone->start + cnt;
-    memcpy (clone->start, stack->start, cnt * sizeof (int32_t));
-  }
-}
-
 static void *
 dimacs_printer_clone (Btor *btor, BtorSATMgr *smgr)
 {
@@ -678,6 +834,24 @@ dimacs_printer_setterm (BtorSATMgr *smgr)
   setterm (printer->smgr);
 }
 
+static void
+dimacs_printer_export_learned (BtorSATMgr *smgr)
+{
+  BtorCnfPrinter *printer = (BtorCnfPrinter *) smgr->solver;
+  printer->smgr->share    = smgr->share;
+  export_learned (printer->smgr);
+}
+
+/* Imported clauses are not part of the dumped CNF. */
+static void
+dimacs_printer_import_clauses (BtorSATMgr *smgr,
+                               const int32_t *lits,
+                               size_t n)
+{
+  BtorCnfPrinter *printer = (BtorCnfPrinter *) smgr->solver;
+  import_clauses (printer->smgr, lits, n);
+}
+
 static int32_t
 dimacs_printer_inc_max_var (BtorSATMgr *smgr)
 {
@@ -716,12 +890,14 @@ enable_dimacs_printer (BtorSATMgr *smgr)
   BTOR_CNEW (smgr->btor->mm, printer->smgr);
   memcpy (printer->smgr, smgr, sizeof (BtorSATMgr));
 
-  /* Clear API */
+  /* Clear API (CNF ids are not reused since the dumped CNF contains all
+   * clauses ever added) */
   memset (&smgr->api, 0, sizeof (smgr->api));
 
   smgr->solver               = printer;
   smgr->name                 = "DIMACS Printer";
   smgr->api.add              = dimacs_printer_add;
+  smgr->api.add_clauses      = dimacs_printer_add_clauses;
   smgr->api.deref            = dimacs_printer_deref;
   smgr->api.enable_verbosity = dimacs_printer_enable_verbosity;
   smgr->api.fixed            = dimacs_printer_fixed;
@@ -735,12 +911,15 @@ enable_dimacs_printer (BtorSATMgr *smgr)
   smgr->api.set_prefix       = dimacs_printer_set_prefix;
   smgr->api.stats            = dimacs_printer_stats;
   smgr->api.setterm          = dimacs_printer_setterm;
+  smgr->api.import_clauses   = dimacs_printer_import_clauses;
 
   /* These function are used in btor_sat_mgr_has_* testers and should only be
    * set if the underlying SAT solver also has support for it. */
   smgr->api.assume = printer->smgr->api.assume ? dimacs_printer_assume : 0;
   smgr->api.failed = printer->smgr->api.failed ? dimacs_printer_failed : 0;
   smgr->api.clone  = printer->smgr->api.clone ? dimacs_printer_clone : 0;
+  smgr->api.export_learned =
+      printer->smgr->api.export_learned ? dimacs_printer_export_learned : 0;
 
   return true;
 }
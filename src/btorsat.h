@@ -29,6 +29,12 @@ struct BtorSATMgr
 
   const char *name; /* solver name */
 
+  /* released CNF ids that are not yet reusable, and CNF ids that the SAT
+   * solver reported as reusable (only if the SAT solver supports reusing
+   * CNF ids) */
+  BtorIntStack released;
+  BtorIntStack reusable;
+
   /* Note: do not change order! (btor_sat_mgr_clone relies on inc_required
    * to come first of all fields following below.) */
   bool inc_required;
@@ -42,6 +48,7 @@ struct BtorSATMgr
   int32_t clauses;
   int32_t true_lit;
   int32_t maxvar;
+  int32_t reused;
 
   double sat_time;
 
@@ -51,10 +58,22 @@ struct BtorSATMgr
     void *state;
   } term;
 
+  struct
+  {
+    /* learned clause callback, 'lits' is not zero terminated */
+    void (*learned) (void *, const int32_t *, uint32_t);
+    /* called before each SAT call to import clauses */
+    void (*import) (void *, BtorSATMgr *);
+    void *state;
+    uint32_t max_size; /* max. size of exported clauses */
+    uint32_t max_lbd;  /* max. LBD of exported clauses (if supported) */
+  } share;
+
   bool have_restore;
   struct
   {
     void (*add) (BtorSATMgr *, int32_t); /* required */
+    void (*add_clauses) (BtorSATMgr *, const int32_t *, size_t);
     void (*assume) (BtorSATMgr *, int32_t);
     int32_t (*deref) (BtorSATMgr *, int32_t); /* required */
     void (*enable_verbosity) (BtorSATMgr *, int32_t);
@@ -71,6 +90,10 @@ struct BtorSATMgr
     void (*stats) (BtorSATMgr *);
     void *(*clone) (Btor *btor, BtorSATMgr *);
     void (*setterm) (BtorSATMgr *);
+    void (*export_learned) (BtorSATMgr *);
+    void (*import_clauses) (BtorSATMgr *, const int32_t *, size_t);
+    int32_t (*reusable) (BtorSATMgr *, int32_t);
+    void (*reuse) (BtorSATMgr *, int32_t);
   } api;
 };
 
@@ -101,6 +124,21 @@ void btor_sat_mgr_set_term (BtorSATMgr *smgr,
                             int32_t (*fun) (void *),
                             void *state);
 
+bool btor_sat_mgr_has_clause_sharing_support (const BtorSATMgr *smgr);
+
+/* Set callbacks for exchanging clauses with other SAT managers.  Learned
+ * clauses with at most 'max_size' literals and LBD at most 'max_lbd' are
+ * passed to 'learned' (if the SAT solver supports exporting learned clauses),
+ * 'import' is called before each SAT call. */
+void btor_sat_mgr_set_share (BtorSATMgr *smgr,
+                             void (*learned) (void *,
+                                              const int32_t *,
+                                              uint32_t),
+                             void (*import) (void *, BtorSATMgr *),
+                             void *state,
+                             uint32_t max_size,
+                             uint32_t max_lbd);
+
 /* Clones existing SAT manager (and underlying SAT solver). */
 BtorSATMgr *btor_sat_mgr_clone (Btor *btor, BtorSATMgr *smgr);
 
@@ -108,10 +146,14 @@ BtorSATMgr *btor_sat_mgr_clone (Btor *btor, BtorSATMgr *smgr);
 void btor_sat_mgr_delete (BtorSATMgr *smgr);
 
 /* Generates fresh CNF indices.
- * Indices are generated in consecutive order. */
+ * Indices are generated in consecutive order, unless the SAT solver supports
+ * reusing released indices, which are then reused first. */
 int32_t btor_sat_mgr_next_cnf_id (BtorSATMgr *smgr);
 
-/* Mark old CNF index as not used anymore. */
+/* Mark old CNF index as not used anymore.
+ * If the SAT solver supports it, the index is reused as soon as the SAT
+ * solver reports that it does not occur in any clause anymore (checked after
+ * each SAT call). */
 void btor_sat_mgr_release_cnf_id (BtorSATMgr *smgr, int32_t);
 
 #if 0
@@ -138,6 +180,17 @@ void btor_sat_print_stats (BtorSATMgr *smgr);
  */
 void btor_sat_add (BtorSATMgr *smgr, int32_t lit);
 
+/* Adds the 'n' literals in 'lits' to the SAT solver at once, where each
+ * clause is terminated by 0 (same as calling 'btor_sat_add' on each).
+ */
+void btor_sat_add_clauses (BtorSATMgr *smgr, const int32_t *lits, size_t n);
+
+/* Adds the zero terminated clauses in 'lits' that are implied by the clauses
+ * added so far (e.g., learned by another SAT solver on the same formula).
+ * Imported clauses may be dropped and are not counted as added clauses.
+ */
+void btor_sat_import_clauses (BtorSATMgr *smgr, const int32_t *lits, size_t n);
+
 /* Adds assumption to SAT solver.
  * Requires that SAT solver supports this.
  */
@@ -28,6 +28,64 @@
 #include "utils/btorunionfind.h"
 #include "utils/btorutil.h"
 
+BTOR_DECLARE_STACK (BtorUInt64, uint64_t);
+
+/*------------------------------------------------------------------------*/
+
+static size_t
+lemma_db_lemma_size (uint32_t num_prems)
+{
+  return sizeof (BtorFunLemma) + num_prems * sizeof (uint64_t);
+}
+
+static void
+clone_data_as_lemma_list (BtorMemMgr *mm,
+                          const void *map,
+                          BtorHashTableData *data,
+                          BtorHashTableData *cloned_data)
+{
+  assert (data);
+  assert (cloned_data);
+  (void) map;
+
+  size_t size;
+  BtorFunLemma *l, *cl, **next;
+
+  next = (BtorFunLemma **) &cloned_data->as_ptr;
+  for (l = data->as_ptr; l; l = l->next)
+  {
+    size = lemma_db_lemma_size (l->num_prems);
+    cl   = btor_mem_malloc (mm, size);
+    memcpy (cl, l, size);
+    *next = cl;
+    next  = &cl->next;
+  }
+  *next = 0;
+}
+
+static void
+delete_lemma_db (BtorFunSolver *slv)
+{
+  BtorMemMgr *mm;
+  BtorFunLemma *l, *next;
+  BtorIntHashTableIterator it;
+
+  mm = slv->btor->mm;
+  btor_iter_hashint_init (&it, slv->lemma_db);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    for (l = btor_iter_hashint_next_data (&it)->as_ptr; l; l = next)
+    {
+      next = l->next;
+      btor_mem_free (mm, l, lemma_db_lemma_size (l->num_prems));
+    }
+  }
+  btor_hashint_map_delete (slv->lemma_db);
+  slv->lemma_db       = 0;
+  slv->lemma_db_bytes = 0;
+  slv->lemma_db_count = 0;
+}
+
 /*------------------------------------------------------------------------*/
 
 static BtorFunSolver *
@@ -50,6 +108,10 @@ clone_fun_solver (Btor *clone, BtorFunSolver *slv, BtorNodeMap *exp_map)
   res->btor   = clone;
   res->lemmas = btor_hashptr_table_clone (
       clone->mm, slv->lemmas, btor_clone_key_as_node, 0, exp_map, 0);
+  res->args_hash_cache = 0;
+  /* node ids are preserved when cloning, no mapping required */
+  res->lemma_db = btor_hashint_map_clone (
+      clone->mm, slv->lemma_db, clone_data_as_lemma_list, 0);
 
   btor_clone_node_ptr_stack (
       clone->mm, &slv->cur_lemmas, &res->cur_lemmas, exp_map, false);
@@ -116,6 +178,7 @@ delete_fun_solver (BtorFunSolver *slv)
   while (btor_iter_hashptr_has_next (&it))
     btor_node_release (btor, btor_iter_hashptr_next (&it));
   btor_hashptr_table_delete (slv->lemmas);
+  delete_lemma_db (slv);
 
   if (slv->score)
   {
@@ -1234,8 +1297,17 @@ hash_args_assignment (BtorNode *exp)
   BtorNode *arg;
   BtorArgsIterator it;
   BtorBitVector *bv;
+  BtorIntHashTable *cache;
+  BtorHashTableData *d;
+
+  btor  = exp->btor;
+  cache = btor->slv && btor->slv->kind == BTOR_FUN_SOLVER_KIND
+              ? BTOR_FUN_SOLVER (btor)->args_hash_cache
+              : 0;
+
+  if (cache && (d = btor_hashint_map_get (cache, exp->id)))
+    return (uint32_t) d->as_int;
 
-  btor = exp->btor;
   hash = 0;
   btor_iter_args_init (&it, exp);
   while (btor_iter_args_has_next (&it))
@@ -1245,6 +1317,8 @@ hash_args_assignment (BtorNode *exp)
     hash += btor_bv_hash (bv);
     btor_bv_free (btor->mm, bv);
   }
+
+  if (cache) btor_hashint_map_add (cache, exp->id)->as_int = (int32_t) hash;
   return hash;
 }
 
@@ -1414,6 +1488,192 @@ mk_premise (Btor *btor, BtorNode *args, BtorNode *prem[], uint32_t num_prem)
   return res;
 }
 
+/*------------------------------------------------------------------------*/
+/* Lemma database                                                         */
+/*------------------------------------------------------------------------*/
+
+/* Premises are encoded as follows:
+ * - conditions: signed node id in the lower 32 bits
+ * - args0 != args1: smaller args id in the upper 32 bits, larger args id in
+ *   the lower 32 bits
+ * - args0 = args1: as args0 != args1, but with the MSB set */
+#define BTOR_FUN_LEMMA_EQ_ARGS (((uint64_t) 1) << 63)
+
+static uint64_t
+lemma_key_args (BtorNode *args0, BtorNode *args1, bool eq)
+{
+  assert (btor_node_is_regular (args0));
+  assert (btor_node_is_regular (args1));
+  assert (btor_node_is_args (args0));
+  assert (btor_node_is_args (args1));
+
+  uint64_t id0, id1, res;
+
+  id0 = (uint64_t) args0->id;
+  id1 = (uint64_t) args1->id;
+  res = id0 < id1 ? (id0 << 32) | id1 : (id1 << 32) | id0;
+  if (eq) res |= BTOR_FUN_LEMMA_EQ_ARGS;
+  return res;
+}
+
+static uint64_t
+lemma_key_conclusion (BtorNode *app, BtorNode *value)
+{
+  assert (btor_node_is_regular (app));
+  assert (btor_node_is_apply (app));
+
+  return ((uint64_t) app->id << 32)
+         | (uint64_t) (uint32_t) btor_node_get_id (value);
+}
+
+static void
+lemma_push_premise_keys (BtorUInt64Stack *keys,
+                         BtorNode *args,
+                         BtorNodePtrStack *prem)
+{
+  uint32_t i;
+  BtorNode *cur;
+
+  for (i = 0; i < BTOR_COUNT_STACK (*prem); i++)
+  {
+    cur = BTOR_PEEK_STACK (*prem, i);
+    if (btor_node_is_args (cur))
+      BTOR_PUSH_STACK (*keys, lemma_key_args (args, cur, false));
+    else
+      BTOR_PUSH_STACK (*keys, (uint64_t) (uint32_t) btor_node_get_id (cur));
+  }
+}
+
+static int32_t
+compare_lemma_keys_qsort_asc (const void *p1, const void *p2)
+{
+  uint64_t k1, k2;
+  k1 = *(const uint64_t *) p1;
+  k2 = *(const uint64_t *) p2;
+  return k1 < k2 ? -1 : (k1 > k2 ? 1 : 0);
+}
+
+/* Sort premise keys and remove duplicates. */
+static void
+lemma_normalize_keys (BtorUInt64Stack *keys)
+{
+  uint64_t *p, *q;
+
+  if (BTOR_COUNT_STACK (*keys) < 2) return;
+
+  qsort (keys->start,
+         BTOR_COUNT_STACK (*keys),
+         sizeof (uint64_t),
+         compare_lemma_keys_qsort_asc);
+  for (p = q = keys->start + 1; q < keys->top; q++)
+    if (*q != *(p - 1)) *p++ = *q;
+  keys->top = p;
+}
+
+/* Check if sorted premises 'p0' are a subset of sorted premises 'p1'. */
+static bool
+lemma_prems_subset (const uint64_t *p0,
+                    uint32_t n0,
+                    const uint64_t *p1,
+                    uint32_t n1)
+{
+  uint32_t i, j;
+
+  if (n0 > n1) return false;
+
+  for (i = 0, j = 0; i < n0 && j < n1;)
+  {
+    if (p0[i] == p1[j])
+    {
+      i++;
+      j++;
+    }
+    else if (p0[i] > p1[j])
+      j++;
+    else
+      return false;
+  }
+  return i == n0;
+}
+
+/* Find lemma in the lemma database that subsumes (or is equal to) the lemma
+ * given by 'conclusion' and premises 'keys'. */
+static BtorFunLemma *
+lemma_db_find_subsuming (BtorFunSolver *slv,
+                         int32_t key,
+                         uint64_t conclusion,
+                         BtorUInt64Stack *keys)
+{
+  BtorFunLemma *l;
+  BtorHashTableData *d;
+
+  if (!(d = btor_hashint_map_get (slv->lemma_db, key))) return 0;
+
+  for (l = d->as_ptr; l; l = l->next)
+  {
+    if (l->conclusion != conclusion) continue;
+    if (lemma_prems_subset (
+            l->prems, l->num_prems, keys->start, BTOR_COUNT_STACK (*keys)))
+      return l;
+  }
+  return 0;
+}
+
+/* Add lemma to the lemma database.  Database lemmas with the same conclusion
+ * and a superset of the premises of the new lemma are subsumed by the new
+ * lemma and removed from the database (only the compact record is removed,
+ * the lemma itself remains part of the formula). */
+static void
+lemma_db_add (BtorFunSolver *slv,
+              int32_t key,
+              uint64_t conclusion,
+              BtorUInt64Stack *keys)
+{
+  size_t size;
+  uint32_t num_prems;
+  BtorFunLemma *l, **prev;
+  BtorHashTableData *d;
+  BtorMemMgr *mm;
+
+  mm        = slv->btor->mm;
+  num_prems = BTOR_COUNT_STACK (*keys);
+  size      = lemma_db_lemma_size (num_prems);
+
+  if (!(d = btor_hashint_map_get (slv->lemma_db, key)))
+  {
+    d         = btor_hashint_map_add (slv->lemma_db, key);
+    d->as_ptr = 0;
+  }
+
+  prev = (BtorFunLemma **) &d->as_ptr;
+  while ((l = *prev))
+  {
+    if (l->conclusion != conclusion
+        || !lemma_prems_subset (keys->start, num_prems, l->prems, l->num_prems))
+    {
+      prev = &l->next;
+      continue;
+    }
+    *prev = l->next;
+    slv->lemma_db_bytes -= lemma_db_lemma_size (l->num_prems);
+    slv->lemma_db_count -= 1;
+    slv->stats.lemmas_subsuming++;
+    btor_mem_free (mm, l, lemma_db_lemma_size (l->num_prems));
+  }
+
+  l             = btor_mem_malloc (mm, size);
+  l->next       = d->as_ptr;
+  l->conclusion = conclusion;
+  l->num_prems  = num_prems;
+  if (num_prems) memcpy (l->prems, keys->start, num_prems * sizeof (uint64_t));
+  d->as_ptr = l;
+
+  slv->lemma_db_bytes += size;
+  slv->lemma_db_count += 1;
+}
+
+/*------------------------------------------------------------------------*/
+
 static void
 add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
 {
@@ -1430,10 +1690,14 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
   assert (!app2 || btor_node_is_regular (app2) || btor_node_is_apply (app2));
 
   double start;
+  int32_t db_key;
   uint32_t i, lemma_size = 1;
+  uint64_t conclusion;
   BtorIntHashTable *cache_app1, *cache_app2;
   BtorNodePtrStack prem_app1, prem_app2, prem;
-  BtorNode *value, *tmp, *and, *con, *lemma;
+  BtorUInt64Stack keys;
+  BtorNode *value = 0, *tmp, *and, *con, *lemma;
+  BtorFunLemma *l;
   BtorMemMgr *mm;
   BtorFunSolver *slv;
 
@@ -1445,32 +1709,34 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
   BTOR_INIT_STACK (mm, prem_app1);
   BTOR_INIT_STACK (mm, prem_app2);
   BTOR_INIT_STACK (mm, prem);
+  BTOR_INIT_STACK (mm, keys);
 
-  /* collect premise and conclusion */
+  /* collect premises and conclusion in compact form */
 
   collect_premisses (btor, app1, fun, app1->e[1], &prem_app1, cache_app1);
-  tmp = mk_premise (
-      btor, app1->e[1], prem_app1.start, BTOR_COUNT_STACK (prem_app1));
-
-  BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
+  lemma_push_premise_keys (&keys, app1->e[1], &prem_app1);
   lemma_size += BTOR_COUNT_STACK (prem_app1);
+  db_key = app1->id;
 
   if (app2) /* function congruence axiom conflict */
   {
     collect_premisses (btor, app2, fun, app2->e[1], &prem_app2, cache_app2);
-    tmp = mk_premise (
-        btor, app2->e[1], prem_app2.start, BTOR_COUNT_STACK (prem_app2));
-
-    BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
-    BTOR_PUSH_STACK (prem, mk_equal_args (btor, app1->e[1], app2->e[1]));
+    lemma_push_premise_keys (&keys, app2->e[1], &prem_app2);
+    BTOR_PUSH_STACK (keys, lemma_key_args (app1->e[1], app2->e[1], true));
     lemma_size += BTOR_COUNT_STACK (prem_app2);
-    con = btor_exp_eq (btor, app1, app2);
+    if (app2->id < app1->id)
+    {
+      db_key     = app2->id;
+      conclusion = lemma_key_conclusion (app2, app1);
+    }
+    else
+      conclusion = lemma_key_conclusion (app1, app2);
   }
   else if (btor_node_is_update (fun)) /* read over write conflict */
   {
-    BTOR_PUSH_STACK (prem, mk_equal_args (btor, app1->e[1], fun->e[1]));
+    BTOR_PUSH_STACK (keys, lemma_key_args (app1->e[1], fun->e[1], true));
     lemma_size += btor_node_args_get_arity (btor, app1->e[1]);
-    con = btor_exp_eq (btor, app1, fun->e[2]);
+    conclusion = lemma_key_conclusion (app1, fun->e[2]);
   }
   else /* beta reduction conflict */
   {
@@ -1488,14 +1754,48 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
                        app1->e[1],
                        &prem_app2,
                        cache_app2);
+    lemma_push_premise_keys (&keys, app1->e[1], &prem_app2);
+    lemma_size += BTOR_COUNT_STACK (prem_app2);
+    conclusion = lemma_key_conclusion (app1, value);
+  }
+
+  /* skip lemma if it is subsumed by a lemma in the lemma database */
+  lemma_normalize_keys (&keys);
+  if ((l = lemma_db_find_subsuming (slv, db_key, conclusion, &keys)))
+  {
+    if (l->num_prems == BTOR_COUNT_STACK (keys))
+      slv->stats.lemmas_duplicate++;
+    else
+      slv->stats.lemmas_subsumed++;
+    goto DONE;
+  }
+
+  /* create premise and conclusion */
 
+  tmp = mk_premise (
+      btor, app1->e[1], prem_app1.start, BTOR_COUNT_STACK (prem_app1));
+  BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
+
+  if (app2)
+  {
+    tmp = mk_premise (
+        btor, app2->e[1], prem_app2.start, BTOR_COUNT_STACK (prem_app2));
+    BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
+    BTOR_PUSH_STACK (prem, mk_equal_args (btor, app1->e[1], app2->e[1]));
+    con = btor_exp_eq (btor, app1, app2);
+  }
+  else if (btor_node_is_update (fun))
+  {
+    BTOR_PUSH_STACK (prem, mk_equal_args (btor, app1->e[1], fun->e[1]));
+    con = btor_exp_eq (btor, app1, fun->e[2]);
+  }
+  else
+  {
+    assert (value);
     tmp = mk_premise (
         btor, app1->e[1], prem_app2.start, BTOR_COUNT_STACK (prem_app2));
-
     BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
-    lemma_size += BTOR_COUNT_STACK (prem_app2);
     con = btor_exp_eq (btor, app1, value);
-    btor_node_release (btor, value);
   }
 
   /* create lemma */
@@ -1514,6 +1814,7 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
   {
     btor_hashptr_table_add (slv->lemmas, btor_node_copy (btor, lemma));
     BTOR_PUSH_STACK (slv->cur_lemmas, lemma);
+    lemma_db_add (slv, db_key, conclusion, &keys);
     slv->stats.lod_refinements++;
     slv->stats.lemmas_size_sum += lemma_size;
     if (lemma_size >= BTOR_SIZE_STACK (slv->stats.lemmas_size))
@@ -1522,7 +1823,9 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
   }
   btor_node_release (btor, lemma);
 
+DONE:
   /* cleanup */
+  if (value) btor_node_release (btor, value);
   for (i = 0; i < BTOR_COUNT_STACK (prem); i++)
     btor_node_release (btor, BTOR_PEEK_STACK (prem, i));
   for (i = 0; i < BTOR_COUNT_STACK (prem_app1); i++)
@@ -1532,6 +1835,7 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
   BTOR_RELEASE_STACK (prem_app1);
   BTOR_RELEASE_STACK (prem_app2);
   BTOR_RELEASE_STACK (prem);
+  BTOR_RELEASE_STACK (keys);
   btor_hashint_table_delete (cache_app1);
   btor_hashint_table_delete (cache_app2);
   BTOR_FUN_SOLVER (btor)->time.lemma_gen += btor_util_time_stamp () - start;
@@ -1646,7 +1950,7 @@ propagate (Btor *btor,
   assert (apply_search_cache);
 
   double start;
-  uint32_t opt_eager_lemmas;
+  uint32_t opt_eager_lemmas, batch_size;
   bool prop_down, conflict, restart;
   BtorBitVector *bv;
   BtorMemMgr *mm;
@@ -1663,11 +1967,21 @@ propagate (Btor *btor,
   slv              = BTOR_FUN_SOLVER (btor);
   conf_apps        = btor_hashint_table_new (mm);
   opt_eager_lemmas = btor_opt_get (btor, BTOR_OPT_FUN_EAGER_LEMMAS);
+  batch_size       = opt_eager_lemmas == BTOR_FUN_EAGER_LEMMAS_BATCH
+                         ? btor_opt_get (btor, BTOR_OPT_FUN_LEMMA_BATCH_SIZE)
+                         : 0;
 
   BTORLOG (1, "");
   BTORLOG (1, "*** %s", __FUNCTION__);
   while (!BTOR_EMPTY_STACK (*prop_stack))
   {
+    /* stop if batch of lemmas is complete */
+    if (batch_size && BTOR_COUNT_STACK (slv->cur_lemmas) >= batch_size)
+    {
+      slv->stats.lemma_batches_full++;
+      break;
+    }
+
     fun = btor_node_get_simplified (btor, BTOR_POP_STACK (*prop_stack));
     assert (btor_node_is_regular (fun));
     assert (btor_node_is_fun (fun));
@@ -1733,7 +2047,8 @@ propagate (Btor *btor,
             btor_hashint_table_add (conf_apps, app->id);
             restart = find_conflict_app (btor, app, conf_apps);
           }
-          else if (opt_eager_lemmas == BTOR_FUN_EAGER_LEMMAS_ALL)
+          else if (opt_eager_lemmas == BTOR_FUN_EAGER_LEMMAS_ALL
+                   || opt_eager_lemmas == BTOR_FUN_EAGER_LEMMAS_BATCH)
             restart = false;
           slv->stats.function_congruence_conflicts++;
           add_lemma (btor, fun, hashed_app, app);
@@ -1854,7 +2169,8 @@ propagate (Btor *btor,
         btor_hashint_table_add (conf_apps, app->id);
         restart = find_conflict_app (btor, app, conf_apps);
       }
-      else if (opt_eager_lemmas == BTOR_FUN_EAGER_LEMMAS_ALL)
+      else if (opt_eager_lemmas == BTOR_FUN_EAGER_LEMMAS_ALL
+               || opt_eager_lemmas == BTOR_FUN_EAGER_LEMMAS_BATCH)
         restart = false;
       slv->stats.beta_reduction_conflicts++;
       add_lemma (btor, fun, app, 0);
@@ -2227,6 +2543,21 @@ push_unreachable_applies (Btor *btor, BtorNodePtrStack *init_apps)
   btor_hashint_table_delete (cache);
 }
 
+/* Order applies by (simplified) function id and apply id. */
+static int32_t
+compare_apps_by_fun_qsort_asc (const void *p1, const void *p2)
+{
+  int32_t id1, id2;
+  BtorNode *a1, *a2;
+
+  a1  = *(BtorNode **) p1;
+  a2  = *(BtorNode **) p2;
+  id1 = btor_node_real_addr (btor_node_get_simplified (a1->btor, a1->e[0]))->id;
+  id2 = btor_node_real_addr (btor_node_get_simplified (a2->btor, a2->e[0]))->id;
+  if (id1 != id2) return id1 < id2 ? -1 : 1;
+  return a1->id - a2->id;
+}
+
 static void
 check_and_resolve_conflicts (Btor *btor,
                              Btor *clone,
@@ -2242,6 +2573,7 @@ check_and_resolve_conflicts (Btor *btor,
   double start, start_cleanup;
   bool found_conflicts;
   int32_t i;
+  uint32_t opt_eager_lemmas;
   BtorMemMgr *mm;
   BtorFunSolver *slv;
   BtorNode *app, *cur;
@@ -2252,11 +2584,12 @@ check_and_resolve_conflicts (Btor *btor,
   BtorPtrHashTableIterator pit;
   BtorIntHashTableIterator iit;
 
-  start           = btor_util_time_stamp ();
-  found_conflicts = false;
-  mm              = btor->mm;
-  slv             = BTOR_FUN_SOLVER (btor);
-  cleanup_table   = btor_hashptr_table_new (mm,
+  start            = btor_util_time_stamp ();
+  found_conflicts  = false;
+  mm               = btor->mm;
+  slv              = BTOR_FUN_SOLVER (btor);
+  opt_eager_lemmas = btor_opt_get (btor, BTOR_OPT_FUN_EAGER_LEMMAS);
+  cleanup_table    = btor_hashptr_table_new (mm,
                                           (BtorHashPtr) btor_node_hash_by_id,
                                           (BtorCmpPtr) btor_node_compare_by_id);
 
@@ -2309,6 +2642,19 @@ check_and_resolve_conflicts (Btor *btor,
     push_unreachable_applies (btor, init_apps);
   }
 
+  /* In batch mode, all applies are checked in one pass. Applies of the same
+   * function are processed consecutively, and the hash values of argument
+   * assignments are computed only once per refinement iteration. */
+  if (opt_eager_lemmas == BTOR_FUN_EAGER_LEMMAS_BATCH)
+  {
+    assert (!slv->args_hash_cache);
+    slv->args_hash_cache = btor_hashint_map_new (mm);
+    qsort (init_apps->start,
+           BTOR_COUNT_STACK (*init_apps),
+           sizeof (BtorNode *),
+           compare_apps_by_fun_qsort_asc);
+  }
+
   for (i = BTOR_COUNT_STACK (*init_apps) - 1; i >= 0; i--)
   {
     app = BTOR_PEEK_STACK (*init_apps, i);
@@ -2382,6 +2728,11 @@ check_and_resolve_conflicts (Btor *btor,
     }
   }
   slv->time.prop_cleanup += btor_util_time_stamp () - start_cleanup;
+  if (slv->args_hash_cache)
+  {
+    btor_hashint_map_delete (slv->args_hash_cache);
+    slv->args_hash_cache = 0;
+  }
   btor_hashptr_table_delete (cleanup_table);
   BTOR_RELEASE_STACK (prop_stack);
   BTOR_RELEASE_STACK (top_applies);
@@ -2403,6 +2754,8 @@ reset_lemma_cache (BtorFunSolver *slv)
   slv->lemmas = btor_hashptr_table_new (btor->mm,
                                         (BtorHashPtr) btor_node_hash_by_id,
                                         (BtorCmpPtr) btor_node_compare_by_id);
+  delete_lemma_db (slv);
+  slv->lemma_db = btor_hashint_map_new (btor->mm);
 }
 
 static BtorSolverResult
@@ -2507,7 +2860,9 @@ sat_fun_solver (BtorFunSolver *slv)
       goto UNKNOWN;
     }
 
+    btor_profile_begin (btor, "synthesize");
     btor_process_unsynthesized_constraints (btor);
+    btor_profile_end (btor);
     if (btor->found_constraint_false)
     {
     UNSAT:
@@ -2518,6 +2873,9 @@ sat_fun_solver (BtorFunSolver *slv)
     assert (btor_dbg_check_all_hash_tables_proxy_free (btor));
     assert (btor_dbg_check_all_hash_tables_simp_free (btor));
 
+    /* bit-blasting may have exhausted the budget */
+    if (btor_terminate (btor)) goto UNKNOWN;
+
     /* make SAT call on bv skeleton */
     btor_add_again_assumptions (btor);
     result = timed_sat_sat (btor, slv->sat_limit);
@@ -2527,6 +2885,7 @@ sat_fun_solver (BtorFunSolver *slv)
     else if (result == BTOR_RESULT_UNKNOWN)
     {
       assert (slv->sat_limit > -1 || btor->cbs.term.done
+              || btor_budget_exhausted (btor)
               || btor_opt_get (btor, BTOR_OPT_PRINT_DIMACS));
       goto DONE;
     }
@@ -2535,8 +2894,10 @@ sat_fun_solver (BtorFunSolver *slv)
 
     if (btor->ufs->count == 0 && btor->lambdas->count == 0) break;
 
+    btor_profile_begin (btor, "refine");
     check_and_resolve_conflicts (
         btor, clone, clone_root, exp_map, &init_apps, init_apps_cache);
+    btor_profile_end (btor);
     if (BTOR_EMPTY_STACK (slv->cur_lemmas)) break;
     slv->stats.refinement_iterations++;
 
@@ -2664,6 +3025,30 @@ print_stats_fun_solver (BtorFunSolver *slv)
                   slv->stats.lemmas_size.start[i],
                   i);
       }
+      BTOR_MSG (btor->msg, 1, "lemma database statistics:");
+      BTOR_MSG (btor->msg,
+                1,
+                "%4d lemmas in database (%.1f KB)",
+                slv->lemma_db_count,
+                slv->lemma_db_bytes / (double) 1024);
+      BTOR_MSG (btor->msg,
+                1,
+                "  %4d duplicate lemmas skipped",
+                slv->stats.lemmas_duplicate);
+      BTOR_MSG (btor->msg,
+                1,
+                "  %4d subsumed lemmas skipped",
+                slv->stats.lemmas_subsumed);
+      BTOR_MSG (btor->msg,
+                1,
+                "  %4d database lemmas subsumed by new lemmas",
+                slv->stats.lemmas_subsuming);
+      if (btor_opt_get (btor, BTOR_OPT_FUN_EAGER_LEMMAS)
+          == BTOR_FUN_EAGER_LEMMAS_BATCH)
+        BTOR_MSG (btor->msg,
+                  1,
+                  "%4d refinement iterations with full lemma batch",
+                  slv->stats.lemma_batches_full);
     }
   }
 
@@ -2817,6 +3202,7 @@ btor_new_fun_solver (Btor *btor)
                                         (BtorHashPtr) btor_node_hash_by_id,
                                         (BtorCmpPtr) btor_node_compare_by_id);
   BTOR_INIT_STACK (btor->mm, slv->cur_lemmas);
+  slv->lemma_db = btor_hashint_map_new (btor->mm);
 
   BTOR_INIT_STACK (btor->mm, slv->stats.lemmas_size);
 
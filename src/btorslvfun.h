@@ -11,10 +11,25 @@
 
 #include "btornode.h"
 #include "btorslv.h"
+#include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 
 #define BTOR_FUN_SOLVER(btor) ((BtorFunSolver *) (btor)->slv)
 
+/* Compact representation of a lemma in the lemma database. Premises and
+ * conclusion are encoded as 64-bit keys over node ids (premises are sorted),
+ * which allows to detect duplicate and subsumed lemmas without constructing
+ * the lemma expression. */
+struct BtorFunLemma
+{
+  struct BtorFunLemma *next; /* next lemma with the same conclusion apply */
+  uint64_t conclusion;       /* encoded conclusion */
+  uint32_t num_prems;        /* number of premises */
+  uint64_t prems[];          /* sorted encoded premises */
+};
+
+typedef struct BtorFunLemma BtorFunLemma;
+
 struct BtorFunSolver
 {
   BTOR_SOLVER_STRUCT;
@@ -22,6 +37,15 @@ struct BtorFunSolver
   BtorPtrHashTable *lemmas;
   BtorNodePtrStack cur_lemmas;
 
+  /* lemma database, maps id of conclusion apply to list of BtorFunLemma */
+  BtorIntHashTable *lemma_db;
+  size_t lemma_db_bytes;   /* memory allocated for BtorFunLemma records */
+  uint32_t lemma_db_count; /* number of lemmas in lemma database */
+
+  /* maps args id to hash of its assignment, only valid during consistency
+   * checking in BTOR_FUN_EAGER_LEMMAS_BATCH mode */
+  BtorIntHashTable *args_hash_cache;
+
   BtorPtrHashTable *score; /* dcr score */
 
   // TODO (ma): make options for these
@@ -41,6 +65,11 @@ struct BtorFunSolver
     BtorUIntStack lemmas_size;      /* distribution of n-size lemmas */
     uint_least64_t lemmas_size_sum; /* sum of the size of all added lemmas */
 
+    uint32_t lemmas_duplicate;   /* lemmas already in lemma database */
+    uint32_t lemmas_subsumed;    /* lemmas subsumed by database lemma */
+    uint32_t lemmas_subsuming;   /* database lemmas subsumed by new lemma */
+    uint32_t lemma_batches_full; /* refinements that hit the batch limit */
+
     uint32_t dp_failed_vars; /* number of vars in FA (dual prop) of last
                                 sat call (final bv skeleton) */
     uint32_t dp_assumed_vars;
@@ -137,6 +137,8 @@ move (Btor *btor, uint32_t nmoves)
   slv = BTOR_PROP_SOLVER (btor);
   assert (slv);
 
+  BTOR_PERF_BEGIN (btor, BTOR_PERF_PROP_MOVE);
+
   root = select_constraint (btor, nmoves);
 
   do
@@ -183,6 +185,7 @@ move (Btor *btor, uint32_t nmoves)
   slv->stats.moves += 1;
   btor_bv_free (btor->mm, assignment);
 
+  BTOR_PERF_END (btor, BTOR_PERF_PROP_MOVE);
   return true;
 }
 
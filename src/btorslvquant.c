@@ -13,6 +13,7 @@
 #include "btorbv.h"
 #include "btorclone.h"
 #include "btorcore.h"
+#include "btorevaltape.h"
 #include "btorexp.h"
 #include "btormodel.h"
 #include "btorprintmodel.h"
@@ -38,6 +39,7 @@ struct BtorQuantStats
   {
     uint32_t refinements;
     uint32_t failed_refinements;
+    uint32_t imported_refinements;
 
     /* overall synthesize statistics */
     uint32_t synthesize_const;
@@ -64,6 +66,38 @@ struct BtorQuantStats
 
 typedef struct BtorQuantStats BtorQuantStats;
 
+#ifdef BTOR_HAVE_PTHREADS
+/* Counterexample shared between ground solver instances of the original
+ * formula, 'origin' is the instance that found it. */
+struct BtorQuantSharedCE
+{
+  struct BtorGroundSolvers *origin;
+  BtorBitVectorTuple *ce;
+  BtorBitVectorTuple *evar_tup;
+};
+
+typedef struct BtorQuantSharedCE BtorQuantSharedCE;
+
+BTOR_DECLARE_STACK (BtorQuantSharedCE, BtorQuantSharedCE);
+
+/* State shared between ground solver instances that run in parallel. All
+ * accesses are synchronized via 'mutex'. Counterexamples are appended to
+ * 'ces' (allocated with 'mm') and never removed while the instances run, each
+ * instance keeps track of the counterexamples it already imported. */
+struct BtorQuantShared
+{
+  pthread_mutex_t mutex;
+  bool found_result;
+  struct BtorGroundSolvers *winner;
+  BtorMemMgr *mm;
+  BtorQuantSharedCEStack ces;
+};
+
+typedef struct BtorQuantShared BtorQuantShared;
+#endif
+
+typedef struct RefineTemplate RefineTemplate;
+
 struct BtorGroundSolvers
 {
   Btor *forall; /* solver for checking the model */
@@ -81,6 +115,8 @@ struct BtorGroundSolvers
   BtorPtrHashTable *forall_ces;         /* counter examples */
   BtorBitVectorTuple *forall_last_ce;
   BtorNodeMap *forall_skolem; /* skolem functions for evars */
+  RefineTemplate *refine_tmpl;   /* forall formula compiled for refinements */
+  BtorPtrHashTable *refinements; /* refinements asserted in exists solver */
 
   Btor *exists;              /* solver for computing the model */
   BtorNodeMap *exists_evars; /* skolem constants (map to existential
@@ -93,8 +129,9 @@ struct BtorGroundSolvers
   BtorQuantStats statistics;
 
 #ifdef BTOR_HAVE_PTHREADS
-  bool *found_result;
-  pthread_mutex_t *found_result_mutex;
+  BtorQuantShared *shared;
+  bool share_ces;          /* share counterexamples with other instances */
+  uint32_t shared_ces_pos; /* next shared counterexample to import */
 #endif
 };
 
@@ -106,6 +143,8 @@ struct BtorQuantSolver
 
   BtorGroundSolvers *gslv;  /* two ground solver instances */
   BtorGroundSolvers *dgslv; /* two ground solver instances for dual */
+  BtorGroundSolvers **workers; /* additional instances for original formula */
+  uint32_t nworkers;
 };
 
 typedef struct BtorQuantSolver BtorQuantSolver;
@@ -639,6 +678,8 @@ setup_solvers (BtorQuantSolver *slv,
   /* configure options */
   btor_opt_set (res->forall, BTOR_OPT_MODEL_GEN, 1);
   btor_opt_set (res->forall, BTOR_OPT_INCREMENTAL, 1);
+  /* profiled as part of the SAT call of 'btor' */
+  btor_opt_set (res->forall, BTOR_OPT_PROFILE, 0);
 
   if (setup_dual)
   {
@@ -732,6 +773,10 @@ setup_solvers (BtorQuantSolver *slv,
   res->exists->slv  = btor_new_fun_solver (res->exists);
   res->exists_evars = btor_nodemap_new (res->exists);
   res->exists_ufs   = btor_nodemap_new (res->exists);
+  res->refinements =
+      btor_hashptr_table_new (res->exists->mm,
+                              (BtorHashPtr) btor_node_hash_by_id,
+                              (BtorCmpPtr) btor_node_compare_by_id);
 
   /* map evars of exists solver to evars of forall solver */
   btor_iter_hashptr_init (&it, res->forall->exists_vars);
@@ -786,6 +831,9 @@ setup_solvers (BtorQuantSolver *slv,
   return res;
 }
 
+static void delete_refine_template (BtorGroundSolvers *gslv,
+                                    RefineTemplate *tmpl);
+
 static void
 delete_ground_solvers (BtorQuantSolver *slv, BtorGroundSolvers *gslv)
 {
@@ -816,123 +864,329 @@ delete_ground_solvers (BtorQuantSolver *slv, BtorGroundSolvers *gslv)
   btor_hashptr_table_delete (gslv->forall_ces);
   BTOR_RELEASE_STACK (gslv->forall_consts);
 
+  if (gslv->refine_tmpl) delete_refine_template (gslv, gslv->refine_tmpl);
+  btor_iter_hashptr_init (&it, gslv->refinements);
+  while (btor_iter_hashptr_has_next (&it))
+    btor_node_release (gslv->exists, btor_iter_hashptr_next (&it));
+  btor_hashptr_table_delete (gslv->refinements);
+
   btor_node_release (gslv->forall, gslv->forall_formula);
   btor_delete (gslv->forall);
   btor_delete (gslv->exists);
   BTOR_DELETE (slv->btor->mm, gslv);
 }
 
+/*------------------------------------------------------------------------*/
+
+/* The forall formula is compiled into a template for building refinements,
+ * which stores the cone of the formula in post-order. Sub-terms that do not
+ * depend on universal variables are instantiated in the exists solver once
+ * when the template is compiled. Instantiating the template for a
+ * counterexample only rebuilds the sub-terms that depend on universal
+ * variables in a linear pass over the template. */
+
+enum RefineInstrKind
+{
+  REFINE_INSTR_GROUND, /* instantiated at compile time */
+  REFINE_INSTR_UVAR,   /* universal var, value at position 'pos' of ce */
+  REFINE_INSTR_SKOLEM, /* skolem function applied to universal vars */
+  REFINE_INSTR_PARAM,  /* parameter (not quantified), fresh per instance */
+  REFINE_INSTR_QUANT,  /* quantifier, instantiated with its body */
+  REFINE_INSTR_SLICE,
+  REFINE_INSTR_EXP, /* any other node */
+};
+
+typedef enum RefineInstrKind RefineInstrKind;
+
+struct RefineInstr
+{
+  RefineInstrKind kind;
+  BtorNodeKind node_kind;
+  uint32_t arity;
+  uint32_t e[3];  /* index of child instruction << 1 | inverted */
+  uint32_t pos;   /* uvar: position in ce, skolem: start in 'argpos' */
+  uint32_t upper; /* slice: upper, skolem: #arguments, param: width */
+  uint32_t lower; /* slice: lower */
+  BtorNode *exp;  /* ground: instantiated node, skolem: UF */
+};
+
+typedef struct RefineInstr RefineInstr;
+
+BTOR_DECLARE_STACK (RefineInstr, RefineInstr);
+
+struct RefineTemplate
+{
+  BtorNode *root;          /* compiled forall formula */
+  uint32_t root_ref;       /* index of root instruction << 1 | inverted */
+  RefineInstrStack instrs; /* cone of 'root' in post-order */
+  BtorUIntStack nonground; /* instructions to rebuild for each instance */
+  BtorUIntStack argpos;    /* ce positions of skolem function arguments */
+  BtorNodePtrStack results; /* instantiated nodes, indexed by instruction */
+};
+
 static BtorNode *
-build_refinement (Btor *btor, BtorNode *root, BtorNodeMap *map)
+get_refine_child (BtorNode **results, uint32_t ref)
 {
-  assert (btor);
-  assert (root);
-  assert (map);
+  return btor_node_cond_invert ((BtorNode *) (uintptr_t) (ref & 1),
+                                results[ref >> 1]);
+}
 
-  size_t j;
+/* Instantiate instruction 'instr' with counterexample 'ce', where 'results'
+ * holds the instantiated children. Ground sub-terms are instantiated at
+ * compile time with 'ce' = 0. */
+static BtorNode *
+instantiate_refine_instr (Btor *e_solver,
+                          RefineTemplate *tmpl,
+                          BtorNode **results,
+                          RefineInstr *instr,
+                          BtorBitVectorTuple *ce)
+{
+  uint32_t i, pos;
+  BtorNode *e[3], *res, *a;
+  BtorNodePtrStack args;
+  BtorSortId sort;
+
+  for (i = 0; i < instr->arity; i++)
+    e[i] = get_refine_child (results, instr->e[i]);
+
+  switch (instr->kind)
+  {
+    case REFINE_INSTR_UVAR:
+      assert (ce);
+      res = btor_exp_bv_const (e_solver, ce->bv[instr->pos]);
+      break;
+
+    case REFINE_INSTR_SKOLEM:
+      assert (ce);
+      BTOR_INIT_STACK (e_solver->mm, args);
+      for (i = 0; i < instr->upper; i++)
+      {
+        pos = BTOR_PEEK_STACK (tmpl->argpos, instr->pos + i);
+        BTOR_PUSH_STACK (args, btor_exp_bv_const (e_solver, ce->bv[pos]));
+      }
+      a   = btor_exp_args (e_solver, args.start, BTOR_COUNT_STACK (args));
+      res = btor_exp_apply (e_solver, instr->exp, a);
+      btor_node_release (e_solver, a);
+      while (!BTOR_EMPTY_STACK (args))
+        btor_node_release (e_solver, BTOR_POP_STACK (args));
+      BTOR_RELEASE_STACK (args);
+      break;
+
+    case REFINE_INSTR_PARAM:
+      sort = btor_sort_bv (e_solver, instr->upper);
+      res  = btor_exp_param (e_solver, sort, 0);
+      btor_sort_release (e_solver, sort);
+      break;
+
+    case REFINE_INSTR_QUANT:
+      assert (!btor_node_is_param (e[1]));
+      res = btor_node_copy (e_solver, e[1]);
+      break;
+
+    case REFINE_INSTR_SLICE:
+      res = btor_exp_bv_slice (e_solver, e[0], instr->upper, instr->lower);
+      break;
+
+    default:
+      assert (instr->kind == REFINE_INSTR_EXP);
+      res = btor_exp_create (e_solver, instr->node_kind, e, instr->arity);
+  }
+  return res;
+}
+
+/* Compile forall formula of 'gslv' into a refinement template. */
+static RefineTemplate *
+new_refine_template (BtorGroundSolvers *gslv)
+{
   int32_t i;
+  uint32_t j, pos, idx, nground;
+  bool ground;
+  Btor *f_solver, *e_solver;
   BtorMemMgr *mm;
-  BtorNode *cur, *real_cur, *result, **e;
-  BtorNodePtrStack visit, args;
-  BtorIntHashTable *mark;
+  BtorNode *cur, *real_cur, *var_es, *a, *arg;
+  BtorNodePtrStack visit;
+  BtorIntHashTable *mark, *uvar_pos, *ufs;
   BtorHashTableData *d;
-  BtorSortId sort;
+  BtorNodeMapIterator it;
+  BtorArgsIterator ait;
+  RefineInstr instr;
+  RefineTemplate *tmpl;
 
-  mm   = btor->mm;
+  f_solver = gslv->forall;
+  e_solver = gslv->exists;
+  mm       = f_solver->mm;
+
+  BTOR_CNEW (mm, tmpl);
+  tmpl->root = btor_node_copy (f_solver, gslv->forall_formula);
+  BTOR_INIT_STACK (mm, tmpl->instrs);
+  BTOR_INIT_STACK (mm, tmpl->nonground);
+  BTOR_INIT_STACK (mm, tmpl->argpos);
+  BTOR_INIT_STACK (mm, tmpl->results);
+
+  /* positions of universal vars in counterexamples */
+  pos      = 0;
+  uvar_pos = btor_hashint_map_new (mm);
+  btor_iter_nodemap_init (&it, gslv->forall_uvars);
+  while (btor_iter_nodemap_has_next (&it))
+  {
+    cur = btor_iter_nodemap_next (&it);
+    btor_hashint_map_add (uvar_pos, cur->id)->as_int = pos++;
+  }
+
+  /* UFs of forall solver map to UFs of exists solver */
+  ufs = btor_hashint_map_new (mm);
+  btor_iter_nodemap_init (&it, gslv->exists_ufs);
+  while (btor_iter_nodemap_has_next (&it))
+  {
+    cur    = it.it.bucket->data.as_ptr;
+    var_es = btor_iter_nodemap_next (&it);
+    btor_hashint_map_add (ufs, cur->id)->as_ptr = var_es;
+  }
+
+  /* 'mark' maps node id to index of its instruction + 1 */
   mark = btor_hashint_map_new (mm);
   BTOR_INIT_STACK (mm, visit);
-  BTOR_INIT_STACK (mm, args);
-  BTOR_PUSH_STACK (visit, root);
-
+  BTOR_PUSH_STACK (visit, tmpl->root);
   while (!BTOR_EMPTY_STACK (visit))
   {
     cur      = BTOR_POP_STACK (visit);
     real_cur = btor_node_real_addr (cur);
     assert (!btor_node_is_proxy (real_cur));
 
-    if ((result = btor_nodemap_mapped (map, real_cur)))
+    d = btor_hashint_map_get (mark, real_cur->id);
+    if (d && d->as_int) continue;
+
+    memset (&instr, 0, sizeof (RefineInstr));
+    instr.kind = REFINE_INSTR_GROUND;
+
+    /* universal/existential vars and UFs get substituted */
+    if ((d = btor_hashint_map_get (uvar_pos, real_cur->id)))
     {
-      result = btor_node_copy (btor, result);
-      goto PUSH_RESULT;
+      instr.kind = REFINE_INSTR_UVAR;
+      instr.pos  = d->as_int;
     }
-
-    d = btor_hashint_map_get (mark, real_cur->id);
-    if (!d)
+    else if ((var_es = btor_nodemap_mapped (gslv->forall_evars, real_cur)))
     {
-      (void) btor_hashint_map_add (mark, real_cur->id);
+      a = btor_nodemap_mapped (gslv->forall_evar_deps, real_cur);
+      if (a)
+      {
+        assert (btor_node_is_uf (var_es));
+        instr.kind  = REFINE_INSTR_SKOLEM;
+        instr.exp   = var_es;
+        instr.pos   = BTOR_COUNT_STACK (tmpl->argpos);
+        instr.upper = btor_node_args_get_arity (f_solver, a);
+        btor_iter_args_init (&ait, a);
+        while (btor_iter_args_has_next (&ait))
+        {
+          arg = btor_iter_args_next (&ait);
+          assert (btor_node_param_is_forall_var (arg));
+          d = btor_hashint_map_get (uvar_pos, arg->id);
+          assert (d);
+          BTOR_PUSH_STACK (tmpl->argpos, d->as_int);
+        }
+      }
+      else
+        instr.exp = btor_node_copy (e_solver, var_es);
+    }
+    else if ((d = btor_hashint_map_get (ufs, real_cur->id)))
+    {
+      instr.exp = btor_node_copy (e_solver, d->as_ptr);
+    }
+    else if (!btor_hashint_map_get (mark, real_cur->id))
+    {
+      btor_hashint_map_add (mark, real_cur->id);
       BTOR_PUSH_STACK (visit, cur);
       for (i = real_cur->arity - 1; i >= 0; i--)
         BTOR_PUSH_STACK (visit, real_cur->e[i]);
+      continue;
     }
-    else if (!d->as_ptr)
+    else
     {
-      assert (!btor_node_is_param (real_cur)
-              || !btor_node_param_is_exists_var (real_cur)
-              || !btor_node_param_is_forall_var (real_cur));
       assert (!btor_node_is_bv_var (real_cur));
       assert (!btor_node_is_uf (real_cur));
 
-      args.top -= real_cur->arity;
-      e = args.top;
+      ground = true;
+      for (i = 0; i < real_cur->arity; i++)
+      {
+        d = btor_hashint_map_get (mark,
+                                  btor_node_real_addr (real_cur->e[i])->id);
+        idx        = d->as_int - 1;
+        instr.e[i] = idx << 1 | btor_node_is_inverted (real_cur->e[i]);
+        /* only the body of a quantifier is instantiated */
+        if ((i == 1 || !btor_node_is_quantifier (real_cur))
+            && BTOR_PEEK_STACK (tmpl->instrs, idx).kind != REFINE_INSTR_GROUND)
+          ground = false;
+      }
+      instr.arity     = real_cur->arity;
+      instr.node_kind = real_cur->kind;
 
       if (btor_node_is_bv_const (real_cur))
       {
-        result = btor_exp_bv_const (btor, btor_node_bv_const_get_bits (real_cur));
+        instr.exp = btor_exp_bv_const (e_solver,
+                                       btor_node_bv_const_get_bits (real_cur));
       }
       else if (btor_node_is_param (real_cur))
       {
         assert (!btor_node_param_is_exists_var (real_cur));
         assert (!btor_node_param_is_forall_var (real_cur));
-        sort = btor_sort_bv (
-            btor, btor_node_bv_get_width (real_cur->btor, real_cur));
-        result = btor_exp_param (btor, sort, 0);
-        btor_sort_release (btor, sort);
-      }
-      else if (btor_node_is_bv_slice (real_cur))
-      {
-        result = btor_exp_bv_slice (btor,
-                                    e[0],
-                                    btor_node_bv_slice_get_upper (real_cur),
-                                    btor_node_bv_slice_get_lower (real_cur));
-      }
-      /* universal/existential vars get substituted */
-      else if (btor_node_is_quantifier (real_cur))
-      {
-        assert (!btor_node_is_param (e[0]));
-        result = btor_node_copy (btor, e[1]);
+        instr.kind  = REFINE_INSTR_PARAM;
+        instr.upper = btor_node_bv_get_width (f_solver, real_cur);
       }
       else
-        result = btor_exp_create (btor, real_cur->kind, e, real_cur->arity);
+      {
+        if (btor_node_is_bv_slice (real_cur))
+        {
+          instr.kind  = REFINE_INSTR_SLICE;
+          instr.upper = btor_node_bv_slice_get_upper (real_cur);
+          instr.lower = btor_node_bv_slice_get_lower (real_cur);
+        }
+        else if (btor_node_is_quantifier (real_cur))
+          instr.kind = REFINE_INSTR_QUANT;
+        else
+          instr.kind = REFINE_INSTR_EXP;
 
-      for (i = 0; i < real_cur->arity; i++) btor_node_release (btor, e[i]);
+        /* sub-terms that do not depend on universal vars are instantiated
+         * once */
+        if (ground)
+        {
+          instr.exp  = instantiate_refine_instr (
+              e_solver, tmpl, tmpl->results.start, &instr, 0);
+          instr.kind = REFINE_INSTR_GROUND;
+        }
+      }
+    }
 
-      d->as_ptr = btor_node_copy (btor, result);
+    BTOR_PUSH_STACK (tmpl->instrs, instr);
+    BTOR_PUSH_STACK (tmpl->results,
+                     instr.kind == REFINE_INSTR_GROUND ? instr.exp : 0);
+    d = btor_hashint_map_get (mark, real_cur->id);
+    if (!d) d = btor_hashint_map_add (mark, real_cur->id);
+    d->as_int = BTOR_COUNT_STACK (tmpl->instrs);
+  }
+  d   = btor_hashint_map_get (mark, btor_node_real_addr (tmpl->root)->id);
+  idx = d->as_int - 1;
+  tmpl->root_ref = idx << 1 | btor_node_is_inverted (tmpl->root);
 
-    PUSH_RESULT:
-      BTOR_PUSH_STACK (args, btor_node_cond_invert (cur, result));
-    }
+  /* results of ground instructions are kept for all instances */
+  nground = 0;
+  for (j = 0; j < BTOR_COUNT_STACK (tmpl->instrs); j++)
+  {
+    if (BTOR_PEEK_STACK (tmpl->instrs, j).kind == REFINE_INSTR_GROUND)
+      nground++;
     else
-    {
-      assert (d->as_ptr);
-      result = btor_node_copy (btor, d->as_ptr);
-      goto PUSH_RESULT;
-    }
+      BTOR_PUSH_STACK (tmpl->nonground, j);
   }
-  assert (BTOR_COUNT_STACK (args) == 1);
-  result = BTOR_POP_STACK (args);
+  BTOR_MSG (f_solver->msg,
+            1,
+            "refinement template: %u instructions, %u ground",
+            BTOR_COUNT_STACK (tmpl->instrs),
+            nground);
 
   BTOR_RELEASE_STACK (visit);
-  BTOR_RELEASE_STACK (args);
-
-  for (j = 0; j < mark->size; j++)
-  {
-    if (!mark->keys[j]) continue;
-    assert (mark->data[j].as_ptr);
-    btor_node_release (btor, mark->data[j].as_ptr);
-  }
   btor_hashint_map_delete (mark);
-
-  return result;
+  btor_hashint_map_delete (uvar_pos);
+  btor_hashint_map_delete (ufs);
+  return tmpl;
 }
 
 static BtorNode *
@@ -962,6 +1216,89 @@ instantiate_args (Btor *btor, BtorNode *args, BtorNodeMap *map)
   return res;
 }
 
+static void
+delete_refine_template (BtorGroundSolvers *gslv, RefineTemplate *tmpl)
+{
+  uint32_t i;
+  BtorMemMgr *mm;
+
+  mm = gslv->forall->mm;
+  for (i = 0; i < BTOR_COUNT_STACK (tmpl->instrs); i++)
+  {
+    if (BTOR_PEEK_STACK (tmpl->instrs, i).kind == REFINE_INSTR_GROUND)
+      btor_node_release (gslv->exists, BTOR_PEEK_STACK (tmpl->results, i));
+  }
+  btor_node_release (gslv->forall, tmpl->root);
+  BTOR_RELEASE_STACK (tmpl->instrs);
+  BTOR_RELEASE_STACK (tmpl->nonground);
+  BTOR_RELEASE_STACK (tmpl->argpos);
+  BTOR_RELEASE_STACK (tmpl->results);
+  BTOR_DELETE (mm, tmpl);
+}
+
+/* Instantiate the forall formula with counterexample 'ce' (values of the
+ * universal variables) in the exists solver. */
+static BtorNode *
+instantiate_refinement (BtorGroundSolvers *gslv, BtorBitVectorTuple *ce)
+{
+  assert (gslv->forall_uvars->table->count == ce->arity);
+
+  uint32_t i, idx;
+  Btor *e_solver;
+  BtorNode *res, **results;
+  RefineTemplate *tmpl;
+
+  e_solver = gslv->exists;
+
+  /* forall formula may change, e.g., by update_formula */
+  tmpl = gslv->refine_tmpl;
+  if (tmpl && tmpl->root != gslv->forall_formula)
+  {
+    delete_refine_template (gslv, tmpl);
+    tmpl = 0;
+  }
+  if (!tmpl)
+  {
+    tmpl              = new_refine_template (gslv);
+    gslv->refine_tmpl = tmpl;
+  }
+
+  results = tmpl->results.start;
+  for (i = 0; i < BTOR_COUNT_STACK (tmpl->nonground); i++)
+  {
+    idx          = BTOR_PEEK_STACK (tmpl->nonground, i);
+    results[idx] = instantiate_refine_instr (
+        e_solver, tmpl, results, tmpl->instrs.start + idx, ce);
+  }
+  res = btor_node_copy (e_solver, get_refine_child (results, tmpl->root_ref));
+  for (i = 0; i < BTOR_COUNT_STACK (tmpl->nonground); i++)
+  {
+    idx = BTOR_PEEK_STACK (tmpl->nonground, i);
+    btor_node_release (e_solver, results[idx]);
+    results[idx] = 0;
+  }
+  return res;
+}
+
+/* Assert refinement 'res' in the exists solver. Returns false if 'res' was
+ * already asserted, i.e., the refinement does not exclude any new
+ * candidate models. */
+static bool
+assert_refinement (BtorGroundSolvers *gslv, BtorNode *res)
+{
+  if (btor_hashptr_table_get (gslv->refinements, res)) return false;
+  btor_hashptr_table_add (gslv->refinements,
+                          btor_node_copy (gslv->exists, res));
+  btor_assert_exp (gslv->exists, res);
+  return true;
+}
+
+#ifdef BTOR_HAVE_PTHREADS
+static void share_ce (BtorGroundSolvers *gslv,
+                      BtorBitVectorTuple *ce,
+                      BtorBitVectorTuple *evar_tup);
+#endif
+
 static void
 refine_exists_solver (BtorGroundSolvers *gslv, BtorNodeMap *evar_map)
 {
@@ -969,33 +1306,26 @@ refine_exists_solver (BtorGroundSolvers *gslv, BtorNodeMap *evar_map)
 
   uint32_t i;
   Btor *f_solver, *e_solver;
-  BtorNodeMap *map;
   BtorNodeMapIterator it;
-  BtorNode *var_es, *var_fs, *c, *res, *uvar, *evar, *a;
+  BtorNode *var_fs, *res, *evar;
   const BtorBitVector *bv;
   BtorBitVectorTuple *ce, *evar_tup;
 
   f_solver = gslv->forall;
   e_solver = gslv->exists;
 
-  map = btor_nodemap_new (f_solver);
-
   /* generate counter example for universal vars */
   assert (f_solver->last_sat_result == BTOR_RESULT_SAT);
   f_solver->slv->api.generate_model (f_solver->slv, false, false);
 
-  /* instantiate universal vars with counter example */
   i  = 0;
   ce = btor_bv_new_tuple (f_solver->mm, gslv->forall_uvars->table->count);
   btor_iter_nodemap_init (&it, gslv->forall_uvars);
   while (btor_iter_nodemap_has_next (&it))
   {
     var_fs = it.it.bucket->data.as_ptr;
-    uvar   = btor_iter_nodemap_next (&it);
-    bv     = btor_model_get_bv (f_solver, btor_simplify_exp (f_solver, var_fs));
-    c      = btor_exp_bv_const (e_solver, (BtorBitVector *) bv);
-    btor_nodemap_map (map, uvar, c);
-    btor_node_release (e_solver, c);
+    (void) btor_iter_nodemap_next (&it);
+    bv = btor_model_get_bv (f_solver, btor_simplify_exp (f_solver, var_fs));
     btor_bv_add_to_tuple (f_solver->mm, ce, bv, i++);
   }
 
@@ -1016,39 +1346,8 @@ refine_exists_solver (BtorGroundSolvers *gslv, BtorNodeMap *evar_map)
     }
   }
 
-  /* map existential variables to skolem constants */
-  btor_iter_nodemap_init (&it, gslv->forall_evars);
-  while (btor_iter_nodemap_has_next (&it))
-  {
-    var_es = it.it.bucket->data.as_ptr;
-    var_fs = btor_iter_nodemap_next (&it);
-
-    a = btor_nodemap_mapped (gslv->forall_evar_deps, var_fs);
-    if (a)
-    {
-      assert (btor_node_is_uf (var_es));
-      a      = instantiate_args (e_solver, a, map);
-      var_es = btor_exp_apply (e_solver, var_es, a);
-      btor_nodemap_map (map, var_fs, var_es);
-      btor_node_release (e_solver, a);
-      btor_node_release (e_solver, var_es);
-    }
-    else
-      btor_nodemap_map (map, var_fs, var_es);
-  }
-
-  /* map UFs */
-  btor_iter_nodemap_init (&it, gslv->exists_ufs);
-  while (btor_iter_nodemap_has_next (&it))
-  {
-    var_fs = it.it.bucket->data.as_ptr;
-    var_es = btor_iter_nodemap_next (&it);
-    btor_nodemap_map (map, var_fs, var_es);
-  }
-
-  res = build_refinement (e_solver, gslv->forall_formula, map);
-
-  btor_nodemap_delete (map);
+  /* instantiate universal vars with counter example */
+  res = instantiate_refinement (gslv, ce);
 
   assert (res != e_solver->true_exp);
   BTOR_ABORT (res == e_solver->true_exp,
@@ -1059,8 +1358,12 @@ refine_exists_solver (BtorGroundSolvers *gslv, BtorNodeMap *evar_map)
   assert (!btor_hashptr_table_get (gslv->forall_ces, ce));
   btor_hashptr_table_add (gslv->forall_ces, ce)->data.as_ptr = evar_tup;
   gslv->forall_last_ce                                       = ce;
+#ifdef BTOR_HAVE_PTHREADS
+  if (gslv->shared) share_ce (gslv, ce, evar_tup);
+#endif
 
-  btor_assert_exp (e_solver, res);
+  if (!assert_refinement (gslv, res))
+    gslv->statistics.stats.failed_refinements++;
   btor_node_release (e_solver, res);
 }
 
@@ -1176,10 +1479,14 @@ delete_quant_solver (BtorQuantSolver *slv)
   assert (slv->btor);
   assert (slv->btor->slv == (BtorSolver *) slv);
 
+  uint32_t i;
   Btor *btor;
   btor = slv->btor;
   delete_ground_solvers (slv, slv->gslv);
   if (slv->dgslv) delete_ground_solvers (slv, slv->dgslv);
+  for (i = 0; i < slv->nworkers; i++)
+    delete_ground_solvers (slv, slv->workers[i]);
+  if (slv->workers) BTOR_DELETEN (btor->mm, slv->workers, slv->nworkers);
   BTOR_DELETE (btor->mm, slv);
   btor->slv = 0;
 }
@@ -1224,156 +1531,19 @@ build_input_output_values (BtorGroundSolvers *gslv,
   assert (BTOR_COUNT_STACK (*value_in) == BTOR_COUNT_STACK (*value_out));
 }
 
-static BtorBitVector *
-eval_exp (Btor *btor,
-          BtorNode *exp,
-          FlatModel *flat_model,
-          BtorBitVectorTuple *ce)
-{
-  assert (btor);
-
-  size_t j;
-  int32_t i;
-  BtorNode *cur, *real_cur;
-  BtorNodePtrStack visit;
-  BtorIntHashTable *cache;
-  BtorHashTableData *d;
-  BtorBitVectorPtrStack arg_stack;
-  BtorMemMgr *mm;
-  BtorBitVector **bv, *result, *inv_result, *a;
-
-  mm    = btor->mm;
-  cache = btor_hashint_map_new (mm);
-
-  BTOR_INIT_STACK (mm, arg_stack);
-  BTOR_INIT_STACK (mm, visit);
-  BTOR_PUSH_STACK (visit, exp);
-  while (!BTOR_EMPTY_STACK (visit))
-  {
-    cur      = BTOR_POP_STACK (visit);
-    real_cur = btor_node_real_addr (cur);
-
-    d = btor_hashint_map_get (cache, real_cur->id);
-    if (!d)
-    {
-      btor_hashint_map_add (cache, real_cur->id);
-      BTOR_PUSH_STACK (visit, cur);
-
-      if (btor_node_is_apply (real_cur)) continue;
-
-      for (i = real_cur->arity - 1; i >= 0; i--)
-        BTOR_PUSH_STACK (visit, real_cur->e[i]);
-    }
-    else if (!d->as_ptr)
-    {
-      assert (!btor_node_is_fun (real_cur));
-      assert (!btor_node_is_apply (real_cur));
-      assert (!btor_node_is_bv_var (real_cur));
-
-      arg_stack.top -= real_cur->arity;
-      bv = arg_stack.top;
-
-      switch (real_cur->kind)
-      {
-        case BTOR_BV_CONST_NODE:
-          result = btor_bv_copy (mm, btor_node_bv_const_get_bits (real_cur));
-          break;
-
-        case BTOR_PARAM_NODE:
-          a      = flat_model_get_value (flat_model, real_cur, ce);
-          result = btor_bv_copy (mm, a);
-          break;
-
-        case BTOR_BV_SLICE_NODE:
-          result = btor_bv_slice (mm,
-                                  bv[0],
-                                  btor_node_bv_slice_get_upper (real_cur),
-                                  btor_node_bv_slice_get_lower (real_cur));
-          break;
-
-        case BTOR_BV_AND_NODE: result = btor_bv_and (mm, bv[0], bv[1]); break;
-
-        case BTOR_BV_EQ_NODE: result = btor_bv_eq (mm, bv[0], bv[1]); break;
-
-        case BTOR_BV_ADD_NODE: result = btor_bv_add (mm, bv[0], bv[1]); break;
-
-        case BTOR_BV_MUL_NODE: result = btor_bv_mul (mm, bv[0], bv[1]); break;
-
-        case BTOR_BV_ULT_NODE: result = btor_bv_ult (mm, bv[0], bv[1]); break;
-
-        case BTOR_BV_SLL_NODE: result = btor_bv_sll (mm, bv[0], bv[1]); break;
-
-        case BTOR_BV_SRL_NODE: result = btor_bv_srl (mm, bv[0], bv[1]); break;
-
-        case BTOR_BV_UDIV_NODE: result = btor_bv_udiv (mm, bv[0], bv[1]); break;
-
-        case BTOR_BV_UREM_NODE: result = btor_bv_urem (mm, bv[0], bv[1]); break;
-
-        case BTOR_BV_CONCAT_NODE:
-          result = btor_bv_concat (mm, bv[0], bv[1]);
-          break;
-
-        case BTOR_EXISTS_NODE:
-        case BTOR_FORALL_NODE: result = btor_bv_copy (mm, bv[1]); break;
-
-        default:
-          assert (real_cur->kind == BTOR_COND_NODE);
-          if (btor_bv_is_true (bv[0]))
-            result = btor_bv_copy (mm, bv[1]);
-          else
-            result = btor_bv_copy (mm, bv[2]);
-      }
-
-      if (!btor_node_is_apply (real_cur))
-      {
-        for (i = 0; i < real_cur->arity; i++) btor_bv_free (mm, bv[i]);
-      }
-
-      d->as_ptr = btor_bv_copy (mm, result);
-
-    EVAL_EXP_PUSH_RESULT:
-      if (btor_node_is_inverted (cur))
-      {
-        inv_result = btor_bv_not (mm, result);
-        btor_bv_free (mm, result);
-        result = inv_result;
-      }
-      BTOR_PUSH_STACK (arg_stack, result);
-    }
-    else
-    {
-      result = btor_bv_copy (mm, d->as_ptr);
-      goto EVAL_EXP_PUSH_RESULT;
-    }
-  }
-
-  assert (BTOR_COUNT_STACK (arg_stack) == 1);
-  result = BTOR_POP_STACK (arg_stack);
-
-  for (j = 0; j < cache->size; j++)
-  {
-    a = cache->data[j].as_ptr;
-    if (!a) continue;
-    btor_bv_free (mm, a);
-  }
-  BTOR_RELEASE_STACK (visit);
-  BTOR_RELEASE_STACK (arg_stack);
-  btor_hashint_map_delete (cache);
-
-  return result;
-}
-
 static void
 update_flat_model (BtorGroundSolvers *gslv,
                    FlatModel *flat_model,
                    BtorNode *evar,
                    BtorNode *result)
 {
-  uint32_t evar_pos;
+  uint32_t i, evar_pos;
   BtorPtrHashTableIterator it;
   BtorBitVectorTuple *ce, *evalues;
-  BtorBitVector *bv;
+  const BtorBitVector *bv;
   BtorPtrHashBucket *b;
+  BtorNode *input;
+  BtorEvalTape *tape;
   Btor *btor;
   BtorMemMgr *mm;
 
@@ -1382,6 +1552,9 @@ update_flat_model (BtorGroundSolvers *gslv,
   evar_pos =
       btor_hashint_map_get (flat_model->evar_index_map, evar->id)->as_int;
 
+  /* compile 'result' once and evaluate it for every counterexample */
+  tape = btor_evaltape_new (btor, &result, 1);
+
   btor_iter_hashptr_init (&it, flat_model->model);
   while (btor_iter_hashptr_has_next (&it))
   {
@@ -1389,9 +1562,18 @@ update_flat_model (BtorGroundSolvers *gslv,
     evalues = b->data.as_ptr;
     ce      = btor_iter_hashptr_next (&it);
     btor_bv_free (mm, evalues->bv[evar_pos]);
-    bv                    = eval_exp (btor, result, flat_model, ce);
-    evalues->bv[evar_pos] = bv;
+    for (i = 0; i < btor_evaltape_get_num_inputs (tape); i++)
+    {
+      input = btor_evaltape_get_input (tape, i);
+      assert (btor_node_is_param (input));
+      bv = flat_model_get_value (flat_model, input, ce);
+      btor_evaltape_set_input (tape, i, bv);
+    }
+    btor_evaltape_run (tape);
+    bv                    = btor_evaltape_get_result (tape, 0);
+    evalues->bv[evar_pos] = btor_bv_copy (mm, bv);
   }
+  btor_evaltape_delete (tape);
 }
 
 static void
@@ -2342,6 +2524,98 @@ DONE:
 }
 
 #ifdef BTOR_HAVE_PTHREADS
+static bool
+get_found_result (BtorQuantShared *shared)
+{
+  bool res;
+  pthread_mutex_lock (&shared->mutex);
+  res = shared->found_result;
+  pthread_mutex_unlock (&shared->mutex);
+  return res;
+}
+
+/* Append counterexample 'ce' of 'gslv' to the shared counterexamples. */
+static void
+share_ce (BtorGroundSolvers *gslv,
+          BtorBitVectorTuple *ce,
+          BtorBitVectorTuple *evar_tup)
+{
+  assert (gslv->shared);
+
+  BtorQuantShared *shared;
+  BtorQuantSharedCE sce;
+
+  if (!gslv->share_ces) return;
+
+  shared = gslv->shared;
+  pthread_mutex_lock (&shared->mutex);
+  sce.origin   = gslv;
+  sce.ce       = btor_bv_copy_tuple (shared->mm, ce);
+  sce.evar_tup = evar_tup ? btor_bv_copy_tuple (shared->mm, evar_tup) : 0;
+  BTOR_PUSH_STACK (shared->ces, sce);
+  pthread_mutex_unlock (&shared->mutex);
+}
+
+/* Refine exists solver of 'gslv' with the counterexamples shared by other
+ * ground solver instances since the last call. */
+static void
+import_shared_ces (BtorGroundSolvers *gslv)
+{
+  assert (gslv->shared);
+
+  uint32_t i;
+  BtorQuantShared *shared;
+  BtorQuantSharedCE *sce;
+  BtorBitVectorTuple *ce, *evar_tup;
+  BtorBitVectorTuplePtrStack ces;
+  BtorNode *res;
+  BtorMemMgr *mm;
+
+  if (!gslv->share_ces) return;
+
+  shared = gslv->shared;
+  mm     = gslv->forall->mm;
+  BTOR_INIT_STACK (mm, ces);
+
+  /* copy new counterexamples, refinements are built outside of the lock */
+  pthread_mutex_lock (&shared->mutex);
+  for (i = gslv->shared_ces_pos; i < BTOR_COUNT_STACK (shared->ces); i++)
+  {
+    sce = shared->ces.start + i;
+    if (sce->origin == gslv) continue;
+    BTOR_PUSH_STACK (ces, btor_bv_copy_tuple (mm, sce->ce));
+    BTOR_PUSH_STACK (
+        ces, sce->evar_tup ? btor_bv_copy_tuple (mm, sce->evar_tup) : 0);
+  }
+  gslv->shared_ces_pos = BTOR_COUNT_STACK (shared->ces);
+  pthread_mutex_unlock (&shared->mutex);
+
+  for (i = 0; i < BTOR_COUNT_STACK (ces); i += 2)
+  {
+    ce       = BTOR_PEEK_STACK (ces, i);
+    evar_tup = BTOR_PEEK_STACK (ces, i + 1);
+
+    res = 0;
+    if (!btor_hashptr_table_get (gslv->forall_ces, ce))
+      res = instantiate_refinement (gslv, ce);
+
+    if (!res || res == gslv->exists->true_exp
+        || btor_hashptr_table_get (gslv->refinements, res))
+    {
+      if (res) btor_node_release (gslv->exists, res);
+      btor_bv_free_tuple (mm, ce);
+      if (evar_tup) btor_bv_free_tuple (mm, evar_tup);
+      continue;
+    }
+
+    btor_hashptr_table_add (gslv->forall_ces, ce)->data.as_ptr = evar_tup;
+    assert_refinement (gslv, res);
+    btor_node_release (gslv->exists, res);
+    gslv->statistics.stats.imported_refinements++;
+  }
+  BTOR_RELEASE_STACK (ces);
+}
+
 static void *
 thread_work (void *state)
 {
@@ -2350,23 +2624,25 @@ thread_work (void *state)
   bool skip_exists = true;
 
   gslv = state;
-  while (res == BTOR_RESULT_UNKNOWN && !*gslv->found_result)
+  while (res == BTOR_RESULT_UNKNOWN && !get_found_result (gslv->shared))
   {
+    if (!skip_exists) import_shared_ces (gslv);
     res         = find_model (gslv, skip_exists);
     skip_exists = false;
     gslv->statistics.stats.refinements++;
   }
-  pthread_mutex_lock (gslv->found_result_mutex);
-  if (!*gslv->found_result)
+  pthread_mutex_lock (&gslv->shared->mutex);
+  if (!gslv->shared->found_result)
   {
     BTOR_MSG (gslv->exists->msg,
               1,
               "found solution in %.2f seconds",
               btor_util_process_time_thread ());
-    *gslv->found_result = true;
+    gslv->shared->found_result = true;
+    gslv->shared->winner       = gslv;
   }
-  assert (*gslv->found_result || res == BTOR_RESULT_UNKNOWN);
-  pthread_mutex_unlock (gslv->found_result_mutex);
+  assert (gslv->shared->found_result || res == BTOR_RESULT_UNKNOWN);
+  pthread_mutex_unlock (&gslv->shared->mutex);
   gslv->result = res;
   return NULL;
 }
@@ -2374,58 +2650,171 @@ thread_work (void *state)
 static int32_t
 thread_terminate (void *state)
 {
-  bool found_result = *((bool *) state);
-  return found_result;
+  return get_found_result ((BtorQuantShared *) state);
+}
+
+/* Diversify the configuration of additional ground solver instance 'gslv'
+ * for the original formula, where 'worker' > 0 is the index of the
+ * instance. */
+static void
+configure_worker (BtorGroundSolvers *gslv, uint32_t worker)
+{
+  assert (worker > 0);
+
+  uint32_t mode, limit, seed;
+  Btor *f_solver;
+
+  f_solver = gslv->forall;
+
+  seed = btor_opt_get (f_solver, BTOR_OPT_SEED) + worker;
+  btor_opt_set (f_solver, BTOR_OPT_SEED, seed);
+  btor_opt_set (gslv->exists, BTOR_OPT_SEED, seed);
+
+  /* cycle through synthesis modes (unless synthesis is disabled) */
+  mode = btor_opt_get (f_solver, BTOR_OPT_QUANT_SYNTH);
+  if (mode != BTOR_QUANT_SYNTH_NONE)
+  {
+    mode = (mode - BTOR_QUANT_SYNTH_EL + worker)
+               % (BTOR_QUANT_SYNTH_MAX - BTOR_QUANT_SYNTH_EL + 1)
+           + BTOR_QUANT_SYNTH_EL;
+    btor_opt_set (f_solver, BTOR_OPT_QUANT_SYNTH, mode);
+  }
+
+  limit = btor_opt_get (f_solver, BTOR_OPT_QUANT_SYNTH_LIMIT);
+  if (limit <= UINT32_MAX >> 2) limit <<= worker % 3;
+  btor_opt_set (f_solver, BTOR_OPT_QUANT_SYNTH_LIMIT, limit);
+
+  if (worker % 2)
+    btor_opt_set (f_solver,
+                  BTOR_OPT_QUANT_SYNTH_QI,
+                  !btor_opt_get (f_solver, BTOR_OPT_QUANT_SYNTH_QI));
+  if ((worker / 2) % 2)
+    btor_opt_set (f_solver,
+                  BTOR_OPT_QUANT_FIXSYNTH,
+                  !btor_opt_get (f_solver, BTOR_OPT_QUANT_FIXSYNTH));
+
+  BTOR_MSG (f_solver->msg,
+            1,
+            "worker %u: synth mode %u, synth limit %u, synth qi %u, "
+            "fix synth %u",
+            worker,
+            btor_opt_get (f_solver, BTOR_OPT_QUANT_SYNTH),
+            limit,
+            btor_opt_get (f_solver, BTOR_OPT_QUANT_SYNTH_QI),
+            btor_opt_get (f_solver, BTOR_OPT_QUANT_FIXSYNTH));
+}
+
+/* Create 'nworkers' - 1 additional ground solver instances for 'root'. */
+static void
+setup_workers (BtorQuantSolver *slv, BtorNode *root, uint32_t nworkers)
+{
+  uint32_t i;
+  char prefix_forall[32], prefix_exists[32];
+
+  if (nworkers <= 1) return;
+
+  slv->nworkers = nworkers - 1;
+  BTOR_CNEWN (slv->btor->mm, slv->workers, slv->nworkers);
+  for (i = 0; i < slv->nworkers; i++)
+  {
+    sprintf (prefix_forall, "forall%u", i + 1);
+    sprintf (prefix_exists, "exists%u", i + 1);
+    slv->workers[i] =
+        setup_solvers (slv, root, false, prefix_forall, prefix_exists);
+    configure_worker (slv->workers[i], i + 1);
+  }
 }
 
 static BtorSolverResult
-run_parallel (BtorGroundSolvers *gslv, BtorGroundSolvers *dgslv)
+run_parallel (BtorQuantSolver *slv)
 {
-  bool thread_found_result;
-  pthread_mutex_t thread_result_mutex = PTHREAD_MUTEX_INITIALIZER;
+  uint32_t i, n;
+  BtorQuantShared shared;
+  BtorQuantSharedCE *sce;
   BtorSolverResult res;
-  pthread_t thread_orig, thread_dual;
+  BtorGroundSolvers **gslvs, *winner;
+  pthread_t *threads;
+  BtorMemMgr *mm;
 
-  thread_found_result   = false;
-  g_measure_thread_time = true;
-  btor_set_term (gslv->forall, thread_terminate, &thread_found_result);
-  btor_set_term (gslv->exists, thread_terminate, &thread_found_result);
-  btor_set_term (dgslv->forall, thread_terminate, &thread_found_result);
-  btor_set_term (dgslv->exists, thread_terminate, &thread_found_result);
+  mm = slv->btor->mm;
 
-  gslv->found_result        = &thread_found_result;
-  gslv->found_result_mutex  = &thread_result_mutex;
-  dgslv->found_result       = &thread_found_result;
-  dgslv->found_result_mutex = &thread_result_mutex;
+  memset (&shared, 0, sizeof (BtorQuantShared));
+  pthread_mutex_init (&shared.mutex, 0);
+  shared.mm = btor_mem_mgr_new ();
+  BTOR_INIT_STACK (shared.mm, shared.ces);
 
-  pthread_create (&thread_orig, 0, thread_work, gslv);
-  pthread_create (&thread_dual, 0, thread_work, dgslv);
-  pthread_join (thread_orig, 0);
-  pthread_join (thread_dual, 0);
+  /* original instance, additional instances, dual instance */
+  n = 1 + slv->nworkers + (slv->dgslv ? 1 : 0);
+  BTOR_NEWN (mm, gslvs, n);
+  BTOR_NEWN (mm, threads, n);
+  gslvs[0] = slv->gslv;
+  for (i = 0; i < slv->nworkers; i++) gslvs[i + 1] = slv->workers[i];
+  if (slv->dgslv) gslvs[n - 1] = slv->dgslv;
 
-  if (gslv->result != BTOR_RESULT_UNKNOWN)
+  g_measure_thread_time = true;
+  for (i = 0; i < n; i++)
   {
-    res = gslv->result;
+    btor_set_term (gslvs[i]->forall, thread_terminate, &shared);
+    btor_set_term (gslvs[i]->exists, thread_terminate, &shared);
+    gslvs[i]->shared    = &shared;
+    gslvs[i]->share_ces = slv->nworkers > 0 && gslvs[i] != slv->dgslv;
   }
-  else
+
+  for (i = 0; i < n; i++)
+    pthread_create (&threads[i], 0, thread_work, gslvs[i]);
+  for (i = 0; i < n; i++) pthread_join (threads[i], 0);
+
+  winner = shared.winner;
+  assert (winner);
+  assert (winner->result != BTOR_RESULT_UNKNOWN);
+
+  if (winner != slv->dgslv)
   {
-    assert (dgslv->result != BTOR_RESULT_UNKNOWN);
-    if (dgslv->result == BTOR_RESULT_SAT)
-    {
-      BTOR_MSG (dgslv->forall->msg,
-                1,
-                "dual solver result: sat, original formula: unsat");
-      res = BTOR_RESULT_UNSAT;
-    }
-    else
+    res = winner->result;
+    /* make the instance that found the result the original instance, which
+     * is used for model printing and statistics */
+    for (i = 0; i < slv->nworkers; i++)
     {
-      assert (dgslv->result == BTOR_RESULT_UNSAT);
-      res = BTOR_RESULT_SAT;
-      BTOR_MSG (dgslv->forall->msg,
-                1,
-                "dual solver result: unsat, original formula: sat");
+      if (slv->workers[i] != winner) continue;
+      BTOR_MSG (slv->btor->msg, 1, "worker %u found result", i + 1);
+      slv->workers[i] = slv->gslv;
+      slv->gslv       = winner;
     }
   }
+  else if (winner->result == BTOR_RESULT_SAT)
+  {
+    BTOR_MSG (winner->forall->msg,
+              1,
+              "dual solver result: sat, original formula: unsat");
+    res = BTOR_RESULT_UNSAT;
+  }
+  else
+  {
+    assert (winner->result == BTOR_RESULT_UNSAT);
+    res = BTOR_RESULT_SAT;
+    BTOR_MSG (winner->forall->msg,
+              1,
+              "dual solver result: unsat, original formula: sat");
+  }
+
+  for (i = 0; i < n; i++)
+  {
+    btor_set_term (gslvs[i]->forall, 0, 0);
+    btor_set_term (gslvs[i]->exists, 0, 0);
+    gslvs[i]->shared = 0;
+  }
+  BTOR_DELETEN (mm, gslvs, n);
+  BTOR_DELETEN (mm, threads, n);
+
+  for (i = 0; i < BTOR_COUNT_STACK (shared.ces); i++)
+  {
+    sce = shared.ces.start + i;
+    btor_bv_free_tuple (shared.mm, sce->ce);
+    if (sce->evar_tup) btor_bv_free_tuple (shared.mm, sce->evar_tup);
+  }
+  BTOR_RELEASE_STACK (shared.ces);
+  btor_mem_mgr_delete (shared.mm);
+  pthread_mutex_destroy (&shared.mutex);
   return res;
 }
 #endif
@@ -2476,6 +2865,9 @@ sat_quant_solver (BtorQuantSolver *slv)
   g = simplify (slv->btor, g);
 
   slv->gslv = setup_solvers (slv, g, false, "forall", "exists");
+#ifdef BTOR_HAVE_PTHREADS
+  setup_workers (slv, g, btor_opt_get (slv->btor, BTOR_OPT_QUANT_N_WORKERS));
+#endif
   btor_node_release (slv->btor, g);
 
 #ifdef BTOR_HAVE_PTHREADS
@@ -2486,11 +2878,11 @@ sat_quant_solver (BtorQuantSolver *slv)
   if (slv->gslv->exists_ufs->table->count > 0) opt_dual_solver = false;
 
   if (opt_dual_solver)
-  {
     slv->dgslv = setup_solvers (
         slv, slv->gslv->forall_formula, true, "dual_forall", "dual_exists");
-    res = run_parallel (slv->gslv, slv->dgslv);
-  }
+
+  if (slv->dgslv || slv->nworkers > 0)
+    res = run_parallel (slv);
   else
 #endif
   {
@@ -2534,6 +2926,8 @@ print_stats_quant_solver (BtorQuantSolver *slv)
   assert (slv->btor->slv == (BtorSolver *) slv);
   assert (slv->gslv);
 
+  uint32_t i;
+
   BTOR_MSG (slv->btor->msg, 1, "");
   BTOR_MSG (slv->btor->msg,
             1,
@@ -2543,6 +2937,19 @@ print_stats_quant_solver (BtorQuantSolver *slv)
             1,
             "cegqi solver failed refinements: %u",
             slv->gslv->statistics.stats.failed_refinements);
+  if (slv->nworkers > 0)
+  {
+    BTOR_MSG (slv->btor->msg,
+              1,
+              "cegqi solver imported refinements: %u",
+              slv->gslv->statistics.stats.imported_refinements);
+    for (i = 0; i < slv->nworkers; i++)
+      BTOR_MSG (slv->btor->msg,
+                1,
+                "cegqi worker solver refinements: %u (%u imported)",
+                slv->workers[i]->statistics.stats.refinements,
+                slv->workers[i]->statistics.stats.imported_refinements);
+  }
   if (slv->gslv->result == BTOR_RESULT_SAT
       || slv->gslv->result == BTOR_RESULT_UNKNOWN)
   {
@@ -0,0 +1,836 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btorsnapshot.h"
+
+#include "btorbv.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btornode.h"
+#include "btorsort.h"
+#include "utils/btorhashptr.h"
+#include "utils/btorstack.h"
+
+#include <string.h>
+
+#ifndef BTOR_WINDOWS_BUILD
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/*------------------------------------------------------------------------*/
+
+/* A snapshot is a sequence of 32-bit words (in host byte order):
+ *
+ *   header    magic, version, byte order mark, #sorts, #nodes, #roots,
+ *             #aliases
+ *   sorts     kind, followed by
+ *               bit-vector: width
+ *               tuple:      #elements, element sort indices
+ *               function:   is_array, domain and codomain sort index
+ *   nodes     kind | arity << 8 | flags, followed by
+ *               constant:   width, bits in 64-bit chunks starting at the LSB
+ *               var/uf/param: sort index
+ *               slice:      child, upper, lower
+ *               otherwise:  children
+ *             and the symbol of the node if flagged
+ *   roots     constraints
+ *   aliases   simplified node, symbol (symbols of simplified inputs)
+ *   checksum  of all preceding words
+ *
+ * Nodes are stored in post-order, sorts in the order of their ids. Nodes and
+ * sorts are referred to by their index in the snapshot, references to nodes
+ * are of the form 'index << 1 | inverted'. Symbols are stored as their length
+ * followed by the characters padded to full words. */
+
+#define BTOR_SNAPSHOT_MAGIC 0x4e535442u /* "BTSN" */
+#define BTOR_SNAPSHOT_VERSION 1
+#define BTOR_SNAPSHOT_BOM 0x01020304u
+#define BTOR_SNAPSHOT_HEADER_SIZE 7
+
+#define BTOR_SNAPSHOT_KIND_MASK 0xffu
+#define BTOR_SNAPSHOT_ARITY_SHIFT 8
+#define BTOR_SNAPSHOT_FLAG_IS_ARRAY (1u << 10)
+#define BTOR_SNAPSHOT_FLAG_SYMBOL (1u << 11)
+
+static uint32_t
+snapshot_checksum (const uint32_t *words, size_t n)
+{
+  size_t i;
+  uint32_t res;
+
+  /* FNV-1a over words */
+  res = 2166136261u;
+  for (i = 0; i < n; i++)
+  {
+    res ^= words[i];
+    res *= 16777619u;
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+write_symbol (BtorUIntStack *buf, const char *symbol)
+{
+  uint32_t len, w;
+  size_t i;
+
+  len = strlen (symbol);
+  BTOR_PUSH_STACK (*buf, len);
+  for (i = 0; i < len; i += 4)
+  {
+    w = 0;
+    memcpy (&w, symbol + i, len - i < 4 ? len - i : 4);
+    BTOR_PUSH_STACK (*buf, w);
+  }
+}
+
+static void
+write_const (Btor *btor, BtorUIntStack *buf, const BtorBitVector *bits)
+{
+  uint32_t width, lo, hi;
+  uint64_t val;
+  BtorBitVector *chunk;
+
+  width = btor_bv_get_width (bits);
+  BTOR_PUSH_STACK (*buf, width);
+  for (lo = 0; lo < width; lo += 64)
+  {
+    hi = lo + 63 < width ? lo + 63 : width - 1;
+    if (lo == 0 && hi == width - 1)
+      val = btor_bv_to_uint64 (bits);
+    else
+    {
+      chunk = btor_bv_slice (btor->mm, bits, hi, lo);
+      val   = btor_bv_to_uint64 (chunk);
+      btor_bv_free (btor->mm, chunk);
+    }
+    BTOR_PUSH_STACK (*buf, (uint32_t) val);
+    BTOR_PUSH_STACK (*buf, (uint32_t) (val >> 32));
+  }
+}
+
+/* Collect cone of 'root' in post-order. Proxies are skipped, i.e., children
+ * are collected in their simplified form. 'mark' maps node ids to the index
+ * of the node + 1 (UINT32_MAX while the node is visited). */
+static void
+collect_cone (Btor *btor,
+              BtorNode *root,
+              uint32_t *mark,
+              BtorNodePtrStack *nodes)
+{
+  int32_t i;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+
+  BTOR_INIT_STACK (btor->mm, visit);
+  BTOR_PUSH_STACK (visit, btor_node_real_addr (root));
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = BTOR_POP_STACK (visit);
+    assert (btor_node_is_regular (cur));
+    assert (!btor_node_is_proxy (cur));
+
+    if (!mark[cur->id])
+    {
+      mark[cur->id] = UINT32_MAX;
+      BTOR_PUSH_STACK (visit, cur);
+      for (i = cur->arity - 1; i >= 0; i--)
+        BTOR_PUSH_STACK (visit,
+                         btor_node_real_addr (
+                             btor_node_get_simplified (btor, cur->e[i])));
+    }
+    else if (mark[cur->id] == UINT32_MAX)
+    {
+      BTOR_PUSH_STACK (*nodes, cur);
+      mark[cur->id] = BTOR_COUNT_STACK (*nodes);
+    }
+  }
+  BTOR_RELEASE_STACK (visit);
+}
+
+static uint32_t
+node_ref (Btor *btor, uint32_t *mark, BtorNode *exp)
+{
+  BtorNode *real_exp;
+
+  exp      = btor_node_get_simplified (btor, exp);
+  real_exp = btor_node_real_addr (exp);
+  assert (mark[real_exp->id] && mark[real_exp->id] != UINT32_MAX);
+  return (mark[real_exp->id] - 1) << 1 | btor_node_is_inverted (exp);
+}
+
+bool
+btor_snapshot_write (Btor *btor, FILE *file)
+{
+  assert (btor);
+  assert (file);
+
+  uint32_t i, j, *mark, *sort_idx, nsorts, nroots, naliases;
+  size_t n;
+  bool res;
+  char *symbol;
+  BtorNode *cur, *simp;
+  BtorMemMgr *mm;
+  BtorSort *sort;
+  BtorSortPtrStack *id2sort;
+  BtorNodePtrStack nodes, roots, aliases;
+  BtorUIntStack buf;
+  BtorPtrHashTableIterator it;
+
+  mm = btor->mm;
+  BTOR_INIT_STACK (mm, nodes);
+  BTOR_INIT_STACK (mm, roots);
+  BTOR_INIT_STACK (mm, aliases);
+  BTOR_INIT_STACK (mm, buf);
+  BTOR_CNEWN (mm, mark, BTOR_COUNT_STACK (btor->nodes_id_table));
+
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->embedded_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_node_get_simplified (btor, btor_iter_hashptr_next (&it));
+    collect_cone (btor, cur, mark, &nodes);
+    BTOR_PUSH_STACK (roots, cur);
+  }
+  /* false constraints are not kept in the constraint tables */
+  if (btor->inconsistent)
+  {
+    cur = btor_node_invert (btor->true_exp);
+    collect_cone (btor, cur, mark, &nodes);
+    BTOR_PUSH_STACK (roots, cur);
+  }
+
+  btor_iter_hashptr_init (&it, btor->node2symbol);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur  = btor_iter_hashptr_next (&it);
+    simp = btor_node_get_simplified (btor, cur);
+    collect_cone (btor, simp, mark, &nodes);
+    if (simp != cur) BTOR_PUSH_STACK (aliases, cur);
+  }
+
+  /* header */
+  id2sort  = &btor->sorts_unique_table.id2sort;
+  nsorts   = 0;
+  nroots   = BTOR_COUNT_STACK (roots);
+  naliases = BTOR_COUNT_STACK (aliases);
+  for (i = 0; i < BTOR_COUNT_STACK (*id2sort); i++)
+    if (BTOR_PEEK_STACK (*id2sort, i)) nsorts++;
+  BTOR_PUSH_STACK (buf, BTOR_SNAPSHOT_MAGIC);
+  BTOR_PUSH_STACK (buf, BTOR_SNAPSHOT_VERSION);
+  BTOR_PUSH_STACK (buf, BTOR_SNAPSHOT_BOM);
+  BTOR_PUSH_STACK (buf, nsorts);
+  BTOR_PUSH_STACK (buf, BTOR_COUNT_STACK (nodes));
+  BTOR_PUSH_STACK (buf, nroots);
+  BTOR_PUSH_STACK (buf, naliases);
+
+  /* sorts (elements of a sort always have smaller ids) */
+  BTOR_CNEWN (mm, sort_idx, BTOR_COUNT_STACK (*id2sort));
+  for (i = 0, nsorts = 0; i < BTOR_COUNT_STACK (*id2sort); i++)
+  {
+    sort = BTOR_PEEK_STACK (*id2sort, i);
+    if (!sort) continue;
+    sort_idx[i] = nsorts++;
+    BTOR_PUSH_STACK (buf, sort->kind);
+    switch (sort->kind)
+    {
+      case BTOR_BV_SORT:
+        BTOR_PUSH_STACK (buf, sort->bitvec.width);
+        break;
+      case BTOR_TUPLE_SORT:
+        BTOR_PUSH_STACK (buf, sort->tuple.num_elements);
+        for (j = 0; j < sort->tuple.num_elements; j++)
+        {
+          assert (sort->tuple.elements[j]->id < sort->id);
+          BTOR_PUSH_STACK (buf, sort_idx[sort->tuple.elements[j]->id]);
+        }
+        break;
+      default:
+        assert (sort->kind == BTOR_FUN_SORT);
+        assert (sort->fun.domain->id < sort->id);
+        assert (sort->fun.codomain->id < sort->id);
+        BTOR_PUSH_STACK (buf, sort->fun.is_array);
+        BTOR_PUSH_STACK (buf, sort_idx[sort->fun.domain->id]);
+        BTOR_PUSH_STACK (buf, sort_idx[sort->fun.codomain->id]);
+    }
+  }
+
+  /* nodes */
+  for (i = 0; i < BTOR_COUNT_STACK (nodes); i++)
+  {
+    cur    = BTOR_PEEK_STACK (nodes, i);
+    symbol = btor_node_get_symbol (btor, cur);
+    BTOR_PUSH_STACK (buf,
+                     cur->kind | cur->arity << BTOR_SNAPSHOT_ARITY_SHIFT
+                         | (cur->is_array ? BTOR_SNAPSHOT_FLAG_IS_ARRAY : 0)
+                         | (symbol ? BTOR_SNAPSHOT_FLAG_SYMBOL : 0));
+    if (btor_node_is_bv_const (cur))
+      write_const (btor, &buf, btor_node_bv_const_get_bits (cur));
+    else if (btor_node_is_bv_var (cur) || btor_node_is_uf (cur)
+             || btor_node_is_param (cur))
+      BTOR_PUSH_STACK (buf, sort_idx[btor_node_get_sort_id (cur)]);
+    else
+    {
+      for (j = 0; j < cur->arity; j++)
+        BTOR_PUSH_STACK (buf, node_ref (btor, mark, cur->e[j]));
+      if (btor_node_is_bv_slice (cur))
+      {
+        BTOR_PUSH_STACK (buf, btor_node_bv_slice_get_upper (cur));
+        BTOR_PUSH_STACK (buf, btor_node_bv_slice_get_lower (cur));
+      }
+    }
+    if (symbol) write_symbol (&buf, symbol);
+  }
+
+  /* roots and aliases */
+  for (i = 0; i < nroots; i++)
+    BTOR_PUSH_STACK (buf, node_ref (btor, mark, BTOR_PEEK_STACK (roots, i)));
+  for (i = 0; i < naliases; i++)
+  {
+    cur = BTOR_PEEK_STACK (aliases, i);
+    BTOR_PUSH_STACK (buf, node_ref (btor, mark, cur));
+    write_symbol (&buf, btor_node_get_symbol (btor, cur));
+  }
+
+  n = BTOR_COUNT_STACK (buf);
+  BTOR_PUSH_STACK (buf, snapshot_checksum (buf.start, n));
+
+  n   = BTOR_COUNT_STACK (buf);
+  res = fwrite (buf.start, sizeof (uint32_t), n, file) == n;
+
+  BTOR_DELETEN (mm, sort_idx, BTOR_COUNT_STACK (*id2sort));
+  BTOR_DELETEN (mm, mark, BTOR_COUNT_STACK (btor->nodes_id_table));
+  BTOR_RELEASE_STACK (buf);
+  BTOR_RELEASE_STACK (aliases);
+  BTOR_RELEASE_STACK (roots);
+  BTOR_RELEASE_STACK (nodes);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+struct BtorSnapshotReader
+{
+  BtorMemMgr *mm;
+  void *base;    /* mapped or allocated memory */
+  size_t size;   /* size of 'base' in bytes */
+  bool mapped;   /* 'base' is mapped */
+  const uint32_t *words;
+  size_t nwords;
+  size_t pos;
+  bool eof;
+};
+
+typedef struct BtorSnapshotReader BtorSnapshotReader;
+
+/* Map or read the remainder of 'file' into memory. */
+static void
+load_snapshot (BtorSnapshotReader *reader, FILE *file)
+{
+  size_t n;
+
+#ifndef BTOR_WINDOWS_BUILD
+  long offset;
+  struct stat st;
+  void *addr;
+
+  offset = ftell (file);
+  if (offset >= 0 && offset % sizeof (uint32_t) == 0
+      && !fstat (fileno (file), &st) && S_ISREG (st.st_mode)
+      && st.st_size > offset)
+  {
+    addr = mmap (0, st.st_size, PROT_READ, MAP_PRIVATE, fileno (file), 0);
+    if (addr != MAP_FAILED)
+    {
+      reader->base   = addr;
+      reader->size   = st.st_size;
+      reader->mapped = true;
+      reader->words  = (const uint32_t *) ((char *) addr + offset);
+      reader->nwords = (st.st_size - offset) / sizeof (uint32_t);
+      return;
+    }
+  }
+#endif
+
+  reader->size = 1 << 16;
+  reader->base = btor_mem_malloc (reader->mm, reader->size);
+  n            = 0;
+  while ((n += fread ((char *) reader->base + n, 1, reader->size - n, file))
+         == reader->size)
+  {
+    reader->base = btor_mem_realloc (
+        reader->mm, reader->base, reader->size, 2 * reader->size);
+    reader->size *= 2;
+  }
+  reader->words  = reader->base;
+  reader->nwords = n / sizeof (uint32_t);
+}
+
+static void
+unload_snapshot (BtorSnapshotReader *reader)
+{
+#ifndef BTOR_WINDOWS_BUILD
+  if (reader->mapped)
+  {
+    munmap (reader->base, reader->size);
+    return;
+  }
+#endif
+  btor_mem_free (reader->mm, reader->base, reader->size);
+}
+
+static uint32_t
+read_word (BtorSnapshotReader *reader)
+{
+  if (reader->pos >= reader->nwords)
+  {
+    reader->eof = true;
+    return 0;
+  }
+  return reader->words[reader->pos++];
+}
+
+/* Returns the symbol at the current position (copied into 'buf'), or 0 if the
+ * snapshot is truncated. */
+static const char *
+read_symbol (BtorSnapshotReader *reader, BtorCharStack *buf)
+{
+  uint32_t len, nwords;
+
+  len    = read_word (reader);
+  nwords = len / 4 + (len % 4 ? 1 : 0);
+  if (reader->eof || reader->nwords - reader->pos < nwords)
+  {
+    reader->eof = true;
+    return 0;
+  }
+  BTOR_RESET_STACK (*buf);
+  BTOR_FIT_STACK (*buf, len);
+  memcpy (buf->start, reader->words + reader->pos, len);
+  buf->top = buf->start + len;
+  BTOR_PUSH_STACK (*buf, 0);
+  reader->pos += nwords;
+  return buf->start;
+}
+
+static BtorBitVector *
+read_const (BtorMemMgr *mm, BtorSnapshotReader *reader)
+{
+  uint32_t width, lo, lo_word;
+  uint64_t val;
+  BtorBitVector *res, *chunk, *tmp;
+
+  width = read_word (reader);
+  if (reader->eof || !width) return 0;
+  res = 0;
+  for (lo = 0; lo < width; lo += 64)
+  {
+    lo_word = read_word (reader);
+    val     = (uint64_t) read_word (reader) << 32 | lo_word;
+    chunk   = btor_bv_uint64_to_bv (mm, val, width - lo < 64 ? width - lo : 64);
+    if (res)
+    {
+      tmp = btor_bv_concat (mm, chunk, res);
+      btor_bv_free (mm, chunk);
+      btor_bv_free (mm, res);
+      res = tmp;
+    }
+    else
+      res = chunk;
+  }
+  if (reader->eof)
+  {
+    btor_bv_free (mm, res);
+    return 0;
+  }
+  return res;
+}
+
+static BtorNode *
+create_node (Btor *btor, BtorNodeKind kind, BtorNode *e[], uint32_t arity)
+{
+  switch (kind)
+  {
+    case BTOR_BV_AND_NODE: return btor_node_create_bv_and (btor, e[0], e[1]);
+    case BTOR_BV_EQ_NODE:
+    case BTOR_FUN_EQ_NODE: return btor_node_create_eq (btor, e[0], e[1]);
+    case BTOR_BV_ADD_NODE: return btor_node_create_bv_add (btor, e[0], e[1]);
+    case BTOR_BV_MUL_NODE: return btor_node_create_bv_mul (btor, e[0], e[1]);
+    case BTOR_BV_ULT_NODE: return btor_node_create_bv_ult (btor, e[0], e[1]);
+    case BTOR_BV_SLL_NODE: return btor_node_create_bv_sll (btor, e[0], e[1]);
+    case BTOR_BV_SRL_NODE: return btor_node_create_bv_srl (btor, e[0], e[1]);
+    case BTOR_BV_UDIV_NODE: return btor_node_create_bv_udiv (btor, e[0], e[1]);
+    case BTOR_BV_UREM_NODE: return btor_node_create_bv_urem (btor, e[0], e[1]);
+    case BTOR_BV_CONCAT_NODE:
+      return btor_node_create_bv_concat (btor, e[0], e[1]);
+    case BTOR_APPLY_NODE: return btor_node_create_apply (btor, e[0], e[1]);
+    case BTOR_LAMBDA_NODE: return btor_node_create_lambda (btor, e[0], e[1]);
+    case BTOR_FORALL_NODE: return btor_node_create_forall (btor, e[0], e[1]);
+    case BTOR_EXISTS_NODE: return btor_node_create_exists (btor, e[0], e[1]);
+    case BTOR_COND_NODE: return btor_node_create_cond (btor, e[0], e[1], e[2]);
+    case BTOR_UPDATE_NODE:
+      return btor_node_create_update (btor, e[0], e[1], e[2]);
+    default:
+      assert (kind == BTOR_ARGS_NODE);
+      return btor_node_create_args (btor, e, arity);
+  }
+}
+
+static bool
+is_bv_node (Btor *btor, BtorNode *exp)
+{
+  return btor_sort_is_bv (btor, btor_node_get_sort_id (exp));
+}
+
+static bool
+is_regular_fun_node (Btor *btor, BtorNode *exp)
+{
+  return btor_node_is_regular (exp)
+         && btor_sort_is_fun (btor, btor_node_get_sort_id (exp));
+}
+
+/* Check operand sorts and kinds of a node of kind 'kind' with operands 'e'
+ * (preconditions of the corresponding 'btor_node_create_*' function). */
+static bool
+check_operands (Btor *btor, BtorNodeKind kind, BtorNode *e[], uint32_t arity)
+{
+  uint32_t i;
+  BtorSortId sort;
+
+  switch (kind)
+  {
+    case BTOR_BV_EQ_NODE:
+    case BTOR_FUN_EQ_NODE:
+      if (btor_node_get_sort_id (e[0]) != btor_node_get_sort_id (e[1])
+          || btor_node_real_addr (e[0])->is_array
+                 != btor_node_real_addr (e[1])->is_array)
+        return false;
+      if (is_bv_node (btor, e[0])) return true;
+      return is_regular_fun_node (btor, e[0])
+             && is_regular_fun_node (btor, e[1]);
+    case BTOR_BV_CONCAT_NODE:
+      return is_bv_node (btor, e[0]) && is_bv_node (btor, e[1])
+             && btor_node_bv_get_width (btor, e[0])
+                    <= INT32_MAX - btor_node_bv_get_width (btor, e[1]);
+    case BTOR_COND_NODE:
+      if (!is_bv_node (btor, e[0]) || btor_node_bv_get_width (btor, e[0]) != 1
+          || btor_node_get_sort_id (e[1]) != btor_node_get_sort_id (e[2])
+          || btor_node_real_addr (e[1])->is_array
+                 != btor_node_real_addr (e[2])->is_array)
+        return false;
+      if (is_bv_node (btor, e[1])) return true;
+      return is_regular_fun_node (btor, e[1])
+             && is_regular_fun_node (btor, e[2]);
+    case BTOR_APPLY_NODE:
+    case BTOR_UPDATE_NODE:
+      if (!is_regular_fun_node (btor, e[0]) || !btor_node_is_regular (e[1])
+          || !btor_node_is_args (e[1]))
+        return false;
+      sort = btor_node_get_sort_id (e[0]);
+      if (btor_sort_fun_get_domain (btor, sort)
+          != btor_node_get_sort_id (e[1]))
+        return false;
+      if (kind == BTOR_APPLY_NODE) return true;
+      return btor_sort_fun_get_codomain (btor, sort)
+             == btor_node_get_sort_id (e[2]);
+    case BTOR_LAMBDA_NODE:
+    case BTOR_FORALL_NODE:
+    case BTOR_EXISTS_NODE:
+      if (!btor_node_is_regular (e[0]) || !btor_node_is_param (e[0])
+          || btor_node_param_is_bound (e[0]))
+        return false;
+      if (kind != BTOR_LAMBDA_NODE)
+        return is_bv_node (btor, e[1])
+               && btor_node_bv_get_width (btor, e[1]) == 1;
+      /* curried functions are represented as nested lambdas */
+      return is_bv_node (btor, e[1])
+             || (btor_node_is_regular (e[1]) && btor_node_is_lambda (e[1]));
+    case BTOR_ARGS_NODE:
+      /* argument lists of more than 3 arguments are split into nested args
+       * nodes, see 'btor_node_create_args' */
+      for (i = 0; i < arity; i++)
+        if (!is_bv_node (btor, e[i])
+            && (i < 2 || !btor_node_is_regular (e[i])
+                || !btor_node_is_args (e[i])))
+          return false;
+      return true;
+    default:
+      return is_bv_node (btor, e[0]) && is_bv_node (btor, e[1])
+             && btor_node_get_sort_id (e[0]) == btor_node_get_sort_id (e[1]);
+  }
+}
+
+/* Expected arity of nodes of kind 'kind', or -1 if 'kind' can not occur in a
+ * snapshot. */
+static int32_t
+get_arity (BtorNodeKind kind)
+{
+  switch (kind)
+  {
+    case BTOR_BV_CONST_NODE:
+    case BTOR_VAR_NODE:
+    case BTOR_PARAM_NODE:
+    case BTOR_UF_NODE: return 0;
+    case BTOR_BV_SLICE_NODE: return 1;
+    case BTOR_COND_NODE:
+    case BTOR_UPDATE_NODE: return 3;
+    case BTOR_ARGS_NODE: return 0; /* 1 to 3 */
+    case BTOR_INVALID_NODE:
+    case BTOR_PROXY_NODE:
+    case BTOR_NUM_OPS_NODE: return -1;
+    default: return 2;
+  }
+}
+
+#define SNAPSHOT_ERROR(msg) \
+  do                        \
+  {                         \
+    error = msg;            \
+    goto DONE;              \
+  } while (0)
+
+#define SNAPSHOT_READ_NODE(res)                                             \
+  do                                                                        \
+  {                                                                         \
+    ref = read_word (&reader);                                              \
+    if (reader.eof) SNAPSHOT_ERROR ("unexpected end of snapshot");          \
+    if ((ref >> 1) >= BTOR_COUNT_STACK (nodes))                             \
+      SNAPSHOT_ERROR ("invalid node reference");                            \
+    res = btor_node_cond_invert ((BtorNode *) (uintptr_t) (ref & 1),        \
+                                 BTOR_PEEK_STACK (nodes, ref >> 1));        \
+  } while (0)
+
+const char *
+btor_snapshot_read (Btor *btor, FILE *file)
+{
+  assert (btor);
+  assert (file);
+
+  uint32_t i, j, w, kind, arity, nsorts, nnodes, nroots, naliases, ref;
+  uint32_t upper, lower;
+  const char *error, *symbol;
+  BtorNode *e[3], *exp, *alias;
+  BtorMemMgr *mm;
+  BtorSortId sort, dom, codom;
+  BtorSortIdStack sorts, elements;
+  BtorNodePtrStack nodes, roots;
+  BtorCharStack symbuf;
+  BtorBitVector *bits;
+  BtorSnapshotReader reader;
+  BtorPtrHashTable *symbols;
+  BtorPtrHashTableIterator it;
+
+  mm = btor->mm;
+  BTOR_CLR (&reader);
+  reader.mm = mm;
+  load_snapshot (&reader, file);
+
+  error = 0;
+  BTOR_INIT_STACK (mm, sorts);
+  BTOR_INIT_STACK (mm, elements);
+  BTOR_INIT_STACK (mm, nodes);
+  BTOR_INIT_STACK (mm, roots);
+  BTOR_INIT_STACK (mm, symbuf);
+  symbols = btor_hashptr_table_new (
+      mm, (BtorHashPtr) btor_hash_str, (BtorCmpPtr) strcmp);
+
+  /* header */
+  if (reader.nwords < BTOR_SNAPSHOT_HEADER_SIZE + 1
+      || reader.words[0] != BTOR_SNAPSHOT_MAGIC)
+    SNAPSHOT_ERROR ("not a snapshot");
+  if (reader.words[1] != BTOR_SNAPSHOT_VERSION)
+    SNAPSHOT_ERROR ("unsupported snapshot version");
+  if (reader.words[2] != BTOR_SNAPSHOT_BOM)
+    SNAPSHOT_ERROR ("snapshot was written with different byte order");
+  if (reader.words[reader.nwords - 1]
+      != snapshot_checksum (reader.words, reader.nwords - 1))
+    SNAPSHOT_ERROR ("snapshot is corrupted");
+  nsorts   = reader.words[3];
+  nnodes   = reader.words[4];
+  nroots   = reader.words[5];
+  naliases = reader.words[6];
+  reader.pos = BTOR_SNAPSHOT_HEADER_SIZE;
+
+  /* sorts */
+  for (i = 0; i < nsorts; i++)
+  {
+    kind = read_word (&reader);
+    if (kind == BTOR_BV_SORT)
+    {
+      w = read_word (&reader);
+      if (!w) SNAPSHOT_ERROR ("invalid bit-vector sort");
+      sort = btor_sort_bv (btor, w);
+    }
+    else if (kind == BTOR_TUPLE_SORT)
+    {
+      w = read_word (&reader);
+      BTOR_RESET_STACK (elements);
+      for (j = 0; j < w && !reader.eof; j++)
+      {
+        ref = read_word (&reader);
+        if (ref >= BTOR_COUNT_STACK (sorts))
+          SNAPSHOT_ERROR ("invalid sort reference");
+        BTOR_PUSH_STACK (elements, BTOR_PEEK_STACK (sorts, ref));
+      }
+      if (!w) SNAPSHOT_ERROR ("invalid tuple sort");
+      sort = btor_sort_tuple (btor, elements.start, w);
+    }
+    else if (kind == BTOR_FUN_SORT)
+    {
+      w     = read_word (&reader);
+      dom   = read_word (&reader);
+      codom = read_word (&reader);
+      if (dom >= BTOR_COUNT_STACK (sorts) || codom >= BTOR_COUNT_STACK (sorts)
+          || !btor_sort_is_tuple (btor, BTOR_PEEK_STACK (sorts, dom)))
+        SNAPSHOT_ERROR ("invalid sort reference");
+      sort = btor_sort_fun (btor,
+                            BTOR_PEEK_STACK (sorts, dom),
+                            BTOR_PEEK_STACK (sorts, codom));
+      if (w) btor_sort_get_by_id (btor, sort)->fun.is_array = true;
+    }
+    else
+      SNAPSHOT_ERROR ("invalid sort");
+    BTOR_PUSH_STACK (sorts, sort);
+    if (reader.eof) SNAPSHOT_ERROR ("unexpected end of snapshot");
+  }
+
+  /* nodes */
+  for (i = 0; i < nnodes; i++)
+  {
+    w     = read_word (&reader);
+    kind  = w & BTOR_SNAPSHOT_KIND_MASK;
+    arity = (w >> BTOR_SNAPSHOT_ARITY_SHIFT) & 3;
+    if (reader.eof) SNAPSHOT_ERROR ("unexpected end of snapshot");
+    if (kind >= BTOR_NUM_OPS_NODE || get_arity (kind) < 0
+        || (kind == BTOR_ARGS_NODE ? arity == 0
+                                   : arity != (uint32_t) get_arity (kind)))
+      SNAPSHOT_ERROR ("invalid node");
+
+    if (kind == BTOR_BV_CONST_NODE)
+    {
+      if (!(bits = read_const (mm, &reader)))
+        SNAPSHOT_ERROR ("invalid constant");
+      exp = btor_node_create_bv_const (btor, bits);
+      btor_bv_free (mm, bits);
+    }
+    else if (kind == BTOR_VAR_NODE || kind == BTOR_UF_NODE
+             || kind == BTOR_PARAM_NODE)
+    {
+      ref = read_word (&reader);
+      if (ref >= BTOR_COUNT_STACK (sorts))
+        SNAPSHOT_ERROR ("invalid sort reference");
+      sort = BTOR_PEEK_STACK (sorts, ref);
+      if ((kind == BTOR_UF_NODE) != btor_sort_is_fun (btor, sort))
+        SNAPSHOT_ERROR ("invalid sort");
+      if (kind == BTOR_VAR_NODE)
+        exp = btor_node_create_var (btor, sort, 0);
+      else if (kind == BTOR_UF_NODE)
+        exp = btor_node_create_uf (btor, sort, 0);
+      else
+        exp = btor_node_create_param (btor, sort, 0);
+    }
+    else
+    {
+      for (j = 0; j < arity; j++) SNAPSHOT_READ_NODE (e[j]);
+      if (kind == BTOR_BV_SLICE_NODE)
+      {
+        upper = read_word (&reader);
+        lower = read_word (&reader);
+        if (reader.eof) SNAPSHOT_ERROR ("unexpected end of snapshot");
+        if (btor_node_is_fun (e[0]) || lower > upper
+            || upper >= btor_node_bv_get_width (btor, e[0]))
+          SNAPSHOT_ERROR ("invalid slice");
+        exp = btor_node_create_bv_slice (btor, e[0], upper, lower);
+      }
+      else
+      {
+        if (!check_operands (btor, kind, e, arity))
+          SNAPSHOT_ERROR ("invalid operands");
+        exp = create_node (btor, kind, e, arity);
+      }
+    }
+    if (w & BTOR_SNAPSHOT_FLAG_IS_ARRAY) exp->is_array = 1;
+    BTOR_PUSH_STACK (nodes, exp);
+
+    if (w & BTOR_SNAPSHOT_FLAG_SYMBOL)
+    {
+      if (!(symbol = read_symbol (&reader, &symbuf)))
+        SNAPSHOT_ERROR ("unexpected end of snapshot");
+      if (btor_hashptr_table_get (btor->symbols, symbol)
+          || btor_hashptr_table_get (symbols, symbol))
+        SNAPSHOT_ERROR ("symbol already exists");
+      btor_hashptr_table_add (symbols, btor_mem_strdup (mm, symbol))
+          ->data.as_ptr = exp;
+    }
+  }
+
+  /* roots */
+  for (i = 0; i < nroots; i++)
+  {
+    SNAPSHOT_READ_NODE (exp);
+    if (btor_node_is_fun (exp) || btor_node_bv_get_width (btor, exp) != 1)
+      SNAPSHOT_ERROR ("invalid constraint");
+    BTOR_PUSH_STACK (roots, exp);
+  }
+
+  /* aliases, asserted as equalities */
+  for (i = 0; i < naliases; i++)
+  {
+    SNAPSHOT_READ_NODE (exp);
+    if (!(symbol = read_symbol (&reader, &symbuf)))
+      SNAPSHOT_ERROR ("unexpected end of snapshot");
+    if (btor_hashptr_table_get (btor->symbols, symbol)
+        || btor_hashptr_table_get (symbols, symbol))
+      SNAPSHOT_ERROR ("symbol already exists");
+    sort = btor_node_get_sort_id (exp);
+    if (!btor_sort_is_fun (btor, sort))
+      alias = btor_exp_var (btor, sort, 0);
+    else if (btor_node_real_addr (exp)->is_array)
+      alias = btor_exp_array (btor, sort, 0);
+    else
+      alias = btor_exp_uf (btor, sort, 0);
+    btor_hashptr_table_add (symbols, btor_mem_strdup (mm, symbol))
+        ->data.as_ptr = alias;
+    BTOR_PUSH_STACK (nodes, alias);
+    exp = btor_exp_eq (btor, alias, exp);
+    BTOR_PUSH_STACK (nodes, exp);
+    BTOR_PUSH_STACK (roots, exp);
+  }
+
+  if (reader.pos != reader.nwords - 1) SNAPSHOT_ERROR ("invalid snapshot");
+
+  btor_iter_hashptr_init (&it, symbols);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    exp = it.bucket->data.as_ptr;
+    btor_node_set_symbol (btor, exp, btor_iter_hashptr_next (&it));
+  }
+  for (i = 0; i < BTOR_COUNT_STACK (roots); i++)
+    btor_assert_exp (btor, BTOR_PEEK_STACK (roots, i));
+
+DONE:
+  btor_iter_hashptr_init (&it, symbols);
+  while (btor_iter_hashptr_has_next (&it))
+    btor_mem_freestr (mm, btor_iter_hashptr_next (&it));
+  btor_hashptr_table_delete (symbols);
+  while (!BTOR_EMPTY_STACK (nodes))
+    btor_node_release (btor, BTOR_POP_STACK (nodes));
+  while (!BTOR_EMPTY_STACK (sorts))
+    btor_sort_release (btor, BTOR_POP_STACK (sorts));
+  BTOR_RELEASE_STACK (symbuf);
+  BTOR_RELEASE_STACK (roots);
+  BTOR_RELEASE_STACK (nodes);
+  BTOR_RELEASE_STACK (elements);
+  BTOR_RELEASE_STACK (sorts);
+  unload_snapshot (&reader);
+  return error;
+}
@@ -0,0 +1,40 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORSNAPSHOT_H_INCLUDED
+#define BTORSNAPSHOT_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "btortypes.h"
+
+/* Binary snapshots of the current formula of a Boolector instance.
+ *
+ * A snapshot stores the sorts, the cone of all constraints (after
+ * simplification, i.e., without proxies) and all symbols in a flat table of
+ * nodes in topological order, which is restored without parsing, rewriting or
+ * simplifying the formula again. Symbols of inputs that were eliminated by
+ * simplification are restored as equality constraints. Assumptions (including
+ * assertions in push/pop scopes), the AIGs the formula was bit-blasted to,
+ * their CNF encoding and the state of the SAT solver are not part of a
+ * snapshot, i.e., a restored formula is bit-blasted again on the next check.
+ *
+ * Snapshots are not portable across machines with different byte order. */
+
+/* Write a snapshot of the current formula of 'btor' to 'file'.
+ * Returns false if writing failed. */
+bool btor_snapshot_write (Btor *btor, FILE *file);
+
+/* Restore snapshot from 'file' into 'btor'. Returns 0 on success and an error
+ * message otherwise, in which case 'btor' is left unchanged. If 'file' is a
+ * regular file, it is mapped into memory rather than read. The restored nodes
+ * are only referenced by the restored constraints. */
+const char *btor_snapshot_read (Btor *btor, FILE *file);
+
+#endif
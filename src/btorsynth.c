@@ -10,6 +10,7 @@
 #include "btorbeta.h"
 #include "btorbv.h"
 #include "btorcore.h"
+#include "btorevaltape.h"
 #include "btormodel.h"
 #include "utils/btorhashint.h"
 #include "utils/btornodeiter.h"
@@ -17,6 +18,10 @@
 #include "utils/btorstack.h"
 #include "utils/btorutil.h"
 
+#ifdef BTOR_HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
 BTOR_DECLARE_STACK (BtorBitVectorTuplePtr, BtorBitVectorTuple *);
 BTOR_DECLARE_STACK (BtorIntHashTablePtr, BtorIntHashTable *);
 
@@ -70,6 +75,31 @@ struct BtorCartProdIterator
 
 typedef struct BtorCartProdIterator BtorCartProdIterator;
 
+/* In/out values packed into one 64-bit word per value. 'in[pos]' is 0 if the
+ * input values at position 'pos' are wider than 64 bits, 'out' is 0 if the
+ * output values are wider than 64 bits. */
+struct PackedValues
+{
+  uint32_t nvalues;
+  uint32_t npos;
+  uint64_t **in;
+  uint64_t *out;
+  uint32_t out_width;
+};
+
+typedef struct PackedValues PackedValues;
+
+/* Signature of a candidate expression of at most 64 bits, packed into one
+ * 64-bit word per in/out value. */
+struct PackedSig
+{
+  uint32_t width;
+  uint32_t nvalues;
+  uint64_t values[];
+};
+
+typedef struct PackedSig PackedSig;
+
 static void
 init_next_sort (BtorCartProdIterator *it)
 {
@@ -292,156 +322,93 @@ collect_exps_post_order (Btor *btor,
   btor_hashint_map_delete (cache);
 }
 
-static BtorBitVector *
-eval_candidate (Btor *btor,
-                BtorNode *candidate,
-                BtorBitVectorTuple *value_in,
-                BtorBitVector *value_out,
-                BtorIntHashTable *value_in_map)
+/* Candidate expression compiled to an evaluation tape. 'pos' maps input i of
+ * the tape to the position of its value in the input value tuples, where -1
+ * denotes the output value. */
+struct CandidateTape
+{
+  BtorEvalTape *tape;
+  BtorIntStack pos;
+  bool packed; /* all inputs are packed, use packed evaluation */
+};
+
+typedef struct CandidateTape CandidateTape;
+
+static void
+init_candidate_tape (Btor *btor,
+                     CandidateTape *ctape,
+                     BtorNode *candidate,
+                     BtorIntHashTable *value_in_map,
+                     PackedValues *pvalues)
 {
   assert (btor);
+  assert (ctape);
   assert (candidate);
-  assert (value_in);
-  assert (value_out);
   assert (value_in_map);
+  assert (pvalues);
 
-  size_t j;
-  int32_t i, pos;
-  BtorNode *cur, *real_cur;
-  BtorNodePtrStack visit;
-  BtorIntHashTable *cache;
-  BtorHashTableData *d;
-  BtorBitVectorPtrStack arg_stack;
-  BtorMemMgr *mm;
-  BtorBitVector **bv, *result, *inv_result, *a;
-
-  mm    = btor->mm;
-  cache = btor_hashint_map_new (mm);
+  uint32_t i;
+  int32_t pos;
+  BtorNode *input;
 
-  BTOR_INIT_STACK (mm, arg_stack);
-  BTOR_INIT_STACK (mm, visit);
-  BTOR_PUSH_STACK (visit, candidate);
-  while (!BTOR_EMPTY_STACK (visit))
+  ctape->tape   = btor_evaltape_new (btor, &candidate, 1);
+  ctape->packed = btor_evaltape_is_packable (ctape->tape);
+  BTOR_INIT_STACK (btor->mm, ctape->pos);
+  for (i = 0; i < btor_evaltape_get_num_inputs (ctape->tape); i++)
   {
-    cur      = BTOR_POP_STACK (visit);
-    real_cur = btor_node_real_addr (cur);
+    input = btor_evaltape_get_input (ctape->tape, i);
+    assert (btor_node_is_bv_var (input) || btor_node_is_param (input));
+    assert (btor_hashint_map_get (value_in_map, input->id));
+    pos = btor_hashint_map_get (value_in_map, input->id)->as_int;
+    BTOR_PUSH_STACK (ctape->pos, pos);
+    if ((pos == -1 && !pvalues->out) || (pos >= 0 && !pvalues->in[pos]))
+      ctape->packed = false;
+  }
 
-    d = btor_hashint_map_get (cache, real_cur->id);
-    if (!d)
+  if (ctape->packed)
+  {
+    for (i = 0; i < BTOR_COUNT_STACK (ctape->pos); i++)
     {
-      btor_hashint_map_add (cache, real_cur->id);
-      BTOR_PUSH_STACK (visit, cur);
-
-      if (btor_node_is_apply (real_cur)) continue;
-
-      for (i = real_cur->arity - 1; i >= 0; i--)
-        BTOR_PUSH_STACK (visit, real_cur->e[i]);
+      pos = BTOR_PEEK_STACK (ctape->pos, i);
+      btor_evaltape_set_input_packed (
+          ctape->tape, i, pos == -1 ? pvalues->out : pvalues->in[pos]);
     }
-    else if (!d->as_ptr)
-    {
-      assert (!btor_node_is_fun (real_cur));
-      assert (!btor_node_is_apply (real_cur));
-
-      arg_stack.top -= real_cur->arity;
-      bv = arg_stack.top;
-
-      switch (real_cur->kind)
-      {
-        case BTOR_BV_CONST_NODE:
-          result = btor_bv_copy (mm, btor_node_bv_const_get_bits (real_cur));
-          break;
-
-        case BTOR_PARAM_NODE:
-        case BTOR_VAR_NODE:
-          assert (btor_hashint_map_get (value_in_map, real_cur->id));
-          pos = btor_hashint_map_get (value_in_map, real_cur->id)->as_int;
-          /* initial signature computation */
-          if (pos == -1)
-          {
-            assert (value_out);
-            assert (!candidate);
-            result = btor_bv_copy (mm, value_out);
-            assert (btor_node_bv_get_width (real_cur->btor, real_cur)
-                    == btor_bv_get_width (value_out));
-          }
-          else
-            result = btor_bv_copy (mm, value_in->bv[pos]);
-          break;
-
-        case BTOR_BV_SLICE_NODE:
-          result = btor_bv_slice (mm,
-                                  bv[0],
-                                  btor_node_bv_slice_get_upper (real_cur),
-                                  btor_node_bv_slice_get_lower (real_cur));
-          break;
-
-        case BTOR_BV_AND_NODE: result = btor_bv_and (mm, bv[0], bv[1]); break;
-
-        case BTOR_BV_EQ_NODE: result = btor_bv_eq (mm, bv[0], bv[1]); break;
-
-        case BTOR_BV_ADD_NODE: result = btor_bv_add (mm, bv[0], bv[1]); break;
-
-        case BTOR_BV_MUL_NODE: result = btor_bv_mul (mm, bv[0], bv[1]); break;
-
-        case BTOR_BV_ULT_NODE: result = btor_bv_ult (mm, bv[0], bv[1]); break;
-
-        case BTOR_BV_SLL_NODE: result = btor_bv_sll (mm, bv[0], bv[1]); break;
-
-        case BTOR_BV_SRL_NODE: result = btor_bv_srl (mm, bv[0], bv[1]); break;
-
-        case BTOR_BV_UDIV_NODE: result = btor_bv_udiv (mm, bv[0], bv[1]); break;
-
-        case BTOR_BV_UREM_NODE: result = btor_bv_urem (mm, bv[0], bv[1]); break;
-
-        case BTOR_BV_CONCAT_NODE:
-          result = btor_bv_concat (mm, bv[0], bv[1]);
-          break;
-
-        case BTOR_EXISTS_NODE:
-        case BTOR_FORALL_NODE: result = btor_bv_copy (mm, bv[1]); break;
-
-        default:
-          assert (real_cur->kind == BTOR_COND_NODE);
-          if (btor_bv_is_true (bv[0]))
-            result = btor_bv_copy (mm, bv[1]);
-          else
-            result = btor_bv_copy (mm, bv[2]);
-      }
-
-      for (i = 0; i < real_cur->arity; i++) btor_bv_free (mm, bv[i]);
+  }
+}
 
-      d->as_ptr = btor_bv_copy (mm, result);
+static void
+release_candidate_tape (CandidateTape *ctape)
+{
+  assert (ctape);
+  btor_evaltape_delete (ctape->tape);
+  BTOR_RELEASE_STACK (ctape->pos);
+}
 
-    EVAL_EXP_PUSH_RESULT:
-      if (btor_node_is_inverted (cur))
-      {
-        inv_result = btor_bv_not (mm, result);
-        btor_bv_free (mm, result);
-        result = inv_result;
-      }
-      BTOR_PUSH_STACK (arg_stack, result);
-    }
-    else
-    {
-      result = btor_bv_copy (mm, d->as_ptr);
-      goto EVAL_EXP_PUSH_RESULT;
-    }
-  }
+static BtorBitVector *
+eval_candidate (Btor *btor,
+                CandidateTape *candidate,
+                BtorBitVectorTuple *value_in,
+                BtorBitVector *value_out)
+{
+  assert (btor);
+  assert (candidate);
+  assert (value_in);
+  assert (value_out);
 
-  assert (BTOR_COUNT_STACK (arg_stack) == 1);
-  result = BTOR_POP_STACK (arg_stack);
+  uint32_t i;
+  int32_t pos;
 
-  for (j = 0; j < cache->size; j++)
+  for (i = 0; i < BTOR_COUNT_STACK (candidate->pos); i++)
   {
-    a = cache->data[j].as_ptr;
-    if (!a) continue;
-    btor_bv_free (mm, a);
+    pos = BTOR_PEEK_STACK (candidate->pos, i);
+    /* initial signature computation */
+    if (pos == -1)
+      btor_evaltape_set_input (candidate->tape, i, value_out);
+    else
+      btor_evaltape_set_input (candidate->tape, i, value_in->bv[pos]);
   }
-  BTOR_RELEASE_STACK (visit);
-  BTOR_RELEASE_STACK (arg_stack);
-  btor_hashint_map_delete (cache);
-
-  return result;
+  btor_evaltape_run (candidate->tape);
+  return btor_bv_copy (btor->mm, btor_evaltape_get_result (candidate->tape, 0));
 }
 
 static BtorBitVector *
@@ -450,7 +417,7 @@ eval_exps (Btor *btor,
            uint32_t nexps,
            BtorIntHashTable *value_cache,
            BtorIntHashTable *cone_hash,
-           BtorNode *candidate,
+           CandidateTape *candidate,
            BtorBitVectorTuple *value_in,
            BtorBitVector *value_out,
            BtorIntHashTable *value_in_map)
@@ -515,8 +482,7 @@ eval_exps (Btor *btor,
           {
             if (candidate)
             {
-              result = eval_candidate (
-                  btor, candidate, value_in, value_out, value_in_map);
+              result = eval_candidate (btor, candidate, value_in, value_out);
             }
             else
             {
@@ -664,13 +630,142 @@ add_exp (Btor *btor, uint32_t exp_size, Candidates *candidates, BtorNode *exp)
   candidates->nexps_level.start[exp_size]++;
 }
 
+static void
+init_packed_values (BtorMemMgr *mm,
+                    PackedValues *pvalues,
+                    BtorBitVectorTuple *value_in[],
+                    BtorBitVector *value_out[],
+                    uint32_t nvalues)
+{
+  assert (mm);
+  assert (pvalues);
+  assert (nvalues > 0);
+
+  uint32_t i, j;
+
+  pvalues->nvalues = nvalues;
+  pvalues->npos    = value_in[0]->arity;
+  BTOR_CNEWN (mm, pvalues->in, pvalues->npos);
+  for (j = 0; j < pvalues->npos; j++)
+  {
+    if (btor_bv_get_width (value_in[0]->bv[j]) > 64) continue;
+    BTOR_NEWN (mm, pvalues->in[j], nvalues);
+    for (i = 0; i < nvalues; i++)
+      pvalues->in[j][i] = btor_bv_to_uint64 (value_in[i]->bv[j]);
+  }
+
+  pvalues->out       = 0;
+  pvalues->out_width = btor_bv_get_width (value_out[0]);
+  if (pvalues->out_width <= 64)
+  {
+    BTOR_NEWN (mm, pvalues->out, nvalues);
+    for (i = 0; i < nvalues; i++)
+      pvalues->out[i] = btor_bv_to_uint64 (value_out[i]);
+  }
+}
+
+static void
+release_packed_values (BtorMemMgr *mm, PackedValues *pvalues)
+{
+  assert (mm);
+  assert (pvalues);
+
+  uint32_t j;
+
+  for (j = 0; j < pvalues->npos; j++)
+  {
+    if (!pvalues->in[j]) continue;
+    BTOR_DELETEN (mm, pvalues->in[j], pvalues->nvalues);
+  }
+  BTOR_DELETEN (mm, pvalues->in, pvalues->npos);
+  if (pvalues->out) BTOR_DELETEN (mm, pvalues->out, pvalues->nvalues);
+}
+
+static PackedSig *
+new_packed_sig (BtorMemMgr *mm, uint32_t width, uint32_t nvalues)
+{
+  PackedSig *res;
+
+  res = btor_mem_malloc (mm, sizeof (PackedSig) + nvalues * sizeof (uint64_t));
+
+  res->width   = width;
+  res->nvalues = nvalues;
+  return res;
+}
+
+static void
+delete_packed_sig (BtorMemMgr *mm, PackedSig *sig)
+{
+  btor_mem_free (
+      mm, sig, sizeof (PackedSig) + sig->nvalues * sizeof (uint64_t));
+}
+
+static uint32_t
+hash_packed_sig (const PackedSig *sig)
+{
+  uint32_t i;
+  uint64_t hash;
+
+  hash = sig->width;
+  for (i = 0; i < sig->nvalues; i++)
+    hash = (hash ^ sig->values[i]) * 1099511628211ull;
+  return (uint32_t) (hash ^ (hash >> 32));
+}
+
+static int32_t
+compare_packed_sig (const PackedSig *sig0, const PackedSig *sig1)
+{
+  if (sig0->width != sig1->width) return 1;
+  if (sig0->nvalues != sig1->nvalues) return 1;
+  return memcmp (sig0->values, sig1->values, sig0->nvalues * sizeof (uint64_t));
+}
+
+/* Compute signature of a candidate expression of at most 64 bits. If the
+ * candidate does not allow packed evaluation, the values are evaluated one
+ * by one and packed afterwards. */
+static PackedSig *
+create_packed_signature_exp (Btor *btor,
+                             CandidateTape *exp,
+                             uint32_t width,
+                             BtorBitVectorTuple *value_in[],
+                             BtorBitVector *value_out[],
+                             uint32_t nvalues)
+{
+  assert (width <= 64);
+
+  uint32_t i;
+  BtorBitVector *res;
+  PackedSig *sig;
+  BtorMemMgr *mm;
+
+  mm  = btor->mm;
+  sig = new_packed_sig (mm, width, nvalues);
+
+  if (exp->packed)
+  {
+    btor_evaltape_run_packed (exp->tape, nvalues);
+    memcpy (sig->values,
+            btor_evaltape_get_result_packed (exp->tape, 0),
+            nvalues * sizeof (uint64_t));
+  }
+  else
+  {
+    for (i = 0; i < nvalues; i++)
+    {
+      res            = eval_candidate (btor, exp, value_in[i], value_out[i]);
+      sig->values[i] = btor_bv_to_uint64 (res);
+      btor_bv_free (mm, res);
+    }
+  }
+  return sig;
+}
+
 static BtorBitVectorTuple *
 create_signature_exp (Btor *btor,
-                      BtorNode *exp,
+                      CandidateTape *exp,
                       BtorBitVectorTuple *value_in[],
                       BtorBitVector *value_out[],
-                      uint32_t nvalues,
-                      BtorIntHashTable *value_in_map)
+                      uint32_t nvalues)
 {
   uint32_t i;
   BtorBitVectorTuple *inputs, *sig;
@@ -684,7 +779,7 @@ create_signature_exp (Btor *btor,
   {
     inputs = value_in[i];
     output = value_out[i];
-    res    = eval_candidate (btor, exp, inputs, output, value_in_map);
+    res    = eval_candidate (btor, exp, inputs, output);
     btor_bv_add_to_tuple (mm, sig, res, i);
     btor_bv_free (mm, res);
   }
@@ -697,7 +792,7 @@ check_signature_exps (Btor *btor,
                       uint32_t nexps,
                       BtorIntHashTable *value_caches[],
                       BtorIntHashTable *cone_hash,
-                      BtorNode *exp,
+                      CandidateTape *exp,
                       BtorBitVectorTuple *value_in[],
                       BtorBitVector *value_out[],
                       uint32_t nvalues,
@@ -734,7 +829,7 @@ check_signature_exps (Btor *btor,
                        output,
                        value_in_map);
     else
-      res = eval_candidate (btor, exp, inputs, output, value_in_map);
+      res = eval_candidate (btor, exp, inputs, output);
 
     if (btor_bv_compare (res, output) == 0)
     {
@@ -752,6 +847,9 @@ check_signature_exps (Btor *btor,
   return is_equal;
 }
 
+/* Check candidate expression 'exp'. If given, 'ctape' is the compiled
+ * candidate and 'psig_exp' its packed signature (e.g., computed by a candidate
+ * batch), both are released by this function. */
 static bool
 check_candidate_exps (Btor *btor,
                       BtorNode *exps[],
@@ -769,51 +867,103 @@ check_candidate_exps (Btor *btor,
                       BtorIntHashTable *cache,
                       BtorPtrHashTable *sigs,
                       BtorPtrHashTable *sigs_exp,
+                      BtorPtrHashTable *psigs_exp,
+                      PackedValues *pvalues,
+                      CandidateTape *ctape,
+                      PackedSig *psig_exp,
                       Op *op)
 {
   bool found_candidate = false;
   int32_t id;
+  uint32_t width;
   BtorBitVectorTuple *sig = 0, *sig_exp;
-  BtorBitVector *matchbv  = 0;
+  BtorBitVector *matchbv = 0;
   BtorMemMgr *mm;
+  CandidateTape tmp_ctape;
 
   id = btor_node_get_id (exp);
   mm = btor->mm;
 
   if (btor_node_is_bv_const (exp) || btor_hashint_table_contains (cache, id))
   {
+    if (ctape) release_candidate_tape (ctape);
+    if (psig_exp) delete_packed_sig (mm, psig_exp);
     btor_node_release (btor, exp);
     return false;
   }
 
+  assert (!ctape || nexps == 0
+          || btor_node_real_addr (exp)->sort_id == target_sort);
+  assert (!psig_exp || ctape);
+
   if (nexps == 0 || btor_node_real_addr (exp)->sort_id == target_sort)
   {
+    /* compile candidate once, evaluated for all in/out values below */
+    if (!ctape)
+    {
+      init_candidate_tape (btor, &tmp_ctape, exp, value_in_map, pvalues);
+      ctape = &tmp_ctape;
+    }
+    width = btor_node_bv_get_width (btor, exp);
+
     /* check signature for candidate expression (in/out values) */
-    sig_exp = create_signature_exp (
-        btor, exp, value_in, value_out, nvalues, value_in_map);
+    if (width <= 64)
+    {
+      if (!psig_exp)
+        psig_exp = create_packed_signature_exp (
+            btor, ctape, width, value_in, value_out, nvalues);
 
-    if (btor_hashptr_table_get (sigs_exp, sig_exp))
+      if (btor_hashptr_table_get (psigs_exp, psig_exp))
+      {
+        release_candidate_tape (ctape);
+        delete_packed_sig (mm, psig_exp);
+        btor_node_release (btor, exp);
+        return false;
+      }
+      btor_hashptr_table_add (psigs_exp, psig_exp);
+    }
+    else
     {
-      btor_bv_free_tuple (mm, sig_exp);
-      btor_node_release (btor, exp);
-      return false;
+      sig_exp =
+          create_signature_exp (btor, ctape, value_in, value_out, nvalues);
+
+      if (btor_hashptr_table_get (sigs_exp, sig_exp))
+      {
+        release_candidate_tape (ctape);
+        btor_bv_free_tuple (mm, sig_exp);
+        btor_node_release (btor, exp);
+        return false;
+      }
+      btor_hashptr_table_add (sigs_exp, sig_exp);
     }
-    btor_hashptr_table_add (sigs_exp, sig_exp);
 
     /* check signature for candidate expression w.r.t. formula */
-    found_candidate = check_signature_exps (btor,
-                                            exps,
-                                            nexps,
-                                            value_caches,
-                                            cone_hash,
-                                            exp,
-                                            value_in,
-                                            value_out,
-                                            nvalues,
-                                            value_in_map,
-                                            &sig,
-                                            0,
-                                            &matchbv);
+    if (nexps == 0 && psig_exp && pvalues->out)
+    {
+      /* the signature w.r.t. the in/out values is the packed signature,
+       * which is already unique in 'psigs_exp' */
+      found_candidate = psig_exp->width == pvalues->out_width
+                        && !memcmp (psig_exp->values,
+                                    pvalues->out,
+                                    nvalues * sizeof (uint64_t));
+    }
+    else
+    {
+      found_candidate = check_signature_exps (btor,
+                                              exps,
+                                              nexps,
+                                              value_caches,
+                                              cone_hash,
+                                              ctape,
+                                              value_in,
+                                              value_out,
+                                              nvalues,
+                                              value_in_map,
+                                              &sig,
+                                              0,
+                                              &matchbv);
+    }
+    release_candidate_tape (ctape);
   }
 
   if (sig && btor_hashptr_table_get (sigs, sig))
@@ -834,6 +984,272 @@ check_candidate_exps (Btor *btor,
   return found_candidate;
 }
 
+/* Number of candidates checked per candidate batch. */
+#define BTOR_SYNTH_BATCH_SIZE 1024
+/* Minimum number of candidates evaluated per batch worker. */
+#define BTOR_SYNTH_BATCH_MIN_SHARD_SIZE 64
+
+/* Candidate of a candidate batch. If 'psig' is not 0, the packed signature of
+ * the candidate is computed by one of the batch workers and 'done' is set
+ * as soon as it is available. */
+struct BatchCandidate
+{
+  BtorNode *exp;
+  Op *op;
+  bool has_tape;
+  CandidateTape ctape;
+  PackedSig *psig;
+  bool done;
+};
+
+typedef struct BatchCandidate BatchCandidate;
+
+/* Candidates of an enumeration level are generated sequentially (node
+ * construction is not thread-safe) and collected in batches. The packed
+ * signatures of the candidates of a batch are computed by 'nshards' (at most
+ * 'nthreads') workers, where worker t processes candidates t, t + nshards,
+ * ... The candidates are then merged in the order in which they were
+ * generated, which yields the same results as checking the candidates one by
+ * one. Workers skip all candidates after the first candidate that matches the
+ * target signature. */
+struct CandidateBatch
+{
+  BatchCandidate *cands;
+  uint32_t ncands;
+  uint32_t nthreads;
+  uint32_t nshards; /* number of workers used for the current batch */
+  uint32_t nvalues;
+  uint64_t *target; /* packed target signature, 0 if not applicable */
+  uint32_t target_width;
+  uint32_t first_match;
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_t mutex;
+#endif
+};
+
+typedef struct CandidateBatch CandidateBatch;
+
+struct CandidateBatchWorker
+{
+  CandidateBatch *batch;
+  uint32_t shard;
+};
+
+typedef struct CandidateBatchWorker CandidateBatchWorker;
+
+static void
+init_candidate_batch (BtorMemMgr *mm,
+                      CandidateBatch *batch,
+                      uint32_t nthreads,
+                      uint32_t nvalues)
+{
+  assert (mm);
+  assert (batch);
+
+  memset (batch, 0, sizeof (CandidateBatch));
+  batch->nthreads = nthreads;
+  batch->nvalues  = nvalues;
+  if (nthreads > 1)
+  {
+    BTOR_CNEWN (mm, batch->cands, BTOR_SYNTH_BATCH_SIZE);
+#ifdef BTOR_HAVE_PTHREADS
+    pthread_mutex_init (&batch->mutex, 0);
+#endif
+  }
+}
+
+/* Release all candidates of 'batch' that have not been merged yet. */
+static void
+release_candidate_batch (Btor *btor, CandidateBatch *batch)
+{
+  assert (btor);
+  assert (batch);
+
+  uint32_t i;
+  BatchCandidate *bc;
+
+  if (!batch->cands) return;
+
+  for (i = 0; i < batch->ncands; i++)
+  {
+    bc = batch->cands + i;
+    if (!bc->exp) continue;
+    if (bc->has_tape) release_candidate_tape (&bc->ctape);
+    if (bc->psig) delete_packed_sig (btor->mm, bc->psig);
+    btor_node_release (btor, bc->exp);
+  }
+  BTOR_DELETEN (btor->mm, batch->cands, BTOR_SYNTH_BATCH_SIZE);
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_destroy (&batch->mutex);
+#endif
+}
+
+static void
+push_candidate_batch (CandidateBatch *batch, BtorNode *exp, Op *op)
+{
+  assert (batch);
+  assert (batch->ncands < BTOR_SYNTH_BATCH_SIZE);
+
+  BatchCandidate *bc;
+
+  bc = batch->cands + batch->ncands++;
+  memset (bc, 0, sizeof (BatchCandidate));
+  bc->exp = exp;
+  bc->op  = op;
+}
+
+static bool
+is_full_candidate_batch (CandidateBatch *batch)
+{
+  assert (batch);
+  return batch->ncands == BTOR_SYNTH_BATCH_SIZE;
+}
+
+static uint32_t
+get_first_match_candidate_batch (CandidateBatch *batch)
+{
+  uint32_t res;
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_lock (&batch->mutex);
+#endif
+  res = batch->first_match;
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_unlock (&batch->mutex);
+#endif
+  return res;
+}
+
+static void
+set_first_match_candidate_batch (CandidateBatch *batch, uint32_t idx)
+{
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_lock (&batch->mutex);
+#endif
+  if (idx < batch->first_match) batch->first_match = idx;
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_unlock (&batch->mutex);
+#endif
+}
+
+/* Compute the packed signatures of the candidates in the shard of 'state'.
+ * Does not allocate memory and does not modify 'btor', the tapes and
+ * signatures are prepared by the main thread. */
+static void *
+eval_candidate_batch_shard (void *state)
+{
+  uint32_t i;
+  BatchCandidate *bc;
+  CandidateBatch *batch;
+  CandidateBatchWorker *worker;
+
+  worker = state;
+  batch  = worker->batch;
+
+  for (i = worker->shard; i < batch->ncands; i += batch->nshards)
+  {
+    bc = batch->cands + i;
+    if (!bc->psig) continue;
+    /* early termination, a previous candidate matches */
+    if (i > get_first_match_candidate_batch (batch)) break;
+
+    btor_evaltape_run_packed (bc->ctape.tape, batch->nvalues);
+    memcpy (bc->psig->values,
+            btor_evaltape_get_result_packed (bc->ctape.tape, 0),
+            batch->nvalues * sizeof (uint64_t));
+    bc->done = true;
+
+    if (batch->target && bc->psig->width == batch->target_width
+        && !memcmp (bc->psig->values,
+                    batch->target,
+                    batch->nvalues * sizeof (uint64_t)))
+      set_first_match_candidate_batch (batch, i);
+  }
+  return 0;
+}
+
+/* Compile the candidates of 'batch' that are not yet known to be redundant
+ * and compute their packed signatures concurrently. */
+static void
+eval_candidate_batch (Btor *btor,
+                      CandidateBatch *batch,
+                      uint32_t nexps,
+                      BtorSortId target_sort,
+                      BtorIntHashTable *value_in_map,
+                      BtorIntHashTable *cache,
+                      PackedValues *pvalues)
+{
+  assert (btor);
+  assert (batch);
+  assert (batch->nthreads > 1);
+  assert (batch->ncands > 0);
+
+  uint32_t i, width, nthreads;
+  BtorNode *exp;
+  BatchCandidate *bc;
+  CandidateBatchWorker *workers;
+  BtorMemMgr *mm;
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_t *threads;
+#endif
+
+  mm = btor->mm;
+
+  for (i = 0; i < batch->ncands; i++)
+  {
+    bc  = batch->cands + i;
+    exp = bc->exp;
+    if (btor_node_is_bv_const (exp)
+        || btor_hashint_table_contains (cache, btor_node_get_id (exp)))
+      continue;
+    if (nexps > 0 && btor_node_real_addr (exp)->sort_id != target_sort)
+      continue;
+    width = btor_node_bv_get_width (btor, exp);
+    if (width > 64) continue;
+
+    init_candidate_tape (btor, &bc->ctape, exp, value_in_map, pvalues);
+    bc->has_tape = true;
+    if (!bc->ctape.packed) continue;
+    btor_evaltape_prepare_packed (bc->ctape.tape, batch->nvalues);
+    bc->psig = new_packed_sig (mm, width, batch->nvalues);
+  }
+
+  batch->target       = nexps == 0 ? pvalues->out : 0;
+  batch->target_width = pvalues->out_width;
+  batch->first_match  = UINT32_MAX;
+
+  /* do not start threads for small batches */
+  nthreads = (batch->ncands + BTOR_SYNTH_BATCH_MIN_SHARD_SIZE - 1)
+             / BTOR_SYNTH_BATCH_MIN_SHARD_SIZE;
+  if (nthreads > batch->nthreads) nthreads = batch->nthreads;
+  batch->nshards = nthreads;
+  BTOR_NEWN (mm, workers, nthreads);
+  for (i = 0; i < nthreads; i++)
+  {
+    workers[i].batch = batch;
+    workers[i].shard = i;
+  }
+#ifdef BTOR_HAVE_PTHREADS
+  BTOR_NEWN (mm, threads, nthreads);
+  for (i = 1; i < nthreads; i++)
+    pthread_create (&threads[i], 0, eval_candidate_batch_shard, &workers[i]);
+  eval_candidate_batch_shard (&workers[0]);
+  for (i = 1; i < nthreads; i++) pthread_join (threads[i], 0);
+  BTOR_DELETEN (mm, threads, nthreads);
+#else
+  for (i = 0; i < nthreads; i++) eval_candidate_batch_shard (&workers[i]);
+#endif
+  BTOR_DELETEN (mm, workers, nthreads);
+
+  /* signatures skipped due to early termination are computed on demand */
+  for (i = 0; i < batch->ncands; i++)
+  {
+    bc = batch->cands + i;
+    if (!bc->psig || bc->done) continue;
+    delete_packed_sig (mm, bc->psig);
+    bc->psig = 0;
+  }
+}
+
 static inline void
 report_stats (Btor *btor,
               double start,
@@ -865,7 +1281,7 @@ report_op_stats (Btor *btor, Op ops[], uint32_t nops)
     BTOR_MSG (btor->msg, 1, "%s: %u", ops[i].name, ops[i].num_added);
 }
 
-#define CHECK_CANDIDATE(exp)                                              \
+#define CHECK_CANDIDATE_EXP(exp, ctape, psig, op)                        \
   {                                                                       \
     found_candidate = check_candidate_exps (btor,                         \
                                             trav_cone.start,              \
@@ -883,7 +1299,11 @@ report_op_stats (Btor *btor, Op ops[], uint32_t nops)
                                             cache,                        \
                                             sigs,                         \
                                             sigs_exp,                     \
-                                            &ops[i]);                     \
+                                            psigs_exp,                    \
+                                            &pvalues,                     \
+                                            ctape,                        \
+                                            psig,                         \
+                                            op);                          \
     num_checks++;                                                         \
     if (num_checks % 10000 == 0)                                          \
       report_stats (btor, start, cur_level, num_checks, &candidates);     \
@@ -895,6 +1315,39 @@ report_op_stats (Btor *btor, Op ops[], uint32_t nops)
     if (found_candidate || num_checks >= max_checks) goto DONE;           \
   }
 
+/* Evaluate the candidates of the current batch and check them in the order
+ * in which they were generated. */
+#define FLUSH_CANDIDATE_BATCH                                            \
+  {                                                                      \
+    eval_candidate_batch (btor,                                          \
+                          &batch,                                        \
+                          BTOR_COUNT_STACK (trav_cone),                  \
+                          target_sort,                                   \
+                          value_in_map,                                  \
+                          cache,                                         \
+                          &pvalues);                                     \
+    for (b = 0; b < batch.ncands; b++)                                   \
+    {                                                                    \
+      bc      = batch.cands + b;                                         \
+      exp     = bc->exp;                                                 \
+      bc->exp = 0;                                                       \
+      CHECK_CANDIDATE_EXP (                                              \
+          exp, bc->has_tape ? &bc->ctape : 0, bc->psig, bc->op);         \
+    }                                                                    \
+    batch.ncands = 0;                                                    \
+  }
+
+#define CHECK_CANDIDATE(exp)                                       \
+  {                                                                \
+    if (batch.nthreads > 1)                                        \
+    {                                                              \
+      push_candidate_batch (&batch, exp, &ops[i]);                 \
+      if (is_full_candidate_batch (&batch)) FLUSH_CANDIDATE_BATCH; \
+    }                                                              \
+    else                                                           \
+      CHECK_CANDIDATE_EXP (exp, 0, 0, &ops[i]);                    \
+  }
+
 static BtorNode *
 synthesize (Btor *btor,
             BtorNode *inputs[],
@@ -925,12 +1378,12 @@ synthesize (Btor *btor,
 
   double start;
   bool found_candidate = false, equal;
-  uint32_t i, j, k, *tuple, cur_level = 1, num_checks = 0, num_added;
+  uint32_t i, j, k, b, *tuple, cur_level = 1, num_checks = 0, num_added;
   BtorNode *exp, **exp_tuple, *result = 0;
   BtorNodePtrStack *exps, trav_exps, trav_cone;
   Candidates candidates;
   BtorIntHashTable *cache, *e0_exps, *e1_exps, *e2_exps;
-  BtorPtrHashTable *sigs, *sigs_exp;
+  BtorPtrHashTable *sigs, *sigs_exp, *psigs_exp;
   BtorHashTableData *d;
   BtorMemMgr *mm;
   BtorPartitionGenerator pg;
@@ -941,6 +1394,9 @@ synthesize (Btor *btor,
   BtorBitVector *bv, **tmp_value_out;
   BtorIntHashTable *value_cache, *cone_hash;
   BtorIntHashTablePtrStack value_caches;
+  PackedValues pvalues;
+  CandidateBatch batch;
+  BatchCandidate *bc;
 
   start     = btor_util_time_stamp ();
   mm        = btor->mm;
@@ -951,6 +1407,8 @@ synthesize (Btor *btor,
       mm, (BtorHashPtr) btor_bv_hash_tuple, (BtorCmpPtr) btor_bv_compare_tuple);
   sigs_exp = btor_hashptr_table_new (
       mm, (BtorHashPtr) btor_bv_hash_tuple, (BtorCmpPtr) btor_bv_compare_tuple);
+  psigs_exp = btor_hashptr_table_new (
+      mm, (BtorHashPtr) hash_packed_sig, (BtorCmpPtr) compare_packed_sig);
 
   BTOR_INIT_STACK (mm, sig_constraints);
   BTOR_INIT_STACK (mm, trav_exps);
@@ -1001,6 +1459,11 @@ synthesize (Btor *btor,
     assert (nvalues == BTOR_COUNT_STACK (value_caches));
   }
 
+  /* pack in/out values of at most 64 bits for packed signature evaluation */
+  init_packed_values (mm, &pvalues, value_in, value_out, nvalues);
+  init_candidate_batch (
+      mm, &batch, btor_opt_get (btor, BTOR_OPT_QUANT_SYNTH_N_THREADS), nvalues);
+
   if (prev_synth)
   {
     exp             = btor_node_copy (btor, prev_synth);
@@ -1020,6 +1483,10 @@ synthesize (Btor *btor,
                                             cache,
                                             sigs,
                                             sigs_exp,
+                                            psigs_exp,
+                                            &pvalues,
+                                            0,
+                                            0,
                                             0);
     num_checks++;
     if (num_checks % 10000 == 0)
@@ -1051,6 +1518,10 @@ synthesize (Btor *btor,
                                             cache,
                                             sigs,
                                             sigs_exp,
+                                            psigs_exp,
+                                            &pvalues,
+                                            0,
+                                            0,
                                             0);
     num_checks++;
     if (num_checks % 10000 == 0)
@@ -1166,6 +1637,7 @@ synthesize (Btor *btor,
         }
       }
     }
+    if (batch.ncands > 0) FLUSH_CANDIDATE_BATCH;
     report_op_stats (btor, ops, nops);
     /* no more expressions generated */
     if (num_added == candidates.nexps) break;
@@ -1203,6 +1675,8 @@ DONE:
     BTOR_MSG (btor->msg, 1, "no candidate found");
 
   /* cleanup */
+  release_candidate_batch (btor, &batch);
+
   for (i = 1; i < BTOR_COUNT_STACK (candidates.exps); i++)
   {
     e0_exps = BTOR_PEEK_STACK (candidates.exps, i);
@@ -1241,8 +1715,14 @@ DONE:
   while (btor_iter_hashptr_has_next (&it))
     btor_bv_free_tuple (mm, btor_iter_hashptr_next (&it));
 
+  btor_iter_hashptr_init (&it, psigs_exp);
+  while (btor_iter_hashptr_has_next (&it))
+    delete_packed_sig (mm, btor_iter_hashptr_next (&it));
+  release_packed_values (mm, &pvalues);
+
   btor_hashptr_table_delete (sigs);
   btor_hashptr_table_delete (sigs_exp);
+  btor_hashptr_table_delete (psigs_exp);
   btor_hashint_table_delete (cache);
   btor_hashint_table_delete (cone_hash);
   BTOR_RELEASE_STACK (trav_exps);
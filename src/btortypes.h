@@ -121,6 +121,8 @@ enum BtorOption
         `Aiger ascii format <http://fmv.jku.at/papers/BiereHeljankoWieringa-FMV-TR-11-2.pdf>`_
       * BTOR_OUTPUT_FORMAT_AIGER_BINARY:
         `Aiger binary format <http://fmv.jku.at/papers/BiereHeljankoWieringa-FMV-TR-11-2.pdf>`_
+      * BTOR_OUTPUT_FORMAT_BTOR_BINARY:
+        compact binary BTOR format
   */
   BTOR_OPT_OUTPUT_FORMAT,
 
@@ -404,6 +406,10 @@ enum BtorOption
         another conflict is found
       * BTOR_FUN_EAGER_LEMMAS_ALL:
         in each refinement iteration, generate lemmas for all conflicts
+      * BTOR_FUN_EAGER_LEMMAS_BATCH:
+        in each refinement iteration, check all applies (ordered by function)
+        in one pass and generate lemmas for all conflicts, up to a bounded
+        number of lemmas per iteration
   */
   BTOR_OPT_FUN_EAGER_LEMMAS,
 
@@ -855,6 +861,16 @@ enum BtorOption
   BTOR_OPT_QUANT_FIXSYNTH,
   BTOR_OPT_RW_ZERO_LOWER_SLICE,
   BTOR_OPT_NONDESTR_SUBST,
+  BTOR_OPT_FUN_LEMMA_BATCH_SIZE,
+  BTOR_OPT_QUANT_SYNTH_N_THREADS,
+  BTOR_OPT_QUANT_N_WORKERS,
+  BTOR_OPT_SAT_PREPROCESS,
+  BTOR_OPT_SAT_SHARE_SIZE,
+  BTOR_OPT_SAT_SHARE_LBD,
+  BTOR_OPT_AIG_GC,
+  BTOR_OPT_BUDGET_TIME,
+  BTOR_OPT_BUDGET_MEM,
+  BTOR_OPT_PROFILE,
   /* this MUST be the last entry! */
   BTOR_OPT_NUM_OPTS,
 };
@@ -916,6 +932,7 @@ enum BtorOptOutputFormat
   BTOR_OUTPUT_FORMAT_SMT2,
   BTOR_OUTPUT_FORMAT_AIGER_ASCII,
   BTOR_OUTPUT_FORMAT_AIGER_BINARY,
+  BTOR_OUTPUT_FORMAT_BTOR_BINARY,
 };
 typedef enum BtorOptOutputFormat BtorOptOutputFormat;
 
@@ -968,6 +985,7 @@ enum BtorOptFunEagerLemmas
   BTOR_FUN_EAGER_LEMMAS_NONE,
   BTOR_FUN_EAGER_LEMMAS_CONF,
   BTOR_FUN_EAGER_LEMMAS_ALL,
+  BTOR_FUN_EAGER_LEMMAS_BATCH,
 };
 typedef enum BtorOptFunEagerLemmas BtorOptFunEagerLemmas;
 
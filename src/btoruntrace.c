@@ -1992,6 +1992,25 @@ NEXT:
       PARSE_ARGS1 (tok, int);
       boolector_dump_aiger_binary (btor, stdout, arg1_int);
     }
+    else if (!strcmp (tok, "dump_btor_binary"))
+    {
+      PARSE_ARGS0 (tok);
+      boolector_dump_btor_binary (btor, stdout);
+    }
+    else if (!strcmp (tok, "snapshot_write"))
+    {
+      PARSE_ARGS0 (tok);
+      outfile = tmpfile ();
+      assert (outfile);
+      ret_bool = boolector_snapshot_write (btor, outfile);
+      exp_ret  = RET_BOOL;
+      fclose (outfile);
+    }
+    else if (!strcmp (tok, "snapshot_read"))
+    {
+      /* the snapshot is not part of the trace */
+      btorunt_parse_error ("'%s' cannot be replayed", tok);
+    }
     else
     {
       btorunt_parse_error ("invalid command '%s'", tok);
@@ -139,6 +139,7 @@ btor_dumpaig_dump (Btor *btor, bool is_binary, FILE *output, bool merge_roots)
 {
   BtorPtrHashTableIterator it;
   BtorNodePtrStack nodes;
+  BtorNode *cur;
 
   const char *fmt_header = "%s AIG dump\nBoolector version %s\n";
   int comment_section_started = 0;
@@ -148,7 +149,10 @@ btor_dumpaig_dump (Btor *btor, bool is_binary, FILE *output, bool merge_roots)
   btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
   while (btor_iter_hashptr_has_next (&it))
   {
-    BTOR_PUSH_STACK (nodes, btor_iter_hashptr_next (&it));
+    cur = btor_iter_hashptr_next (&it);
+    /* assertions of (popped) push/pop contexts are not dumped */
+    if (btor_node_real_addr (cur)->activation_below) continue;
+    BTOR_PUSH_STACK (nodes, cur);
   }
 
   if (BTOR_EMPTY_STACK(nodes))
@@ -0,0 +1,418 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "dumper/btordumpbin.h"
+
+#include "btorbv.h"
+#include "btorcore.h"
+#include "btornode.h"
+#include "btorsort.h"
+#include "utils/btorhashptr.h"
+#include "utils/btornodeiter.h"
+#include "utils/btorstack.h"
+
+#include <string.h>
+
+/*------------------------------------------------------------------------*/
+
+typedef struct BtorDumpBinContext BtorDumpBinContext;
+
+struct BtorDumpBinContext
+{
+  Btor *btor;
+  BtorCharStack buf;
+  BtorCharStack sorts;
+  uint32_t *sort_idx; /* sort id -> index + 1 */
+  uint32_t nsorts;
+  uint32_t *node_idx; /* node id -> index + 1 */
+  BtorNodePtrStack nodes;
+};
+
+static void
+put_varint (BtorCharStack *buf, uint64_t val)
+{
+  while (val >= 0x80)
+  {
+    BTOR_PUSH_STACK (*buf, (char) (val | 0x80));
+    val >>= 7;
+  }
+  BTOR_PUSH_STACK (*buf, (char) val);
+}
+
+static void
+put_symbol (BtorDumpBinContext *bdc, const char *symbol)
+{
+  const char *c;
+
+  put_varint (&bdc->buf, strlen (symbol));
+  for (c = symbol; *c; c++) BTOR_PUSH_STACK (bdc->buf, *c);
+}
+
+static void
+put_const (BtorDumpBinContext *bdc, const BtorBitVector *bits)
+{
+  uint32_t i, j, width;
+  uint64_t val;
+  char byte;
+
+  width = btor_bv_get_width (bits);
+  put_varint (&bdc->buf, width);
+  if (width <= 64)
+  {
+    val = btor_bv_to_uint64 (bits);
+    for (i = 0; i < width; i += 8, val >>= 8)
+      BTOR_PUSH_STACK (bdc->buf, (char) val);
+    return;
+  }
+  for (i = 0; i < width; i += 8)
+  {
+    byte = 0;
+    for (j = i; j < width && j < i + 8; j++)
+      byte |= btor_bv_get_bit (bits, j) << (j - i);
+    BTOR_PUSH_STACK (bdc->buf, byte);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+static uint32_t
+add_sort (BtorDumpBinContext *bdc, BtorSortId sort_id)
+{
+  uint32_t i;
+  BtorSort *sort, *domain;
+  BtorSortId index, element;
+
+  if (bdc->sort_idx[sort_id]) return bdc->sort_idx[sort_id] - 1;
+
+  sort = btor_sort_get_by_id (bdc->btor, sort_id);
+  if (sort->kind == BTOR_BV_SORT)
+  {
+    BTOR_PUSH_STACK (bdc->sorts, BTOR_DUMPBIN_SORT_BV);
+    put_varint (&bdc->sorts, sort->bitvec.width);
+  }
+  else if (btor_sort_is_array (bdc->btor, sort_id))
+  {
+    index   = btor_sort_array_get_index (bdc->btor, sort_id);
+    element = btor_sort_array_get_element (bdc->btor, sort_id);
+    index   = add_sort (bdc, index);
+    element = add_sort (bdc, element);
+    BTOR_PUSH_STACK (bdc->sorts, BTOR_DUMPBIN_SORT_ARRAY);
+    put_varint (&bdc->sorts, index);
+    put_varint (&bdc->sorts, element);
+  }
+  else
+  {
+    assert (sort->kind == BTOR_FUN_SORT);
+    domain = sort->fun.domain;
+    for (i = 0; i < domain->tuple.num_elements; i++)
+      add_sort (bdc, domain->tuple.elements[i]->id);
+    add_sort (bdc, sort->fun.codomain->id);
+    BTOR_PUSH_STACK (bdc->sorts, BTOR_DUMPBIN_SORT_FUN);
+    put_varint (&bdc->sorts, domain->tuple.num_elements);
+    for (i = 0; i < domain->tuple.num_elements; i++)
+      put_varint (&bdc->sorts,
+                  bdc->sort_idx[domain->tuple.elements[i]->id] - 1);
+    put_varint (&bdc->sorts, bdc->sort_idx[sort->fun.codomain->id] - 1);
+  }
+  bdc->sort_idx[sort_id] = ++bdc->nsorts;
+  return bdc->nsorts - 1;
+}
+
+/* Returns true if 'lambda' is a write-lambda as created by
+ * btor_exp_lambda_write, i.e., of the form
+ * 'lambda p . p = index ? value : array[p]'. */
+static bool
+is_lambda_write (Btor *btor,
+                 BtorNode *lambda,
+                 BtorNode **array,
+                 BtorNode **index,
+                 BtorNode **value)
+{
+  BtorNode *body, *read, *args;
+  BtorPtrHashTable *rho;
+
+  rho = btor_node_lambda_get_static_rho (lambda);
+  if (!lambda->is_array || !rho || rho->count != 1) return false;
+
+  body = btor_node_get_simplified (btor, lambda->e[1]);
+  if (!btor_node_is_regular (body) || !btor_node_is_cond (body)) return false;
+
+  read = btor_node_get_simplified (btor, body->e[2]);
+  if (!btor_node_is_regular (read) || !btor_node_is_apply (read)) return false;
+
+  args = btor_node_get_simplified (btor, read->e[1]);
+  if (args->arity != 1
+      || btor_node_get_simplified (btor, args->e[0]) != lambda->e[0])
+    return false;
+
+  *value = btor_node_get_simplified (btor, rho->first->data.as_ptr);
+  if (btor_node_get_simplified (btor, body->e[1]) != *value) return false;
+
+  args   = rho->first->key;
+  *index = btor_node_get_simplified (btor, args->e[0]);
+  *array = btor_node_get_simplified (btor, read->e[0]);
+  return btor_node_is_array (*array);
+}
+
+/* Returns true if 'lambda' is a constant array. */
+static bool
+is_const_array (Btor *btor, BtorNode *lambda)
+{
+  BtorNode *body;
+
+  body = btor_node_get_simplified (btor, lambda->e[1]);
+  return lambda->is_array && !btor_node_lambda_get_static_rho (lambda)
+         && !btor_node_real_addr (body)->parameterized;
+}
+
+/* Collect operands of 'exp' as dumped, i.e., arguments of applies are
+ * flattened. */
+static void
+get_operands (BtorDumpBinContext *bdc, BtorNode *exp, BtorNodePtrStack *ops)
+{
+  uint32_t i;
+  BtorNode *args, *array, *index, *value;
+  BtorArgsIterator it;
+  Btor *btor;
+
+  btor = bdc->btor;
+  BTOR_RESET_STACK (*ops);
+  if (btor_node_is_apply (exp))
+  {
+    BTOR_PUSH_STACK (*ops, btor_node_get_simplified (btor, exp->e[0]));
+    btor_iter_args_init (&it, btor_node_get_simplified (btor, exp->e[1]));
+    while (btor_iter_args_has_next (&it))
+      BTOR_PUSH_STACK (
+          *ops, btor_node_get_simplified (btor, btor_iter_args_next (&it)));
+  }
+  else if (btor_node_is_lambda (exp)
+           && is_lambda_write (btor, exp, &array, &index, &value))
+  {
+    BTOR_PUSH_STACK (*ops, array);
+    BTOR_PUSH_STACK (*ops, index);
+    BTOR_PUSH_STACK (*ops, value);
+  }
+  else if (btor_node_is_lambda (exp) && is_const_array (btor, exp))
+    BTOR_PUSH_STACK (*ops, btor_node_get_simplified (btor, exp->e[1]));
+  else if (btor_node_is_update (exp))
+  {
+    args = btor_node_get_simplified (btor, exp->e[1]);
+    assert (args->arity == 1);
+    BTOR_PUSH_STACK (*ops, btor_node_get_simplified (btor, exp->e[0]));
+    BTOR_PUSH_STACK (*ops, btor_node_get_simplified (btor, args->e[0]));
+    BTOR_PUSH_STACK (*ops, btor_node_get_simplified (btor, exp->e[2]));
+  }
+  else
+  {
+    for (i = 0; i < exp->arity; i++)
+      BTOR_PUSH_STACK (*ops, btor_node_get_simplified (btor, exp->e[i]));
+  }
+}
+
+/* Collect cone of 'root' in post-order. */
+static void
+collect_nodes (BtorDumpBinContext *bdc, BtorNode *root)
+{
+  size_t i;
+  BtorNode *cur;
+  BtorNodePtrStack visit, ops;
+  BtorMemMgr *mm;
+
+  mm = bdc->btor->mm;
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_INIT_STACK (mm, ops);
+  BTOR_PUSH_STACK (visit, btor_node_real_addr (root));
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = BTOR_POP_STACK (visit);
+    assert (btor_node_is_regular (cur));
+    assert (!btor_node_is_proxy (cur));
+    assert (!btor_node_is_args (cur));
+
+    if (!bdc->node_idx[cur->id])
+    {
+      bdc->node_idx[cur->id] = UINT32_MAX;
+      BTOR_PUSH_STACK (visit, cur);
+      get_operands (bdc, cur, &ops);
+      for (i = BTOR_COUNT_STACK (ops); i > 0; i--)
+        BTOR_PUSH_STACK (visit, btor_node_real_addr (ops.start[i - 1]));
+    }
+    else if (bdc->node_idx[cur->id] == UINT32_MAX)
+    {
+      BTOR_PUSH_STACK (bdc->nodes, cur);
+      bdc->node_idx[cur->id] = BTOR_COUNT_STACK (bdc->nodes);
+    }
+  }
+  BTOR_RELEASE_STACK (ops);
+  BTOR_RELEASE_STACK (visit);
+}
+
+static void
+put_ref (BtorDumpBinContext *bdc, uint32_t idx, BtorNode *exp)
+{
+  uint32_t ref_idx;
+
+  ref_idx = bdc->node_idx[btor_node_real_addr (exp)->id] - 1;
+  assert (ref_idx < idx);
+  put_varint (&bdc->buf,
+              (uint64_t) (idx - ref_idx) << 1 | btor_node_is_inverted (exp));
+}
+
+static uint8_t
+get_op (BtorDumpBinContext *bdc, BtorNode *exp)
+{
+  BtorNode *array, *index, *value;
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_CONST_NODE: return BTOR_DUMPBIN_CONST;
+    case BTOR_VAR_NODE: return BTOR_DUMPBIN_VAR;
+    case BTOR_PARAM_NODE: return BTOR_DUMPBIN_PARAM;
+    case BTOR_UF_NODE:
+      return btor_node_is_uf_array (exp) ? BTOR_DUMPBIN_ARRAY : BTOR_DUMPBIN_UF;
+    case BTOR_BV_SLICE_NODE: return BTOR_DUMPBIN_SLICE;
+    case BTOR_BV_AND_NODE: return BTOR_DUMPBIN_AND;
+    case BTOR_BV_EQ_NODE:
+    case BTOR_FUN_EQ_NODE: return BTOR_DUMPBIN_EQ;
+    case BTOR_BV_ADD_NODE: return BTOR_DUMPBIN_ADD;
+    case BTOR_BV_MUL_NODE: return BTOR_DUMPBIN_MUL;
+    case BTOR_BV_ULT_NODE: return BTOR_DUMPBIN_ULT;
+    case BTOR_BV_SLL_NODE: return BTOR_DUMPBIN_SLL;
+    case BTOR_BV_SRL_NODE: return BTOR_DUMPBIN_SRL;
+    case BTOR_BV_UDIV_NODE: return BTOR_DUMPBIN_UDIV;
+    case BTOR_BV_UREM_NODE: return BTOR_DUMPBIN_UREM;
+    case BTOR_BV_CONCAT_NODE: return BTOR_DUMPBIN_CONCAT;
+    case BTOR_COND_NODE: return BTOR_DUMPBIN_COND;
+    case BTOR_APPLY_NODE: return BTOR_DUMPBIN_APPLY;
+    case BTOR_LAMBDA_NODE:
+      if (is_lambda_write (bdc->btor, exp, &array, &index, &value))
+        return BTOR_DUMPBIN_WRITE;
+      if (is_const_array (bdc->btor, exp)) return BTOR_DUMPBIN_CONST_ARRAY;
+      return BTOR_DUMPBIN_LAMBDA;
+    case BTOR_FORALL_NODE: return BTOR_DUMPBIN_FORALL;
+    case BTOR_EXISTS_NODE: return BTOR_DUMPBIN_EXISTS;
+    default: assert (exp->kind == BTOR_UPDATE_NODE); return BTOR_DUMPBIN_WRITE;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+void
+btor_dumpbin_dump (Btor *btor, FILE *file)
+{
+  assert (btor);
+  assert (file);
+
+  uint32_t i, j, nnodes;
+  uint8_t op;
+  char *symbol;
+  BtorNode *cur;
+  BtorNodePtrStack roots, ops;
+  BtorCharStack header;
+  BtorDumpBinContext bdc;
+  BtorPtrHashTableIterator it;
+  BtorMemMgr *mm;
+
+  mm = btor->mm;
+  BTOR_CLR (&bdc);
+  bdc.btor = btor;
+  BTOR_INIT_STACK (mm, bdc.buf);
+  BTOR_INIT_STACK (mm, bdc.sorts);
+  BTOR_INIT_STACK (mm, bdc.nodes);
+  BTOR_INIT_STACK (mm, roots);
+  BTOR_INIT_STACK (mm, ops);
+  BTOR_CNEWN (mm, bdc.node_idx, BTOR_COUNT_STACK (btor->nodes_id_table));
+  BTOR_CNEWN (
+      mm, bdc.sort_idx, BTOR_COUNT_STACK (btor->sorts_unique_table.id2sort));
+
+  if (btor->inconsistent)
+    BTOR_PUSH_STACK (roots, btor_node_invert (btor->true_exp));
+  else
+  {
+    btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+    btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+    btor_iter_hashptr_queue (&it, btor->embedded_constraints);
+    while (btor_iter_hashptr_has_next (&it))
+    {
+      cur = btor_node_get_simplified (btor, btor_iter_hashptr_next (&it));
+      /* assertions of (popped) push/pop contexts are not dumped */
+      if (btor_node_real_addr (cur)->activation_below) continue;
+      BTOR_PUSH_STACK (roots, cur);
+    }
+  }
+  for (i = 0; i < BTOR_COUNT_STACK (roots); i++)
+    collect_nodes (&bdc, BTOR_PEEK_STACK (roots, i));
+
+  /* nodes */
+  nnodes = BTOR_COUNT_STACK (bdc.nodes);
+  put_varint (&bdc.buf, nnodes);
+  for (i = 0; i < nnodes; i++)
+  {
+    cur    = BTOR_PEEK_STACK (bdc.nodes, i);
+    op     = get_op (&bdc, cur);
+    symbol = 0;
+    if (op == BTOR_DUMPBIN_VAR || op == BTOR_DUMPBIN_PARAM
+        || op == BTOR_DUMPBIN_ARRAY || op == BTOR_DUMPBIN_UF)
+    {
+      symbol = btor_node_get_symbol (btor, cur);
+      BTOR_PUSH_STACK (bdc.buf, op | (symbol ? BTOR_DUMPBIN_FLAG_SYMBOL : 0));
+      put_varint (&bdc.buf, add_sort (&bdc, btor_node_get_sort_id (cur)));
+      if (symbol) put_symbol (&bdc, symbol);
+      continue;
+    }
+
+    BTOR_PUSH_STACK (bdc.buf, op);
+    if (op == BTOR_DUMPBIN_CONST)
+    {
+      put_const (&bdc, btor_node_bv_const_get_bits (cur));
+      continue;
+    }
+
+    get_operands (&bdc, cur, &ops);
+    j = 0;
+    if (op == BTOR_DUMPBIN_CONST_ARRAY)
+      put_varint (&bdc.buf, add_sort (&bdc, btor_node_get_sort_id (cur)));
+    else if (op == BTOR_DUMPBIN_APPLY)
+    {
+      put_ref (&bdc, i, BTOR_PEEK_STACK (ops, 0));
+      put_varint (&bdc.buf, BTOR_COUNT_STACK (ops) - 1);
+      j = 1;
+    }
+    for (; j < BTOR_COUNT_STACK (ops); j++)
+      put_ref (&bdc, i, BTOR_PEEK_STACK (ops, j));
+    if (op == BTOR_DUMPBIN_SLICE)
+    {
+      put_varint (&bdc.buf, btor_node_bv_slice_get_upper (cur));
+      put_varint (&bdc.buf, btor_node_bv_slice_get_lower (cur));
+    }
+  }
+
+  /* roots */
+  put_varint (&bdc.buf, BTOR_COUNT_STACK (roots));
+  for (i = 0; i < BTOR_COUNT_STACK (roots); i++)
+    put_ref (&bdc, nnodes, BTOR_PEEK_STACK (roots, i));
+
+  /* header and sort table (collected while dumping nodes) */
+  fputs (BTOR_DUMPBIN_MAGIC, file);
+  BTOR_INIT_STACK (mm, header);
+  put_varint (&header, BTOR_DUMPBIN_VERSION);
+  put_varint (&header, bdc.nsorts);
+  fwrite (header.start, 1, BTOR_COUNT_STACK (header), file);
+  fwrite (bdc.sorts.start, 1, BTOR_COUNT_STACK (bdc.sorts), file);
+  fwrite (bdc.buf.start, 1, BTOR_COUNT_STACK (bdc.buf), file);
+
+  BTOR_DELETEN (
+      mm, bdc.sort_idx, BTOR_COUNT_STACK (btor->sorts_unique_table.id2sort));
+  BTOR_DELETEN (mm, bdc.node_idx, BTOR_COUNT_STACK (btor->nodes_id_table));
+  BTOR_RELEASE_STACK (header);
+  BTOR_RELEASE_STACK (ops);
+  BTOR_RELEASE_STACK (roots);
+  BTOR_RELEASE_STACK (bdc.nodes);
+  BTOR_RELEASE_STACK (bdc.sorts);
+  BTOR_RELEASE_STACK (bdc.buf);
+}
@@ -0,0 +1,83 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+#ifndef BTORDUMPBIN_H_INCLUDED
+#define BTORDUMPBIN_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "btortypes.h"
+
+/* Compact binary format for formulas (read by the BTOR binary parser).
+ *
+ *   magic     "\177BTB"
+ *   version   BTOR_DUMPBIN_VERSION
+ *   sorts     #sorts, followed by each sort as
+ *               BTOR_DUMPBIN_SORT_BV     width
+ *               BTOR_DUMPBIN_SORT_ARRAY  index sort, element sort
+ *               BTOR_DUMPBIN_SORT_FUN    arity, domain sorts, codomain sort
+ *   nodes     #nodes, followed by each node as an opcode byte (or'ed with
+ *             BTOR_DUMPBIN_FLAG_SYMBOL if a symbol follows) and its operands
+ *               CONST        width, ceil(width / 8) bytes starting at the LSB
+ *               VAR, PARAM   sort
+ *               ARRAY, UF    sort
+ *               SLICE        node, upper, lower
+ *               APPLY        function, #arguments, arguments
+ *               CONST_ARRAY  sort, value
+ *               otherwise    children
+ *             and the symbol as length followed by its characters
+ *   roots     #roots, root nodes
+ *
+ * All numbers are unsigned LEB128 varints. Nodes are given in topological
+ * order and referenced relative to the referring node as
+ * '(index - child index) << 1 | inverted' (roots relative to #nodes), sorts
+ * by their index in the sort table. */
+
+#define BTOR_DUMPBIN_MAGIC "\177BTB"
+#define BTOR_DUMPBIN_VERSION 1
+#define BTOR_DUMPBIN_FLAG_SYMBOL 0x80
+
+enum BtorDumpBinSort
+{
+  BTOR_DUMPBIN_SORT_BV,
+  BTOR_DUMPBIN_SORT_ARRAY,
+  BTOR_DUMPBIN_SORT_FUN,
+};
+
+enum BtorDumpBinOp
+{
+  BTOR_DUMPBIN_CONST,
+  BTOR_DUMPBIN_VAR,
+  BTOR_DUMPBIN_PARAM,
+  BTOR_DUMPBIN_ARRAY,
+  BTOR_DUMPBIN_UF,
+  BTOR_DUMPBIN_SLICE,
+  BTOR_DUMPBIN_AND,
+  BTOR_DUMPBIN_EQ,
+  BTOR_DUMPBIN_ADD,
+  BTOR_DUMPBIN_MUL,
+  BTOR_DUMPBIN_ULT,
+  BTOR_DUMPBIN_SLL,
+  BTOR_DUMPBIN_SRL,
+  BTOR_DUMPBIN_UDIV,
+  BTOR_DUMPBIN_UREM,
+  BTOR_DUMPBIN_CONCAT,
+  BTOR_DUMPBIN_COND,
+  BTOR_DUMPBIN_APPLY,
+  BTOR_DUMPBIN_LAMBDA,
+  BTOR_DUMPBIN_FORALL,
+  BTOR_DUMPBIN_EXISTS,
+  BTOR_DUMPBIN_WRITE,
+  BTOR_DUMPBIN_CONST_ARRAY,
+  BTOR_DUMPBIN_NUM_OPS,
+};
+
+/* Dumps current formula (without assumptions) in binary format to file. */
+void btor_dumpbin_dump (Btor *btor, FILE *file);
+
+#endif
@@ -863,20 +863,23 @@ btor_dumpbtor_dump (Btor *btor, FILE *file, uint32_t version)
     btor_dumpbtor_add_root_to_dump_context (bdc, tmp);
     btor_node_release (btor, tmp);
   }
-  else if (btor->unsynthesized_constraints->count == 0
-           && btor->synthesized_constraints->count == 0)
-  {
-    tmp = btor_exp_true (btor);
-    btor_dumpbtor_add_root_to_dump_context (bdc, tmp);
-    btor_node_release (btor, tmp);
-  }
   else
   {
     btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
     btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
     while (btor_iter_hashptr_has_next (&it))
-      btor_dumpbtor_add_root_to_dump_context (bdc,
-                                              btor_iter_hashptr_next (&it));
+    {
+      tmp = btor_iter_hashptr_next (&it);
+      /* assertions of (popped) push/pop contexts are not dumped */
+      if (btor_node_real_addr (tmp)->activation_below) continue;
+      btor_dumpbtor_add_root_to_dump_context (bdc, tmp);
+    }
+    if (BTOR_EMPTY_STACK (bdc->roots))
+    {
+      tmp = btor_exp_true (btor);
+      btor_dumpbtor_add_root_to_dump_context (bdc, tmp);
+      btor_node_release (btor, tmp);
+    }
   }
 
   btor_dumpbtor_dump_bdc (bdc, file);
@@ -1782,19 +1782,23 @@ dump_smt_aux (Btor *btor, FILE *file, BtorNode **roots, uint32_t nroots)
       add_root_to_smt_dump_context (sdc, tmp);
       btor_node_release (btor, tmp);
     }
-    else if (btor->unsynthesized_constraints->count == 0
-             && btor->synthesized_constraints->count == 0)
-    {
-      tmp = btor_exp_true (btor);
-      add_root_to_smt_dump_context (sdc, tmp);
-      btor_node_release (btor, tmp);
-    }
     else
     {
       btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
       btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
       while (btor_iter_hashptr_has_next (&it))
-        add_root_to_smt_dump_context (sdc, btor_iter_hashptr_next (&it));
+      {
+        tmp = btor_iter_hashptr_next (&it);
+        /* assertions of (popped) push/pop contexts are not dumped */
+        if (btor_node_real_addr (tmp)->activation_below) continue;
+        add_root_to_smt_dump_context (sdc, tmp);
+      }
+      if (sdc->roots->count == 0)
+      {
+        tmp = btor_exp_true (btor);
+        add_root_to_smt_dump_context (sdc, tmp);
+        btor_node_release (btor, tmp);
+      }
     }
   }
 
@@ -0,0 +1,692 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btorbin.h"
+
+#include "btorcore.h"
+#include "btormsg.h"
+#include "btorparse.h"
+#include "dumper/btordumpbin.h"
+#include "utils/btorhashptr.h"
+#include "utils/btormem.h"
+#include "utils/btorstack.h"
+#include "utils/btorutil.h"
+
+#include <assert.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+/*------------------------------------------------------------------------*/
+
+BTOR_DECLARE_STACK (BoolectorNodePtr, BoolectorNode *);
+BTOR_DECLARE_STACK (BoolectorSort, BoolectorSort);
+
+typedef struct BtorBINParser BtorBINParser;
+
+struct BtorBINParser
+{
+  BtorMemMgr *mem;
+  Btor *btor;
+  uint32_t nprefix;
+  BtorIntStack *prefix;
+  FILE *infile;
+  const char *infile_name;
+  uint32_t offset;
+  char *error;
+  BoolectorNodePtrStack exps;
+  BoolectorSortStack sorts;
+  BtorIntStack sort_kinds;
+  BoolectorNodePtrStack args;
+  BtorCharStack symbol;
+  bool found_arrays;
+  bool found_lambdas;
+  bool found_ufs;
+  bool found_quantifiers;
+};
+
+/*------------------------------------------------------------------------*/
+
+static const char *
+perr_bin (BtorBINParser *parser, const char *fmt, ...)
+{
+  size_t bytes;
+  va_list ap;
+
+  if (!parser->error)
+  {
+    va_start (ap, fmt);
+    bytes = btor_mem_parse_error_msg_length (parser->infile_name, fmt, ap);
+    va_end (ap);
+
+    /* the byte offset is reported instead of a line number */
+    va_start (ap, fmt);
+    parser->error = btor_mem_parse_error_msg (
+        parser->mem, parser->infile_name, parser->offset, 0, fmt, ap, bytes);
+    va_end (ap);
+  }
+  return parser->error;
+}
+
+static int32_t
+nextch_bin (BtorBINParser *parser)
+{
+  int32_t ch;
+
+  if (parser->prefix && parser->nprefix < BTOR_COUNT_STACK (*parser->prefix))
+    ch = parser->prefix->start[parser->nprefix++];
+  else
+    ch = getc (parser->infile);
+  if (ch != EOF) parser->offset++;
+  return ch;
+}
+
+/*------------------------------------------------------------------------*/
+
+static bool
+read_varint (BtorBINParser *parser, uint32_t *res)
+{
+  int32_t ch;
+  uint32_t shift;
+  uint64_t val;
+
+  val = 0;
+  for (shift = 0;; shift += 7)
+  {
+    if ((ch = nextch_bin (parser)) == EOF)
+    {
+      perr_bin (parser, "unexpected end of file");
+      return false;
+    }
+    if (shift > 28)
+    {
+      perr_bin (parser, "number too large");
+      return false;
+    }
+    val |= (uint64_t) (ch & 0x7f) << shift;
+    if (!(ch & 0x80)) break;
+  }
+  if (val > UINT32_MAX)
+  {
+    perr_bin (parser, "number too large");
+    return false;
+  }
+  *res = val;
+  return true;
+}
+
+static BoolectorNode *
+read_ref (BtorBINParser *parser, uint32_t idx)
+{
+  uint32_t ref;
+  BoolectorNode *res;
+
+  if (!read_varint (parser, &ref)) return 0;
+  if (!(ref >> 1) || (ref >> 1) > idx)
+  {
+    perr_bin (parser, "invalid node reference");
+    return 0;
+  }
+  res = BTOR_PEEK_STACK (parser->exps, idx - (ref >> 1));
+  if (ref & 1)
+  {
+    if (boolector_is_fun (parser->btor, res))
+    {
+      perr_bin (parser, "unexpected function");
+      return 0;
+    }
+    return boolector_not (parser->btor, res);
+  }
+  return boolector_copy (parser->btor, res);
+}
+
+static bool
+read_sort (BtorBINParser *parser, uint32_t *res)
+{
+  if (!read_varint (parser, res)) return false;
+  if (*res >= BTOR_COUNT_STACK (parser->sorts))
+  {
+    perr_bin (parser, "invalid sort");
+    return false;
+  }
+  return true;
+}
+
+static const char *
+read_symbol (BtorBINParser *parser)
+{
+  uint32_t i, len;
+  int32_t ch;
+  bool clash;
+  char *symb;
+  Btor *btor;
+
+  if (!read_varint (parser, &len)) return 0;
+  BTOR_RESET_STACK (parser->symbol);
+  for (i = 0; i < len; i++)
+  {
+    if ((ch = nextch_bin (parser)) == EOF)
+    {
+      perr_bin (parser, "unexpected end of file");
+      return 0;
+    }
+    BTOR_PUSH_STACK (parser->symbol, ch);
+  }
+  BTOR_PUSH_STACK (parser->symbol, 0);
+
+  /* symbols are made unique per push/pop context on the API level */
+  btor = parser->btor;
+  if (btor->num_push_pop)
+  {
+    len = strlen ("BTOR_@") + btor_util_num_digits (btor->num_push_pop);
+    BTOR_NEWN (parser->mem, symb, len + BTOR_COUNT_STACK (parser->symbol));
+    sprintf (symb, "BTOR_%u@%s", btor->num_push_pop, parser->symbol.start);
+    clash = btor_hashptr_table_get (btor->symbols, symb) != 0;
+    BTOR_DELETEN (parser->mem, symb, len + BTOR_COUNT_STACK (parser->symbol));
+  }
+  else
+    clash = btor_hashptr_table_get (btor->symbols, parser->symbol.start) != 0;
+  if (clash)
+  {
+    perr_bin (parser, "symbol '%s' already defined", parser->symbol.start);
+    return 0;
+  }
+  return parser->symbol.start;
+}
+
+static BoolectorNode *
+read_const (BtorBINParser *parser)
+{
+  static const char *hex = "0123456789abcdef";
+  uint32_t i, width, nbytes;
+  int32_t ch;
+  uint64_t val;
+  char *digits;
+  BoolectorSort sort;
+  BoolectorNode *res;
+
+  if (!read_varint (parser, &width)) return 0;
+  if (!width)
+  {
+    perr_bin (parser, "invalid bit-width");
+    return 0;
+  }
+  nbytes = width / 8 + (width % 8 ? 1 : 0);
+  sort   = boolector_bitvec_sort (parser->btor, width);
+  ch     = 0;
+
+  /* bytes are stored least significant byte first, i.e., the last byte read
+   * is the most significant byte and its bits beyond 'width' must be zero */
+  if (width <= 32)
+  {
+    for (i = 0, val = 0; i < nbytes; i++)
+    {
+      if ((ch = nextch_bin (parser)) == EOF) goto EOF_ERROR;
+      val |= (uint64_t) ch << (8 * i);
+    }
+    if (width % 8 && ch >> (width % 8)) goto PADDING_ERROR;
+    res = boolector_unsigned_int (parser->btor, (uint32_t) val, sort);
+  }
+  else
+  {
+    /* two hex digits per byte, most significant byte first */
+    BTOR_NEWN (parser->mem, digits, 2 * nbytes + 1);
+    digits[2 * nbytes] = 0;
+    for (i = nbytes; i > 0; i--)
+    {
+      if ((ch = nextch_bin (parser)) == EOF)
+      {
+        BTOR_DELETEN (parser->mem, digits, 2 * nbytes + 1);
+        goto EOF_ERROR;
+      }
+      digits[2 * i - 2] = hex[ch >> 4];
+      digits[2 * i - 1] = hex[ch & 15];
+    }
+    if (width % 8 && ch >> (width % 8))
+    {
+      BTOR_DELETEN (parser->mem, digits, 2 * nbytes + 1);
+      goto PADDING_ERROR;
+    }
+    res = boolector_consth (parser->btor, sort, digits);
+    BTOR_DELETEN (parser->mem, digits, 2 * nbytes + 1);
+  }
+  boolector_release_sort (parser->btor, sort);
+  return res;
+
+EOF_ERROR:
+  boolector_release_sort (parser->btor, sort);
+  perr_bin (parser, "unexpected end of file");
+  return 0;
+
+PADDING_ERROR:
+  boolector_release_sort (parser->btor, sort);
+  perr_bin (parser, "constant does not fit into bit-width %u", width);
+  return 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+static bool
+parse_sorts (BtorBINParser *parser)
+{
+  uint32_t i, j, n, kind, arity, s0, s1;
+  int32_t ch;
+  BoolectorSort res, *domain;
+
+  if (!read_varint (parser, &n)) return false;
+  for (i = 0; i < n; i++)
+  {
+    if ((ch = nextch_bin (parser)) == EOF)
+      return !perr_bin (parser, "unexpected end of file");
+    kind = ch;
+    if (kind == BTOR_DUMPBIN_SORT_BV)
+    {
+      if (!read_varint (parser, &s0)) return false;
+      if (!s0) return !perr_bin (parser, "invalid bit-width");
+      res = boolector_bitvec_sort (parser->btor, s0);
+    }
+    else if (kind == BTOR_DUMPBIN_SORT_ARRAY)
+    {
+      if (!read_sort (parser, &s0) || !read_sort (parser, &s1)) return false;
+      if (BTOR_PEEK_STACK (parser->sort_kinds, s0) != BTOR_DUMPBIN_SORT_BV
+          || BTOR_PEEK_STACK (parser->sort_kinds, s1) != BTOR_DUMPBIN_SORT_BV)
+        return !perr_bin (parser, "invalid array sort");
+      res = boolector_array_sort (parser->btor,
+                                  BTOR_PEEK_STACK (parser->sorts, s0),
+                                  BTOR_PEEK_STACK (parser->sorts, s1));
+    }
+    else if (kind == BTOR_DUMPBIN_SORT_FUN)
+    {
+      if (!read_varint (parser, &arity)) return false;
+      if (!arity) return !perr_bin (parser, "invalid function sort");
+      BTOR_NEWN (parser->mem, domain, arity);
+      for (j = 0; j < arity; j++)
+      {
+        if (!read_sort (parser, &s0)
+            || BTOR_PEEK_STACK (parser->sort_kinds, s0)
+                   != BTOR_DUMPBIN_SORT_BV)
+        {
+          BTOR_DELETEN (parser->mem, domain, arity);
+          return !perr_bin (parser, "invalid function sort");
+        }
+        domain[j] = BTOR_PEEK_STACK (parser->sorts, s0);
+      }
+      if (!read_sort (parser, &s1)
+          || BTOR_PEEK_STACK (parser->sort_kinds, s1) != BTOR_DUMPBIN_SORT_BV)
+      {
+        BTOR_DELETEN (parser->mem, domain, arity);
+        return !perr_bin (parser, "invalid function sort");
+      }
+      res = boolector_fun_sort (
+          parser->btor, domain, arity, BTOR_PEEK_STACK (parser->sorts, s1));
+      BTOR_DELETEN (parser->mem, domain, arity);
+    }
+    else
+      return !perr_bin (parser, "invalid sort kind '%u'", kind);
+    BTOR_PUSH_STACK (parser->sorts, res);
+    BTOR_PUSH_STACK (parser->sort_kinds, kind);
+  }
+  return true;
+}
+
+static BoolectorNode *
+parse_input (BtorBINParser *parser, uint32_t op, bool has_symbol)
+{
+  uint32_t s, kind;
+  const char *symbol;
+  BoolectorSort sort;
+
+  if (!read_sort (parser, &s)) return 0;
+  sort   = BTOR_PEEK_STACK (parser->sorts, s);
+  kind   = BTOR_PEEK_STACK (parser->sort_kinds, s);
+  symbol = 0;
+  if (has_symbol && !(symbol = read_symbol (parser))) return 0;
+
+  switch (op)
+  {
+    case BTOR_DUMPBIN_VAR:
+      if (kind != BTOR_DUMPBIN_SORT_BV) break;
+      return boolector_var (parser->btor, sort, symbol);
+    case BTOR_DUMPBIN_PARAM:
+      if (kind != BTOR_DUMPBIN_SORT_BV) break;
+      return boolector_param (parser->btor, sort, symbol);
+    case BTOR_DUMPBIN_ARRAY:
+      if (kind != BTOR_DUMPBIN_SORT_ARRAY) break;
+      parser->found_arrays = true;
+      return boolector_array (parser->btor, sort, symbol);
+    default:
+      assert (op == BTOR_DUMPBIN_UF);
+      if (kind == BTOR_DUMPBIN_SORT_BV) break;
+      parser->found_ufs = true;
+      return boolector_uf (parser->btor, sort, symbol);
+  }
+  perr_bin (parser, "invalid sort");
+  return 0;
+}
+
+/* Check operand sorts and create node for 'op' with operands 'e'. */
+static BoolectorNode *
+mk_node (BtorBINParser *parser, uint32_t op, BoolectorNode *e[])
+{
+  Btor *btor;
+  bool fun0, fun1;
+
+  btor = parser->btor;
+  fun0 = boolector_is_fun (btor, e[0]);
+  fun1 = op != BTOR_DUMPBIN_CONST_ARRAY && boolector_is_fun (btor, e[1]);
+
+  switch (op)
+  {
+    case BTOR_DUMPBIN_EQ:
+      if (!boolector_is_equal_sort (btor, e[0], e[1])
+          || (fun0 && boolector_is_array (btor, e[0])
+                          != boolector_is_array (btor, e[1])))
+        break;
+      return boolector_eq (btor, e[0], e[1]);
+    case BTOR_DUMPBIN_CONCAT:
+      if (fun0 || fun1) break;
+      return boolector_concat (btor, e[0], e[1]);
+    case BTOR_DUMPBIN_COND:
+      if (fun0 || boolector_get_width (btor, e[0]) != 1
+          || !boolector_is_equal_sort (btor, e[1], e[2])
+          || (fun1 && boolector_is_array (btor, e[1])
+                          != boolector_is_array (btor, e[2])))
+        break;
+      return boolector_cond (btor, e[0], e[1], e[2]);
+    case BTOR_DUMPBIN_LAMBDA:
+    case BTOR_DUMPBIN_FORALL:
+    case BTOR_DUMPBIN_EXISTS:
+      if (!boolector_is_param (btor, e[0])
+          || boolector_is_bound_param (btor, e[0]))
+        break;
+      if (op == BTOR_DUMPBIN_LAMBDA)
+      {
+        if (fun1 && boolector_is_uf (btor, e[1])) break;
+        parser->found_lambdas = true;
+        return boolector_fun (btor, e, 1, e[1]);
+      }
+      if (fun1 || boolector_get_width (btor, e[1]) != 1) break;
+      parser->found_quantifiers = true;
+      if (op == BTOR_DUMPBIN_FORALL) return boolector_forall (btor, e, 1, e[1]);
+      return boolector_exists (btor, e, 1, e[1]);
+    case BTOR_DUMPBIN_WRITE:
+      if (!fun0 || !boolector_is_array (btor, e[0]) || fun1
+          || boolector_is_fun (btor, e[2])
+          || boolector_get_index_width (btor, e[0])
+                 != boolector_get_width (btor, e[1])
+          || boolector_get_width (btor, e[0])
+                 != boolector_get_width (btor, e[2]))
+        break;
+      return boolector_write (btor, e[0], e[1], e[2]);
+    default:
+      if (fun0 || fun1 || !boolector_is_equal_sort (btor, e[0], e[1])) break;
+      switch (op)
+      {
+        case BTOR_DUMPBIN_AND: return boolector_and (btor, e[0], e[1]);
+        case BTOR_DUMPBIN_ADD: return boolector_add (btor, e[0], e[1]);
+        case BTOR_DUMPBIN_MUL: return boolector_mul (btor, e[0], e[1]);
+        case BTOR_DUMPBIN_ULT: return boolector_ult (btor, e[0], e[1]);
+        case BTOR_DUMPBIN_SLL: return boolector_sll (btor, e[0], e[1]);
+        case BTOR_DUMPBIN_SRL: return boolector_srl (btor, e[0], e[1]);
+        case BTOR_DUMPBIN_UDIV: return boolector_udiv (btor, e[0], e[1]);
+        default:
+          assert (op == BTOR_DUMPBIN_UREM);
+          return boolector_urem (btor, e[0], e[1]);
+      }
+  }
+  perr_bin (parser, "invalid operands");
+  return 0;
+}
+
+static BoolectorNode *
+parse_apply (BtorBINParser *parser, uint32_t idx)
+{
+  uint32_t i, argc;
+  BoolectorNode *fun, *arg, *res;
+
+  res = 0;
+  if (!(fun = read_ref (parser, idx))) return 0;
+  if (!read_varint (parser, &argc)) goto DONE;
+  assert (BTOR_EMPTY_STACK (parser->args));
+  for (i = 0; i < argc; i++)
+  {
+    if (!(arg = read_ref (parser, idx))) goto DONE;
+    BTOR_PUSH_STACK (parser->args, arg);
+  }
+  if (!boolector_is_fun (parser->btor, fun)
+      || boolector_get_fun_arity (parser->btor, fun) != argc
+      || boolector_fun_sort_check (parser->btor, parser->args.start, argc, fun)
+             >= 0)
+  {
+    perr_bin (parser, "invalid arguments");
+    goto DONE;
+  }
+  if (boolector_is_array (parser->btor, fun))
+    res = boolector_read (parser->btor, fun, parser->args.start[0]);
+  else
+    res = boolector_apply (parser->btor, parser->args.start, argc, fun);
+DONE:
+  while (!BTOR_EMPTY_STACK (parser->args))
+    boolector_release (parser->btor, BTOR_POP_STACK (parser->args));
+  boolector_release (parser->btor, fun);
+  return res;
+}
+
+static BoolectorNode *
+parse_node (BtorBINParser *parser, uint32_t idx)
+{
+  uint32_t i, op, arity, upper, lower, s;
+  int32_t ch;
+  bool has_symbol;
+  BoolectorNode *e[3], *res;
+
+  if ((ch = nextch_bin (parser)) == EOF)
+  {
+    perr_bin (parser, "unexpected end of file");
+    return 0;
+  }
+  op         = ch & ~BTOR_DUMPBIN_FLAG_SYMBOL;
+  has_symbol = ch & BTOR_DUMPBIN_FLAG_SYMBOL;
+  if (op >= BTOR_DUMPBIN_NUM_OPS)
+  {
+    perr_bin (parser, "invalid operator '%u'", op);
+    return 0;
+  }
+  if (has_symbol && op > BTOR_DUMPBIN_UF)
+  {
+    perr_bin (parser, "unexpected symbol");
+    return 0;
+  }
+
+  switch (op)
+  {
+    case BTOR_DUMPBIN_CONST: return read_const (parser);
+    case BTOR_DUMPBIN_VAR:
+    case BTOR_DUMPBIN_PARAM:
+    case BTOR_DUMPBIN_ARRAY:
+    case BTOR_DUMPBIN_UF: return parse_input (parser, op, has_symbol);
+    case BTOR_DUMPBIN_APPLY: return parse_apply (parser, idx);
+    case BTOR_DUMPBIN_SLICE:
+      if (!(e[0] = read_ref (parser, idx))) return 0;
+      res = 0;
+      if (read_varint (parser, &upper) && read_varint (parser, &lower))
+      {
+        if (boolector_is_fun (parser->btor, e[0]) || upper < lower
+            || upper >= boolector_get_width (parser->btor, e[0]))
+          perr_bin (parser, "invalid slice");
+        else
+          res = boolector_slice (parser->btor, e[0], upper, lower);
+      }
+      boolector_release (parser->btor, e[0]);
+      return res;
+    case BTOR_DUMPBIN_CONST_ARRAY:
+      if (!read_sort (parser, &s)) return 0;
+      if (!(e[0] = read_ref (parser, idx))) return 0;
+      res = 0;
+      if (BTOR_PEEK_STACK (parser->sort_kinds, s) != BTOR_DUMPBIN_SORT_ARRAY
+          || boolector_is_fun (parser->btor, e[0]))
+        perr_bin (parser, "invalid constant array");
+      else
+      {
+        parser->found_arrays = true;
+        res = boolector_const_array (
+            parser->btor, BTOR_PEEK_STACK (parser->sorts, s), e[0]);
+      }
+      boolector_release (parser->btor, e[0]);
+      return res;
+    case BTOR_DUMPBIN_COND:
+    case BTOR_DUMPBIN_WRITE: arity = 3; break;
+    default: arity = 2;
+  }
+
+  for (i = 0; i < arity; i++)
+  {
+    if (!(e[i] = read_ref (parser, idx)))
+    {
+      while (i > 0) boolector_release (parser->btor, e[--i]);
+      return 0;
+    }
+  }
+  res = mk_node (parser, op, e);
+  for (i = 0; i < arity; i++) boolector_release (parser->btor, e[i]);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static BtorBINParser *
+new_bin_parser (Btor *btor)
+{
+  BtorMemMgr *mem = btor_mem_mgr_new ();
+  BtorBINParser *res;
+
+  BTOR_NEW (mem, res);
+  BTOR_CLR (res);
+
+  res->mem  = mem;
+  res->btor = btor;
+
+  BTOR_INIT_STACK (mem, res->exps);
+  BTOR_INIT_STACK (mem, res->sorts);
+  BTOR_INIT_STACK (mem, res->sort_kinds);
+  BTOR_INIT_STACK (mem, res->args);
+  BTOR_INIT_STACK (mem, res->symbol);
+
+  return res;
+}
+
+static void
+delete_bin_parser (BtorBINParser *parser)
+{
+  BtorMemMgr *mm;
+
+  while (!BTOR_EMPTY_STACK (parser->exps))
+    boolector_release (parser->btor, BTOR_POP_STACK (parser->exps));
+  while (!BTOR_EMPTY_STACK (parser->sorts))
+    boolector_release_sort (parser->btor, BTOR_POP_STACK (parser->sorts));
+
+  mm = parser->mem;
+
+  BTOR_RELEASE_STACK (parser->exps);
+  BTOR_RELEASE_STACK (parser->sorts);
+  BTOR_RELEASE_STACK (parser->sort_kinds);
+  BTOR_RELEASE_STACK (parser->args);
+  BTOR_RELEASE_STACK (parser->symbol);
+
+  btor_mem_freestr (mm, parser->error);
+  BTOR_DELETE (mm, parser);
+  btor_mem_mgr_delete (mm);
+}
+
+/* Note: we need prefix in case of stdin as input (also applies to compressed
+ * input files). */
+static const char *
+parse_bin_parser (BtorBINParser *parser,
+                  BtorIntStack *prefix,
+                  FILE *infile,
+                  const char *infile_name,
+                  FILE *outfile,
+                  BtorParseResult *res)
+{
+  uint32_t i, n, version;
+  BoolectorNode *exp;
+
+  assert (infile);
+  assert (infile_name);
+  (void) outfile;
+
+  BTOR_MSG (
+      boolector_get_btor_msg (parser->btor), 1, "parsing %s", infile_name);
+
+  parser->nprefix     = 0;
+  parser->prefix      = prefix;
+  parser->infile      = infile;
+  parser->infile_name = infile_name;
+  parser->offset      = 0;
+
+  BTOR_CLR (res);
+
+  for (i = 0; i < sizeof BTOR_DUMPBIN_MAGIC - 1; i++)
+    if (nextch_bin (parser) != (uint8_t) BTOR_DUMPBIN_MAGIC[i])
+      return perr_bin (parser, "invalid header");
+  if (!read_varint (parser, &version)) return parser->error;
+  if (version != BTOR_DUMPBIN_VERSION)
+    return perr_bin (parser, "unsupported version %u", version);
+
+  if (!parse_sorts (parser)) return parser->error;
+
+  if (!read_varint (parser, &n)) return parser->error;
+  for (i = 0; i < n; i++)
+  {
+    if (!(exp = parse_node (parser, i))) return parser->error;
+    BTOR_PUSH_STACK (parser->exps, exp);
+  }
+
+  if (!read_varint (parser, &n)) return parser->error;
+  for (i = 0; i < n; i++)
+  {
+    if (!(exp = read_ref (parser, BTOR_COUNT_STACK (parser->exps))))
+      return parser->error;
+    if (boolector_is_fun (parser->btor, exp)
+        || boolector_get_width (parser->btor, exp) != 1
+        || btor_node_real_addr (BTOR_IMPORT_BOOLECTOR_NODE (exp))->parameterized)
+    {
+      boolector_release (parser->btor, exp);
+      return perr_bin (parser, "invalid root");
+    }
+    boolector_assert (parser->btor, exp);
+    boolector_release (parser->btor, exp);
+  }
+
+  if (nextch_bin (parser) != EOF)
+    return perr_bin (parser, "expected end of file");
+
+  if (parser->found_quantifiers)
+    res->logic = BTOR_LOGIC_BV;
+  else if (parser->found_ufs)
+    res->logic = BTOR_LOGIC_QF_AUFBV;
+  else if (parser->found_arrays || parser->found_lambdas)
+    res->logic = BTOR_LOGIC_QF_ABV;
+  else
+    res->logic = BTOR_LOGIC_QF_BV;
+  res->status = BOOLECTOR_UNKNOWN;
+
+  return 0;
+}
+
+static BtorParserAPI parsebin_parser_api = {
+    (BtorInitParser) new_bin_parser,
+    (BtorResetParser) delete_bin_parser,
+    (BtorParse) parse_bin_parser,
+};
+
+const BtorParserAPI *
+btor_parsebin_parser_api ()
+{
+  return &parsebin_parser_api;
+}
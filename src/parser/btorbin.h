@@ -0,0 +1,19 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORBIN_H_INCLUDED
+#define BTORBIN_H_INCLUDED
+
+#include "btorparse.h"
+
+#include <stdio.h>
+
+/* Parser for the binary format written by btor_dumpbin_dump. */
+const BtorParserAPI* btor_parsebin_parser_api ();
+
+#endif
@@ -44,6 +44,7 @@ btor_simplify (Btor *btor)
 
   rounds = 0;
   start  = btor_util_time_stamp ();
+  BTOR_PERF_BEGIN (btor, BTOR_PERF_SIMPLIFY);
 
   if (btor->valid_assignments) btor_reset_incremental_usage (btor);
 
@@ -67,6 +68,8 @@ btor_simplify (Btor *btor)
 
   do
   {
+    /* constraints not processed yet remain in 'unsynthesized_constraints' */
+    if (rounds && btor_budget_exhausted (btor)) break;
     rounds++;
     assert (btor_dbg_check_all_hash_tables_proxy_free (btor));
     assert (btor_dbg_check_all_hash_tables_simp_free (btor));
@@ -75,7 +78,9 @@ btor_simplify (Btor *btor)
     {
       if (btor_opt_get (btor, BTOR_OPT_VAR_SUBST))
       {
+        btor_profile_begin (btor, "var_subst");
         btor_substitute_var_exps (btor);
+        btor_profile_end (btor);
 
         if (btor->inconsistent)
         {
@@ -89,7 +94,9 @@ btor_simplify (Btor *btor)
 
       while (btor->embedded_constraints->count)
       {
+        btor_profile_begin (btor, "embedded");
         btor_process_embedded_constraints (btor);
+        btor_profile_end (btor);
 
         if (btor->inconsistent)
         {
@@ -106,7 +113,9 @@ btor_simplify (Btor *btor)
         && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
         && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL))
     {
+      btor_profile_begin (btor, "slicing");
       btor_eliminate_slices_on_bv_vars (btor);
+      btor_profile_end (btor);
       if (btor->inconsistent)
       {
         BTORLOG (1, "formula inconsistent after slice elimination");
@@ -125,7 +134,9 @@ btor_simplify (Btor *btor)
       skelrounds++;
       if (skelrounds <= 1)  // TODO only one?
       {
+        btor_profile_begin (btor, "skeleton");
         btor_process_skeleton (btor);
+        btor_profile_end (btor);
         if (btor->inconsistent)
         {
           BTORLOG (1, "formula inconsistent after skeleton preprocessing");
@@ -147,7 +158,9 @@ btor_simplify (Btor *btor)
         && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
         && !btor_opt_get (btor, BTOR_OPT_MODEL_GEN))
     {
+      btor_profile_begin (btor, "ucopt");
       btor_optimize_unconstrained (btor);
+      btor_profile_end (btor);
       if (btor->inconsistent)
       {
         BTORLOG (1, "formula inconsistent after skeleton preprocessing");
@@ -160,11 +173,19 @@ btor_simplify (Btor *btor)
 
     if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
         && btor_opt_get (btor, BTOR_OPT_EXTRACT_LAMBDAS))
+    {
+      btor_profile_begin (btor, "extract_lambdas");
       btor_extract_lambdas (btor);
+      btor_profile_end (btor);
+    }
 
     if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
         && btor_opt_get (btor, BTOR_OPT_MERGE_LAMBDAS))
+    {
+      btor_profile_begin (btor, "merge_lambdas");
       btor_merge_lambdas (btor);
+      btor_profile_end (btor);
+    }
 
     if (btor->varsubst_constraints->count || btor->embedded_constraints->count)
       continue;
@@ -182,21 +203,32 @@ btor_simplify (Btor *btor)
                   "no UFs or function equalities, enable beta-reduction=all");
         btor_opt_set (btor, BTOR_OPT_BETA_REDUCE, BTOR_BETA_REDUCE_ALL);
       }
+      btor_profile_begin (btor, "elim_applies");
       btor_eliminate_applies (btor);
+      btor_profile_end (btor);
     }
 
     /* add ackermann constraints for all uninterpreted functions */
     if (btor_opt_get (btor, BTOR_OPT_ACKERMANN))
+    {
+      btor_profile_begin (btor, "ackermann");
       btor_add_ackermann_constraints (btor);
+      btor_profile_end (btor);
+    }
 
     if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
         && btor_opt_get (btor, BTOR_OPT_SIMP_NORMAMLIZE_ADDERS))
+    {
+      btor_profile_begin (btor, "normalize_adds");
       btor_normalize_adds (btor);
+      btor_profile_end (btor);
+    }
 
   } while (btor->varsubst_constraints->count
            || btor->embedded_constraints->count);
 
 DONE:
+  BTOR_PERF_END (btor, BTOR_PERF_SIMPLIFY);
   delta = btor_util_time_stamp () - start;
   btor->time.simplify += delta;
   BTOR_MSG (btor->msg, 1, "%u rewriting rounds in %.1f seconds", rounds, delta);
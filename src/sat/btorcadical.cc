@@ -0,0 +1,346 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifdef BTOR_USE_CADICAL
+
+#include "cadical.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <vector>
+
+extern "C" {
+
+#include "btorabort.h"
+#include "btorcore.h"
+#include "sat/btorcadical.h"
+
+/*------------------------------------------------------------------------*/
+
+class BtorCaDiCaL : public CaDiCaL::Terminator, public CaDiCaL::Learner
+{
+ public:
+  CaDiCaL::Solver solver;
+
+  /* Termination callback, for CaDiCaL 'state' is the first argument
+   * (unlike, e.g., Lingeling). */
+  int32_t (*term_fun) (void *);
+  void *term_state;
+
+  /* Model of the solver this solver was cloned from (if it was satisfied).
+   * CaDiCaL does not copy its assignment, but Boolector queries the model of
+   * a clone without calling the SAT solver first.  Discarded on the next SAT
+   * call. */
+  std::vector<signed char> model;
+
+  /* Assumptions of the next and of the last SAT call, and the (sorted) failed
+   * assumptions of the solver this solver was cloned from (if it was
+   * unsatisfiable).  CaDiCaL neither copies assumptions nor can answer
+   * 'failed' without solving, hence the clone answers from the snapshot until
+   * its next SAT call. */
+  std::vector<int32_t> assumptions;
+  std::vector<int32_t> last_assumptions;
+  std::vector<int32_t> failed_lits;
+  bool has_failed_lits;
+
+  /* Learned clause export, see 'share' in BtorSATMgr.  CaDiCaL does not
+   * provide the LBD of learned clauses, hence only their size is limited. */
+  void (*learned) (void *, const int32_t *, uint32_t);
+  void *learned_state;
+  uint32_t learned_max_size;
+  std::vector<int32_t> clause;
+
+  BtorCaDiCaL ()
+      : term_fun (0),
+        term_state (0),
+        has_failed_lits (false),
+        learned (0),
+        learned_state (0),
+        learned_max_size (0)
+  {
+  }
+
+  bool terminate () { return term_fun (term_state) != 0; }
+
+  bool learning (int size) { return (uint32_t) size <= learned_max_size; }
+
+  void learn (int lit)
+  {
+    if (lit)
+    {
+      clause.push_back (lit);
+      return;
+    }
+    learned (learned_state, clause.data (), clause.size ());
+    clause.clear ();
+  }
+
+  void set_learned (void (*fun) (void *, const int32_t *, uint32_t),
+                    void *state,
+                    uint32_t max_size)
+  {
+    learned          = fun;
+    learned_state    = state;
+    learned_max_size = max_size;
+    if (fun)
+      solver.connect_learner (this);
+    else
+      solver.disconnect_learner ();
+  }
+
+  void set_terminate (int32_t (*fun) (void *), void *state)
+  {
+    term_fun   = fun;
+    term_state = state;
+    if (fun)
+      solver.connect_terminator (this);
+    else
+      solver.disconnect_terminator ();
+  }
+
+  int32_t deref (int32_t lit)
+  {
+    int32_t val;
+    if (!model.empty ())
+    {
+      if ((size_t) abs (lit) >= model.size ()) return 0;
+      val = model[abs (lit)];
+      return lit < 0 ? -val : val;
+    }
+    val = solver.val (lit);
+    if (val > 0) return 1;
+    if (val < 0) return -1;
+    return 0;
+  }
+
+  bool failed (int32_t lit)
+  {
+    if (has_failed_lits)
+      return std::binary_search (failed_lits.begin (), failed_lits.end (), lit);
+    return solver.failed (lit);
+  }
+};
+
+/*------------------------------------------------------------------------*/
+
+static void *
+init (BtorSATMgr *smgr)
+{
+  BtorCaDiCaL *slv = new BtorCaDiCaL ();
+  if (smgr->inc_required
+      && btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE_CADICAL_FREEZE))
+  {
+    slv->solver.set ("checkfrozen", 1);
+  }
+  return slv;
+}
+
+static void
+add (BtorSATMgr *smgr, int32_t lit)
+{
+  ((BtorCaDiCaL *) smgr->solver)->solver.add (lit);
+}
+
+static void
+add_clauses (BtorSATMgr *smgr, const int32_t *lits, size_t n)
+{
+  CaDiCaL::Solver &slv = ((BtorCaDiCaL *) smgr->solver)->solver;
+  const int32_t *p, *end;
+  for (p = lits, end = lits + n; p < end; p++) slv.add (*p);
+}
+
+static void
+assume (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorCaDiCaL *slv = (BtorCaDiCaL *) smgr->solver;
+  slv->assumptions.push_back (lit);
+  slv->solver.assume (lit);
+}
+
+static int32_t
+deref (BtorSATMgr *smgr, int32_t lit)
+{
+  return ((BtorCaDiCaL *) smgr->solver)->deref (lit);
+}
+
+static void
+enable_verbosity (BtorSATMgr *smgr, int32_t level)
+{
+  CaDiCaL::Solver &slv = ((BtorCaDiCaL *) smgr->solver)->solver;
+  if (level <= 1)
+    slv.set ("quiet", 1);
+  else if (level >= 2)
+    slv.set ("verbose", level - 2);
+}
+
+static int32_t
+failed (BtorSATMgr *smgr, int32_t lit)
+{
+  return ((BtorCaDiCaL *) smgr->solver)->failed (lit);
+}
+
+static void
+reset (BtorSATMgr *smgr)
+{
+  delete (BtorCaDiCaL *) smgr->solver;
+  smgr->solver = 0;
+}
+
+static int32_t
+sat (BtorSATMgr *smgr, int32_t limit)
+{
+  (void) limit;
+  BtorCaDiCaL *slv = (BtorCaDiCaL *) smgr->solver;
+  slv->model.clear ();
+  slv->failed_lits.clear ();
+  slv->has_failed_lits = false;
+  slv->last_assumptions.swap (slv->assumptions);
+  slv->assumptions.clear ();
+  return slv->solver.solve ();
+}
+
+static void
+setterm (BtorSATMgr *smgr)
+{
+  ((BtorCaDiCaL *) smgr->solver)
+      ->set_terminate (smgr->term.fun, smgr->term.state);
+}
+
+static void
+export_learned (BtorSATMgr *smgr)
+{
+  ((BtorCaDiCaL *) smgr->solver)
+      ->set_learned (smgr->share.learned,
+                     smgr->share.state,
+                     smgr->share.max_size);
+}
+
+/*------------------------------------------------------------------------*/
+/* incremental API                                                        */
+/*------------------------------------------------------------------------*/
+
+static int32_t
+inc_max_var (BtorSATMgr *smgr)
+{
+  int32_t var = smgr->maxvar + 1;
+  if (smgr->inc_required)
+  {
+    ((BtorCaDiCaL *) smgr->solver)->solver.freeze (var);
+  }
+  return var;
+}
+
+static void
+melt (BtorSATMgr *smgr, int32_t lit)
+{
+  if (smgr->inc_required)
+    ((BtorCaDiCaL *) smgr->solver)->solver.melt (lit);
+}
+
+/*------------------------------------------------------------------------*/
+
+/* CaDiCaL copies options, irredundant clauses (including units) and the
+ * reconstruction stack of eliminated variables, which is all that is needed
+ * to continue incrementally on the clone.  Learned clauses and assumptions
+ * are not copied, frozen variables, the model and the failed assumptions are
+ * transferred manually. */
+static void *
+clone (Btor *btor, BtorSATMgr *smgr)
+{
+  (void) btor;
+  BtorCaDiCaL *slv, *res;
+  int32_t var, maxvar;
+
+  slv    = (BtorCaDiCaL *) smgr->solver;
+  res    = new BtorCaDiCaL ();
+  maxvar = slv->solver.vars ();
+
+  /* 'copy' requires an unmodified target solver */
+  slv->solver.copy (res->solver);
+  res->solver.reserve (maxvar);
+
+  for (var = 1; var <= maxvar; var++)
+  {
+    if (slv->solver.frozen (var)) res->solver.freeze (var);
+  }
+
+  if (slv->solver.status () == 10)
+  {
+    res->model.resize (maxvar + 1, 0);
+    for (var = 1; var <= maxvar; var++) res->model[var] = slv->deref (var);
+  }
+  else
+  {
+    res->model = slv->model;
+  }
+
+  if (slv->solver.status () == 20)
+  {
+    for (int32_t lit : slv->last_assumptions)
+      if (slv->failed (lit)) res->failed_lits.push_back (lit);
+    std::sort (res->failed_lits.begin (), res->failed_lits.end ());
+    res->has_failed_lits = true;
+  }
+  else
+  {
+    res->failed_lits     = slv->failed_lits;
+    res->has_failed_lits = slv->has_failed_lits;
+  }
+  res->last_assumptions = slv->last_assumptions;
+
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+bool
+btor_sat_enable_cadical (BtorSATMgr *smgr)
+{
+  assert (smgr != NULL);
+
+  BTOR_ABORT (smgr->initialized,
+              "'btor_sat_init' called before 'btor_sat_enable_cadical'");
+
+  smgr->name = "CaDiCaL";
+
+  BTOR_CLR (&smgr->api);
+  smgr->api.add              = add;
+  smgr->api.add_clauses      = add_clauses;
+  smgr->api.assume           = assume;
+  smgr->api.clone            = clone;
+  smgr->api.deref            = deref;
+  smgr->api.enable_verbosity = enable_verbosity;
+  smgr->api.failed           = failed;
+  smgr->api.fixed            = 0;
+  smgr->api.inc_max_var      = 0;
+  smgr->api.init             = init;
+  smgr->api.melt             = 0;
+  smgr->api.repr             = 0;
+  smgr->api.reset            = reset;
+  smgr->api.sat              = sat;
+  smgr->api.set_output       = 0;
+  smgr->api.set_prefix       = 0;
+  smgr->api.stats            = 0;
+  smgr->api.setterm          = setterm;
+  smgr->api.export_learned   = export_learned;
+
+  if (btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE_CADICAL_FREEZE))
+  {
+    smgr->api.inc_max_var = inc_max_var;
+    smgr->api.melt        = melt;
+  }
+  else
+  {
+    smgr->have_restore = true;
+  }
+
+  return true;
+}
+};
+#endif
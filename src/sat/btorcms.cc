@@ -35,6 +35,11 @@ class BtorCMS : public SATSolver
   int32_t* assigned_map;
   bool nomodel;
 
+  /* Learned clause export, see 'share' in BtorSATMgr. */
+  void (*learned) (void*, const int32_t*, uint32_t);
+  void* learned_state;
+  uint32_t learned_max_size, learned_max_lbd;
+
   Lit import (int32_t lit)
   {
     assert (0 < abs (lit) && ((uint32_t) abs (lit)) <= nVars ());
@@ -79,8 +84,38 @@ class BtorCMS : public SATSolver
     }
   }
 
+  /* CryptoMiniSat only provides learned clauses between SAT calls, which
+   * includes clauses already exported after previous calls. */
+  void export_learned ()
+  {
+    std::vector<Lit> lits;
+    std::vector<int32_t> clause;
+    start_getting_small_clauses (learned_max_size, learned_max_lbd);
+    while (get_next_small_clause (lits))
+    {
+      clause.clear ();
+      for (size_t i = 0; i < lits.size (); i++)
+      {
+        int32_t lit = lits[i].var () + 1;
+        clause.push_back (lits[i].sign () ? -lit : lit);
+      }
+      learned (learned_state, clause.data (), clause.size ());
+    }
+    end_getting_small_clauses ();
+  }
+
  public:
-  BtorCMS () : size (0), failed_map (0), assigned_map (0), nomodel (true) {}
+  BtorCMS ()
+      : size (0),
+        failed_map (0),
+        assigned_map (0),
+        nomodel (true),
+        learned (0),
+        learned_state (0),
+        learned_max_size (0),
+        learned_max_lbd (0)
+  {
+  }
 
   ~BtorCMS () { reset (); }
 
@@ -106,6 +141,16 @@ class BtorCMS : public SATSolver
       add_clause (clause), clause.clear ();
   }
 
+  void add_clauses (const int32_t* lits, size_t n)
+  {
+    nomodel = true;
+    for (size_t i = 0; i < n; i++)
+      if (lits[i])
+        clause.push_back (import (lits[i]));
+      else
+        add_clause (clause), clause.clear ();
+  }
+
   int32_t sat ()
   {
     calls++;
@@ -116,6 +161,7 @@ class BtorCMS : public SATSolver
     decisions += get_last_decisions ();
     propagations += get_last_propagations ();
     assumptions.clear ();
+    if (learned) export_learned ();
     nomodel = res != l_True;
     return res == l_Undef ? 0 : (res == l_True ? 10 : 20);
   }
@@ -148,6 +194,17 @@ class BtorCMS : public SATSolver
     return l.sign () ? -res : res;
   }
 
+  void set_learned (void (*fun) (void*, const int32_t*, uint32_t),
+                    void* state,
+                    uint32_t max_size,
+                    uint32_t max_lbd)
+  {
+    learned          = fun;
+    learned_state    = state;
+    learned_max_size = max_size;
+    learned_max_lbd  = max_lbd;
+  }
+
   uint64_t calls, conflicts, decisions, propagations;
 };
 
@@ -171,6 +228,13 @@ add (BtorSATMgr* smgr, int32_t lit)
   solver->add (lit);
 }
 
+static void
+add_clauses (BtorSATMgr* smgr, const int32_t* lits, size_t n)
+{
+  BtorCMS* solver = (BtorCMS*) smgr->solver;
+  solver->add_clauses (lits, n);
+}
+
 static int32_t
 sat (BtorSATMgr* smgr, int32_t limit)
 {
@@ -228,6 +292,16 @@ enable_verbosity (BtorSATMgr* smgr, int32_t level)
   if (level >= 2) ((BtorCMS*) smgr->solver)->set_verbosity (level - 1);
 }
 
+static void
+export_learned (BtorSATMgr* smgr)
+{
+  BtorCMS* solver = (BtorCMS*) smgr->solver;
+  solver->set_learned (smgr->share.learned,
+                       smgr->share.state,
+                       smgr->share.max_size,
+                       smgr->share.max_lbd);
+}
+
 static void
 stats (BtorSATMgr* smgr)
 {
@@ -258,6 +332,7 @@ btor_sat_enable_cms (BtorSATMgr* smgr)
 
   BTOR_CLR (&smgr->api);
   smgr->api.add              = add;
+  smgr->api.add_clauses      = add_clauses;
   smgr->api.assume           = assume;
   smgr->api.deref            = deref;
   smgr->api.enable_verbosity = enable_verbosity;
@@ -271,6 +346,7 @@ btor_sat_enable_cms (BtorSATMgr* smgr)
   smgr->api.set_output       = 0;
   smgr->api.set_prefix       = 0;
   smgr->api.stats            = stats;
+  smgr->api.export_learned   = export_learned;
   return true;
 }
 };
@@ -60,6 +60,14 @@ add (BtorSATMgr *smgr, int32_t lit)
   lgladd (blgl->lgl, lit);
 }
 
+static void
+add_clauses (BtorSATMgr *smgr, const int32_t *lits, size_t n)
+{
+  BtorLGL *blgl = smgr->solver;
+  const int32_t *p, *end;
+  for (p = lits, end = lits + n; p < end; p++) lgladd (blgl->lgl, *p);
+}
+
 static int32_t
 sat (BtorSATMgr *smgr, int32_t limit)
 {
@@ -246,6 +254,21 @@ melt (BtorSATMgr *smgr, int32_t lit)
   if (smgr->inc_required) lglmelt (blgl->lgl, lit);
 }
 
+static int32_t
+reusable (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorLGL *blgl = smgr->solver;
+  return lglreusable (blgl->lgl, lit);
+}
+
+static void
+reuse (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorLGL *blgl = smgr->solver;
+  lglreuse (blgl->lgl, lit);
+  if (smgr->inc_required) lglfreeze (blgl->lgl, lit);
+}
+
 static int32_t
 failed (BtorSATMgr *smgr, int32_t lit)
 {
@@ -310,6 +333,7 @@ btor_sat_enable_lingeling (BtorSATMgr *smgr)
 
   BTOR_CLR (&smgr->api);
   smgr->api.add              = add;
+  smgr->api.add_clauses      = add_clauses;
   smgr->api.assume           = assume;
   smgr->api.deref            = deref;
   smgr->api.enable_verbosity = enable_verbosity;
@@ -326,6 +350,8 @@ btor_sat_enable_lingeling (BtorSATMgr *smgr)
   smgr->api.stats            = stats;
   smgr->api.clone            = clone;
   smgr->api.setterm          = setterm;
+  smgr->api.reusable         = reusable;
+  smgr->api.reuse            = reuse;
   return true;
 }
 
@@ -89,6 +89,16 @@ class BtorMiniSAT : public SimpSolver
       addClause (clause), clause.clear ();
   }
 
+  void add_clauses (const int32_t* lits, size_t n)
+  {
+    nomodel = true;
+    for (size_t i = 0; i < n; i++)
+      if (lits[i])
+        clause.push (import (lits[i]));
+      else
+        addClause (clause), clause.clear ();
+  }
+
   unsigned long long calls;
 
   int32_t sat (bool simp)
@@ -148,6 +158,13 @@ add (BtorSATMgr* smgr, int32_t lit)
   solver->add (lit);
 }
 
+static void
+add_clauses (BtorSATMgr* smgr, const int32_t* lits, size_t n)
+{
+  BtorMiniSAT* solver = (BtorMiniSAT*) smgr->solver;
+  solver->add_clauses (lits, n);
+}
+
 static int32_t
 sat (BtorSATMgr* smgr, int32_t limit)
 {
@@ -240,6 +257,7 @@ btor_sat_enable_minisat (BtorSATMgr* smgr)
 
   BTOR_CLR (&smgr->api);
   smgr->api.add              = add;
+  smgr->api.add_clauses      = add_clauses;
   smgr->api.assume           = assume;
   smgr->api.deref            = deref;
   smgr->api.enable_verbosity = enable_verbosity;
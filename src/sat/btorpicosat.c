@@ -39,6 +39,14 @@ add (BtorSATMgr *smgr, int32_t lit)
   (void) picosat_add (smgr->solver, lit);
 }
 
+static void
+add_clauses (BtorSATMgr *smgr, const int32_t *lits, size_t n)
+{
+  PicoSAT *ps = smgr->solver;
+  const int32_t *p, *end;
+  for (p = lits, end = lits + n; p < end; p++) (void) picosat_add (ps, *p);
+}
+
 static int32_t
 sat (BtorSATMgr *smgr, int32_t limit)
 {
@@ -122,6 +130,7 @@ btor_sat_enable_picosat (BtorSATMgr *smgr)
 
   BTOR_CLR (&smgr->api);
   smgr->api.add              = add;
+  smgr->api.add_clauses      = add_clauses;
   smgr->api.assume           = assume;
   smgr->api.deref            = deref;
   smgr->api.enable_verbosity = enable_verbosity;
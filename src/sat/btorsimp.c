@@ -0,0 +1,1315 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "sat/btorsimp.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "btorcore.h"
+#include "utils/btorutil.h"
+
+/*------------------------------------------------------------------------*/
+
+/* The preprocessor buffers all clauses added between two SAT calls and
+ * simplifies them on the next SAT call before they are forwarded to the
+ * wrapped SAT solver.  Only variables that were not yet sent to the wrapped
+ * solver are substituted or eliminated, and a variable is only eliminated if
+ * it is not frozen, i.e., if it will not occur in clauses or assumptions
+ * added later.  Variables keep their index in the wrapped solver.  Values of
+ * eliminated variables are reconstructed from the clauses on the extension
+ * stack after each SAT call, values of substituted variables are derived
+ * from their representatives. */
+
+#define BTOR_SIMP_ROUNDS 4
+#define BTOR_SIMP_ELIM_OCCS 16        /* max. occurrences per phase */
+#define BTOR_SIMP_ELIM_CLAUSE_SIZE 24 /* max. size of resolvents */
+#define BTOR_SIMP_SUBSUME_CLAUSE_SIZE 16
+#define BTOR_SIMP_SUBSUME_EFFORT 20 /* steps per buffered literal */
+
+/*------------------------------------------------------------------------*/
+
+typedef struct BtorSimpVar BtorSimpVar;
+
+struct BtorSimpVar
+{
+  BtorIntStack occs[2]; /* buffered clauses with positive / negative lit */
+  int32_t repr;         /* representative literal if substituted */
+  uint32_t frozen;      /* number of references from outside */
+  int32_t dfs[2];       /* DFS index of literal when searching for SCCs */
+  int32_t low[2];
+  int8_t fixed;           /* value fixed on top level */
+  int8_t val;             /* value after model reconstruction */
+  int8_t mark;            /* 1: positive lit marked, -1: negative lit */
+  uint8_t sent : 1;       /* occurs in clauses passed to the SAT solver */
+  uint8_t eliminated : 1; /* eliminated by variable elimination */
+  uint8_t assumed : 1;    /* assumed in the current SAT call */
+  uint8_t touched : 1;    /* occurs in buffered clauses */
+  uint8_t onstack : 2;    /* literal is on SCC stack (bit per phase) */
+};
+
+typedef struct BtorSATSimp BtorSATSimp;
+
+struct BtorSATSimp
+{
+  BtorSATMgr *smgr; /* SAT manager wrapped by preprocessor */
+  BtorSimpVar *vars;
+  uint32_t size_vars;
+  /* Buffered clauses, stored as size, garbage flag and literals. */
+  BtorIntStack arena;
+  BtorIntStack clauses; /* offsets of buffered clauses in 'arena' */
+  BtorIntStack touched; /* variables occurring in buffered clauses */
+  BtorIntStack clause;  /* clause currently added */
+  BtorIntStack assumptions;
+  BtorIntStack units; /* top level assigned literals */
+  size_t next_propagate;
+  size_t next_forward;
+  /* Clauses of eliminated variables, stored as witness literal, remaining
+   * literals and size. */
+  BtorIntStack extension;
+  bool extended; /* values of eliminated vars reconstructed */
+  bool inconsistent;
+  bool inconsistent_sent;
+  BtorIntStack tmp;
+  BtorIntStack resolvents;
+  struct
+  {
+    uint32_t eliminated;
+    uint32_t substituted;
+    uint32_t subsumed;
+    uint32_t strengthened;
+    uint32_t units;
+    uint32_t resolvents;
+    double time;
+  } stats;
+};
+
+/*------------------------------------------------------------------------*/
+
+#define BTOR_SIMP_SIZE(simp, c) ((simp)->arena.start[c])
+#define BTOR_SIMP_GARBAGE(simp, c) ((simp)->arena.start[(c) + 1])
+#define BTOR_SIMP_LITS(simp, c) ((simp)->arena.start + (c) + 2)
+
+static inline BtorSimpVar *
+get_var (BtorSATSimp *simp, int32_t lit)
+{
+  assert (lit);
+  assert ((uint32_t) abs (lit) < simp->size_vars);
+  return simp->vars + abs (lit);
+}
+
+static inline int32_t
+sign_lit (int32_t lit)
+{
+  return lit < 0 ? -1 : 1;
+}
+
+static inline BtorIntStack *
+get_occs (BtorSATSimp *simp, int32_t lit)
+{
+  return get_var (simp, lit)->occs + (lit < 0);
+}
+
+static inline int32_t
+mark_lit (BtorSATSimp *simp, int32_t lit)
+{
+  return get_var (simp, lit)->mark * sign_lit (lit);
+}
+
+static int32_t
+repr_lit (BtorSATSimp *simp, int32_t lit)
+{
+  int32_t r;
+  while ((r = get_var (simp, lit)->repr)) lit = lit < 0 ? -r : r;
+  return lit;
+}
+
+static int32_t
+fixed_lit (BtorSATSimp *simp, int32_t lit)
+{
+  return get_var (simp, lit)->fixed * sign_lit (lit);
+}
+
+static void
+touch (BtorSATSimp *simp, int32_t lit)
+{
+  BtorSimpVar *v = get_var (simp, lit);
+  if (v->touched) return;
+  v->touched = 1;
+  BTOR_PUSH_STACK (simp->touched, abs (lit));
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+assign (BtorSATSimp *simp, int32_t lit)
+{
+  int32_t val = fixed_lit (simp, lit);
+  if (val > 0) return;
+  if (val < 0)
+  {
+    simp->inconsistent = true;
+    return;
+  }
+  get_var (simp, lit)->fixed = sign_lit (lit);
+  BTOR_PUSH_STACK (simp->units, lit);
+  simp->stats.units++;
+}
+
+static void
+store_clause (BtorSATSimp *simp, BtorIntStack *lits)
+{
+  int32_t c, lit;
+  size_t i;
+
+  assert (BTOR_COUNT_STACK (*lits) > 1);
+
+  c = BTOR_COUNT_STACK (simp->arena);
+  BTOR_PUSH_STACK (simp->arena, BTOR_COUNT_STACK (*lits));
+  BTOR_PUSH_STACK (simp->arena, 0);
+  for (i = 0; i < BTOR_COUNT_STACK (*lits); i++)
+  {
+    lit = BTOR_PEEK_STACK (*lits, i);
+    BTOR_PUSH_STACK (simp->arena, lit);
+    BTOR_PUSH_STACK (*get_occs (simp, lit), c);
+    touch (simp, lit);
+  }
+  BTOR_PUSH_STACK (simp->clauses, c);
+}
+
+/* Adds clause 'lits' to the buffer after substituting literals by their
+ * representatives and removing top level assigned literals. */
+static void
+new_clause (BtorSATSimp *simp, const int32_t *lits, size_t n)
+{
+  BtorSimpVar *v;
+  bool satisfied = false;
+  int32_t lit, m;
+  size_t i;
+
+  BTOR_RESET_STACK (simp->tmp);
+  for (i = 0; i < n && !satisfied; i++)
+  {
+    lit = repr_lit (simp, lits[i]);
+    v   = get_var (simp, lit);
+    assert (!v->eliminated);
+    if (v->fixed)
+    {
+      satisfied = fixed_lit (simp, lit) > 0;
+      continue;
+    }
+    m = mark_lit (simp, lit);
+    if (m > 0) continue;
+    if (m < 0)
+    {
+      satisfied = true;
+      continue;
+    }
+    v->mark = sign_lit (lit);
+    BTOR_PUSH_STACK (simp->tmp, lit);
+  }
+  for (i = 0; i < BTOR_COUNT_STACK (simp->tmp); i++)
+    get_var (simp, BTOR_PEEK_STACK (simp->tmp, i))->mark = 0;
+
+  if (satisfied) return;
+  if (BTOR_EMPTY_STACK (simp->tmp))
+    simp->inconsistent = true;
+  else if (BTOR_COUNT_STACK (simp->tmp) == 1)
+    assign (simp, BTOR_TOP_STACK (simp->tmp));
+  else
+    store_clause (simp, &simp->tmp);
+}
+
+/* Removes 'lit' from buffered clause 'c' without updating occurrences. */
+static void
+remove_lit (BtorSATSimp *simp, int32_t c, int32_t lit)
+{
+  int32_t *lits, size, i;
+
+  lits = BTOR_SIMP_LITS (simp, c);
+  size = BTOR_SIMP_SIZE (simp, c);
+  for (i = 0; lits[i] != lit; i++) assert (i + 1 < size);
+  lits[i]                  = lits[size - 1];
+  BTOR_SIMP_SIZE (simp, c) = size - 1;
+  if (size - 1 == 1)
+  {
+    BTOR_SIMP_GARBAGE (simp, c) = 1;
+    assign (simp, lits[0]);
+  }
+}
+
+static void
+strengthen (BtorSATSimp *simp, int32_t c, int32_t lit)
+{
+  BtorIntStack *occs;
+  size_t i;
+
+  occs = get_occs (simp, lit);
+  for (i = 0; BTOR_PEEK_STACK (*occs, i) != c; i++)
+    assert (i + 1 < BTOR_COUNT_STACK (*occs));
+  occs->start[i] = BTOR_POP_STACK (*occs);
+  remove_lit (simp, c, lit);
+  simp->stats.strengthened++;
+}
+
+/* Removes garbage clauses from occurrence list of 'lit' and returns the
+ * number of remaining occurrences. */
+static size_t
+flush_occs (BtorSATSimp *simp, int32_t lit)
+{
+  BtorIntStack *occs;
+  int32_t *p, *q;
+
+  occs = get_occs (simp, lit);
+  for (p = q = occs->start; p < occs->top; p++)
+    if (!BTOR_SIMP_GARBAGE (simp, *p)) *q++ = *p;
+  occs->top = q;
+  return BTOR_COUNT_STACK (*occs);
+}
+
+static void
+propagate (BtorSATSimp *simp)
+{
+  BtorIntStack *occs;
+  int32_t lit, c;
+  size_t i;
+
+  while (!simp->inconsistent
+         && simp->next_propagate < BTOR_COUNT_STACK (simp->units))
+  {
+    lit = BTOR_PEEK_STACK (simp->units, simp->next_propagate);
+    simp->next_propagate++;
+
+    occs = get_occs (simp, lit);
+    for (i = 0; i < BTOR_COUNT_STACK (*occs); i++)
+      BTOR_SIMP_GARBAGE (simp, occs->start[i]) = 1;
+    BTOR_RESET_STACK (*occs);
+
+    occs = get_occs (simp, -lit);
+    for (i = 0; i < BTOR_COUNT_STACK (*occs); i++)
+    {
+      c = occs->start[i];
+      if (BTOR_SIMP_GARBAGE (simp, c)) continue;
+      remove_lit (simp, c, -lit);
+    }
+    BTOR_RESET_STACK (*occs);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+static bool
+is_frozen (BtorSATSimp *simp, BtorSimpVar *v)
+{
+  return simp->smgr->inc_required && v->frozen;
+}
+
+/* Replaces variable 'idx' by literal 'lit' in all buffered clauses. */
+static void
+substitute (BtorSATSimp *simp, int32_t idx, int32_t lit)
+{
+  BtorSimpVar *v, *r;
+  BtorIntStack *occs;
+  int32_t i, j, c, *lits, size, m, sign, l;
+  size_t k;
+
+  v = get_var (simp, idx);
+  r = get_var (simp, lit);
+  assert (!v->repr);
+  assert (!v->sent);
+  assert (!r->repr);
+
+  v->repr = lit;
+  simp->stats.substituted++;
+  if (v->frozen)
+  {
+    /* The references to 'idx' now refer to 'lit', which is frozen in the
+     * wrapped solver as long as it is referenced. */
+    if (simp->smgr->api.melt) simp->smgr->api.melt (simp->smgr, idx);
+    r->frozen += v->frozen;
+    v->frozen = 0;
+  }
+
+  for (sign = 0; sign < 2; sign++)
+  {
+    occs = v->occs + sign;
+    l    = sign ? -lit : lit;
+    for (k = 0; k < BTOR_COUNT_STACK (*occs); k++)
+    {
+      c = occs->start[k];
+      if (BTOR_SIMP_GARBAGE (simp, c)) continue;
+      lits = BTOR_SIMP_LITS (simp, c);
+      size = BTOR_SIMP_SIZE (simp, c);
+      for (i = 0, j = -1, m = 0; i < size; i++)
+      {
+        if (abs (lits[i]) == idx)
+          j = i;
+        else if (lits[i] == l)
+          m = 1;
+        else if (lits[i] == -l)
+          m = -1;
+      }
+      assert (j >= 0);
+      if (m < 0)
+        BTOR_SIMP_GARBAGE (simp, c) = 1;
+      else if (m > 0)
+        remove_lit (simp, c, lits[j]);
+      else
+      {
+        lits[j] = l;
+        BTOR_PUSH_STACK (*get_occs (simp, l), c);
+        touch (simp, l);
+      }
+    }
+    BTOR_RELEASE_STACK (*occs);
+  }
+}
+
+#define BTOR_SIMP_DFS(l) (get_var (simp, l)->dfs[(l) < 0])
+#define BTOR_SIMP_LOW(l) (get_var (simp, l)->low[(l) < 0])
+#define BTOR_SIMP_ONSTACK(l) ((get_var (simp, l)->onstack >> ((l) < 0)) & 1)
+
+/* Searches strongly connected components of the binary implication graph of
+ * the buffered clauses reachable from 'root' (Tarjan).  All literals of a
+ * component are equivalent, the variables to be substituted are pushed onto
+ * 'subst' together with the literal replacing them. */
+static void
+find_scc (BtorSATSimp *simp,
+          int32_t root,
+          int32_t *index,
+          BtorIntStack *work,
+          BtorIntStack *scc,
+          BtorIntStack *subst)
+{
+  BtorSimpVar *v, *w, *r, *best;
+  BtorIntStack *occs;
+  int32_t u, c, *lits, other, lit, rlit;
+  size_t pos, i, start;
+
+#define BTOR_SIMP_VISIT(l)                            \
+  do                                                  \
+  {                                                   \
+    BTOR_SIMP_DFS (l) = BTOR_SIMP_LOW (l) = ++*index; \
+    get_var (simp, l)->onstack |= 1 << ((l) < 0);     \
+    BTOR_PUSH_STACK (*scc, l);                        \
+    BTOR_PUSH_STACK (*work, l);                       \
+    BTOR_PUSH_STACK (*work, 0);                       \
+  } while (0)
+
+  BTOR_SIMP_VISIT (root);
+  while (!BTOR_EMPTY_STACK (*work))
+  {
+    pos  = work->top[-1];
+    u    = work->top[-2];
+    occs = get_occs (simp, -u);
+    if (pos < BTOR_COUNT_STACK (*occs))
+    {
+      work->top[-1] = pos + 1;
+      c             = occs->start[pos];
+      if (BTOR_SIMP_GARBAGE (simp, c) || BTOR_SIMP_SIZE (simp, c) != 2)
+        continue;
+      lits  = BTOR_SIMP_LITS (simp, c);
+      other = lits[0] == -u ? lits[1] : lits[0];
+      if (!BTOR_SIMP_DFS (other))
+        BTOR_SIMP_VISIT (other);
+      else if (BTOR_SIMP_ONSTACK (other)
+               && BTOR_SIMP_DFS (other) < BTOR_SIMP_LOW (u))
+        BTOR_SIMP_LOW (u) = BTOR_SIMP_DFS (other);
+      continue;
+    }
+    work->top -= 2;
+    if (!BTOR_EMPTY_STACK (*work))
+    {
+      lit = work->top[-2];
+      if (BTOR_SIMP_LOW (u) < BTOR_SIMP_LOW (lit))
+        BTOR_SIMP_LOW (lit) = BTOR_SIMP_LOW (u);
+    }
+    if (BTOR_SIMP_LOW (u) != BTOR_SIMP_DFS (u)) continue;
+
+    for (start = BTOR_COUNT_STACK (*scc); scc->start[start - 1] != u; start--)
+      ;
+    start--;
+
+    /* Pick representative: prefer variables already sent to the SAT solver,
+     * then frozen variables, then the smallest index. */
+    best = 0;
+    rlit = 0;
+    for (i = start; i < BTOR_COUNT_STACK (*scc); i++)
+    {
+      lit = scc->start[i];
+      v   = get_var (simp, lit);
+      v->onstack &= ~(1 << (lit < 0));
+      if (v->mark == -sign_lit (lit)) simp->inconsistent = true;
+      v->mark = sign_lit (lit);
+      if (!best || (v->sent && !best->sent)
+          || (v->sent == best->sent
+              && ((v->frozen && !best->frozen)
+                  || (!v->frozen == !best->frozen && abs (lit) < abs (rlit)))))
+      {
+        best = v;
+        rlit = lit;
+      }
+    }
+    for (i = start; i < BTOR_COUNT_STACK (*scc); i++)
+    {
+      lit     = scc->start[i];
+      w       = get_var (simp, lit);
+      w->mark = 0;
+      if (simp->inconsistent || lit == rlit) continue;
+      if (w->sent || w->repr || w->assumed) continue;
+      r = get_var (simp, rlit);
+      if (is_frozen (simp, w) && !r->frozen) continue;
+      BTOR_PUSH_STACK (*subst, abs (lit));
+      BTOR_PUSH_STACK (*subst, lit < 0 ? -rlit : rlit);
+    }
+    scc->top = scc->start + start;
+  }
+#undef BTOR_SIMP_VISIT
+}
+
+/* Equivalent literal substitution. */
+static bool
+substitute_equivalences (BtorSATSimp *simp)
+{
+  BtorIntStack work, scc, subst;
+  BtorMemMgr *mm;
+  BtorSimpVar *v;
+  int32_t index, c, lit, idx;
+  size_t i, j;
+  bool res;
+
+  mm    = simp->smgr->btor->mm;
+  index = 0;
+  BTOR_INIT_STACK (mm, work);
+  BTOR_INIT_STACK (mm, scc);
+  BTOR_INIT_STACK (mm, subst);
+
+  for (i = 0; i < BTOR_COUNT_STACK (simp->clauses) && !simp->inconsistent;
+       i++)
+  {
+    c = BTOR_PEEK_STACK (simp->clauses, i);
+    if (BTOR_SIMP_GARBAGE (simp, c) || BTOR_SIMP_SIZE (simp, c) != 2)
+      continue;
+    for (j = 0; j < 4; j++)
+    {
+      lit = BTOR_SIMP_LITS (simp, c)[j / 2];
+      if (j & 1) lit = -lit;
+      if (BTOR_SIMP_DFS (lit)) continue;
+      find_scc (simp, lit, &index, &work, &scc, &subst);
+    }
+  }
+
+  for (i = 0; i < BTOR_COUNT_STACK (simp->touched); i++)
+  {
+    v          = get_var (simp, BTOR_PEEK_STACK (simp->touched, i));
+    v->dfs[0]  = v->dfs[1] = v->low[0] = v->low[1] = 0;
+    v->onstack = 0;
+  }
+
+  res = false;
+  for (i = 0; i < BTOR_COUNT_STACK (subst) && !simp->inconsistent; i += 2)
+  {
+    idx = BTOR_PEEK_STACK (subst, i);
+    lit = BTOR_PEEK_STACK (subst, i + 1);
+    /* Each equivalence is found twice, once per phase.  Variables assigned
+     * while substituting are not substituted anymore. */
+    if (get_var (simp, idx)->repr || get_var (simp, idx)->fixed
+        || get_var (simp, lit)->fixed)
+      continue;
+    substitute (simp, idx, lit);
+    res = true;
+  }
+
+  BTOR_RELEASE_STACK (work);
+  BTOR_RELEASE_STACK (scc);
+  BTOR_RELEASE_STACK (subst);
+  return res;
+}
+
+#undef BTOR_SIMP_DFS
+#undef BTOR_SIMP_LOW
+#undef BTOR_SIMP_ONSTACK
+
+/*------------------------------------------------------------------------*/
+
+/* Backward subsumption and self-subsuming resolution. */
+static bool
+subsume (BtorSATSimp *simp)
+{
+  BtorIntStack *occs;
+  int32_t c, d, size, *lits, lit, best, neg, m, j, k;
+  size_t i, l, cnt, min, matched;
+  uint64_t steps, limit;
+  bool res;
+
+  res   = false;
+  steps = 0;
+  limit = BTOR_SIMP_SUBSUME_EFFORT * (uint64_t) BTOR_COUNT_STACK (simp->arena);
+
+  for (i = 0; i < BTOR_COUNT_STACK (simp->clauses); i++)
+  {
+    if (simp->inconsistent || steps > limit) break;
+    c = BTOR_PEEK_STACK (simp->clauses, i);
+    if (BTOR_SIMP_GARBAGE (simp, c)) continue;
+    size = BTOR_SIMP_SIZE (simp, c);
+    if (size > BTOR_SIMP_SUBSUME_CLAUSE_SIZE) continue;
+
+    lits = BTOR_SIMP_LITS (simp, c);
+    best = 0;
+    min  = 0;
+    for (j = 0; j < size; j++)
+    {
+      lit = lits[j];
+      cnt = BTOR_COUNT_STACK (*get_occs (simp, lit))
+            + BTOR_COUNT_STACK (*get_occs (simp, -lit));
+      get_var (simp, lit)->mark = sign_lit (lit);
+      if (!best || cnt < min)
+      {
+        best = lit;
+        min  = cnt;
+      }
+    }
+
+    BTOR_RESET_STACK (simp->tmp);
+    for (k = 0; k < 2; k++)
+    {
+      occs = get_occs (simp, k ? -best : best);
+      for (l = 0; l < BTOR_COUNT_STACK (*occs); l++)
+      {
+        d = occs->start[l];
+        if (d != c && !BTOR_SIMP_GARBAGE (simp, d)
+            && BTOR_SIMP_SIZE (simp, d) >= size)
+          BTOR_PUSH_STACK (simp->tmp, d);
+      }
+    }
+
+    for (l = 0; l < BTOR_COUNT_STACK (simp->tmp); l++)
+    {
+      d = BTOR_PEEK_STACK (simp->tmp, l);
+      if (BTOR_SIMP_GARBAGE (simp, d)) continue;
+      steps += BTOR_SIMP_SIZE (simp, d);
+      neg     = 0;
+      matched = 0;
+      for (j = 0; j < BTOR_SIMP_SIZE (simp, d); j++)
+      {
+        lit = BTOR_SIMP_LITS (simp, d)[j];
+        m   = mark_lit (simp, lit);
+        if (m > 0)
+          matched++;
+        else if (m < 0)
+        {
+          if (neg) break;
+          neg = lit;
+          matched++;
+        }
+      }
+      if (matched != (size_t) size) continue;
+      if (!neg)
+      {
+        BTOR_SIMP_GARBAGE (simp, d) = 1;
+        simp->stats.subsumed++;
+      }
+      else
+        strengthen (simp, d, neg);
+      res = true;
+    }
+
+    lits = BTOR_SIMP_LITS (simp, c);
+    for (j = 0; j < size; j++) get_var (simp, lits[j])->mark = 0;
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static bool
+is_eliminable (BtorSATSimp *simp, BtorSimpVar *v)
+{
+  return !v->sent && !v->eliminated && !v->repr && !v->fixed && !v->assumed
+         && !is_frozen (simp, v);
+}
+
+/* Pushes the resolvent of 'c' and 'd' on variable 'idx' onto the resolvents
+ * stack. Returns 0 if the resolvent is tautological, -1 if it exceeds the
+ * size limit and 1 otherwise. */
+static int32_t
+resolve (BtorSATSimp *simp, int32_t c, int32_t d, int32_t idx)
+{
+  int32_t i, lit, m, *lits, res;
+  size_t start;
+
+  start = BTOR_COUNT_STACK (simp->resolvents);
+  lits  = BTOR_SIMP_LITS (simp, c);
+  for (i = 0; i < BTOR_SIMP_SIZE (simp, c); i++)
+  {
+    lit = lits[i];
+    if (abs (lit) == idx) continue;
+    get_var (simp, lit)->mark = sign_lit (lit);
+    BTOR_PUSH_STACK (simp->resolvents, lit);
+  }
+  res  = 1;
+  lits = BTOR_SIMP_LITS (simp, d);
+  for (i = 0; i < BTOR_SIMP_SIZE (simp, d) && res; i++)
+  {
+    lit = lits[i];
+    if (abs (lit) == idx) continue;
+    m = mark_lit (simp, lit);
+    if (m < 0)
+      res = 0;
+    else if (!m)
+      BTOR_PUSH_STACK (simp->resolvents, lit);
+  }
+  lits = BTOR_SIMP_LITS (simp, c);
+  for (i = 0; i < BTOR_SIMP_SIZE (simp, c); i++)
+    get_var (simp, lits[i])->mark = 0;
+  if (res
+      && BTOR_COUNT_STACK (simp->resolvents) - start
+             > BTOR_SIMP_ELIM_CLAUSE_SIZE)
+    res = -1;
+  if (res > 0)
+    BTOR_PUSH_STACK (simp->resolvents, 0);
+  else
+    simp->resolvents.top = simp->resolvents.start + start;
+  return res;
+}
+
+static void
+push_extension (BtorSATSimp *simp, int32_t c, int32_t witness)
+{
+  int32_t i, size, *lits;
+
+  size = BTOR_SIMP_SIZE (simp, c);
+  lits = BTOR_SIMP_LITS (simp, c);
+  BTOR_PUSH_STACK (simp->extension, witness);
+  for (i = 0; i < size; i++)
+    if (lits[i] != witness) BTOR_PUSH_STACK (simp->extension, lits[i]);
+  BTOR_PUSH_STACK (simp->extension, size);
+  BTOR_SIMP_GARBAGE (simp, c) = 1;
+}
+
+/* Bounded variable elimination: eliminate 'idx' if the number of
+ * non-tautological resolvents does not exceed the number of clauses
+ * containing 'idx'. */
+static bool
+eliminate_var (BtorSATSimp *simp, int32_t idx)
+{
+  BtorIntStack *pos, *neg;
+  size_t npos, nneg, i, j, n;
+  int32_t *p, *start, r;
+
+  npos = flush_occs (simp, idx);
+  nneg = flush_occs (simp, -idx);
+  if (!npos && !nneg) return false;
+  if (npos > BTOR_SIMP_ELIM_OCCS || nneg > BTOR_SIMP_ELIM_OCCS) return false;
+
+  pos = get_occs (simp, idx);
+  neg = get_occs (simp, -idx);
+  BTOR_RESET_STACK (simp->resolvents);
+  for (i = 0, n = 0; i < npos; i++)
+    for (j = 0; j < nneg; j++)
+    {
+      r = resolve (simp, pos->start[i], neg->start[j], idx);
+      if (!r) continue;
+      if (r < 0 || ++n > npos + nneg) return false;
+    }
+
+  for (i = 0; i < npos; i++) push_extension (simp, pos->start[i], idx);
+  for (i = 0; i < nneg; i++) push_extension (simp, neg->start[i], -idx);
+  BTOR_RELEASE_STACK (*pos);
+  BTOR_RELEASE_STACK (*neg);
+  get_var (simp, idx)->eliminated = 1;
+  simp->stats.eliminated++;
+  simp->stats.resolvents += n;
+
+  for (start = p = simp->resolvents.start; p < simp->resolvents.top; p++)
+  {
+    if (*p) continue;
+    new_clause (simp, start, p - start);
+    start = p + 1;
+  }
+  return true;
+}
+
+static int
+cmp_elim_cand (const void *p, const void *q)
+{
+  uint64_t a = *(const uint64_t *) p, b = *(const uint64_t *) q;
+  return a < b ? -1 : a > b;
+}
+
+static bool
+eliminate (BtorSATSimp *simp)
+{
+  BtorMemMgr *mm;
+  BtorSimpVar *v;
+  uint64_t *cands, cost;
+  size_t i, n, size;
+  int32_t idx;
+  bool res;
+
+  mm   = simp->smgr->btor->mm;
+  size = BTOR_COUNT_STACK (simp->touched);
+  if (!size) return false;
+  BTOR_NEWN (mm, cands, size);
+  for (i = 0, n = 0; i < size; i++)
+  {
+    idx = BTOR_PEEK_STACK (simp->touched, i);
+    v   = get_var (simp, idx);
+    if (!is_eliminable (simp, v)) continue;
+    cost       = flush_occs (simp, idx) * (uint64_t) flush_occs (simp, -idx);
+    cands[n++] = (cost << 32) | (uint32_t) idx;
+  }
+  qsort (cands, n, sizeof *cands, cmp_elim_cand);
+
+  res = false;
+  for (i = 0; i < n && !simp->inconsistent; i++)
+  {
+    idx = (int32_t) (cands[i] & 0xffffffff);
+    propagate (simp);
+    if (!is_eliminable (simp, get_var (simp, idx))) continue;
+    res |= eliminate_var (simp, idx);
+  }
+  propagate (simp);
+  BTOR_DELETEN (mm, cands, size);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Passes the simplified clauses and new top level units to the wrapped SAT
+ * solver and clears the clause buffer. */
+static void
+forward (BtorSATSimp *simp, BtorSATMgr *smgr)
+{
+  BtorSATMgr *wrapped_smgr = simp->smgr;
+  BtorSimpVar *v;
+  int32_t c, i, lit, *lits;
+  size_t k;
+
+  BTOR_RESET_STACK (simp->tmp);
+  for (; simp->next_forward < BTOR_COUNT_STACK (simp->units);
+       simp->next_forward++)
+  {
+    lit = BTOR_PEEK_STACK (simp->units, simp->next_forward);
+    BTOR_PUSH_STACK (simp->tmp, lit);
+    BTOR_PUSH_STACK (simp->tmp, 0);
+    get_var (simp, lit)->sent = 1;
+  }
+  for (k = 0; k < BTOR_COUNT_STACK (simp->clauses); k++)
+  {
+    c = BTOR_PEEK_STACK (simp->clauses, k);
+    if (BTOR_SIMP_GARBAGE (simp, c)) continue;
+    lits = BTOR_SIMP_LITS (simp, c);
+    for (i = 0; i < BTOR_SIMP_SIZE (simp, c); i++)
+    {
+      get_var (simp, lits[i])->sent = 1;
+      BTOR_PUSH_STACK (simp->tmp, lits[i]);
+    }
+    BTOR_PUSH_STACK (simp->tmp, 0);
+  }
+  if (simp->inconsistent && !simp->inconsistent_sent)
+  {
+    /* Contradicts the unit clause 'true_lit', which is added first. */
+    BTOR_PUSH_STACK (simp->tmp, -smgr->true_lit);
+    BTOR_PUSH_STACK (simp->tmp, 0);
+    simp->inconsistent_sent = true;
+  }
+
+  if (wrapped_smgr->api.add_clauses)
+    wrapped_smgr->api.add_clauses (
+        wrapped_smgr, simp->tmp.start, BTOR_COUNT_STACK (simp->tmp));
+  else
+    for (k = 0; k < BTOR_COUNT_STACK (simp->tmp); k++)
+      wrapped_smgr->api.add (wrapped_smgr, BTOR_PEEK_STACK (simp->tmp, k));
+
+  for (k = 0; k < BTOR_COUNT_STACK (simp->touched); k++)
+  {
+    v = get_var (simp, BTOR_PEEK_STACK (simp->touched, k));
+    BTOR_RELEASE_STACK (v->occs[0]);
+    BTOR_RELEASE_STACK (v->occs[1]);
+    v->touched = 0;
+  }
+  BTOR_RESET_STACK (simp->touched);
+  BTOR_RESET_STACK (simp->clauses);
+  BTOR_RESET_STACK (simp->arena);
+}
+
+static void
+preprocess (BtorSATSimp *simp)
+{
+  double start;
+  uint32_t round;
+  bool changed;
+
+  start = btor_util_time_stamp ();
+  propagate (simp);
+  for (round = 0; round < BTOR_SIMP_ROUNDS && !simp->inconsistent; round++)
+  {
+    if (BTOR_EMPTY_STACK (simp->clauses)) break;
+    changed = substitute_equivalences (simp);
+    propagate (simp);
+    changed |= subsume (simp);
+    propagate (simp);
+    changed |= eliminate (simp);
+    if (!changed) break;
+  }
+  simp->stats.time += btor_util_time_stamp () - start;
+}
+
+/* Computes the values of eliminated variables by processing the clauses on
+ * the extension stack in reverse order and flipping the witness literal of
+ * every clause that is not satisfied. */
+static int32_t value_lit (BtorSATSimp *simp, int32_t lit);
+
+static void
+extend (BtorSATSimp *simp)
+{
+  int32_t *p, *start, *q;
+  bool satisfied;
+
+  simp->extended = true;
+  for (p = simp->extension.top; p > simp->extension.start; p = start)
+  {
+    start                       = p - 1 - p[-1];
+    get_var (simp, *start)->val = -1;
+  }
+  for (p = simp->extension.top; p > simp->extension.start; p = start)
+  {
+    start     = p - 1 - p[-1];
+    satisfied = false;
+    for (q = start; q < p - 1 && !satisfied; q++)
+      satisfied = value_lit (simp, *q) > 0;
+    if (!satisfied) get_var (simp, *start)->val = sign_lit (*start);
+  }
+}
+
+static int32_t
+value_lit (BtorSATSimp *simp, int32_t lit)
+{
+  BtorSATMgr *wrapped_smgr = simp->smgr;
+  BtorSimpVar *v;
+
+  lit = repr_lit (simp, lit);
+  v   = get_var (simp, lit);
+  if (v->fixed) return fixed_lit (simp, lit);
+  if (v->eliminated)
+  {
+    if (!simp->extended) extend (simp);
+    return v->val * sign_lit (lit);
+  }
+  return wrapped_smgr->api.deref (wrapped_smgr, lit);
+}
+
+/*------------------------------------------------------------------------*/
+
+static void *
+simp_init (BtorSATMgr *smgr)
+{
+  BtorSATSimp *simp        = (BtorSATSimp *) smgr->solver;
+  BtorSATMgr *wrapped_smgr = simp->smgr;
+  BtorMemMgr *mm           = smgr->btor->mm;
+
+  BTOR_INIT_STACK (mm, simp->arena);
+  BTOR_INIT_STACK (mm, simp->clauses);
+  BTOR_INIT_STACK (mm, simp->touched);
+  BTOR_INIT_STACK (mm, simp->clause);
+  BTOR_INIT_STACK (mm, simp->assumptions);
+  BTOR_INIT_STACK (mm, simp->units);
+  BTOR_INIT_STACK (mm, simp->extension);
+  BTOR_INIT_STACK (mm, simp->tmp);
+  BTOR_INIT_STACK (mm, simp->resolvents);
+
+  /* See dimacs_printer_init in btorsat.c. */
+  BTOR_MSG (smgr->btor->msg, 1, "initialized %s", wrapped_smgr->name);
+  wrapped_smgr->initialized  = true;
+  wrapped_smgr->inc_required = true;
+  wrapped_smgr->sat_time     = 0;
+  wrapped_smgr->solver       = wrapped_smgr->api.init (wrapped_smgr);
+
+  return simp;
+}
+
+static void
+simp_add (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATSimp *simp = (BtorSATSimp *) smgr->solver;
+
+  if (lit)
+  {
+    BTOR_PUSH_STACK (simp->clause, lit);
+    return;
+  }
+  new_clause (simp, simp->clause.start, BTOR_COUNT_STACK (simp->clause));
+  BTOR_RESET_STACK (simp->clause);
+}
+
+static void
+simp_add_clauses (BtorSATMgr *smgr, const int32_t *lits, size_t n)
+{
+  size_t i;
+  for (i = 0; i < n; i++) simp_add (smgr, lits[i]);
+}
+
+/* Imported clauses are buffered like added clauses, clauses containing
+ * eliminated variables are dropped. */
+static void
+simp_import_clauses (BtorSATMgr *smgr, const int32_t *lits, size_t n)
+{
+  BtorSATSimp *simp = (BtorSATSimp *) smgr->solver;
+  bool eliminated;
+  size_t i, j;
+
+  for (i = 0; i < n; i = j + 1)
+  {
+    eliminated = false;
+    for (j = i; lits[j]; j++)
+      eliminated |= get_var (simp, repr_lit (simp, lits[j]))->eliminated;
+    if (!eliminated) new_clause (simp, lits + i, j - i);
+  }
+}
+
+static void
+simp_assume (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATSimp *simp = (BtorSATSimp *) smgr->solver;
+  BTOR_PUSH_STACK (simp->assumptions, lit);
+}
+
+static void
+mark_assumptions (BtorSATSimp *simp, bool assumed)
+{
+  BtorSimpVar *v;
+  size_t i;
+
+  for (i = 0; i < BTOR_COUNT_STACK (simp->assumptions); i++)
+  {
+    v          = get_var (simp, repr_lit (simp, simp->assumptions.start[i]));
+    v->assumed = assumed;
+  }
+}
+
+static int32_t
+simp_sat (BtorSATMgr *smgr, int32_t limit)
+{
+  BtorSATSimp *simp        = (BtorSATSimp *) smgr->solver;
+  BtorSATMgr *wrapped_smgr = simp->smgr;
+  int32_t lit;
+  size_t i;
+
+  assert (BTOR_EMPTY_STACK (simp->clause));
+
+  wrapped_smgr->inc_required = smgr->inc_required;
+  wrapped_smgr->satcalls     = smgr->satcalls;
+  /* Assumed variables are neither substituted nor eliminated. */
+  mark_assumptions (simp, true);
+  preprocess (simp);
+  forward (simp, smgr);
+  mark_assumptions (simp, false);
+  for (i = 0; i < BTOR_COUNT_STACK (simp->assumptions); i++)
+  {
+    lit = repr_lit (simp, BTOR_PEEK_STACK (simp->assumptions, i));
+    wrapped_smgr->api.assume (wrapped_smgr, lit);
+  }
+  BTOR_RESET_STACK (simp->assumptions);
+
+  simp->extended = false;
+  return wrapped_smgr->api.sat (wrapped_smgr, limit);
+}
+
+static int32_t
+simp_deref (BtorSATMgr *smgr, int32_t lit)
+{
+  return value_lit ((BtorSATSimp *) smgr->solver, lit);
+}
+
+static int32_t
+simp_repr (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATSimp *simp        = (BtorSATSimp *) smgr->solver;
+  BtorSATMgr *wrapped_smgr = simp->smgr;
+
+  lit = repr_lit (simp, lit);
+  if (!get_var (simp, lit)->sent || !wrapped_smgr->api.repr) return lit;
+  return wrapped_smgr->api.repr (wrapped_smgr, lit);
+}
+
+static int32_t
+simp_failed (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATSimp *simp        = (BtorSATSimp *) smgr->solver;
+  BtorSATMgr *wrapped_smgr = simp->smgr;
+  return wrapped_smgr->api.failed (wrapped_smgr, repr_lit (simp, lit));
+}
+
+static int32_t
+simp_fixed (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATSimp *simp        = (BtorSATSimp *) smgr->solver;
+  BtorSATMgr *wrapped_smgr = simp->smgr;
+  BtorSimpVar *v;
+
+  lit = repr_lit (simp, lit);
+  v   = get_var (simp, lit);
+  if (v->fixed) return fixed_lit (simp, lit);
+  if (!v->sent || !wrapped_smgr->api.fixed) return 0;
+  return wrapped_smgr->api.fixed (wrapped_smgr, lit);
+}
+
+static int32_t
+simp_inc_max_var (BtorSATMgr *smgr)
+{
+  BtorSATSimp *simp        = (BtorSATSimp *) smgr->solver;
+  BtorSATMgr *wrapped_smgr = simp->smgr;
+  BtorMemMgr *mm           = smgr->btor->mm;
+  BtorSimpVar *v;
+  uint32_t size;
+  int32_t res;
+
+  wrapped_smgr->inc_required = smgr->inc_required;
+  wrapped_smgr->maxvar       = smgr->maxvar;
+  if (wrapped_smgr->api.inc_max_var)
+    res = wrapped_smgr->api.inc_max_var (wrapped_smgr);
+  else
+    res = smgr->maxvar + 1;
+
+  if ((uint32_t) res >= simp->size_vars)
+  {
+    size = simp->size_vars ? 2 * simp->size_vars : 1024;
+    while (size <= (uint32_t) res) size *= 2;
+    BTOR_REALLOC (mm, simp->vars, simp->size_vars, size);
+    BTOR_CLRN (simp->vars + simp->size_vars, size - simp->size_vars);
+    simp->size_vars = size;
+  }
+  v = simp->vars + res;
+  BTOR_INIT_STACK (mm, v->occs[0]);
+  BTOR_INIT_STACK (mm, v->occs[1]);
+  v->frozen = smgr->inc_required ? 1 : 0;
+  return res;
+}
+
+static void
+simp_melt (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATSimp *simp        = (BtorSATSimp *) smgr->solver;
+  BtorSATMgr *wrapped_smgr = simp->smgr;
+  BtorSimpVar *v;
+
+  lit = repr_lit (simp, lit);
+  v   = get_var (simp, lit);
+  if (!v->frozen) return;
+  if (--v->frozen) return;
+  wrapped_smgr->inc_required = smgr->inc_required;
+  if (wrapped_smgr->api.melt) wrapped_smgr->api.melt (wrapped_smgr, lit);
+}
+
+static void
+simp_enable_verbosity (BtorSATMgr *smgr, int32_t level)
+{
+  BtorSATSimp *simp        = (BtorSATSimp *) smgr->solver;
+  BtorSATMgr *wrapped_smgr = simp->smgr;
+  if (wrapped_smgr->api.enable_verbosity)
+    wrapped_smgr->api.enable_verbosity (wrapped_smgr, level);
+}
+
+static void
+simp_set_output (BtorSATMgr *smgr, FILE *output)
+{
+  BtorSATSimp *simp        = (BtorSATSimp *) smgr->solver;
+  BtorSATMgr *wrapped_smgr = simp->smgr;
+  wrapped_smgr->output     = output;
+  if (wrapped_smgr->api.set_output)
+    wrapped_smgr->api.set_output (wrapped_smgr, output);
+}
+
+static void
+simp_set_prefix (BtorSATMgr *smgr, const char *prefix)
+{
+  BtorSATSimp *simp        = (BtorSATSimp *) smgr->solver;
+  BtorSATMgr *wrapped_smgr = simp->smgr;
+  if (wrapped_smgr->api.set_prefix)
+    wrapped_smgr->api.set_prefix (wrapped_smgr, prefix);
+}
+
+static void
+simp_setterm (BtorSATMgr *smgr)
+{
+  BtorSATSimp *simp        = (BtorSATSimp *) smgr->solver;
+  BtorSATMgr *wrapped_smgr = simp->smgr;
+  wrapped_smgr->term       = smgr->term;
+  wrapped_smgr->api.setterm (wrapped_smgr);
+}
+
+static void
+simp_export_learned (BtorSATMgr *smgr)
+{
+  BtorSATSimp *simp        = (BtorSATSimp *) smgr->solver;
+  BtorSATMgr *wrapped_smgr = simp->smgr;
+  wrapped_smgr->share      = smgr->share;
+  wrapped_smgr->api.export_learned (wrapped_smgr);
+}
+
+static void
+simp_stats (BtorSATMgr *smgr)
+{
+  BtorSATSimp *simp        = (BtorSATSimp *) smgr->solver;
+  BtorSATMgr *wrapped_smgr = simp->smgr;
+
+  BTOR_MSG (smgr->btor->msg,
+            1,
+            "%u variables eliminated (%u resolvents)",
+            simp->stats.eliminated,
+            simp->stats.resolvents);
+  BTOR_MSG (smgr->btor->msg,
+            1,
+            "%u variables substituted, %u units",
+            simp->stats.substituted,
+            simp->stats.units);
+  BTOR_MSG (smgr->btor->msg,
+            1,
+            "%u clauses subsumed, %u strengthened",
+            simp->stats.subsumed,
+            simp->stats.strengthened);
+  BTOR_MSG (smgr->btor->msg,
+            1,
+            "%.1f seconds preprocessing",
+            simp->stats.time);
+  if (wrapped_smgr->api.stats) wrapped_smgr->api.stats (wrapped_smgr);
+}
+
+static void
+simp_reset (BtorSATMgr *smgr)
+{
+  BtorSATSimp *simp        = (BtorSATSimp *) smgr->solver;
+  BtorSATMgr *wrapped_smgr = simp->smgr;
+  BtorMemMgr *mm           = smgr->btor->mm;
+  uint32_t i;
+
+  wrapped_smgr->api.reset (wrapped_smgr);
+  BTOR_DELETE (mm, wrapped_smgr);
+
+  for (i = 0; i < simp->size_vars; i++)
+  {
+    if (!simp->vars[i].occs[0].mm) continue;
+    BTOR_RELEASE_STACK (simp->vars[i].occs[0]);
+    BTOR_RELEASE_STACK (simp->vars[i].occs[1]);
+  }
+  BTOR_DELETEN (mm, simp->vars, simp->size_vars);
+  BTOR_RELEASE_STACK (simp->arena);
+  BTOR_RELEASE_STACK (simp->clauses);
+  BTOR_RELEASE_STACK (simp->touched);
+  BTOR_RELEASE_STACK (simp->clause);
+  BTOR_RELEASE_STACK (simp->assumptions);
+  BTOR_RELEASE_STACK (simp->units);
+  BTOR_RELEASE_STACK (simp->extension);
+  BTOR_RELEASE_STACK (simp->tmp);
+  BTOR_RELEASE_STACK (simp->resolvents);
+  BTOR_DELETE (mm, simp);
+  smgr->solver = 0;
+}
+
+static void
+clone_int_stack (BtorMemMgr *mm, BtorIntStack *clone, BtorIntStack *stack)
+{
+  size_t size = BTOR_SIZE_STACK (*stack);
+  size_t cnt  = BTOR_COUNT_STACK (*stack);
+
+  BTOR_INIT_STACK (mm, *clone);
+  if (size)
+  {
+    BTOR_CNEWN (mm, clone->start, size);
+    clone->end = clone->start + size;
+    clone->top = clone->start + cnt;
+    memcpy (clone->start, stack->start, cnt * sizeof (int32_t));
+  }
+}
+
+static void *
+simp_clone (Btor *btor, BtorSATMgr *smgr)
+{
+  BtorSATSimp *simp, *res;
+  BtorMemMgr *mm;
+  uint32_t i;
+
+  mm   = btor->mm;
+  simp = (BtorSATSimp *) smgr->solver;
+
+  BTOR_NEW (mm, res);
+  memcpy (res, simp, sizeof *res);
+  res->smgr = btor_sat_mgr_clone (btor, simp->smgr);
+  res->vars = 0;
+  if (simp->size_vars)
+  {
+    BTOR_NEWN (mm, res->vars, simp->size_vars);
+    memcpy (res->vars, simp->vars, simp->size_vars * sizeof *simp->vars);
+    for (i = 0; i < simp->size_vars; i++)
+    {
+      if (!simp->vars[i].occs[0].mm) continue;
+      clone_int_stack (mm, res->vars[i].occs, simp->vars[i].occs);
+      clone_int_stack (mm, res->vars[i].occs + 1, simp->vars[i].occs + 1);
+    }
+  }
+  clone_int_stack (mm, &res->arena, &simp->arena);
+  clone_int_stack (mm, &res->clauses, &simp->clauses);
+  clone_int_stack (mm, &res->touched, &simp->touched);
+  clone_int_stack (mm, &res->clause, &simp->clause);
+  clone_int_stack (mm, &res->assumptions, &simp->assumptions);
+  clone_int_stack (mm, &res->units, &simp->units);
+  clone_int_stack (mm, &res->extension, &simp->extension);
+  BTOR_INIT_STACK (mm, res->tmp);
+  BTOR_INIT_STACK (mm, res->resolvents);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+bool
+btor_sat_enable_simp (BtorSATMgr *smgr)
+{
+  assert (smgr);
+  assert (smgr->name);
+
+  BtorSATSimp *simp;
+
+  /* Initialize preprocessor and copy current SAT manager. */
+  BTOR_CNEW (smgr->btor->mm, simp);
+  BTOR_CNEW (smgr->btor->mm, simp->smgr);
+  memcpy (simp->smgr, smgr, sizeof (BtorSATMgr));
+
+  /* Clear API */
+  memset (&smgr->api, 0, sizeof (smgr->api));
+
+  smgr->solver               = simp;
+  smgr->name                 = "CNF Preprocessor";
+  smgr->api.add              = simp_add;
+  smgr->api.add_clauses      = simp_add_clauses;
+  smgr->api.deref            = simp_deref;
+  smgr->api.enable_verbosity = simp_enable_verbosity;
+  smgr->api.fixed            = simp_fixed;
+  smgr->api.inc_max_var      = simp_inc_max_var;
+  smgr->api.init             = simp_init;
+  smgr->api.melt             = simp_melt;
+  smgr->api.repr             = simp_repr;
+  smgr->api.reset            = simp_reset;
+  smgr->api.sat              = simp_sat;
+  smgr->api.set_output       = simp_set_output;
+  smgr->api.set_prefix       = simp_set_prefix;
+  smgr->api.stats            = simp_stats;
+  smgr->api.import_clauses   = simp_import_clauses;
+
+  /* Only set if supported by the wrapped SAT solver, see
+   * enable_dimacs_printer in btorsat.c. */
+  smgr->api.assume  = simp->smgr->api.assume ? simp_assume : 0;
+  smgr->api.failed  = simp->smgr->api.failed ? simp_failed : 0;
+  smgr->api.clone   = simp->smgr->api.clone ? simp_clone : 0;
+  smgr->api.setterm = simp->smgr->api.setterm ? simp_setterm : 0;
+  smgr->api.export_learned =
+      simp->smgr->api.export_learned ? simp_export_learned : 0;
+
+  return true;
+}
@@ -0,0 +1,21 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORSATSIMP_H_INCLUDED
+#define BTORSATSIMP_H_INCLUDED
+
+#include "btorsat.h"
+
+/* Wraps the currently enabled SAT solver of 'smgr' into a CNF preprocessor,
+ * which simplifies the clauses added between two SAT calls (unit propagation,
+ * equivalent literal substitution, subsumption and bounded variable
+ * elimination) before passing them on to the wrapped SAT solver.
+ * Assumes that a SAT solver was already enabled. */
+bool btor_sat_enable_simp (BtorSATMgr *smgr);
+
+#endif
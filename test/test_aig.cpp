@@ -143,3 +143,92 @@ TEST_F (TestAig, aig_to_sat)
   btor_aig_release (amgr, and3);
   btor_aig_mgr_delete (amgr);
 }
+
+TEST_F (TestAig, add_toplevel_to_sat)
+{
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorSATMgr *smgr = btor_aig_get_sat_mgr (amgr);
+  BtorAIG *var1    = btor_aig_var (amgr);
+  BtorAIG *var2    = btor_aig_var (amgr);
+  BtorAIG *var3    = btor_aig_var (amgr);
+  BtorAIG *var4    = btor_aig_var (amgr);
+  BtorAIG *and1    = btor_aig_and (amgr, var1, var2);
+  BtorAIG *and2    = btor_aig_and (amgr, var3, var4);
+  BtorAIG *and3    = btor_aig_or (amgr, and1, and2);
+  btor_sat_enable_solver (smgr);
+  btor_sat_init (smgr);
+  btor_aig_add_toplevel_to_sat (amgr, and3);
+  btor_aig_add_toplevel_to_sat (amgr, var1);
+  btor_aig_add_toplevel_to_sat (amgr, var2);
+  btor_aig_add_toplevel_to_sat (amgr, var3);
+  btor_aig_add_toplevel_to_sat (amgr, var4);
+  ASSERT_EQ (btor_sat_check_sat (smgr, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (btor_aig_get_assignment (amgr, and1), 1);
+  ASSERT_EQ (btor_aig_get_assignment (amgr, and2), 1);
+  ASSERT_EQ (btor_aig_get_assignment (amgr, and3), 1);
+  /* 'and1' only occurs positively so far and is upgraded here */
+  btor_aig_to_sat (amgr, and1);
+  btor_sat_assume (smgr, -btor_aig_get_cnf_id (and1));
+  ASSERT_EQ (btor_sat_check_sat (smgr, -1), BTOR_RESULT_UNSAT);
+  btor_sat_reset (smgr);
+  btor_aig_release (amgr, var1);
+  btor_aig_release (amgr, var2);
+  btor_aig_release (amgr, var3);
+  btor_aig_release (amgr, var4);
+  btor_aig_release (amgr, and1);
+  btor_aig_release (amgr, and2);
+  btor_aig_release (amgr, and3);
+  btor_aig_mgr_delete (amgr);
+}
+
+TEST_F (TestAig, gc)
+{
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorSATMgr *smgr = btor_aig_get_sat_mgr (amgr);
+  BtorAIG *var1    = btor_aig_var (amgr);
+  BtorAIG *var2    = btor_aig_var (amgr);
+  BtorAIG *var3    = btor_aig_var (amgr);
+  BtorAIG *var4    = btor_aig_var (amgr);
+  BtorAIG *and1    = btor_aig_and (amgr, var1, var2);
+  BtorAIG *and2, *and3;
+  btor_sat_enable_solver (smgr);
+  btor_sat_init (smgr);
+  btor_aig_to_sat (amgr, and1);
+  btor_aig_release (amgr, and1);
+  btor_aig_release (amgr, var2);
+  and2 = btor_aig_and (amgr, var3, BTOR_INVERT_AIG (var4));
+  btor_aig_to_sat (amgr, and2);
+  ASSERT_EQ (btor_aig_mgr_num_dead_ids (amgr), 2u);
+  ASSERT_EQ (and2->id, 7);
+
+  btor_aig_mgr_gc (amgr);
+  ASSERT_EQ (btor_aig_mgr_num_dead_ids (amgr), 0u);
+  ASSERT_EQ (BTOR_COUNT_STACK (amgr->id2aig), 6u);
+  ASSERT_EQ (amgr->num_gc_ids, 2u);
+  ASSERT_EQ (var1->id, 2);
+  ASSERT_EQ (var3->id, 3);
+  ASSERT_EQ (var4->id, 4);
+  ASSERT_EQ (and2->id, 5);
+  ASSERT_EQ (btor_aig_get_left_child (amgr, and2), var3);
+  ASSERT_EQ (btor_aig_get_right_child (amgr, and2), BTOR_INVERT_AIG (var4));
+  ASSERT_EQ (amgr->cnfid2aig.start[and2->cnf_id], and2->id);
+  ASSERT_EQ (amgr->cnfid2aig.start[var3->cnf_id], var3->id);
+
+  /* unique table is rebuilt */
+  and3 = btor_aig_and (amgr, var3, BTOR_INVERT_AIG (var4));
+  ASSERT_EQ (and3, and2);
+  btor_aig_release (amgr, and3);
+  and3 = btor_aig_and (amgr, var1, var3);
+  ASSERT_EQ (and3->id, 6);
+
+  btor_sat_assume (smgr, btor_aig_get_cnf_id (and2));
+  ASSERT_EQ (btor_sat_check_sat (smgr, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (btor_aig_get_assignment (amgr, var4), -1);
+  btor_sat_reset (smgr);
+  btor_aig_release (amgr, var1);
+  btor_aig_release (amgr, var3);
+  btor_aig_release (amgr, var4);
+  btor_aig_release (amgr, and2);
+  btor_aig_release (amgr, and3);
+  btor_aig_mgr_delete (amgr);
+}
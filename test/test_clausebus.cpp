@@ -0,0 +1,223 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btoraig.h"
+#include "btorclausebus.h"
+#include "btorclone.h"
+#include "btorcore.h"
+}
+
+class TestClauseBus : public TestBtor
+{
+ protected:
+  void SetUp () override
+  {
+    TestBtor::SetUp ();
+    d_btor2 = btor_new ();
+    d_bus   = btor_clause_bus_new ();
+  }
+  void TearDown () override
+  {
+    btor_clause_bus_delete (d_bus);
+    btor_delete (d_btor2);
+    TestBtor::TearDown ();
+  }
+  /* 'btor1' and 'btor2' correspond on AIGs 'x_id' and 'y_id' (encoded to CNF),
+   * and create different AIGs with the same ids afterwards.  If 'attach' is
+   * true, they are attached after diverging (which requires that they are
+   * clones), else they must be attached already. */
+  void test_diverged (
+      Btor *btor1, Btor *btor2, int32_t x_id, int32_t y_id, bool attach)
+  {
+    BtorAIGMgr *amgr1 = btor_get_aig_mgr (btor1);
+    BtorAIGMgr *amgr2 = btor_get_aig_mgr (btor2);
+    BtorAIG *x1       = btor_aig_get_by_id (amgr1, x_id);
+    BtorAIG *x2       = btor_aig_get_by_id (amgr2, x_id);
+    BtorAIG *y2       = btor_aig_get_by_id (amgr2, y_id);
+    BtorAIG *v1, *w1, *t2;
+    int32_t lits[1];
+
+    v1 = btor_aig_var (amgr1);
+    t2 = btor_aig_and (amgr2, x2, y2);
+    ASSERT_EQ (v1->id, t2->id);
+    btor_aig_to_sat (amgr1, v1);
+    btor_aig_to_sat (amgr2, t2);
+
+    /* clauses over AIGs created after cloning or attaching are not shared */
+    if (attach) btor_clause_bus_attach (d_bus, btor1);
+    lits[0] = btor_aig_get_cnf_id (v1);
+    btor_clause_bus_publish (d_bus, btor1, lits, 1);
+    if (attach) btor_clause_bus_attach (d_bus, btor2);
+    ASSERT_EQ (btor_clause_bus_import (d_bus, btor2), 0u);
+
+    w1 = btor_aig_var (amgr1);
+    btor_aig_to_sat (amgr1, w1);
+    lits[0] = -btor_aig_get_cnf_id (w1);
+    btor_clause_bus_publish (d_bus, btor1, lits, 1);
+    ASSERT_EQ (btor_clause_bus_import (d_bus, btor2), 0u);
+
+    lits[0] = -btor_aig_get_cnf_id (x1);
+    btor_clause_bus_publish (d_bus, btor1, lits, 1);
+    ASSERT_EQ (btor_clause_bus_import (d_bus, btor2), 1u);
+    btor_sat_assume (btor_get_sat_mgr (btor2), btor_aig_get_cnf_id (t2));
+    ASSERT_EQ (btor_sat_check_sat (btor_get_sat_mgr (btor2), -1),
+               BTOR_RESULT_UNSAT);
+
+    btor_aig_release (amgr1, v1);
+    btor_aig_release (amgr1, w1);
+    btor_aig_release (amgr2, t2);
+  }
+
+  Btor *d_btor2        = nullptr;
+  BtorClauseBus *d_bus = nullptr;
+};
+
+TEST_F (TestClauseBus, new_delete) {}
+
+TEST_F (TestClauseBus, attach_detach)
+{
+  btor_clause_bus_attach (d_bus, d_btor);
+  btor_clause_bus_attach (d_bus, d_btor2);
+  btor_clause_bus_detach (d_bus, d_btor);
+  btor_clause_bus_detach (d_bus, d_btor2);
+}
+
+TEST_F (TestClauseBus, share)
+{
+  BtorAIGMgr *amgr1 = btor_get_aig_mgr (d_btor);
+  BtorAIGMgr *amgr2 = btor_get_aig_mgr (d_btor2);
+  BtorSATMgr *smgr1 = btor_get_sat_mgr (d_btor);
+  BtorSATMgr *smgr2 = btor_get_sat_mgr (d_btor2);
+  BtorAIG *x1       = btor_aig_var (amgr1);
+  BtorAIG *y1       = btor_aig_var (amgr1);
+  BtorAIG *t1       = btor_aig_and (amgr1, x1, y1);
+  BtorAIG *x2       = btor_aig_var (amgr2);
+  BtorAIG *y2       = btor_aig_var (amgr2);
+  BtorAIG *t2       = btor_aig_and (amgr2, x2, y2);
+  int32_t lits[1];
+
+  ASSERT_EQ (x1->id, x2->id);
+  ASSERT_EQ (y1->id, y2->id);
+  ASSERT_EQ (t1->id, t2->id);
+
+  btor_sat_enable_solver (smgr1);
+  btor_sat_init (smgr1);
+  btor_sat_enable_solver (smgr2);
+  btor_sat_init (smgr2);
+  btor_aig_to_sat (amgr1, t1);
+  /* different encoding order yields different CNF ids */
+  btor_aig_to_sat (amgr2, x2);
+  btor_aig_to_sat (amgr2, t2);
+  ASSERT_NE (btor_aig_get_cnf_id (x1), btor_aig_get_cnf_id (x2));
+
+  btor_clause_bus_attach (d_bus, d_btor);
+  btor_clause_bus_attach (d_bus, d_btor2);
+
+  lits[0] = -btor_aig_get_cnf_id (x1);
+  btor_clause_bus_publish (d_bus, d_btor, lits, 1);
+  /* duplicates and clauses over CNF ids without AIG are not published */
+  btor_clause_bus_publish (d_bus, d_btor, lits, 1);
+  lits[0] = smgr1->true_lit;
+  btor_clause_bus_publish (d_bus, d_btor, lits, 1);
+
+  ASSERT_EQ (btor_clause_bus_import (d_bus, d_btor), 0u);
+  ASSERT_EQ (btor_clause_bus_import (d_bus, d_btor2), 1u);
+  ASSERT_EQ (btor_clause_bus_import (d_bus, d_btor2), 0u);
+  btor_sat_assume (smgr2, btor_aig_get_cnf_id (t2));
+  ASSERT_EQ (btor_sat_check_sat (smgr2, -1), BTOR_RESULT_UNSAT);
+  btor_sat_assume (smgr2, btor_aig_get_cnf_id (y2));
+  ASSERT_EQ (btor_sat_check_sat (smgr2, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (btor_aig_get_assignment (amgr2, x2), -1);
+
+  /* clauses are imported before each SAT call */
+  lits[0] = btor_aig_get_cnf_id (y2);
+  btor_clause_bus_publish (d_bus, d_btor2, lits, 1);
+  ASSERT_EQ (btor_sat_check_sat (smgr1, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (btor_aig_get_assignment (amgr1, x1), -1);
+  ASSERT_EQ (btor_aig_get_assignment (amgr1, y1), 1);
+
+  btor_clause_bus_detach (d_bus, d_btor);
+  btor_clause_bus_detach (d_bus, d_btor2);
+  btor_aig_release (amgr1, x1);
+  btor_aig_release (amgr1, y1);
+  btor_aig_release (amgr1, t1);
+  btor_aig_release (amgr2, x2);
+  btor_aig_release (amgr2, y2);
+  btor_aig_release (amgr2, t2);
+}
+
+TEST_F (TestClauseBus, diverged)
+{
+  BtorAIGMgr *amgr1 = btor_get_aig_mgr (d_btor);
+  BtorAIGMgr *amgr2 = btor_get_aig_mgr (d_btor2);
+  BtorAIG *x1       = btor_aig_var (amgr1);
+  BtorAIG *y1       = btor_aig_var (amgr1);
+  BtorAIG *x2       = btor_aig_var (amgr2);
+  BtorAIG *y2       = btor_aig_var (amgr2);
+
+  btor_sat_enable_solver (btor_get_sat_mgr (d_btor));
+  btor_sat_init (btor_get_sat_mgr (d_btor));
+  btor_sat_enable_solver (btor_get_sat_mgr (d_btor2));
+  btor_sat_init (btor_get_sat_mgr (d_btor2));
+  btor_aig_to_sat (amgr1, x1);
+  btor_aig_to_sat (amgr1, y1);
+  btor_aig_to_sat (amgr2, x2);
+  btor_aig_to_sat (amgr2, y2);
+
+  btor_clause_bus_attach (d_bus, d_btor);
+  btor_clause_bus_attach (d_bus, d_btor2);
+  test_diverged (d_btor, d_btor2, x1->id, y1->id, false);
+  btor_clause_bus_detach (d_bus, d_btor);
+  btor_clause_bus_detach (d_bus, d_btor2);
+
+  btor_aig_release (amgr1, x1);
+  btor_aig_release (amgr1, y1);
+  btor_aig_release (amgr2, x2);
+  btor_aig_release (amgr2, y2);
+}
+
+#if defined(BTOR_USE_LINGELING) || defined(BTOR_USE_CADICAL)
+TEST_F (TestClauseBus, diverged_clones)
+{
+  BtorAIGMgr *amgr = btor_get_aig_mgr (d_btor);
+  BtorSATMgr *smgr = btor_get_sat_mgr (d_btor);
+  BtorAIG *x, *y, *t;
+  Btor *clone1, *clone2;
+
+#ifdef BTOR_USE_LINGELING
+  btor_opt_set (d_btor, BTOR_OPT_SAT_ENGINE, BTOR_SAT_ENGINE_LINGELING);
+#else
+  btor_opt_set (d_btor, BTOR_OPT_SAT_ENGINE, BTOR_SAT_ENGINE_CADICAL);
+#endif
+  x = btor_aig_var (amgr);
+  y = btor_aig_var (amgr);
+  btor_sat_enable_solver (smgr);
+  btor_sat_init (smgr);
+  btor_aig_to_sat (amgr, x);
+  btor_aig_to_sat (amgr, y);
+
+  /* AIGs created by the parent after cloning are not shared either */
+  clone1 = btor_clone_btor (d_btor);
+  t      = btor_aig_and (amgr, x, y);
+  clone2 = btor_clone_btor (d_btor);
+  ASSERT_EQ (btor_get_aig_mgr (clone2)->num_shared_ids, t->id);
+
+  test_diverged (clone1, clone2, x->id, y->id, true);
+  btor_clause_bus_detach (d_bus, clone1);
+  btor_clause_bus_detach (d_bus, clone2);
+
+  btor_delete (clone1);
+  btor_delete (clone2);
+  btor_aig_release (amgr, x);
+  btor_aig_release (amgr, y);
+  btor_aig_release (amgr, t);
+}
+#endif
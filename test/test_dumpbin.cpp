@@ -0,0 +1,338 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "boolector.h"
+}
+
+class TestDumpBin : public TestBoolector
+{
+ protected:
+  void SetUp () override
+  {
+    TestBoolector::SetUp ();
+
+    d_file = tmpfile ();
+    ASSERT_NE (d_file, nullptr);
+    d_parsed = boolector_new ();
+  }
+
+  void TearDown () override
+  {
+    if (d_parsed) boolector_delete (d_parsed);
+    if (d_file) fclose (d_file);
+
+    TestBoolector::TearDown ();
+  }
+
+  /* Dump d_btor in binary format and parse it into d_parsed. */
+  int32_t round_trip ()
+  {
+    boolector_dump_btor_binary (d_btor, d_file);
+    rewind (d_file);
+    return parse ();
+  }
+
+  int32_t parse ()
+  {
+    char *error_msg;
+    int32_t status;
+    bool parsed_smt2;
+
+    return boolector_parse (d_parsed,
+                            d_file,
+                            "dump",
+                            stdout,
+                            &error_msg,
+                            &status,
+                            &parsed_smt2);
+  }
+
+  /* Dump d_btor, overwrite byte at 'pos' (or truncate the dump at 'pos' if
+   * 'byte' is negative) and parse the result. */
+  int32_t corrupt (long pos, int32_t byte)
+  {
+    FILE *dump;
+    long size, i;
+
+    dump = tmpfile ();
+    boolector_dump_btor_binary (d_btor, dump);
+    size = ftell (dump);
+    rewind (dump);
+    fclose (d_file);
+    d_file = tmpfile ();
+    for (i = 0; i < size; i++)
+    {
+      int32_t ch = getc (dump);
+      if (i == pos)
+      {
+        if (byte < 0) break;
+        ch = byte;
+      }
+      putc (ch, d_file);
+    }
+    fclose (dump);
+    rewind (d_file);
+    return parse ();
+  }
+
+  /* Dump d_btor and return the offset of the first occurrence of byte
+   * sequence 'seq' of length 'n' in the dump (-1 if not found). */
+  long find (const uint8_t *seq, size_t n)
+  {
+    FILE *dump;
+    uint8_t *buf;
+    long size, res;
+    size_t i;
+
+    dump = tmpfile ();
+    boolector_dump_btor_binary (d_btor, dump);
+    size = ftell (dump);
+    rewind (dump);
+    buf = new uint8_t[size];
+    if (fread (buf, 1, size, dump) != (size_t) size) size = 0;
+    fclose (dump);
+    for (res = 0; res + (long) n <= size; res++)
+    {
+      for (i = 0; i < n && buf[res + i] == seq[i]; i++)
+        ;
+      if (i == n) break;
+    }
+    delete[] buf;
+    return res + (long) n <= size ? res : -1;
+  }
+
+  void reset_parsed ()
+  {
+    boolector_delete (d_parsed);
+    d_parsed = boolector_new ();
+  }
+
+  FILE *d_file   = nullptr;
+  Btor *d_parsed = nullptr;
+};
+
+TEST_F (TestDumpBin, bv)
+{
+  BoolectorSort s8, s80;
+  BoolectorNode *x, *y, *z, *c, *w, *mul, *ult, *ext, *slice, *eq, *ne;
+  BoolectorNode *node;
+
+  s8    = boolector_bitvec_sort (d_btor, 8);
+  s80   = boolector_bitvec_sort (d_btor, 80);
+  x     = boolector_var (d_btor, s8, "x");
+  y     = boolector_var (d_btor, s8, "y");
+  z     = boolector_var (d_btor, s80, 0);
+  c     = boolector_unsigned_int (d_btor, 123, s8);
+  w     = boolector_consth (d_btor, s80, "8000000000000000abcd");
+  mul   = boolector_mul (d_btor, x, y);
+  ult   = boolector_ult (d_btor, c, mul);
+  ext   = boolector_concat (d_btor, x, y);
+  slice = boolector_slice (d_btor, ext, 11, 4);
+  eq    = boolector_eq (d_btor, slice, c);
+  ne    = boolector_ne (d_btor, z, w);
+  boolector_assert (d_btor, ult);
+  boolector_assert (d_btor, boolector_not (d_btor, eq));
+  boolector_assert (d_btor, ne);
+
+  ASSERT_EQ (round_trip (), BOOLECTOR_PARSE_UNKNOWN);
+  ASSERT_EQ (boolector_sat (d_parsed), BOOLECTOR_SAT);
+  node = boolector_match_node_by_symbol (d_parsed, "x");
+  ASSERT_NE (node, nullptr);
+  boolector_release (d_parsed, node);
+
+  boolector_release_all (d_btor);
+}
+
+TEST_F (TestDumpBin, unsat)
+{
+  BoolectorSort s32;
+  BoolectorNode *x, *y, *add, *sub, *eq;
+
+  s32 = boolector_bitvec_sort (d_btor, 32);
+  x   = boolector_var (d_btor, s32, "x");
+  y   = boolector_var (d_btor, s32, "y");
+  add = boolector_add (d_btor, x, y);
+  sub = boolector_sub (d_btor, add, y);
+  eq  = boolector_eq (d_btor, sub, x);
+  boolector_assert (d_btor, boolector_not (d_btor, eq));
+
+  ASSERT_EQ (round_trip (), BOOLECTOR_PARSE_UNKNOWN);
+  ASSERT_EQ (boolector_sat (d_parsed), BOOLECTOR_UNSAT);
+
+  boolector_release_all (d_btor);
+}
+
+TEST_F (TestDumpBin, array)
+{
+  BoolectorSort s4, s8, sa;
+  BoolectorNode *a, *b, *i, *j, *v, *wr, *rd, *eq, *neq;
+
+  s4  = boolector_bitvec_sort (d_btor, 4);
+  s8  = boolector_bitvec_sort (d_btor, 8);
+  sa  = boolector_array_sort (d_btor, s4, s8);
+  a   = boolector_array (d_btor, sa, "a");
+  i   = boolector_var (d_btor, s4, "i");
+  j   = boolector_var (d_btor, s4, "j");
+  v   = boolector_var (d_btor, s8, "v");
+  b   = boolector_const_array (d_btor, sa, v);
+  wr  = boolector_write (d_btor, b, i, v);
+  rd  = boolector_read (d_btor, wr, j);
+  eq  = boolector_eq (d_btor, wr, a);
+  neq = boolector_ne (d_btor, rd, boolector_read (d_btor, a, j));
+  boolector_assert (d_btor, eq);
+  boolector_assert (d_btor, neq);
+
+  ASSERT_EQ (round_trip (), BOOLECTOR_PARSE_UNKNOWN);
+  ASSERT_EQ (boolector_sat (d_parsed), BOOLECTOR_UNSAT);
+
+  boolector_release_all (d_btor);
+}
+
+TEST_F (TestDumpBin, fun)
+{
+  BoolectorSort s8, sf, domain[2];
+  BoolectorNode *f, *g, *p[2], *x, *y, *args[2], *app0, *app1, *eq;
+
+  s8        = boolector_bitvec_sort (d_btor, 8);
+  domain[0] = s8;
+  domain[1] = s8;
+  sf        = boolector_fun_sort (d_btor, domain, 2, s8);
+  f         = boolector_uf (d_btor, sf, "f");
+  p[0]      = boolector_param (d_btor, s8, 0);
+  p[1]      = boolector_param (d_btor, s8, 0);
+  g = boolector_fun (d_btor, p, 2, boolector_add (d_btor, p[0], p[1]));
+  x = boolector_var (d_btor, s8, "x");
+  y = boolector_var (d_btor, s8, "y");
+  args[0] = x;
+  args[1] = y;
+  app0    = boolector_apply (d_btor, args, 2, f);
+  app1    = boolector_apply (d_btor, args, 2, g);
+  eq      = boolector_eq (d_btor, app0, app1);
+  boolector_assert (d_btor, eq);
+  boolector_assert (d_btor, boolector_ne (d_btor, x, y));
+
+  ASSERT_EQ (round_trip (), BOOLECTOR_PARSE_UNKNOWN);
+  ASSERT_EQ (boolector_sat (d_parsed), BOOLECTOR_SAT);
+
+  boolector_release_all (d_btor);
+}
+
+TEST_F (TestDumpBin, quantifier)
+{
+  BoolectorSort s8;
+  BoolectorNode *x, *y, *and_, *eq, *forall;
+
+  s8     = boolector_bitvec_sort (d_btor, 8);
+  x      = boolector_param (d_btor, s8, "x");
+  y      = boolector_var (d_btor, s8, "y");
+  and_   = boolector_and (d_btor, x, y);
+  eq     = boolector_eq (d_btor, and_, boolector_zero (d_btor, s8));
+  forall = boolector_forall (d_btor, &x, 1, eq);
+  boolector_assert (d_btor, forall);
+
+  ASSERT_EQ (round_trip (), BOOLECTOR_PARSE_UNKNOWN);
+  ASSERT_EQ (boolector_sat (d_parsed), BOOLECTOR_SAT);
+
+  boolector_release_all (d_btor);
+}
+
+TEST_F (TestDumpBin, inconsistent)
+{
+  boolector_assert (d_btor, boolector_false (d_btor));
+
+  ASSERT_EQ (round_trip (), BOOLECTOR_PARSE_UNKNOWN);
+  ASSERT_EQ (boolector_sat (d_parsed), BOOLECTOR_UNSAT);
+
+  boolector_release_all (d_btor);
+}
+
+TEST_F (TestDumpBin, corrupted)
+{
+  BoolectorSort s8;
+  BoolectorNode *x, *y;
+
+  s8 = boolector_bitvec_sort (d_btor, 8);
+  x  = boolector_var (d_btor, s8, "x");
+  y  = boolector_var (d_btor, s8, "y");
+  boolector_assert (d_btor, boolector_ult (d_btor, x, y));
+
+  /* truncated */
+  ASSERT_EQ (corrupt (12, -1), BOOLECTOR_PARSE_ERROR);
+  boolector_delete (d_parsed);
+  d_parsed = boolector_new ();
+  /* unsupported version */
+  ASSERT_EQ (corrupt (4, 2), BOOLECTOR_PARSE_ERROR);
+  boolector_delete (d_parsed);
+  d_parsed = boolector_new ();
+  /* invalid sort kind */
+  ASSERT_EQ (corrupt (6, 3), BOOLECTOR_PARSE_ERROR);
+
+  boolector_release_all (d_btor);
+}
+
+TEST_F (TestDumpBin, corrupted_const)
+{
+  BoolectorSort s4, s36;
+  BoolectorNode *x, *y, *c4, *c36;
+  /* const opcode, width, value bytes (LSB first), the constants are even and
+   * thus not normalized by inversion */
+  const uint8_t seq4[]  = {0x00, 0x04, 0x04};
+  const uint8_t seq36[] = {0x00, 0x24, 0x88, 0x67, 0x45, 0x23, 0x01};
+  long pos;
+
+  s4  = boolector_bitvec_sort (d_btor, 4);
+  s36 = boolector_bitvec_sort (d_btor, 36);
+  x   = boolector_var (d_btor, s4, "x");
+  y   = boolector_var (d_btor, s36, "y");
+  c4  = boolector_unsigned_int (d_btor, 4, s4);
+  c36 = boolector_consth (d_btor, s36, "123456788");
+  boolector_assert (d_btor, boolector_ne (d_btor, x, c4));
+  boolector_assert (d_btor, boolector_ne (d_btor, y, c36));
+
+  /* set bits beyond the bit-width in the most significant byte */
+  pos = find (seq4, sizeof seq4);
+  ASSERT_GE (pos, 0);
+  ASSERT_EQ (corrupt (pos + 2, 0x14), BOOLECTOR_PARSE_ERROR);
+  reset_parsed ();
+  pos = find (seq36, sizeof seq36);
+  ASSERT_GE (pos, 0);
+  ASSERT_EQ (corrupt (pos + 6, 0x11), BOOLECTOR_PARSE_ERROR);
+  reset_parsed ();
+  ASSERT_EQ (corrupt (pos + 6, 0x0f), BOOLECTOR_PARSE_UNKNOWN);
+
+  boolector_release_all (d_btor);
+}
+
+TEST_F (TestDumpBin, corrupted_root)
+{
+  BoolectorSort s8;
+  BoolectorNode *x, *y, *ult, *forall;
+  const uint8_t root[] = {0x01, 0x02};
+  long pos;
+
+  s8     = boolector_bitvec_sort (d_btor, 8);
+  x      = boolector_param (d_btor, s8, "x");
+  y      = boolector_var (d_btor, s8, "y");
+  ult    = boolector_ult (d_btor, x, y);
+  forall = boolector_forall (d_btor, &x, 1, ult);
+  boolector_assert (d_btor, forall);
+
+  /* the single root refers to the last node (the quantifier), let it refer
+   * to the parameterized body of the quantifier instead */
+  pos = find (root, sizeof root);
+  ASSERT_GE (pos, 0);
+  ASSERT_EQ (corrupt (pos + 1, 0x04), BOOLECTOR_PARSE_ERROR);
+  reset_parsed ();
+  /* refer to the bit-vector parameter */
+  ASSERT_EQ (corrupt (pos + 1, 0x08), BOOLECTOR_PARSE_ERROR);
+
+  boolector_release_all (d_btor);
+}
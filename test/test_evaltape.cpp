@@ -0,0 +1,207 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorbv.h"
+#include "btorcore.h"
+#include "btorevaltape.h"
+#include "btorexp.h"
+}
+
+class TestEvalTape : public TestBtor
+{
+ protected:
+  void SetUp () override
+  {
+    TestBtor::SetUp ();
+
+    d_sort = btor_sort_bv (d_btor, 8);
+    d_x    = btor_exp_var (d_btor, d_sort, "x");
+    d_y    = btor_exp_var (d_btor, d_sort, "y");
+  }
+
+  void TearDown () override
+  {
+    btor_node_release (d_btor, d_x);
+    btor_node_release (d_btor, d_y);
+    btor_sort_release (d_btor, d_sort);
+
+    TestBtor::TearDown ();
+  }
+
+  void set_inputs (BtorEvalTape *tape, uint64_t x, uint64_t y)
+  {
+    uint32_t i;
+    BtorNode *input;
+    BtorBitVector *bv;
+
+    for (i = 0; i < btor_evaltape_get_num_inputs (tape); i++)
+    {
+      input = btor_evaltape_get_input (tape, i);
+      ASSERT_TRUE (input == d_x || input == d_y);
+      bv = btor_bv_uint64_to_bv (d_btor->mm, input == d_x ? x : y, 8);
+      btor_evaltape_set_input (tape, i, bv);
+      btor_bv_free (d_btor->mm, bv);
+    }
+  }
+
+  BtorSortId d_sort;
+  BtorNode *d_x;
+  BtorNode *d_y;
+};
+
+TEST_F (TestEvalTape, inputs)
+{
+  BtorNode *add;
+  BtorEvalTape *tape;
+
+  add  = btor_exp_bv_add (d_btor, d_x, d_y);
+  tape = btor_evaltape_new (d_btor, &add, 1);
+  ASSERT_EQ (btor_evaltape_get_num_inputs (tape), 2u);
+  btor_evaltape_delete (tape);
+  btor_node_release (d_btor, add);
+}
+
+TEST_F (TestEvalTape, eval)
+{
+  uint64_t x, y, ite, slice;
+  BtorNode *ult, *add, *mul, *cond, *concat, *roots[2];
+  BtorEvalTape *tape;
+
+  ult      = btor_exp_bv_ult (d_btor, d_x, d_y);
+  add      = btor_exp_bv_add (d_btor, d_x, d_y);
+  mul      = btor_exp_bv_mul (d_btor, d_x, d_y);
+  cond     = btor_exp_cond (d_btor, ult, add, btor_node_invert (mul));
+  concat   = btor_exp_bv_concat (d_btor, d_x, d_y);
+  roots[0] = cond;
+  roots[1] = btor_exp_bv_slice (d_btor, concat, 11, 4);
+
+  tape = btor_evaltape_new (d_btor, roots, 2);
+
+  /* rerun the same tape under changing input assignments */
+  for (x = 0; x < 256; x += 7)
+  {
+    for (y = 0; y < 256; y += 11)
+    {
+      set_inputs (tape, x, y);
+      btor_evaltape_run (tape);
+
+      ite   = x < y ? (x + y) & 0xff : ~(x * y) & 0xff;
+      slice = ((x << 8 | y) >> 4) & 0xff;
+      ASSERT_EQ (btor_bv_to_uint64 (btor_evaltape_get_result (tape, 0)), ite);
+      ASSERT_EQ (btor_bv_to_uint64 (btor_evaltape_get_result (tape, 1)),
+                 slice);
+    }
+  }
+
+  btor_evaltape_delete (tape);
+  btor_node_release (d_btor, ult);
+  btor_node_release (d_btor, add);
+  btor_node_release (d_btor, mul);
+  btor_node_release (d_btor, cond);
+  btor_node_release (d_btor, concat);
+  btor_node_release (d_btor, roots[1]);
+}
+
+TEST_F (TestEvalTape, inverted_root)
+{
+  BtorNode *root;
+  BtorEvalTape *tape;
+
+  root = btor_node_invert (d_x);
+  tape = btor_evaltape_new (d_btor, &root, 1);
+  ASSERT_EQ (btor_evaltape_get_num_inputs (tape), 1u);
+
+  set_inputs (tape, 0x0f, 0);
+  btor_evaltape_run (tape);
+  ASSERT_EQ (btor_bv_to_uint64 (btor_evaltape_get_result (tape, 0)), 0xf0u);
+
+  set_inputs (tape, 0xaa, 0);
+  btor_evaltape_run (tape);
+  ASSERT_EQ (btor_bv_to_uint64 (btor_evaltape_get_result (tape, 0)), 0x55u);
+
+  btor_evaltape_delete (tape);
+}
+
+TEST_F (TestEvalTape, packed)
+{
+  uint32_t i, j, n, nroots;
+  uint64_t x, y, xs[1024], ys[1024];
+  BtorNode *roots[9], *tmp;
+  const BtorBitVector *bv;
+  BtorEvalTape *tape;
+
+  tmp      = btor_exp_bv_concat (d_btor, d_x, btor_node_invert (d_y));
+  roots[0] = btor_exp_bv_slice (d_btor, tmp, 13, 3);
+  btor_node_release (d_btor, tmp);
+  roots[1] = btor_exp_bv_sll (d_btor, d_x, d_y);
+  roots[2] = btor_exp_bv_srl (d_btor, d_x, d_y);
+  roots[3] = btor_exp_bv_udiv (d_btor, d_x, d_y);
+  roots[4] = btor_exp_bv_urem (d_btor, d_x, d_y);
+  roots[5] = btor_exp_eq (d_btor, d_x, d_y);
+  roots[6] = btor_exp_bv_mul (d_btor, d_x, btor_node_invert (d_y));
+  roots[7] = btor_exp_bv_ult (d_btor, d_y, d_x);
+  roots[8] = btor_exp_bv_concat (d_btor, d_x, d_x);
+  nroots   = 9;
+
+  tape = btor_evaltape_new (d_btor, roots, nroots);
+  ASSERT_TRUE (btor_evaltape_is_packable (tape));
+
+  n = 0;
+  for (x = 0; x < 256; x += 9)
+    for (y = 0; y < 256; y += 7)
+    {
+      xs[n]   = x;
+      ys[n++] = y;
+    }
+  ASSERT_LE (n, 1024u);
+
+  for (i = 0; i < btor_evaltape_get_num_inputs (tape); i++)
+    btor_evaltape_set_input_packed (
+        tape, i, btor_evaltape_get_input (tape, i) == d_x ? xs : ys);
+  btor_evaltape_run_packed (tape, n);
+
+  /* packed results must match the results of the bit-vector evaluation */
+  for (j = 0; j < n; j++)
+  {
+    set_inputs (tape, xs[j], ys[j]);
+    btor_evaltape_run (tape);
+    for (i = 0; i < nroots; i++)
+    {
+      bv = btor_evaltape_get_result (tape, i);
+      ASSERT_EQ (btor_bv_to_uint64 (bv),
+                 btor_evaltape_get_result_packed (tape, i)[j]);
+    }
+  }
+
+  btor_evaltape_delete (tape);
+  for (i = 0; i < nroots; i++) btor_node_release (d_btor, roots[i]);
+}
+
+TEST_F (TestEvalTape, not_packable)
+{
+  uint32_t i;
+  BtorNode *wide, *next;
+  BtorEvalTape *tape;
+
+  wide = btor_exp_bv_concat (d_btor, d_x, d_y);
+  for (i = 0; i < 3; i++)
+  {
+    next = btor_exp_bv_concat (d_btor, wide, wide);
+    btor_node_release (d_btor, wide);
+    wide = next;
+  }
+  ASSERT_EQ (btor_node_bv_get_width (d_btor, wide), 128u);
+
+  tape = btor_evaltape_new (d_btor, &wide, 1);
+  ASSERT_FALSE (btor_evaltape_is_packable (tape));
+  btor_evaltape_delete (tape);
+  btor_node_release (d_btor, wide);
+}
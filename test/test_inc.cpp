@@ -9,12 +9,36 @@
 #include "test.h"
 
 extern "C" {
+#include "btorcore.h"
 #include "btoropt.h"
+#include "btorslvfun.h"
 }
 
 class TestInc : public TestBoolector
 {
  protected:
+  /* Dump d_btor in SMT2 (or BTOR) format and return the dump. */
+  std::string dump (bool smt2)
+  {
+    FILE *file;
+    char *buf;
+    long size;
+    std::string res;
+
+    file = tmpfile ();
+    if (smt2)
+      boolector_dump_smt2 (d_btor, file);
+    else
+      boolector_dump_btor (d_btor, file);
+    size = ftell (file);
+    rewind (file);
+    buf = new char[size];
+    if (fread (buf, 1, size, file) == (size_t) size) res.assign (buf, size);
+    delete[] buf;
+    fclose (file);
+    return res;
+  }
+
   void test_inc_counter (uint32_t w, bool nondet)
   {
     assert (w > 0);
@@ -255,3 +279,213 @@ TEST_F (TestInc, lemmas_on_demand1)
   boolector_release_sort (d_btor, s);
   boolector_release_sort (d_btor, as);
 }
+
+TEST_F (TestInc, lemma_db)
+{
+  BoolectorNode *a, *b, *w, *idx[8], *read, *val, *eq, *ne, *j, *v;
+  BoolectorSort s, as;
+  BtorFunSolver *slv;
+  uint32_t i;
+  char name[10];
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_REWRITE_LEVEL, 0);
+  s  = boolector_bitvec_sort (d_btor, 8);
+  as = boolector_array_sort (d_btor, s, s);
+  a  = boolector_array (d_btor, as, "a");
+  j  = boolector_var (d_btor, s, "j");
+  v  = boolector_var (d_btor, s, "v");
+  w  = boolector_write (d_btor, a, j, v);
+  b  = boolector_write (d_btor, w, v, j);
+  for (i = 0; i < 8; i++)
+  {
+    sprintf (name, "i%u", i);
+    idx[i] = boolector_var (d_btor, s, name);
+    read   = boolector_read (d_btor, i % 2 ? b : w, idx[i]);
+    val    = boolector_unsigned_int (d_btor, i, s);
+    eq     = boolector_eq (d_btor, read, val);
+    boolector_assert (d_btor, eq);
+    boolector_release (d_btor, read);
+    boolector_release (d_btor, val);
+    boolector_release (d_btor, eq);
+  }
+
+  for (i = 2; i < 8; i++)
+  {
+    eq = boolector_eq (d_btor, idx[i - 2], idx[i]);
+    ne = boolector_ne (d_btor, idx[0], idx[i]);
+    boolector_assume (d_btor, eq);
+    ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+    boolector_assume (d_btor, ne);
+    ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+    boolector_release (d_btor, eq);
+    boolector_release (d_btor, ne);
+
+    /* lemmas skipped or subsumed in the lemma database remain part of the
+     * formula, i.e., lemmas are never removed from the lemma cache */
+    slv = BTOR_FUN_SOLVER (d_btor);
+    ASSERT_EQ (slv->lemmas->count, slv->stats.lod_refinements);
+    ASSERT_LE (slv->lemma_db_count, slv->stats.lod_refinements);
+  }
+
+  for (i = 0; i < 8; i++) boolector_release (d_btor, idx[i]);
+  boolector_release (d_btor, a);
+  boolector_release (d_btor, w);
+  boolector_release (d_btor, b);
+  boolector_release (d_btor, j);
+  boolector_release (d_btor, v);
+  boolector_release_sort (d_btor, s);
+  boolector_release_sort (d_btor, as);
+}
+
+TEST_F (TestInc, push_pop)
+{
+  BoolectorNode *x, *y, *ult, *ugt, *eq;
+  BoolectorSort s;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  s   = boolector_bitvec_sort (d_btor, 8);
+  x   = boolector_var (d_btor, s, "x");
+  y   = boolector_var (d_btor, s, "y");
+  ult = boolector_ult (d_btor, x, y);
+  ugt = boolector_ugt (d_btor, x, y);
+  eq  = boolector_eq (d_btor, x, y);
+
+  boolector_push (d_btor, 1);
+  boolector_assert (d_btor, ult);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  boolector_push (d_btor, 2);
+  boolector_assert (d_btor, ugt);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  boolector_pop (d_btor, 1);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  boolector_pop (d_btor, 1);
+  boolector_assume (d_btor, eq);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_TRUE (boolector_failed (d_btor, eq));
+  /* activation literals are not fixated */
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  boolector_fixate_assumptions (d_btor);
+  boolector_pop (d_btor, 1);
+  boolector_assert (d_btor, ugt);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, ult);
+  boolector_release (d_btor, ugt);
+  boolector_release (d_btor, eq);
+  boolector_release_sort (d_btor, s);
+}
+
+TEST_F (TestInc, push_pop_dump)
+{
+  BoolectorNode *x, *y, *ult, *ugt;
+  BoolectorSort s;
+  std::string smt2, btor;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  s   = boolector_bitvec_sort (d_btor, 8);
+  x   = boolector_var (d_btor, s, "x");
+  y   = boolector_var (d_btor, s, "y");
+  ult = boolector_ult (d_btor, x, y);
+  ugt = boolector_ugt (d_btor, x, y);
+  boolector_assert (d_btor, ult);
+  smt2 = dump (true);
+  btor = dump (false);
+
+  /* assertions of contexts and their activation literals are not dumped */
+  boolector_push (d_btor, 1);
+  boolector_assert (d_btor, ugt);
+  ASSERT_EQ (dump (true), smt2);
+  ASSERT_EQ (dump (false), btor);
+  boolector_pop (d_btor, 1);
+  ASSERT_EQ (dump (true), smt2);
+  ASSERT_EQ (dump (false), btor);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, ult);
+  boolector_release (d_btor, ugt);
+  boolector_release_sort (d_btor, s);
+}
+
+#ifdef BTOR_USE_CADICAL
+TEST_F (TestInc, failed_clone)
+{
+  BoolectorNode *x, *y, *ult, *eq, *ceq;
+  BoolectorSort s;
+  Btor *clone;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_sat_solver (d_btor, "cadical");
+  s   = boolector_bitvec_sort (d_btor, 8);
+  x   = boolector_var (d_btor, s, "x");
+  y   = boolector_var (d_btor, s, "y");
+  ult = boolector_ult (d_btor, x, y);
+  eq  = boolector_eq (d_btor, x, y);
+
+  boolector_assert (d_btor, ult);
+  boolector_assume (d_btor, eq);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+
+  /* the clone answers failed assumptions without solving first */
+  clone = boolector_clone (d_btor);
+  ceq   = boolector_match_node (clone, eq);
+  ASSERT_TRUE (boolector_failed (clone, ceq));
+  ASSERT_TRUE (boolector_failed (d_btor, eq));
+  ASSERT_EQ (boolector_sat (clone), BOOLECTOR_SAT);
+  boolector_release (clone, ceq);
+  boolector_delete (clone);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, ult);
+  boolector_release (d_btor, eq);
+  boolector_release_sort (d_btor, s);
+}
+#endif
+
+TEST_F (TestInc, budget)
+{
+  BoolectorNode *x, *y, *z, *mul1, *mul2, *c, *eq;
+  BoolectorSort s;
+  uint32_t i;
+  int32_t res;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  s    = boolector_bitvec_sort (d_btor, 64);
+  x    = boolector_var (d_btor, s, "x");
+  y    = boolector_var (d_btor, s, "y");
+  z    = boolector_var (d_btor, s, "z");
+  mul1 = boolector_mul (d_btor, x, y);
+  mul2 = boolector_mul (d_btor, mul1, z);
+  c    = boolector_unsigned_int (d_btor, 391, s);
+  eq   = boolector_eq (d_btor, mul2, c);
+  boolector_assert (d_btor, eq);
+
+  /* bit-blasting exceeds 1 MB, an exhausted budget does not permanently
+   * terminate the instance */
+  boolector_set_opt (d_btor, BTOR_OPT_BUDGET_MEM, 1);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNKNOWN);
+  ASSERT_FALSE (boolector_terminate (d_btor));
+  /* the budget limits the memory allocated per call, i.e., subsequent calls
+   * resume from the current state with a fresh budget and make progress */
+  for (i = 0; i < 100 && (res = boolector_sat (d_btor)) == BOOLECTOR_UNKNOWN;
+       i++)
+    ;
+  ASSERT_EQ (res, BOOLECTOR_SAT);
+  boolector_set_opt (d_btor, BTOR_OPT_BUDGET_MEM, 0);
+  boolector_set_opt (d_btor, BTOR_OPT_BUDGET_TIME, 60000);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, z);
+  boolector_release (d_btor, mul1);
+  boolector_release (d_btor, mul2);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, eq);
+  boolector_release_sort (d_btor, s);
+}
@@ -8,6 +8,8 @@
 
 #include "test.h"
 
+#include <unistd.h>
+
 extern "C" {
 #include "boolectormc.h"
 }
@@ -447,3 +449,502 @@ TEST_F (TestMc, count2multi)
   ASSERT_EQ (boolector_mc_reached_bad_at_bound (d_mc, 3), 3);
   boolector_release (d_btor, count);
 }
+
+/*------------------------------------------------------------------------*/
+
+TEST_F (TestMc, kinduction)
+{
+  int32_t k, mode;
+  BoolectorNode *x, *in, *zero, *one, *two, *three, *bad;
+  BoolectorNode *is0, *is1, *inc, *next1, *next;
+  BoolectorSort s1, s2;
+
+  for (mode = 0; mode < 2; mode++)
+  {
+    set_up_iteration ();
+
+    boolector_mc_set_opt (d_mc, BTOR_MC_OPT_KINDUCTION, 1);
+    boolector_mc_set_opt (d_mc, BTOR_MC_OPT_STOP_FIRST, 0);
+    /* x is stuck at 0, which the model reduction would find */
+    boolector_mc_set_opt (d_mc, BTOR_MC_OPT_REDUCE, 0);
+    if (mode) boolector_mc_set_opt (d_mc, BTOR_MC_OPT_SIMPLE_PATH, 1);
+
+    s1 = boolector_bitvec_sort (d_btor, 1);
+    s2 = boolector_bitvec_sort (d_btor, 2);
+
+    /* 0 -> 0, 1 -> (in ? 2 : 1), 2 -> 3, 3 -> 3, starting in 0 */
+    x     = boolector_mc_state (d_mc, s2, "x");
+    in    = boolector_mc_input (d_mc, s1, "in");
+    zero  = boolector_zero (d_btor, s2);
+    one   = boolector_one (d_btor, s2);
+    two   = boolector_unsigned_int (d_btor, 2, s2);
+    three = boolector_ones (d_btor, s2);
+    is0   = boolector_eq (d_btor, x, zero);
+    is1   = boolector_eq (d_btor, x, one);
+    inc   = boolector_cond (d_btor, in, two, one);
+    next1 = boolector_cond (d_btor, is1, inc, three);
+    next  = boolector_cond (d_btor, is0, zero, next1);
+    bad   = boolector_eq (d_btor, x, three);
+
+    boolector_mc_init (d_mc, x, zero);
+    boolector_mc_next (d_mc, x, next);
+    boolector_mc_bad (d_mc, bad);
+
+    boolector_release (d_btor, in);
+    boolector_release (d_btor, zero);
+    boolector_release (d_btor, one);
+    boolector_release (d_btor, two);
+    boolector_release (d_btor, three);
+    boolector_release (d_btor, is0);
+    boolector_release (d_btor, is1);
+    boolector_release (d_btor, inc);
+    boolector_release (d_btor, next1);
+    boolector_release (d_btor, next);
+    boolector_release (d_btor, bad);
+
+    k = boolector_mc_kind (d_mc, 0, 5);
+    if (mode)
+    {
+      /* the only paths to 3 of arbitrary length stay in 1, which is not
+       * simple, hence the property is proven at a small bound */
+      ASSERT_TRUE (0 <= k && k <= 5);
+      ASSERT_EQ (boolector_mc_reached_bad_at_bound (d_mc, 0), k);
+    }
+    else
+    {
+      ASSERT_LT (k, 0);
+      ASSERT_LT (boolector_mc_reached_bad_at_bound (d_mc, 0), 0);
+    }
+
+    boolector_release (d_btor, x);
+    boolector_release_sort (d_btor, s1);
+    boolector_release_sort (d_btor, s2);
+  }
+}
+
+TEST_F (TestMc, kinductionsimplepath)
+{
+  int32_t k;
+  BoolectorNode *x, *in, *zero, *one, *is0, *is1, *next, *bad;
+  BoolectorSort s1, s2;
+
+  boolector_mc_set_opt (d_mc, BTOR_MC_OPT_KINDUCTION, 1);
+  boolector_mc_set_opt (d_mc, BTOR_MC_OPT_STOP_FIRST, 0);
+  boolector_mc_set_opt (d_mc, BTOR_MC_OPT_SIMPLE_PATH, 1);
+  boolector_mc_set_opt (d_mc, BTOR_MC_OPT_REDUCE, 0);
+
+  s1 = boolector_bitvec_sort (d_btor, 1);
+  s2 = boolector_bitvec_sort (d_btor, 2);
+
+  /* x stays in its initial value 0 forever, bad is 'x = 1 & in', hence the
+   * counterexample to induction at bound 1 stays in 1 in frames 0 and 1 */
+  x    = boolector_mc_state (d_mc, s2, "x");
+  in   = boolector_mc_input (d_mc, s1, "in");
+  zero = boolector_zero (d_btor, s2);
+  one  = boolector_one (d_btor, s2);
+  is0  = boolector_eq (d_btor, x, zero);
+  is1  = boolector_eq (d_btor, x, one);
+  next = boolector_cond (d_btor, is0, zero, x);
+  bad  = boolector_and (d_btor, is1, in);
+
+  boolector_mc_init (d_mc, x, zero);
+  boolector_mc_next (d_mc, x, next);
+  boolector_mc_bad (d_mc, bad);
+
+  k = boolector_mc_kind (d_mc, 0, 5);
+  ASSERT_EQ (k, 1);
+  ASSERT_EQ (boolector_mc_reached_bad_at_bound (d_mc, 0), 1);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, in);
+  boolector_release (d_btor, zero);
+  boolector_release (d_btor, one);
+  boolector_release (d_btor, is0);
+  boolector_release (d_btor, is1);
+  boolector_release (d_btor, next);
+  boolector_release (d_btor, bad);
+  boolector_release_sort (d_btor, s1);
+  boolector_release_sort (d_btor, s2);
+}
+
+/*------------------------------------------------------------------------*/
+
+TEST_F (TestMc, pdr)
+{
+  int32_t k, mode;
+  BoolectorNode *c, *d, *in, *zero, *one, *nine, *eqnine, *inc, *next;
+  BoolectorNode *six, *eqzero, *eqone, *nextd, *bad0, *bad1, *bad2;
+  BoolectorSort s4;
+
+  for (mode = 0; mode < 2; mode++)
+  {
+    set_up_iteration ();
+
+    boolector_mc_set_opt (d_mc, BTOR_MC_OPT_STOP_FIRST, 0);
+    if (mode) boolector_mc_set_opt (d_mc, BTOR_MC_OPT_TRACE_GEN, 1);
+
+    s4 = boolector_bitvec_sort (d_btor, 4);
+
+    /* c counts from 0 to 9 and stays there, d toggles its bits freely */
+    c      = boolector_mc_state (d_mc, s4, "c");
+    d      = boolector_mc_state (d_mc, s4, "d");
+    in     = boolector_mc_input (d_mc, s4, "in");
+    zero   = boolector_zero (d_btor, s4);
+    one    = boolector_one (d_btor, s4);
+    nine   = boolector_unsigned_int (d_btor, 9, s4);
+    eqnine = boolector_eq (d_btor, c, nine);
+    inc    = boolector_add (d_btor, c, one);
+    next   = boolector_cond (d_btor, eqnine, c, inc);
+    nextd  = boolector_xor (d_btor, d, in);
+    six    = boolector_unsigned_int (d_btor, 6, s4);
+    eqzero = boolector_eq (d_btor, c, zero);
+    eqone  = boolector_eq (d_btor, d, one);
+    bad0   = boolector_ugt (d_btor, c, nine);
+    bad1   = boolector_eq (d_btor, c, six);
+    bad2   = boolector_and (d_btor, eqzero, eqone);
+
+    boolector_mc_init (d_mc, c, zero);
+    boolector_mc_init (d_mc, d, zero);
+    boolector_mc_next (d_mc, c, next);
+    boolector_mc_next (d_mc, d, nextd);
+    boolector_mc_bad (d_mc, bad0);
+    boolector_mc_bad (d_mc, bad1);
+    boolector_mc_bad (d_mc, bad2);
+
+    boolector_release (d_btor, in);
+    boolector_release (d_btor, zero);
+    boolector_release (d_btor, one);
+    boolector_release (d_btor, nine);
+    boolector_release (d_btor, six);
+    boolector_release (d_btor, eqnine);
+    boolector_release (d_btor, eqzero);
+    boolector_release (d_btor, eqone);
+    boolector_release (d_btor, inc);
+    boolector_release (d_btor, next);
+    boolector_release (d_btor, nextd);
+    boolector_release (d_btor, bad0);
+    boolector_release (d_btor, bad1);
+    boolector_release (d_btor, bad2);
+
+    k = boolector_mc_pdr (d_mc, 20);
+    ASSERT_EQ (k, 6);
+    /* c > 9 and (c = 0 & d = 1) are unreachable */
+    ASSERT_EQ (boolector_mc_reached_bad_at_bound (d_mc, 1), 6);
+    ASSERT_GE (boolector_mc_reached_bad_at_bound (d_mc, 0), 0);
+    ASSERT_GE (boolector_mc_reached_bad_at_bound (d_mc, 2), 0);
+
+    if (mode)
+    {
+      char *val = boolector_mc_assignment (d_mc, c, 6);
+      ASSERT_STREQ (val, "0110");
+      boolector_mc_free_assignment (d_mc, val);
+    }
+
+    boolector_release (d_btor, c);
+    boolector_release (d_btor, d);
+    boolector_release_sort (d_btor, s4);
+  }
+}
+
+TEST_F (TestMc, pdrwitnessorder)
+{
+  BoolectorNode *x, *in, *one, *two, *bad0, *bad1, *ne, *val;
+  BoolectorSort s2;
+  char *a;
+
+  boolector_mc_set_opt (d_mc, BTOR_MC_OPT_STOP_FIRST, 0);
+  boolector_mc_set_opt (d_mc, BTOR_MC_OPT_TRACE_GEN, 1);
+
+  s2 = boolector_bitvec_sort (d_btor, 2);
+
+  /* x takes the value of the input of the previous frame, which must not be
+   * 2, i.e., bad1 is only reachable at bound 0 without considering frame 1 */
+  x    = boolector_mc_state (d_mc, s2, "x");
+  in   = boolector_mc_input (d_mc, s2, "in");
+  one  = boolector_one (d_btor, s2);
+  two  = boolector_unsigned_int (d_btor, 2, s2);
+  bad0 = boolector_eq (d_btor, x, one);
+  bad1 = boolector_eq (d_btor, in, two);
+  ne   = boolector_ne (d_btor, x, two);
+  val  = boolector_zero (d_btor, s2);
+
+  boolector_mc_init (d_mc, x, val);
+  boolector_mc_next (d_mc, x, in);
+  boolector_mc_constraint (d_mc, ne);
+  boolector_mc_bad (d_mc, bad0);
+  boolector_mc_bad (d_mc, bad1);
+
+  /* witnesses are replayed in increasing order of bounds */
+  ASSERT_GE (boolector_mc_pdr (d_mc, 10), 0);
+  ASSERT_EQ (boolector_mc_reached_bad_at_bound (d_mc, 0), 1);
+  ASSERT_EQ (boolector_mc_reached_bad_at_bound (d_mc, 1), 0);
+  a = boolector_mc_assignment (d_mc, x, 1);
+  ASSERT_STREQ (a, "01");
+  boolector_mc_free_assignment (d_mc, a);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, in);
+  boolector_release (d_btor, one);
+  boolector_release (d_btor, two);
+  boolector_release (d_btor, bad0);
+  boolector_release (d_btor, bad1);
+  boolector_release (d_btor, ne);
+  boolector_release (d_btor, val);
+  boolector_release_sort (d_btor, s2);
+}
+
+/*------------------------------------------------------------------------*/
+
+TEST_F (TestMc, aigunroll)
+{
+  int32_t k, mode;
+  char *val;
+  BoolectorNode *c, *d, *e, *in, *zero, *one, *two, *five, *seven;
+  BoolectorNode *nextc, *nextd, *nonzero, *eqtwo, *eqzero;
+  BoolectorNode *bad0, *bad1, *bad2;
+  BoolectorSort s4;
+
+  for (mode = 0; mode < 2; mode++)
+  {
+    set_up_iteration ();
+
+    boolector_mc_set_opt (d_mc, BTOR_MC_OPT_STOP_FIRST, 0);
+    boolector_mc_set_opt (d_mc, BTOR_MC_OPT_TRACE_GEN, 1);
+    if (mode) boolector_mc_set_opt (d_mc, BTOR_MC_OPT_AIG_UNROLL, 1);
+
+    s4 = boolector_bitvec_sort (d_btor, 4);
+
+    /* c counts, d adds a non-zero input and e has no next state function */
+    c       = boolector_mc_state (d_mc, s4, "c");
+    d       = boolector_mc_state (d_mc, s4, "d");
+    e       = boolector_mc_state (d_mc, s4, "e");
+    in      = boolector_mc_input (d_mc, s4, "in");
+    zero    = boolector_zero (d_btor, s4);
+    one     = boolector_one (d_btor, s4);
+    two     = boolector_unsigned_int (d_btor, 2, s4);
+    five    = boolector_unsigned_int (d_btor, 5, s4);
+    seven   = boolector_unsigned_int (d_btor, 7, s4);
+    nextc   = boolector_add (d_btor, c, one);
+    nextd   = boolector_add (d_btor, d, in);
+    nonzero = boolector_ne (d_btor, in, zero);
+    eqtwo   = boolector_eq (d_btor, c, two);
+    eqzero  = boolector_eq (d_btor, d, zero);
+    bad0    = boolector_eq (d_btor, c, five);
+    bad1    = boolector_eq (d_btor, e, seven);
+    bad2    = boolector_and (d_btor, eqtwo, eqzero);
+
+    boolector_mc_init (d_mc, c, zero);
+    boolector_mc_init (d_mc, d, zero);
+    boolector_mc_init (d_mc, e, zero);
+    boolector_mc_next (d_mc, c, nextc);
+    boolector_mc_next (d_mc, d, nextd);
+    boolector_mc_constraint (d_mc, nonzero);
+    boolector_mc_bad (d_mc, bad0);
+    boolector_mc_bad (d_mc, bad1);
+    boolector_mc_bad (d_mc, bad2);
+
+    boolector_release (d_btor, zero);
+    boolector_release (d_btor, one);
+    boolector_release (d_btor, two);
+    boolector_release (d_btor, five);
+    boolector_release (d_btor, seven);
+    boolector_release (d_btor, nextc);
+    boolector_release (d_btor, nextd);
+    boolector_release (d_btor, nonzero);
+    boolector_release (d_btor, eqtwo);
+    boolector_release (d_btor, eqzero);
+    boolector_release (d_btor, bad0);
+    boolector_release (d_btor, bad1);
+    boolector_release (d_btor, bad2);
+
+    k = boolector_mc_bmc (d_mc, 0, 3);
+    ASSERT_EQ (k, -1);
+    ASSERT_EQ (boolector_mc_reached_bad_at_bound (d_mc, 0), -1);
+    ASSERT_EQ (boolector_mc_reached_bad_at_bound (d_mc, 1), 1);
+    ASSERT_EQ (boolector_mc_reached_bad_at_bound (d_mc, 2), 2);
+
+    /* continues with the next bound */
+    k = boolector_mc_bmc (d_mc, 0, 10);
+    ASSERT_EQ (k, 5);
+    ASSERT_EQ (boolector_mc_reached_bad_at_bound (d_mc, 0), 5);
+
+    val = boolector_mc_assignment (d_mc, c, 5);
+    ASSERT_STREQ (val, "0101");
+    boolector_mc_free_assignment (d_mc, val);
+
+    boolector_release (d_btor, c);
+    boolector_release (d_btor, d);
+    boolector_release (d_btor, e);
+    boolector_release (d_btor, in);
+    boolector_release_sort (d_btor, s4);
+  }
+}
+
+TEST_F (TestMc, reduce)
+{
+  int32_t i, k, mode;
+  long irr0, sum;
+  char *val, *val1;
+  BoolectorNode *c, *r, *d1, *d2, *irr, *in, *zero, *one, *three, *five;
+  BoolectorNode *nextc, *nextr, *inc1, *inc2, *nextd1, *nextd2, *nextirr;
+  BoolectorNode *eqc, *eqr, *eqd, *nonzero, *bad;
+  BoolectorSort s4;
+
+  for (mode = 0; mode < 2; mode++)
+  {
+    set_up_iteration ();
+
+    boolector_mc_set_opt (d_mc, BTOR_MC_OPT_TRACE_GEN, 1);
+    if (!mode) boolector_mc_set_opt (d_mc, BTOR_MC_OPT_REDUCE, 0);
+
+    s4 = boolector_bitvec_sort (d_btor, 4);
+
+    /* c counts, r is stuck at 5, d1 and d2 are equivalent and irr is
+     * outside the cone of influence of the property */
+    c     = boolector_mc_state (d_mc, s4, "c");
+    r     = boolector_mc_state (d_mc, s4, "r");
+    d1    = boolector_mc_state (d_mc, s4, "d1");
+    d2    = boolector_mc_state (d_mc, s4, "d2");
+    irr   = boolector_mc_state (d_mc, s4, "irr");
+    in    = boolector_mc_input (d_mc, s4, "in");
+    zero  = boolector_zero (d_btor, s4);
+    one   = boolector_one (d_btor, s4);
+    three = boolector_unsigned_int (d_btor, 3, s4);
+    five  = boolector_unsigned_int (d_btor, 5, s4);
+    nextc = boolector_add (d_btor, c, one);
+    eqc   = boolector_eq (d_btor, c, three);
+    nextr = boolector_cond (d_btor, eqc, five, r);
+    inc1  = boolector_add (d_btor, d1, in);
+    inc2  = boolector_add (d_btor, d2, in);
+    nextd1  = boolector_cond (d_btor, eqc, d1, inc1);
+    nextd2  = boolector_cond (d_btor, eqc, d2, inc2);
+    nextirr = boolector_add (d_btor, irr, in);
+    eqr     = boolector_eq (d_btor, r, five);
+    eqd     = boolector_eq (d_btor, d1, d2);
+    nonzero = boolector_ne (d_btor, in, zero);
+    bad     = boolector_and (d_btor, eqc, eqr);
+
+    boolector_mc_init (d_mc, c, zero);
+    boolector_mc_init (d_mc, r, five);
+    boolector_mc_init (d_mc, d1, zero);
+    boolector_mc_init (d_mc, d2, zero);
+    boolector_mc_next (d_mc, c, nextc);
+    boolector_mc_next (d_mc, r, nextr);
+    boolector_mc_next (d_mc, d1, nextd1);
+    boolector_mc_next (d_mc, d2, nextd2);
+    boolector_mc_next (d_mc, irr, nextirr);
+    boolector_mc_constraint (d_mc, eqd);
+    boolector_mc_constraint (d_mc, nonzero);
+    boolector_mc_bad (d_mc, bad);
+
+    boolector_release (d_btor, zero);
+    boolector_release (d_btor, one);
+    boolector_release (d_btor, three);
+    boolector_release (d_btor, five);
+    boolector_release (d_btor, nextc);
+    boolector_release (d_btor, eqc);
+    boolector_release (d_btor, nextr);
+    boolector_release (d_btor, inc1);
+    boolector_release (d_btor, inc2);
+    boolector_release (d_btor, nextd1);
+    boolector_release (d_btor, nextd2);
+    boolector_release (d_btor, nextirr);
+    boolector_release (d_btor, eqr);
+    boolector_release (d_btor, eqd);
+    boolector_release (d_btor, nonzero);
+    boolector_release (d_btor, bad);
+
+    k = boolector_mc_bmc (d_mc, 0, 10);
+    ASSERT_EQ (k, 3);
+
+    /* the trace is complete, including the states not unrolled */
+    val  = boolector_mc_assignment (d_mc, irr, 0);
+    irr0 = strtol (val, 0, 2);
+    boolector_mc_free_assignment (d_mc, val);
+    sum = irr0;
+    for (i = 0; i <= k; i++)
+    {
+      val = boolector_mc_assignment (d_mc, irr, i);
+      ASSERT_EQ (strtol (val, 0, 2), sum % 16);
+      boolector_mc_free_assignment (d_mc, val);
+      val = boolector_mc_assignment (d_mc, in, i);
+      sum += strtol (val, 0, 2);
+      boolector_mc_free_assignment (d_mc, val);
+      val = boolector_mc_assignment (d_mc, r, i);
+      ASSERT_STREQ (val, "0101");
+      boolector_mc_free_assignment (d_mc, val);
+      val  = boolector_mc_assignment (d_mc, d1, i);
+      val1 = boolector_mc_assignment (d_mc, d2, i);
+      ASSERT_STREQ (val, val1);
+      boolector_mc_free_assignment (d_mc, val);
+      boolector_mc_free_assignment (d_mc, val1);
+    }
+
+    boolector_release (d_btor, c);
+    boolector_release (d_btor, r);
+    boolector_release (d_btor, d1);
+    boolector_release (d_btor, d2);
+    boolector_release (d_btor, irr);
+    boolector_release (d_btor, in);
+    boolector_release_sort (d_btor, s4);
+  }
+}
+
+TEST_F (TestMc, arraywitness)
+{
+  BoolectorNode *a, *in, *zero, *three, *next, *read, *bad;
+  BoolectorSort s2, as;
+  FILE *out;
+  int32_t k, fd;
+  long size;
+  char buf[1024];
+
+  boolector_mc_set_opt (d_mc, BTOR_MC_OPT_TRACE_GEN, 1);
+  boolector_mc_set_opt (d_mc, BTOR_MC_OPT_TRACE_GEN_FULL, 1);
+
+  /* array state initialized with a constant (constant array) */
+  s2    = boolector_bitvec_sort (d_btor, 2);
+  as    = boolector_array_sort (d_btor, s2, s2);
+  a     = boolector_mc_state (d_mc, as, "a");
+  in    = boolector_mc_input (d_mc, s2, "in");
+  zero  = boolector_zero (d_btor, s2);
+  three = boolector_unsigned_int (d_btor, 3, s2);
+  next  = boolector_write (d_btor, a, in, three);
+  read  = boolector_read (d_btor, a, zero);
+  bad   = boolector_eq (d_btor, read, three);
+  boolector_mc_init (d_mc, a, zero);
+  boolector_mc_next (d_mc, a, next);
+  boolector_mc_bad (d_mc, bad);
+
+  /* the witness is printed to stdout */
+  out = tmpfile ();
+  ASSERT_NE (out, nullptr);
+  fflush (stdout);
+  fd = dup (fileno (stdout));
+  dup2 (fileno (out), fileno (stdout));
+  k = boolector_mc_bmc (d_mc, 0, 2);
+  fflush (stdout);
+  dup2 (fd, fileno (stdout));
+  close (fd);
+  ASSERT_EQ (k, 1);
+
+  size = ftell (out);
+  ASSERT_LT (size, (long) sizeof buf);
+  rewind (out);
+  ASSERT_EQ (fread (buf, 1, size, out), (size_t) size);
+  buf[size] = 0;
+  fclose (out);
+  /* default value of the initial constant array */
+  ASSERT_NE (strstr (buf, "\n0 [*] 00 a@0\n"), nullptr);
+  ASSERT_NE (strstr (buf, "\n0 00 in@0\n"), nullptr);
+
+  boolector_release (d_btor, a);
+  boolector_release (d_btor, in);
+  boolector_release (d_btor, zero);
+  boolector_release (d_btor, three);
+  boolector_release (d_btor, next);
+  boolector_release (d_btor, read);
+  boolector_release (d_btor, bad);
+  boolector_release_sort (d_btor, s2);
+  boolector_release_sort (d_btor, as);
+}
@@ -0,0 +1,97 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btoropt.h"
+#include "btorprofile.h"
+}
+
+#include <stdlib.h>
+
+class TestProfile : public TestBoolector
+{
+ protected:
+  void SetUp () override
+  {
+    TestBoolector::SetUp ();
+    d_profile_file_name = std::string (BTOR_LOG_DIR) + "profile.log";
+    setenv ("BTORPROFILEOUT", d_profile_file_name.c_str (), 1);
+  }
+
+  void TearDown () override
+  {
+    unsetenv ("BTORPROFILEOUT");
+    TestBoolector::TearDown ();
+  }
+
+  /* Solve x * y = 391 for 16-bit x and y twice, returns the profile. */
+  std::string profile (BtorProfileMode mode)
+  {
+    BoolectorNode *x, *y, *mul, *c, *eq;
+    BoolectorSort s;
+
+    boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+    boolector_set_opt (d_btor, BTOR_OPT_PROFILE, mode);
+    s   = boolector_bitvec_sort (d_btor, 16);
+    x   = boolector_var (d_btor, s, "x");
+    y   = boolector_var (d_btor, s, "y");
+    mul = boolector_mul (d_btor, x, y);
+    c   = boolector_unsigned_int (d_btor, 391, s);
+    eq  = boolector_eq (d_btor, mul, c);
+    boolector_assert (d_btor, eq);
+    EXPECT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+    EXPECT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+
+    boolector_release (d_btor, x);
+    boolector_release (d_btor, y);
+    boolector_release (d_btor, mul);
+    boolector_release (d_btor, c);
+    boolector_release (d_btor, eq);
+    boolector_release_sort (d_btor, s);
+
+    /* closes profile output */
+    boolector_delete (d_btor);
+    d_btor = nullptr;
+
+    std::ifstream file (d_profile_file_name);
+    std::stringstream ss;
+    ss << file.rdbuf ();
+    return ss.str ();
+  }
+
+  std::string d_profile_file_name;
+};
+
+TEST_F (TestProfile, json)
+{
+  std::string prof = profile (BTOR_PROFILE_JSON);
+  size_t pos;
+
+  ASSERT_EQ (prof.find ("{\"call\":1,\"phases\":[{\"name\":\"check_sat\""), 0u);
+  pos = prof.find ('\n');
+  ASSERT_NE (pos, std::string::npos);
+  ASSERT_EQ (prof.find ("{\"call\":2,\"phases\":[{\"name\":\"check_sat\""),
+             pos + 1);
+  ASSERT_EQ (prof.find ('\n', pos + 1), prof.size () - 1);
+  ASSERT_NE (prof.find ("{\"name\":\"sat\",\"calls\":1,"), std::string::npos);
+  ASSERT_NE (prof.find ("\"sat_calls\":1,\"phases\":[]}"), std::string::npos);
+}
+
+TEST_F (TestProfile, trace)
+{
+  std::string prof = profile (BTOR_PROFILE_TRACE);
+
+  ASSERT_EQ (prof.find ("[\n{\"name\":"), 0u);
+  ASSERT_NE (prof.find ("{\"name\":\"check_sat\",\"cat\":\"btor\",\"ph\":\"X\""),
+             std::string::npos);
+  ASSERT_NE (prof.find ("\"args\":{\"call\":2,"), std::string::npos);
+  /* event array is not closed */
+  ASSERT_EQ (prof.find (']'), std::string::npos);
+}
@@ -40,3 +40,63 @@ TEST_F (TestSatMgr, next_cnf_id)
   ASSERT_EQ (btor_sat_mgr_next_cnf_id (d_smgr), 4);
   btor_sat_reset (d_smgr);
 }
+
+TEST_F (TestSatMgr, add_clauses)
+{
+  int32_t a, b, c;
+
+  btor_sat_enable_solver (d_smgr);
+  btor_sat_init (d_smgr);
+  a = btor_sat_mgr_next_cnf_id (d_smgr);
+  b = btor_sat_mgr_next_cnf_id (d_smgr);
+  c = btor_sat_mgr_next_cnf_id (d_smgr);
+  int32_t clauses[] = {a, b, 0, -a, 0, -b, c, 0};
+  btor_sat_add_clauses (d_smgr, clauses, sizeof clauses / sizeof *clauses);
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (btor_sat_deref (d_smgr, a), -1);
+  ASSERT_EQ (btor_sat_deref (d_smgr, b), 1);
+  ASSERT_EQ (btor_sat_deref (d_smgr, c), 1);
+  btor_sat_reset (d_smgr);
+}
+
+TEST_F (TestSatMgr, preprocess)
+{
+  int32_t a, b, c, e, t, i, j, sat;
+
+  btor_opt_set (d_btor, BTOR_OPT_SAT_PREPROCESS, 1);
+  btor_sat_enable_solver (d_smgr);
+  btor_sat_init (d_smgr);
+  a = btor_sat_mgr_next_cnf_id (d_smgr);
+  b = btor_sat_mgr_next_cnf_id (d_smgr);
+  c = btor_sat_mgr_next_cnf_id (d_smgr);
+  e = btor_sat_mgr_next_cnf_id (d_smgr);
+  t = btor_sat_mgr_next_cnf_id (d_smgr);
+  /* t = a & b, e = a */
+  int32_t clauses[] = {
+      -t, a, 0, -t, b, 0, t, -a, -b, 0, t, c, 0, -e, a, 0, e, -a, 0};
+  size_t n = sizeof clauses / sizeof *clauses;
+  btor_sat_add_clauses (d_smgr, clauses, n);
+  /* 't' and 'e' may be eliminated */
+  btor_sat_mgr_release_cnf_id (d_smgr, t);
+  btor_sat_mgr_release_cnf_id (d_smgr, e);
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_SAT);
+  for (i = 0; i < (int32_t) n; i = j + 1)
+  {
+    for (j = i, sat = 0; clauses[j]; j++)
+      sat |= btor_sat_deref (d_smgr, clauses[j]) > 0;
+    ASSERT_TRUE (sat);
+  }
+
+  btor_sat_add (d_smgr, -c);
+  btor_sat_add (d_smgr, 0);
+  btor_sat_assume (d_smgr, -a);
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_UNSAT);
+  ASSERT_TRUE (btor_sat_failed (d_smgr, -a));
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (btor_sat_deref (d_smgr, a), 1);
+  ASSERT_EQ (btor_sat_deref (d_smgr, b), 1);
+  ASSERT_EQ (btor_sat_deref (d_smgr, c), -1);
+  ASSERT_EQ (btor_sat_deref (d_smgr, e), 1);
+  ASSERT_EQ (btor_sat_deref (d_smgr, t), 1);
+  btor_sat_reset (d_smgr);
+}
@@ -0,0 +1,339 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+#include <unistd.h>
+#include <vector>
+
+extern "C" {
+#include "boolector.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btoropt.h"
+#include "btorsnapshot.h"
+#include "preprocess/btorpreprocess.h"
+}
+
+class TestSnapshot : public TestBtor
+{
+ protected:
+  void SetUp () override
+  {
+    TestBtor::SetUp ();
+
+    d_file = tmpfile ();
+    ASSERT_NE (d_file, nullptr);
+    d_restored = btor_new ();
+    /* model checking is only supported on the API level */
+    btor_opt_set (d_btor, BTOR_OPT_CHK_MODEL, 0);
+    btor_opt_set (d_restored, BTOR_OPT_CHK_MODEL, 0);
+  }
+
+  void TearDown () override
+  {
+    if (d_restored) btor_delete (d_restored);
+    if (d_file) fclose (d_file);
+
+    TestBtor::TearDown ();
+  }
+
+  /* Write snapshot of d_btor and restore it into d_restored. */
+  const char *round_trip ()
+  {
+    EXPECT_TRUE (btor_snapshot_write (d_btor, d_file));
+    rewind (d_file);
+    return btor_snapshot_read (d_restored, d_file);
+  }
+
+  FILE *d_file     = nullptr;
+  Btor *d_restored = nullptr;
+};
+
+TEST_F (TestSnapshot, bv)
+{
+  BtorSortId s8;
+  BtorNode *x, *y, *c, *mul, *ult, *ext, *slice, *eq;
+
+  s8    = btor_sort_bv (d_btor, 8);
+  x     = btor_exp_var (d_btor, s8, "x");
+  y     = btor_exp_var (d_btor, s8, "y");
+  c     = btor_exp_bv_int (d_btor, 123, s8);
+  mul   = btor_exp_bv_mul (d_btor, x, y);
+  ult   = btor_exp_bv_ult (d_btor, c, mul);
+  ext   = btor_exp_bv_concat (d_btor, x, y);
+  slice = btor_exp_bv_slice (d_btor, ext, 11, 4);
+  eq    = btor_exp_eq (d_btor, slice, c);
+  btor_assert_exp (d_btor, ult);
+  btor_assert_exp (d_btor, btor_node_invert (eq));
+
+  ASSERT_EQ (round_trip (), nullptr);
+  ASSERT_EQ (btor_check_sat (d_btor, -1, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (btor_check_sat (d_restored, -1, -1), BTOR_RESULT_SAT);
+  ASSERT_NE (btor_node_get_by_symbol (d_restored, "x"), nullptr);
+  ASSERT_NE (btor_node_get_by_symbol (d_restored, "y"), nullptr);
+
+  btor_node_release (d_btor, eq);
+  btor_node_release (d_btor, slice);
+  btor_node_release (d_btor, ext);
+  btor_node_release (d_btor, ult);
+  btor_node_release (d_btor, mul);
+  btor_node_release (d_btor, c);
+  btor_node_release (d_btor, y);
+  btor_node_release (d_btor, x);
+  btor_sort_release (d_btor, s8);
+}
+
+TEST_F (TestSnapshot, unsat_array)
+{
+  BtorSortId s8, as;
+  BtorNode *a, *i, *j, *w, *r, *ri, *eq, *ne;
+
+  s8 = btor_sort_bv (d_btor, 8);
+  as = btor_sort_array (d_btor, s8, s8);
+  a  = btor_exp_array (d_btor, as, "a");
+  i  = btor_exp_var (d_btor, s8, "i");
+  j  = btor_exp_var (d_btor, s8, "j");
+  w  = btor_exp_write (d_btor, a, i, j);
+  r  = btor_exp_read (d_btor, w, i);
+  ri = btor_exp_read (d_btor, a, j);
+  eq = btor_exp_eq (d_btor, r, ri);
+  ne = btor_exp_eq (d_btor, r, j);
+  btor_assert_exp (d_btor, btor_node_invert (ne));
+  btor_assert_exp (d_btor, eq);
+
+  ASSERT_EQ (round_trip (), nullptr);
+  ASSERT_EQ (btor_check_sat (d_btor, -1, -1), BTOR_RESULT_UNSAT);
+  ASSERT_EQ (btor_check_sat (d_restored, -1, -1), BTOR_RESULT_UNSAT);
+  ASSERT_TRUE (
+      btor_node_real_addr (btor_node_get_by_symbol (d_restored, "a"))
+          ->is_array);
+
+  btor_node_release (d_btor, ne);
+  btor_node_release (d_btor, eq);
+  btor_node_release (d_btor, ri);
+  btor_node_release (d_btor, r);
+  btor_node_release (d_btor, w);
+  btor_node_release (d_btor, j);
+  btor_node_release (d_btor, i);
+  btor_node_release (d_btor, a);
+  btor_sort_release (d_btor, as);
+  btor_sort_release (d_btor, s8);
+}
+
+TEST_F (TestSnapshot, alias)
+{
+  BtorSortId s8;
+  BtorNode *x, *y, *eq, *rx, *ry, *v;
+
+  s8 = btor_sort_bv (d_btor, 8);
+  x  = btor_exp_var (d_btor, s8, "x");
+  y  = btor_exp_var (d_btor, s8, "y");
+  eq = btor_exp_eq (d_btor, x, y);
+  btor_assert_exp (d_btor, eq);
+  btor_simplify (d_btor);
+
+  /* x or y is substituted and only kept as alias */
+  btor_opt_set (d_restored, BTOR_OPT_INCREMENTAL, 1);
+  ASSERT_EQ (round_trip (), nullptr);
+  rx = btor_node_get_by_symbol (d_restored, "x");
+  ry = btor_node_get_by_symbol (d_restored, "y");
+  ASSERT_NE (rx, nullptr);
+  ASSERT_NE (ry, nullptr);
+  rx = btor_node_copy (d_restored, rx);
+  ry = btor_node_copy (d_restored, ry);
+  ASSERT_EQ (btor_check_sat (d_restored, -1, -1), BTOR_RESULT_SAT);
+
+  /* the alias is still equal to the remaining input */
+  v = btor_exp_bv_ult (d_restored, rx, ry);
+  btor_assert_exp (d_restored, v);
+  ASSERT_EQ (btor_check_sat (d_restored, -1, -1), BTOR_RESULT_UNSAT);
+
+  btor_node_release (d_restored, v);
+  btor_node_release (d_restored, ry);
+  btor_node_release (d_restored, rx);
+  btor_node_release (d_btor, eq);
+  btor_node_release (d_btor, y);
+  btor_node_release (d_btor, x);
+  btor_sort_release (d_btor, s8);
+}
+
+TEST_F (TestSnapshot, invalid)
+{
+  BtorSortId s8;
+  BtorNode *x, *y, *ult;
+  long size;
+  int ch;
+
+  s8  = btor_sort_bv (d_btor, 8);
+  x   = btor_exp_var (d_btor, s8, "x");
+  y   = btor_exp_var (d_btor, s8, "y");
+  ult = btor_exp_bv_ult (d_btor, x, y);
+  btor_assert_exp (d_btor, ult);
+  ASSERT_TRUE (btor_snapshot_write (d_btor, d_file));
+  size = ftell (d_file);
+
+  /* corrupted */
+  fseek (d_file, size / 2, SEEK_SET);
+  ch = fgetc (d_file);
+  fseek (d_file, size / 2, SEEK_SET);
+  fputc (ch ^ 1, d_file);
+  rewind (d_file);
+  ASSERT_NE (btor_snapshot_read (d_restored, d_file), nullptr);
+  ASSERT_EQ (btor_node_get_by_symbol (d_restored, "x"), nullptr);
+
+  /* not a snapshot */
+  rewind (d_file);
+  fputc ('x', d_file);
+  rewind (d_file);
+  ASSERT_NE (btor_snapshot_read (d_restored, d_file), nullptr);
+
+  /* truncated */
+  fclose (d_file);
+  d_file = tmpfile ();
+  ASSERT_TRUE (btor_snapshot_write (d_btor, d_file));
+  rewind (d_file);
+  ASSERT_EQ (ftruncate (fileno (d_file), size - 8), 0);
+  ASSERT_NE (btor_snapshot_read (d_restored, d_file), nullptr);
+  ASSERT_EQ (btor_check_sat (d_restored, -1, -1), BTOR_RESULT_SAT);
+
+  /* symbol clash */
+  rewind (d_file);
+  ASSERT_TRUE (btor_snapshot_write (d_btor, d_file));
+  rewind (d_file);
+  ASSERT_EQ (btor_snapshot_read (d_restored, d_file), nullptr);
+  rewind (d_file);
+  ASSERT_NE (btor_snapshot_read (d_restored, d_file), nullptr);
+
+  btor_node_release (d_btor, ult);
+  btor_node_release (d_btor, y);
+  btor_node_release (d_btor, x);
+  btor_sort_release (d_btor, s8);
+}
+
+TEST_F (TestSnapshot, invalid_operands)
+{
+  BtorSortId s4, s8;
+  BtorNode *x, *y, *eq;
+  std::vector<uint32_t> words;
+  uint32_t i, nsorts, idx4, idx8, checksum;
+  long size;
+
+  s4 = btor_sort_bv (d_btor, 4);
+  s8 = btor_sort_bv (d_btor, 8);
+  x  = btor_exp_var (d_btor, s8, 0);
+  y  = btor_exp_var (d_btor, s8, 0);
+  eq = btor_exp_eq (d_btor, x, y);
+  btor_assert_exp (d_btor, eq);
+  ASSERT_TRUE (btor_snapshot_write (d_btor, d_file));
+  size = ftell (d_file);
+  words.resize (size / sizeof (uint32_t));
+  rewind (d_file);
+  ASSERT_EQ (fread (words.data (), sizeof (uint32_t), words.size (), d_file),
+             words.size ());
+
+  /* skip the 7 header words and the sorts */
+  nsorts = words[3];
+  idx4 = idx8 = UINT32_MAX;
+  for (i = 7; nsorts > 0; nsorts--)
+  {
+    ASSERT_EQ (words[i], (uint32_t) BTOR_BV_SORT);
+    if (words[i + 1] == 4) idx4 = words[3] - nsorts;
+    if (words[i + 1] == 8) idx8 = words[3] - nsorts;
+    i += 2;
+  }
+  ASSERT_NE (idx4, UINT32_MAX);
+
+  /* turn the second variable into a bit-vector of width 4, i.e., create
+   * eq (bv8, bv4) */
+  ASSERT_EQ (words[i], (uint32_t) BTOR_VAR_NODE);
+  ASSERT_EQ (words[i + 1], idx8);
+  ASSERT_EQ (words[i + 2], (uint32_t) BTOR_VAR_NODE);
+  ASSERT_EQ (words[i + 3], idx8);
+  words[i + 3] = idx4;
+
+  /* FNV-1a checksum over all but the last word */
+  checksum = 2166136261u;
+  for (i = 0; i + 1 < words.size (); i++)
+  {
+    checksum ^= words[i];
+    checksum *= 16777619u;
+  }
+  words.back () = checksum;
+
+  rewind (d_file);
+  ASSERT_EQ (fwrite (words.data (), sizeof (uint32_t), words.size (), d_file),
+             words.size ());
+  rewind (d_file);
+  ASSERT_STREQ (btor_snapshot_read (d_restored, d_file), "invalid operands");
+  ASSERT_EQ (d_restored->unsynthesized_constraints->count, 0u);
+
+  btor_node_release (d_btor, eq);
+  btor_node_release (d_btor, y);
+  btor_node_release (d_btor, x);
+  btor_sort_release (d_btor, s8);
+  btor_sort_release (d_btor, s4);
+}
+
+TEST_F (TestSnapshot, api)
+{
+  BoolectorSort s;
+  BoolectorNode *x, *y, *one, *mul, *c, *eq, *ugt1, *ugt2, *rx, *ry;
+  char *ax, *ay;
+
+  s    = boolector_bitvec_sort (d_btor, 16);
+  x    = boolector_var (d_btor, s, "x");
+  y    = boolector_var (d_btor, s, "y");
+  one  = boolector_one (d_btor, s);
+  mul  = boolector_mul (d_btor, x, y);
+  c    = boolector_unsigned_int (d_btor, 391, s);
+  eq   = boolector_eq (d_btor, mul, c);
+  ugt1 = boolector_ugt (d_btor, x, one);
+  ugt2 = boolector_ugt (d_btor, y, one);
+  boolector_assert (d_btor, eq);
+  boolector_assert (d_btor, ugt1);
+  boolector_assert (d_btor, ugt2);
+  boolector_simplify (d_btor);
+
+  ASSERT_TRUE (boolector_snapshot_write (d_btor, d_file));
+  rewind (d_file);
+  boolector_set_opt (d_restored, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_restored, BTOR_OPT_MODEL_GEN, 1);
+  ASSERT_EQ (boolector_snapshot_read (d_restored, d_file), nullptr);
+  ASSERT_EQ (boolector_sat (d_restored), BOOLECTOR_SAT);
+  rx = boolector_match_node_by_symbol (d_restored, "x");
+  ry = boolector_match_node_by_symbol (d_restored, "y");
+  ASSERT_NE (rx, nullptr);
+  ASSERT_NE (ry, nullptr);
+  ax = (char *) boolector_bv_assignment (d_restored, rx);
+  ay = (char *) boolector_bv_assignment (d_restored, ry);
+  ASSERT_EQ (strtoul (ax, 0, 2) * strtoul (ay, 0, 2) % 65536, 391u);
+  ASSERT_GT (strtoul (ax, 0, 2), 1u);
+  ASSERT_GT (strtoul (ay, 0, 2), 1u);
+  boolector_free_bv_assignment (d_restored, ax);
+  boolector_free_bv_assignment (d_restored, ay);
+
+  /* a failed restore reports an error and leaves the formula unchanged */
+  rewind (d_file);
+  fputc ('x', d_file);
+  rewind (d_file);
+  ASSERT_NE (boolector_snapshot_read (d_restored, d_file), nullptr);
+  ASSERT_EQ (boolector_sat (d_restored), BOOLECTOR_SAT);
+
+  boolector_release (d_restored, rx);
+  boolector_release (d_restored, ry);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, one);
+  boolector_release (d_btor, mul);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, eq);
+  boolector_release (d_btor, ugt1);
+  boolector_release (d_btor, ugt2);
+  boolector_release_sort (d_btor, s);
+}